@@ -1,18 +1,49 @@
 #version 330 core
 
 in vec2 TexCoord;
+in vec2 ShadowUvOffset;
+in vec4 TextColor;
 out vec4 FragColor;
 
+// Signed distance field, 0.5 is the glyph edge and the full range covers uSdfSpread font pixels on each side
 uniform sampler2D uTexture;
-uniform vec3 uTextColor;   // Text tint color (e.g. white = vec3(1.0))
+uniform float uSdfSpread;
+
+uniform vec4 uShadowColor;   // Alpha 0 disables the shadow
+uniform vec3 uOutlineColor;
+uniform float uOutlineWidth; // In font pixels, 0 disables the outline
+
+float Coverage(float distance, float edge)
+{
+    float width = max(fwidth(distance), 1e-4) * 0.5;
+    return smoothstep(edge - width, edge + width, distance);
+}
 
 void main()
 {
-    vec4 sampled = texture(uTexture, TexCoord);
+    float distance = texture(uTexture, TexCoord).r;
+
+    // Distance in font pixels maps to (0.5 / uSdfSpread) per pixel in the texture
+    float outlineEdge = 0.5 - uOutlineWidth * 0.5 / uSdfSpread;
+
+    float textAlpha = Coverage(distance, 0.5);
+    float outlineAlpha = uOutlineWidth > 0.0 ? Coverage(distance, outlineEdge) : textAlpha;
+
+    vec3 color = mix(uOutlineColor, TextColor.rgb, textAlpha);
+    float alpha = outlineAlpha;
+
+    if (uShadowColor.a > 0.0)
+    {
+        float shadowDistance = texture(uTexture, TexCoord - ShadowUvOffset).r;
+        float shadowAlpha = Coverage(shadowDistance, uOutlineWidth > 0.0 ? outlineEdge : 0.5) * uShadowColor.a;
+
+        color = mix(uShadowColor.rgb, color, alpha);
+        alpha = alpha + shadowAlpha * (1.0 - alpha);
+    }
 
-    // Use alpha from texture
-    if (sampled.a < 0.1)
+    alpha *= TextColor.a;
+    if (alpha < 0.01)
         discard;
 
-    FragColor = vec4(uTextColor, sampled.a);
+    FragColor = vec4(color, alpha);
 }
@@ -1,14 +1,40 @@
 #version 330 core
 
-layout(location = 0) in vec3 aPos;
-layout(location = 1) in vec2 aUV;
+// Per-instance attributes (one instance per character)
+layout(location = 0) in vec2 aGlyphPos;   // Top-left corner in pixels
+layout(location = 1) in uint aGlyphIndex; // Index into uGlyphMetrics
+layout(location = 2) in vec4 aColor;      // RGBA8 normalized
 
 uniform mat4 uProjection;
+uniform float uScale;
+uniform float uShadowOffset; // In font pixels
+
+// 2 texels per glyph : (u0, v0, u1, v1) of the padded cell and (width, height, advance, padding)
+uniform samplerBuffer uGlyphMetrics;
 
 out vec2 TexCoord;
+out vec2 ShadowUvOffset;
+out vec4 TextColor;
+
+// Triangle strip corners, indexed by gl_VertexID
+const vec2 kCorners[4] = vec2[4](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(0.0, 1.0), vec2(1.0, 1.0));
 
 void main()
 {
-    gl_Position = uProjection * vec4(aPos, 1.0);
-    TexCoord = aUV;
+    vec2 corner = kCorners[gl_VertexID];
+
+    int base = int(aGlyphIndex) * 2;
+    vec4 uvRect = texelFetch(uGlyphMetrics, base);
+    vec4 metrics = texelFetch(uGlyphMetrics, base + 1);
+
+    // The quad covers the glyph and its padding, so shadows and outlines are not clipped
+    float padding = metrics.w;
+    vec2 paddedSize = metrics.xy + vec2(2.0 * padding);
+    vec2 pos = aGlyphPos + (corner * paddedSize - vec2(padding)) * uScale;
+
+    gl_Position = uProjection * vec4(pos, 0.0, 1.0);
+    TexCoord = mix(uvRect.xy, uvRect.zw, corner);
+
+    ShadowUvOffset = (uvRect.zw - uvRect.xy) / paddedSize * uShadowOffset;
+    TextColor = aColor;
 }
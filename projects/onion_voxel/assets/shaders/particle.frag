@@ -0,0 +1,18 @@
+#version 330 core
+
+in vec2 TexCoord;
+in vec4 ParticleColor;
+out vec4 FragColor;
+
+uniform sampler2D uAtlas;
+
+void main()
+{
+    vec4 color = texture(uAtlas, TexCoord) * ParticleColor;
+
+    // Cutout, the particles are not sorted
+    if (color.a < 0.1)
+        discard;
+
+    FragColor = color;
+}
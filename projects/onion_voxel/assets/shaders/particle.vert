@@ -0,0 +1,43 @@
+#version 330 core
+
+// Per-instance attributes (one instance per particle)
+layout(location = 0) in vec4 aPositionSize; // Center in blocks, side of the quad in blocks
+layout(location = 1) in uint aSprite;       // Index into uSprites, and the quarter bits (see ParticleSystem)
+layout(location = 2) in vec4 aColor;        // RGBA8 normalized
+
+uniform mat4 uViewProjection;
+uniform vec3 uCameraRight;
+uniform vec3 uCameraUp;
+
+// 1 texel per sprite : (u0, v0, u1, v1) in the atlas
+uniform samplerBuffer uSprites;
+
+out vec2 TexCoord;
+out vec4 ParticleColor;
+
+// Triangle strip corners, indexed by gl_VertexID
+const vec2 kCorners[4] = vec2[4](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(0.0, 1.0), vec2(1.0, 1.0));
+
+void main()
+{
+    vec2 corner = kCorners[gl_VertexID];
+
+    vec4 uvRect = texelFetch(uSprites, int(aSprite & 0xFFFFu));
+
+    // Block debris shows a quarter of the texture, at one of 4 x 4 cells
+    if ((aSprite & 0x10000u) != 0u)
+    {
+        vec2 cell = vec2(float((aSprite >> 17) & 3u), float((aSprite >> 19) & 3u));
+        vec2 cellSize = (uvRect.zw - uvRect.xy) * 0.25;
+        uvRect.xy += cell * cellSize;
+        uvRect.zw = uvRect.xy + cellSize;
+    }
+
+    // Facing the camera
+    vec2 offset = (corner - vec2(0.5)) * aPositionSize.w;
+    vec3 position = aPositionSize.xyz + uCameraRight * offset.x + uCameraUp * offset.y;
+
+    gl_Position = uViewProjection * vec4(position, 1.0);
+    TexCoord = mix(uvRect.xy, uvRect.zw, vec2(corner.x, 1.0 - corner.y));
+    ParticleColor = aColor;
+}
@@ -0,0 +1,12 @@
+#version 330 core
+
+out vec4 FragColor;
+in vec2 TexCoord;
+
+uniform sampler2DArray uTextures;
+uniform float uLayer;
+
+void main()
+{
+    FragColor = texture(uTextures, vec3(TexCoord, uLayer));
+}
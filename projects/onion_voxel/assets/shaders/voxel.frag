@@ -0,0 +1,18 @@
+#version 330 core
+
+out vec4 FragColor;
+in vec3 TexCoord;
+in float Shade;
+
+uniform sampler2DArray uTextures;
+
+void main()
+{
+    vec4 color = texture(uTextures, TexCoord);
+
+    // Cutout blocks (leaves) are drawn with the opaque meshes
+    if (color.a < 0.1)
+        discard;
+
+    FragColor = vec4(color.rgb * Shade, color.a);
+}
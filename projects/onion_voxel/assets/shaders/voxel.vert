@@ -0,0 +1,48 @@
+#version 330 core
+
+// Packed VoxelVertex, see renderer/world/VoxelVertex.hpp
+layout(location = 0) in uvec2 aData;
+// Section origin (xyz) and scale (w) per draw of a multi draw indirect, (0, 0, 0, 1) when the attribute is disabled
+layout(location = 1) in vec4 aDrawOrigin;
+
+uniform mat4 uViewProjection;
+uniform vec3 uChunkOrigin; // World position of the section minimum corner, for the draws without aDrawOrigin
+uniform float uChunkScale = 1.0; // Blocks per mesh unit, 2^level for the coarser levels of detail
+
+out vec3 TexCoord; // (u, v, layer)
+out float Shade;
+
+// Per BlockFace : PosX, NegX, PosY, NegY, PosZ, NegZ
+const float kFaceShade[6] = float[6](0.8, 0.8, 1.0, 0.5, 0.6, 0.6);
+const float kOcclusion[4] = float[4](0.4, 0.6, 0.8, 1.0);
+const float kMinBrightness = 0.05; // Caves are dark, not black
+
+void main()
+{
+    vec3 localPos = vec3(aData.x & 63u, (aData.x >> 6) & 63u, (aData.x >> 12) & 63u);
+    uint face = (aData.x >> 18) & 7u;
+    uint ambientOcclusion = (aData.x >> 21) & 3u;
+    uint layer = aData.y & 0xFFFFu;
+    // Smooth light of the corner, x4 in [0, 60]
+    float blockLight = float((aData.y >> 16) & 63u) / 60.0;
+    float skyLight = float((aData.y >> 22) & 63u) / 60.0;
+
+    vec3 worldPos = uChunkOrigin + aDrawOrigin.xyz + localPos * (uChunkScale * aDrawOrigin.w);
+    gl_Position = uViewProjection * vec4(worldPos, 1.0);
+
+    // Merged quads span several blocks, texture coordinates come from the position so the texture repeats.
+    // Sides are upright (V goes down with Y), top and bottom use X and Z.
+    vec2 uv;
+    if (face < 2u)
+        uv = vec2(worldPos.z, -worldPos.y);
+    else if (face < 4u)
+        uv = worldPos.xz;
+    else
+        uv = vec2(worldPos.x, -worldPos.y);
+
+    TexCoord = vec3(uv, float(layer));
+    // Convex curve : half light is a fifth of full brightness, light falls off fast away from the source
+    float light = max(blockLight, skyLight);
+    float brightness = mix(kMinBrightness, 1.0, light / (4.0 - 3.0 * light));
+    Shade = kFaceShade[face] * kOcclusion[ambientOcclusion] * brightness;
+}
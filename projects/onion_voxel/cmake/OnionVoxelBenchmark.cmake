@@ -0,0 +1,37 @@
+# OnionVoxelBenchmark.cmake
+# ---------------------------------------------------------------------------
+# onion_voxel_add_benchmark(<name>
+#     SOURCES <sources...>
+#     [INCLUDE_DIRECTORIES <dirs...>])
+# Adds the executable onion_voxel_benchmark_<name>, linked to onion_voxel_shared
+# ---------------------------------------------------------------------------
+
+function(onion_voxel_add_benchmark name)
+    cmake_parse_arguments(PARSE_ARGV 1 ARG "" "" "SOURCES;INCLUDE_DIRECTORIES")
+
+    set(target onion_voxel_benchmark_${name})
+
+    add_executable(${target}
+        ${ARG_SOURCES}
+    )
+
+    if (ARG_INCLUDE_DIRECTORIES)
+        target_include_directories(${target}
+            PRIVATE
+                ${ARG_INCLUDE_DIRECTORIES}
+        )
+    endif()
+
+    target_link_libraries(${target}
+        PRIVATE
+            onion_voxel_shared
+    )
+
+    target_compile_features(${target} PRIVATE cxx_std_20)
+
+    set_target_properties(${target} PROPERTIES
+        CXX_STANDARD 20
+        CXX_STANDARD_REQUIRED ON
+        CXX_EXTENSIONS OFF
+    )
+endfunction()
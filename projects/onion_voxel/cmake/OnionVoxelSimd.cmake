@@ -0,0 +1,19 @@
+# OnionVoxelSimd.cmake
+# ---------------------------------------------------------------------------
+# onion_voxel_enable_avx(<sources...>)
+# Builds the given sources of the current directory with AVX enabled. The rest
+# of the target keeps running on any x86 CPU : only call into these files after
+# CpuSupportsAvx() (shared/platform/CpuFeatures.hpp)
+# ---------------------------------------------------------------------------
+
+function(onion_voxel_enable_avx)
+    if (NOT CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64|i[3-6]86|x86)$")
+        return()
+    endif()
+
+    if (MSVC)
+        set_property(SOURCE ${ARGN} APPEND PROPERTY COMPILE_OPTIONS /arch:AVX)
+    else()
+        set_property(SOURCE ${ARGN} APPEND PROPERTY COMPILE_OPTIONS -mavx)
+    endif()
+endfunction()
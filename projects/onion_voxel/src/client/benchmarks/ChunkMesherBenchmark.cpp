@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <renderer/world/ChunkMesher.hpp>
+#include <world/Blocks.hpp>
+#include <world/ChunkStore.hpp>
+#include <world/LightEngine.hpp>
+#include <world/SectionRegion.hpp>
+#include <world/SectionSnapshot.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace onion::voxel;
+using namespace onion::voxel::benchmark;
+
+namespace
+{
+	constexpr int WorldRadius = 4; // 8 x 8 chunks
+	constexpr int SeaLevel = 62;
+
+	/// @brief Rolling hills with lakes, caves, ores and a few trees, so meshes have the usual mix of large flat
+	/// areas (merged well) and scattered details (merged poorly).
+	void GenerateTerrain(ChunkStore& store)
+	{
+		std::mt19937 random(1234);
+		std::uniform_int_distribution<int> chance(0, 999);
+
+		for (int chunkX = -WorldRadius; chunkX < WorldRadius; chunkX++)
+		{
+			for (int chunkZ = -WorldRadius; chunkZ < WorldRadius; chunkZ++)
+			{
+				Chunk& chunk = store.GetOrCreateChunk({chunkX, chunkZ});
+
+				for (int x = 0; x < ChunkSize; x++)
+				{
+					for (int z = 0; z < ChunkSize; z++)
+					{
+						const int worldX = chunkX * ChunkSize + x;
+						const int worldZ = chunkZ * ChunkSize + z;
+						const int height =
+							64 + static_cast<int>(8.0 * std::sin(worldX * 0.05) * std::cos(worldZ * 0.07));
+
+						for (int y = 0; y <= std::max(height, SeaLevel); y++)
+						{
+							BlockId block = Blocks::Stone;
+							if (y == 0)
+								block = Blocks::Bedrock;
+							else if (y > height)
+								block = Blocks::Water;
+							else if (y == height)
+								block = height >= SeaLevel ? Blocks::Grass : Blocks::Sand;
+							else if (y > height - 4)
+								block = Blocks::Dirt;
+							else if (std::sin(worldX * 0.2) * std::sin(y * 0.25) * std::sin(worldZ * 0.2) > 0.6)
+								block = Blocks::Air; // Caves
+							else if (chance(random) < 8)
+								block = Blocks::CoalOre;
+
+							chunk.SetBlock(x, y, z, block);
+						}
+
+						// Trees : a trunk and a cube of leaves
+						if (height > SeaLevel && x >= 2 && x < 14 && z >= 2 && z < 14 && chance(random) < 4)
+						{
+							for (int dy = 3; dy <= 6; dy++)
+								for (int dz = -2; dz <= 2; dz++)
+									for (int dx = -2; dx <= 2; dx++)
+										chunk.SetBlock(x + dx, height + dy, z + dz, Blocks::OakLeaves);
+							for (int dy = 1; dy <= 5; dy++)
+								chunk.SetBlock(x, height + dy, z, Blocks::OakLog);
+						}
+					}
+				}
+
+				chunk.Compact();
+			}
+		}
+	}
+} // namespace
+
+int main()
+{
+	std::cout << "-------------- Benchmark Chunk Mesher --------------" << std::endl;
+
+	ChunkStore store;
+	GenerateTerrain(store);
+
+	// Lit like the game world, so the corners have the usual mix of sky, shade and caves
+	LightEngine lighting(store);
+	for (const auto& [coord, chunk] : store.GetChunks())
+		lighting.AddChunk(coord);
+	lighting.Propagate();
+
+	// Snapshots of every non empty section, as the meshing jobs get them
+	std::vector<SectionSnapshot> snapshots;
+	for (const auto& [coord, chunk] : store.GetChunks())
+	{
+		for (int sectionY = 0; sectionY < Chunk::SectionCount; sectionY++)
+		{
+			SectionSnapshot snapshot;
+			snapshot.Capture(store, coord, sectionY);
+			if (!snapshot.IsEmpty())
+				snapshots.push_back(snapshot);
+		}
+	}
+
+	const uint64_t sectionCount = snapshots.size();
+	std::cout << store.GetChunkCount() << " chunks, " << sectionCount << " non empty sections" << std::endl
+			  << std::endl;
+
+	const BlockAppearanceTable appearances = BlockAppearanceTable::CreateDefault();
+	ChunkMesher mesher(appearances);
+	SectionMesh mesh;
+
+	// ----- Vertex counts -----
+	size_t fullDetailQuads = 0;
+	auto printCounts = [&](const char* name)
+	{
+		size_t totalQuads = 0;
+		size_t maxQuads = 0;
+		for (const SectionSnapshot& snapshot : snapshots)
+		{
+			mesher.Mesh(snapshot, mesh);
+			totalQuads += mesh.GetQuadCount();
+			maxQuads = std::max(maxQuads, mesh.GetQuadCount());
+		}
+
+		fullDetailQuads = totalQuads;
+		const double quadsPerSection = static_cast<double>(totalQuads) / sectionCount;
+		std::cout << name << " : " << quadsPerSection * 4 << " vertices per section (max " << maxQuads * 4 << "), "
+				  << quadsPerSection * 4 * sizeof(VoxelVertex) / 1024.0 << " KiB per section" << std::endl;
+	};
+
+	mesher.SetGreedy(false);
+	printCounts("Face culling only");
+	mesher.SetGreedy(true);
+	printCounts("Greedy meshing   ");
+	std::cout << std::endl;
+
+	// ----- Timings -----
+	Measure("Snapshot capture, per section",
+			sectionCount,
+			[&]()
+			{
+				SectionSnapshot snapshot;
+				for (const SectionSnapshot& source : snapshots)
+				{
+					snapshot.Capture(store, source.GetCoord(), source.GetSectionY());
+					DoNotOptimize(snapshot.Get(0, 0, 0));
+				}
+			});
+
+	mesher.SetGreedy(false);
+	Measure("Face culling only, per section",
+			sectionCount,
+			[&]()
+			{
+				size_t vertices = 0;
+				for (const SectionSnapshot& snapshot : snapshots)
+				{
+					mesher.Mesh(snapshot, mesh);
+					vertices += mesh.OpaqueVertices.size() + mesh.TransparentVertices.size();
+				}
+				DoNotOptimize(vertices);
+			});
+
+	mesher.SetGreedy(true);
+	Measure("Greedy meshing, per section",
+			sectionCount,
+			[&]()
+			{
+				size_t vertices = 0;
+				for (const SectionSnapshot& snapshot : snapshots)
+				{
+					mesher.Mesh(snapshot, mesh);
+					vertices += mesh.OpaqueVertices.size() + mesh.TransparentVertices.size();
+				}
+				DoNotOptimize(vertices);
+			});
+
+	Measure("Face connectivity only, per section",
+			sectionCount,
+			[&]()
+			{
+				SectionConnectivity connectivity;
+				size_t verticalPaths = 0;
+				for (const SectionSnapshot& snapshot : snapshots)
+				{
+					mesher.ComputeConnectivity(snapshot, connectivity);
+					verticalPaths += connectivity.IsConnected(BlockFace::PosY, BlockFace::NegY) ? 1 : 0;
+				}
+				DoNotOptimize(verticalPaths);
+			});
+	std::cout << std::endl;
+
+	// ----- Levels of detail : the whole terrain meshed at each level -----
+	std::cout << "LOD 0 (1x) : " << sectionCount << " sections, " << fullDetailQuads * 4 << " vertices, "
+			  << fullDetailQuads * 4 * sizeof(VoxelVertex) / 1024.0 << " KiB for the whole terrain" << std::endl;
+
+	for (int level = 1; level <= SectionRegion::MaxLevel; level++)
+	{
+		const int regionsPerAxis = 2 * WorldRadius >> level;
+		std::vector<SectionRegion> regions;
+
+		for (int y = 0; (y << level) < Chunk::SectionCount; y++)
+		{
+			for (int z = 0; z < regionsPerAxis; z++)
+			{
+				for (int x = 0; x < regionsPerAxis; x++)
+				{
+					const SectionCoord coord{x - (WorldRadius >> level), y, z - (WorldRadius >> level)};
+
+					SectionRegion region;
+					if (region.Capture(store, coord, level))
+						regions.push_back(std::move(region));
+				}
+			}
+		}
+
+		SectionSnapshot snapshot;
+		size_t totalQuads = 0;
+		for (const SectionRegion& region : regions)
+		{
+			snapshot.Downsample(region);
+			mesher.Mesh(snapshot, mesh);
+			totalQuads += mesh.GetQuadCount();
+		}
+
+		std::cout << "LOD " << level << " (" << (1 << level) << "x) : " << regions.size() << " regions, "
+				  << totalQuads * 4 << " vertices, " << totalQuads * 4 * sizeof(VoxelVertex) / 1024.0
+				  << " KiB for the whole terrain" << std::endl;
+
+		Measure("Downsampling and meshing, per region",
+				regions.size(),
+				[&]()
+				{
+					size_t vertices = 0;
+					for (const SectionRegion& region : regions)
+					{
+						snapshot.Downsample(region);
+						mesher.Mesh(snapshot, mesh);
+						vertices += mesh.OpaqueVertices.size() + mesh.TransparentVertices.size();
+					}
+					DoNotOptimize(vertices);
+				});
+	}
+
+	return 0;
+}
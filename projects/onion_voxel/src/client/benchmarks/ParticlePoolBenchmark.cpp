@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <renderer/particles/ParticlePool.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace onion::voxel;
+using namespace onion::voxel::benchmark;
+
+namespace
+{
+	constexpr float DeltaSeconds = 1.f / 60.f;
+	constexpr int UpdateSteps = 60;
+
+	/// @brief The usual layout : one struct per particle, the same integration one particle at a time.
+	struct Particle
+	{
+		float X, Y, Z;
+		float VelocityX, VelocityY, VelocityZ;
+		float Age, Lifetime, Size, Gravity, Drag;
+		uint32_t Sprite;
+		uint16_t FrameCount;
+		uint32_t Color;
+	};
+
+	void UpdateAos(std::vector<Particle>& particles, float deltaSeconds)
+	{
+		for (size_t i = 0; i < particles.size();)
+		{
+			Particle& particle = particles[i];
+			const float keep = std::max(1.f - particle.Drag * deltaSeconds, 0.f);
+
+			particle.VelocityX *= keep;
+			particle.VelocityY = (particle.VelocityY - particle.Gravity * deltaSeconds) * keep;
+			particle.VelocityZ *= keep;
+			particle.X += particle.VelocityX * deltaSeconds;
+			particle.Y += particle.VelocityY * deltaSeconds;
+			particle.Z += particle.VelocityZ * deltaSeconds;
+			particle.Age += deltaSeconds;
+
+			if (particle.Age < particle.Lifetime)
+			{
+				i++;
+				continue;
+			}
+
+			particle = particles.back();
+			particles.pop_back();
+		}
+	}
+
+	std::vector<ParticleSpawn> MakeSpawns(size_t count)
+	{
+		std::mt19937 random(1234);
+		std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+		// Lifetimes past the measured steps, every run updates the same particles
+		std::vector<ParticleSpawn> spawns(count);
+		for (ParticleSpawn& spawn : spawns)
+		{
+			spawn.X = unit(random) * 64.f;
+			spawn.Y = 64.f + unit(random) * 16.f;
+			spawn.Z = unit(random) * 64.f;
+			spawn.VelocityX = unit(random) - 0.5f;
+			spawn.VelocityY = unit(random) * 4.f;
+			spawn.VelocityZ = unit(random) - 0.5f;
+			spawn.Lifetime = 1000.f;
+			spawn.Size = 0.1f;
+			spawn.Gravity = 16.f;
+			spawn.Drag = 0.4f;
+		}
+		return spawns;
+	}
+
+	void Run(size_t count)
+	{
+		const std::string name = std::to_string(count / 1000) + "k particles";
+		const std::vector<ParticleSpawn> spawns = MakeSpawns(count);
+
+		ParticlePool pool(count);
+		for (const ParticleSpawn& spawn : spawns)
+			pool.Emit(spawn);
+
+		Measure(name + " : SoA update (per particle)",
+				count * UpdateSteps,
+				[&]()
+				{
+					for (int step = 0; step < UpdateSteps; step++)
+						pool.Update(DeltaSeconds);
+				});
+		DoNotOptimize(pool.GetPositionY()[count / 2]);
+
+		std::vector<Particle> particles;
+		particles.reserve(count);
+		for (const ParticleSpawn& spawn : spawns)
+			particles.push_back({spawn.X,
+								 spawn.Y,
+								 spawn.Z,
+								 spawn.VelocityX,
+								 spawn.VelocityY,
+								 spawn.VelocityZ,
+								 0.f,
+								 spawn.Lifetime,
+								 spawn.Size,
+								 spawn.Gravity,
+								 spawn.Drag,
+								 spawn.Sprite,
+								 spawn.FrameCount,
+								 spawn.Color});
+
+		Measure(name + " : AoS scalar update (per particle)",
+				count * UpdateSteps,
+				[&]()
+				{
+					for (int step = 0; step < UpdateSteps; step++)
+						UpdateAos(particles, DeltaSeconds);
+				});
+		DoNotOptimize(particles[count / 2].Y);
+
+		// Bursts into a pool emptied each run, the arrays are never reallocated
+		Measure(name + " : emit (per particle)",
+				count,
+				[&]()
+				{
+					pool.Clear();
+					for (const ParticleSpawn& spawn : spawns)
+						pool.Emit(spawn);
+				});
+		DoNotOptimize(pool.GetCount());
+
+		std::cout << std::endl;
+	}
+} // namespace
+
+int main()
+{
+	std::cout << "-------------- Benchmark Particle Pool --------------" << std::endl;
+	std::cout << "Update with " << ParticlePool::GetInstructionSet() << ", " << UpdateSteps << " steps per run"
+			  << std::endl
+			  << std::endl;
+
+	for (size_t count : {1000, 10000, 100000})
+		Run(count);
+
+	return 0;
+}
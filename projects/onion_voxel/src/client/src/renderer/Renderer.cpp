@@ -1,9 +1,18 @@
 #include "Renderer.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <iostream>
 #include <stdexcept>
 #include <stop_token>
+#include <string>
 #include <thread>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <physics/VoxelRaycaster.hpp>
 
 namespace
 {
@@ -11,6 +20,111 @@ namespace
 	{
 		std::fprintf(stderr, "GLFW error %d: %s\n", code, desc);
 	}
+
+	using namespace onion::voxel;
+
+	std::vector<std::string> GetDebugLines(const Camera& camera,
+										   const WorldRenderer& worldRenderer,
+										   const ChunkStreamer& streaming,
+										   const ParticleSystem& particles)
+	{
+		const glm::vec3& position = camera.GetPosition();
+		const WorldRenderer::FrameStats& frame = worldRenderer.GetFrameStats();
+		const MeshingPipeline::Stats meshing = worldRenderer.GetMeshing().GetStats();
+		const ChunkStreamer::Stats chunks = streaming.GetStats();
+
+		char buffer[160];
+		std::vector<std::string> lines;
+
+		std::snprintf(buffer, sizeof(buffer), "XYZ: %.1f / %.1f / %.1f", position.x, position.y, position.z);
+		lines.emplace_back(buffer);
+
+		std::snprintf(buffer,
+					  sizeof(buffer),
+					  "Chunks: %zu resident (%zu cached, %zu dirty, %.1f MiB), %zu pending, %zu in flight",
+					  chunks.ResidentCount,
+					  chunks.CachedCount,
+					  chunks.DirtyCount,
+					  static_cast<double>(chunks.ResidentBytes) / (1024.0 * 1024.0),
+					  chunks.PendingCount,
+					  chunks.InFlightCount);
+		lines.emplace_back(buffer);
+
+		std::snprintf(buffer,
+					  sizeof(buffer),
+					  "Sections: %zu drawn / %zu in frustum / %zu resident, %u draws",
+					  frame.VisibleCount,
+					  frame.FrustumCount,
+					  frame.SectionCount,
+					  frame.DrawCalls);
+		lines.emplace_back(buffer);
+
+		std::snprintf(buffer,
+					  sizeof(buffer),
+					  "Culling: frustum %.1f us (%s), occlusion %.1f us (%s, O to toggle)",
+					  frame.CullMicroseconds,
+					  FrustumCuller::GetInstructionSet(),
+					  frame.OcclusionMicroseconds,
+					  frame.OcclusionCulled ? "on" : "off");
+		lines.emplace_back(buffer);
+
+		const GLStateCache::FrameStats glState = GLStateCache::GetLastFrameStats();
+		std::snprintf(buffer,
+					  sizeof(buffer),
+					  "GL state: %u calls issued, %u elided (last frame)",
+					  glState.Issued,
+					  glState.Elided);
+		lines.emplace_back(buffer);
+
+		std::snprintf(buffer,
+					  sizeof(buffer),
+					  "Meshing: %zu dirty, %zu in flight, last upload %u (%zu KiB, %.2f ms)",
+					  meshing.DirtyCount,
+					  meshing.InFlightCount,
+					  meshing.LastUploadCount,
+					  meshing.LastUploadBytes / 1024,
+					  meshing.LastUploadMilliseconds);
+		lines.emplace_back(buffer);
+
+		std::snprintf(buffer,
+					  sizeof(buffer),
+					  "Terrain: %s, %u section layers, %zu arenas (%.1f MiB)",
+					  frame.MultiDrawIndirect ? "multi draw indirect" : "draw per section",
+					  frame.IndirectDraws,
+					  meshing.ArenaCount,
+					  static_cast<double>(meshing.ArenaUsedBytes) / (1024.0 * 1024.0));
+		lines.emplace_back(buffer);
+
+		const ParticlePool& pool = particles.GetPool();
+		std::snprintf(buffer,
+					  sizeof(buffer),
+					  "Particles: %zu / %zu (%s), %llu dropped (B burst, R rain)",
+					  pool.GetCount(),
+					  pool.GetCapacity(),
+					  ParticlePool::GetInstructionSet(),
+					  static_cast<unsigned long long>(pool.GetDroppedCount()));
+		lines.emplace_back(buffer);
+
+		for (int level = 0; level < LodLevelCount; level++)
+		{
+			const WorldRenderer::LevelFrameStats& drawn = frame.Levels[level];
+			const MeshingPipeline::LevelStats& resident = meshing.Levels[level];
+
+			std::snprintf(buffer,
+						  sizeof(buffer),
+						  "LOD %d (%dx): %zu drawn, %llu k vertices | %zu resident, %llu k vertices, %.1f MiB",
+						  level,
+						  1 << level,
+						  drawn.DrawnCount,
+						  static_cast<unsigned long long>(drawn.VertexCount / 1000),
+						  resident.MeshCount,
+						  static_cast<unsigned long long>(resident.VertexCount / 1000),
+						  static_cast<double>(resident.Bytes) / (1024.0 * 1024.0));
+			lines.emplace_back(buffer);
+		}
+
+		return lines;
+	}
 } // namespace
 
 namespace onion::voxel
@@ -52,12 +166,22 @@ namespace onion::voxel
 			throw std::runtime_error("GLFW initialization failed");
 		}
 
-		// Request an OpenGL context
-		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+		// Request the newest OpenGL context available, 4.3 brings multi draw indirect, 3.3 is the fallback
+		constexpr int ContextVersions[][2] = {{4, 6}, {4, 3}, {3, 3}};
+		for (const auto& [major, minor] : ContextVersions)
+		{
+			glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, major);
+			glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, minor);
+			glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+			m_Window = glfwCreateWindow(m_WindowWidth, m_WindowHeight, m_WindowTitle.c_str(), nullptr, nullptr);
+			if (m_Window)
+			{
+				std::cout << "[OPENGL] : " << major << "." << minor << " core context created" << std::endl;
+				break;
+			}
+		}
 
-		m_Window = glfwCreateWindow(m_WindowWidth, m_WindowHeight, m_WindowTitle.c_str(), nullptr, nullptr);
 		if (!m_Window)
 		{
 			glfwTerminate();
@@ -75,6 +199,9 @@ namespace onion::voxel
 			throw std::runtime_error("GLAD initialization failed");
 		}
 
+		// Entry points above 3.3 core, when the driver has them
+		GLExtensions::Load((GLADloadproc) glfwGetProcAddress);
+
 		// Initialize Inputs Manager
 		m_InputsManager.Init(m_Window);
 		m_InputsManager.SetMouseCaptureEnabled(false);
@@ -83,17 +210,22 @@ namespace onion::voxel
 
 	void Renderer::InitOpenGlState()
 	{
-		glEnable(GL_DEPTH_TEST);
-		glDepthFunc(GL_LESS);
+		// Fresh context : nothing is shadowed yet
+		GLStateCache::Invalidate();
 
-		//glEnable(GL_CULL_FACE);
-		//glCullFace(GL_BACK);
+		GLStateCache::SetEnabled(GL_DEPTH_TEST, true);
+		GLStateCache::DepthFunc(GL_LESS);
+
+		//GLStateCache::SetEnabled(GL_CULL_FACE, true);
+		//GLStateCache::CullFace(GL_BACK);
 		//glFrontFace(GL_CCW);
 
-		glDisable(GL_CULL_FACE);
+		GLStateCache::SetEnabled(GL_CULL_FACE, false);
+
+		GLStateCache::SetEnabled(GL_BLEND, true);
+		GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		GLStateCache::Viewport(0, 0, m_WindowWidth, m_WindowHeight);
 	}
 
 	void Renderer::RenderThreadFunction(std::stop_token st)
@@ -104,12 +236,26 @@ namespace onion::voxel
 
 		InitOpenGlState();
 
+		TextureLoader::Initialize();
+		m_RenderQueue.Initialize();
+		m_WorldRenderer.Initialize();
+		m_Particles.Initialize();
+
 		Gui::Initialize();
 		GuiElement::SetScreenSize(m_WindowWidth, m_WindowHeight);
 
 		DemoPanel demoPanel("DemoPanel");
 		demoPanel.Initialize();
 
+		DebugOverlay debugOverlay("DebugOverlay");
+		debugOverlay.Initialize();
+
+		// GL resources are created, from now on the GUI only records commands. The window size belongs to this
+		// thread, the logic thread starts from a copy
+		m_ThreadLogic = std::jthread(
+			[this, &demoPanel, &debugOverlay, width = m_WindowWidth, height = m_WindowHeight](std::stop_token st)
+			{ LogicThreadFunction(st, demoPanel, debugOverlay, width, height); });
+
 		while (!st.stop_requested() && !glfwWindowShouldClose(m_Window))
 		{
 			// Pool inputs
@@ -119,6 +265,8 @@ namespace onion::voxel
 			// Process Global Inputs
 			ProcessInputs(m_InputsSnapshot);
 
+			GLStateCache::BeginFrame();
+
 			// Clear
 			glClearColor(0.1f, 0.1f, 0.12f, 1.f);
 			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -128,47 +276,198 @@ namespace onion::voxel
 			m_DeltaTime = currentFrame - m_LastFrame;
 			m_LastFrame = currentFrame;
 
-			demoPanel.Render();
+			// Upload textures decoded and chunk sections meshed in the background
+			TextureLoader::Update(m_TextureUploadBudgetBytes);
+			m_WorldRenderer.Update(m_RenderQueue, m_MeshUploadBudgetMilliseconds, m_MeshUploadBudgetBytes);
+			m_Particles.Update();
 
-			//// Process Camera Movement
-			//ProcessCameraMovement(m_InputsSnapshot);
-
-			//// Get Camera projection, view and ProjView Matix
-			//m_ProjectionMatrix = m_Camera.GetProjectionMatrix();
-			//m_ViewMatrix = m_Camera.GetViewMatrix();
-			//m_ViewProjMatrix = m_ProjectionMatrix * m_ViewMatrix;
-
-			//// ------ TESTS MODELS ------
-			//UpdateShaderModel();
-			//DrawAppleModel();
+			// Draw the latest frame recorded by the logic thread, or the previous one again
+			m_RenderQueue.Execute();
 
 			glfwSwapBuffers(m_Window);
 			glfwPollEvents();
 		}
 
+		m_ThreadLogic.request_stop();
+		if (m_ThreadLogic.joinable())
+			m_ThreadLogic.join();
+
 		demoPanel.Delete();
+		debugOverlay.Delete();
 
 		// Cleanup
 		CleanupOpenGl();
+		m_WorldRenderer.Delete();
+		m_Particles.Delete();
 		Gui::Shutdown();
+		m_RenderQueue.Delete();
+		TextureLoader::Shutdown();
 
 		m_IsRunning.store(false);
 	}
 
+	void Renderer::LogicThreadFunction(std::stop_token st,
+									   DemoPanel& demoPanel,
+									   DebugOverlay& debugOverlay,
+									   int screenWidth,
+									   int screenHeight)
+	{
+		m_Camera.SetAspectRatio(static_cast<float>(screenWidth) / static_cast<float>(screenHeight));
+
+		auto lastFrame = std::chrono::steady_clock::now();
+
+		while (!st.stop_requested())
+		{
+			std::shared_ptr<InputsSnapshot> inputs;
+			double mouseXoffset = 0.0;
+			double mouseYoffset = 0.0;
+			{
+				std::unique_lock<std::mutex> lock(m_MutexLogicInputs);
+				if (!m_LogicInputsAvailable.wait(lock, st, [this]() { return m_LogicInputs != nullptr; }))
+					break;
+
+				inputs = std::move(m_LogicInputs);
+				m_LogicInputs = nullptr;
+
+				std::swap(mouseXoffset, m_LogicMouseXoffset);
+				std::swap(mouseYoffset, m_LogicMouseYoffset);
+			}
+
+			const auto now = std::chrono::steady_clock::now();
+			const float deltaTime = std::chrono::duration<float>(now - lastFrame).count();
+			lastFrame = now;
+
+			// Skip empty sizes, the window is minimized
+			const auto& framebuffer = inputs->Framebuffer;
+			if ((framebuffer.Width != screenWidth || framebuffer.Height != screenHeight) && framebuffer.Width > 0 &&
+				framebuffer.Height > 0)
+			{
+				screenWidth = framebuffer.Width;
+				screenHeight = framebuffer.Height;
+				GuiElement::SetScreenSize(screenWidth, screenHeight);
+				m_Camera.SetAspectRatio(static_cast<float>(screenWidth) / static_cast<float>(screenHeight));
+			}
+
+			GuiElement::SetInputsSnapshot(inputs);
+
+			ProcessCameraMovement(*inputs, mouseXoffset, mouseYoffset, deltaTime);
+			m_WorldRenderer.SetOcclusionCulling(m_OcclusionCulling.load(std::memory_order_relaxed));
+
+			// Chunks load, generate and save on the workers, the completed ones are inserted and lit here
+			const glm::vec3& position = m_Camera.GetPosition();
+			const glm::vec3& forward = m_Camera.GetForward();
+			m_Streaming.Update(position.x, position.z, forward.x, forward.z);
+
+			MeshingPipeline& meshing = m_WorldRenderer.GetMeshing();
+			for (const ChunkCoord& coord : m_Streaming.TakeUnloadedChunks())
+			{
+				// The coarse meshes stay, the loaded neighbours lose a border
+				meshing.RemoveChunk(coord);
+				meshing.MarkChunkDirty(m_World, coord);
+			}
+			for (const ChunkCoord& coord : m_Streaming.TakeLoadedChunks())
+				meshing.MarkChunkDirty(m_World, coord);
+			for (const SectionCoord& section : m_Lighting.TakeChangedSections())
+				meshing.MarkSectionDirty(section);
+
+			// Nearest dirty sections first, meshed on the workers
+			meshing.Dispatch(m_World, position);
+
+			// Debug bursts at the block looked at, the block itself stays
+			for (int burst = m_ParticleBursts.exchange(0, std::memory_order_relaxed); burst > 0; burst--)
+			{
+				VoxelRaycaster raycaster(m_World);
+				const RayHit hit =
+					raycaster.Cast({position.x, position.y, position.z, forward.x, forward.y, forward.z, 64.f});
+				if (!hit.Hit)
+					break;
+
+				m_Particles.EmitBlockBreak(hit.Block, hit.Id);
+				m_Particles.EmitSmoke({hit.Block.x + 0.5f, hit.Block.y + 1.f, hit.Block.z + 0.5f}, 16);
+			}
+			m_Particles.SetRainRate(m_Raining.load(std::memory_order_relaxed) ? 2000.f : 0.f);
+			m_Particles.Simulate(deltaTime, position);
+
+			RenderFrame& frame = m_RenderQueue.BeginFrame();
+
+			m_WorldRenderer.Record(frame.AcquireCommandBuffer(), m_Camera);
+			m_Particles.Record(frame.AcquireCommandBuffer(), m_Camera);
+
+			GuiElement::BeginFrame(frame.AcquireCommandBuffer());
+
+			demoPanel.Render();
+
+			debugOverlay.SetLines(GetDebugLines(m_Camera, m_WorldRenderer, m_Streaming, m_Particles));
+			debugOverlay.Render();
+
+			m_RenderQueue.Publish();
+		}
+
+		// Edited and generated chunks still loaded, the unloaded ones were saved on the way out
+		const auto saveStart = std::chrono::steady_clock::now();
+		const size_t savedCount = m_Streaming.SaveAll();
+		std::cout << "[WORLD] : Saved " << savedCount << " chunks in "
+				  << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - saveStart).count()
+				  << " ms" << std::endl;
+
+		const ChunkStreamer::Stats streaming = m_Streaming.GetStats();
+		if (streaming.SaveFailedCount > 0 || streaming.CorruptCount > 0)
+			std::cout << "[WORLD] : " << streaming.SaveFailedCount << " chunks failed to save, "
+					  << streaming.CorruptCount << " corrupt chunks generated again" << std::endl;
+	}
+
+	void Renderer::ProcessCameraMovement(const InputsSnapshot& inputs,
+										 double mouseXoffset,
+										 double mouseYoffset,
+										 float deltaTime)
+	{
+		// The cursor is free to click the GUI
+		if (!inputs.Mouse.CaptureEnabled)
+			return;
+
+		m_Camera.ProcessMouseMovement(static_cast<float>(mouseXoffset), static_cast<float>(mouseYoffset));
+
+		auto axis = [&inputs](int positiveId, int negativeId)
+		{
+			return (inputs.GetKeyState(positiveId).IsPressed ? 1.f : 0.f) -
+				(inputs.GetKeyState(negativeId).IsPressed ? 1.f : 0.f);
+		};
+
+		const glm::vec3 direction(axis(m_InputIdMoveRight, m_InputIdMoveLeft),
+								  axis(m_InputIdMoveUp, m_InputIdMoveDown),
+								  axis(m_InputIdMoveForward, m_InputIdMoveBackward));
+		const float speedMultiplier = inputs.GetKeyState(m_InputIdSpeedUp).IsPressed ? 4.f : 1.f;
+
+		m_Camera.Move(direction, deltaTime, speedMultiplier);
+	}
+
 	void Renderer::FramebufferSizeCallback(int width, int height)
 	{
-		glViewport(0, 0, width, height);
+		GLStateCache::Viewport(0, 0, width, height);
 
+		// The GUI layout follows on the logic thread, from the framebuffer size of the inputs snapshot
 		m_WindowWidth = width;
 		m_WindowHeight = height;
-
-		GuiElement::SetScreenSize(m_WindowWidth, m_WindowHeight);
 	}
 
 	void Renderer::RegisterInputs()
 	{
+		m_InputIdMoveForward = m_InputsManager.RegisterInput(Key::W);
+		m_InputIdMoveBackward = m_InputsManager.RegisterInput(Key::S);
+		m_InputIdMoveLeft = m_InputsManager.RegisterInput(Key::A);
+		m_InputIdMoveRight = m_InputsManager.RegisterInput(Key::D);
+		// Not Space : it captures the mouse again, the camera would fly up at the same time
+		m_InputIdMoveUp = m_InputsManager.RegisterInput(Key::E);
+		m_InputIdMoveDown = m_InputsManager.RegisterInput(Key::Q);
+		m_InputIdSpeedUp = m_InputsManager.RegisterInput(Key::LeftControl);
+
 		m_InputIdUnfocus = m_InputsManager.RegisterInput(Key::Escape);
 		m_InputIdFocus = m_InputsManager.RegisterInput(Key::Space);
+
+		// Pressed once per key press, holding it doesn't toggle again
+		m_InputIdToggleOcclusion = m_InputsManager.RegisterInput(Key::O, InputConfig(true, 1e9, 1e9));
+		m_InputIdToggleRain = m_InputsManager.RegisterInput(Key::R, InputConfig(true, 1e9, 1e9));
+		m_InputIdParticleBurst = m_InputsManager.RegisterInput(Key::B, InputConfig(true, 1e9, 1e9));
 	}
 
 	void Renderer::ProcessInputs(const std::shared_ptr<InputsSnapshot>& inputs)
@@ -188,7 +487,34 @@ namespace onion::voxel
 			m_InputsManager.SetMouseCaptureEnabled(true);
 		}
 
-		GuiElement::SetInputsSnapshot(inputs);
+		// Handled here rather than by the logic thread, it may skip the snapshot of the press
+		if (inputs->GetKeyState(m_InputIdToggleOcclusion).IsPressed)
+		{
+			m_OcclusionCulling.store(!m_OcclusionCulling.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+
+		if (inputs->GetKeyState(m_InputIdToggleRain).IsPressed)
+		{
+			m_Raining.store(!m_Raining.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+
+		if (inputs->GetKeyState(m_InputIdParticleBurst).IsPressed)
+		{
+			m_ParticleBursts.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		// Wake the logic thread up to record the next frame
+		{
+			std::lock_guard<std::mutex> lock(m_MutexLogicInputs);
+			m_LogicInputs = inputs;
+
+			if (inputs->Mouse.MovementOffsetChanged)
+			{
+				m_LogicMouseXoffset += inputs->Mouse.Xoffset;
+				m_LogicMouseYoffset += inputs->Mouse.Yoffset;
+			}
+		}
+		m_LogicInputsAvailable.notify_one();
 	}
 
 	void Renderer::CleanupOpenGl() {}
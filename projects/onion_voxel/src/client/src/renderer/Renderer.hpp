@@ -5,13 +5,30 @@
 #include <GLFW/glfw3.h>
 
 #include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <stop_token>
 #include <string>
 #include <thread>
 
+#include <jobs/JobSystem.hpp>
+#include <storage/WorldStorage.hpp>
+#include <streaming/ChunkStreamer.hpp>
+#include <world/ChunkStore.hpp>
+#include <world/LightEngine.hpp>
+#include <worldgen/WorldGenerator.hpp>
+
+#include "Variables.hpp"
+#include "camera/Camera.hpp"
+#include "gl_state/GLExtensions.hpp"
+#include "gl_state/GLStateCache.hpp"
 #include "gui/Gui.hpp"
 #include "inputs_manager/inputs_manager.hpp"
+#include "particles/ParticleSystem.hpp"
+#include "render_queue/RenderQueue.hpp"
+#include "texture/TextureLoader.hpp"
+#include "world/WorldRenderer.hpp"
 
 namespace onion::voxel
 {
@@ -35,10 +52,49 @@ namespace onion::voxel
 		void RenderThreadFunction(std::stop_token st);
 		std::jthread m_ThreadRenderer;
 
+		// GUI logic and event handlers, records the frames executed by the render thread
+		// screenWidth, screenHeight : the window size when the thread starts, then it follows the inputs snapshots
+		void LogicThreadFunction(std::stop_token st,
+								 DemoPanel& demoPanel,
+								 DebugOverlay& debugOverlay,
+								 int screenWidth,
+								 int screenHeight);
+		std::jthread m_ThreadLogic;
+		RenderQueue m_RenderQueue;
+
+		// Generation and meshing run on the job workers
+		JobSystem m_Jobs;
+
+		// Owned by the logic thread : only it modifies, streams and relights the world and dispatches the meshing jobs
+		ChunkStore m_World;
+		LightEngine m_Lighting{m_World};
+		WorldStorage m_Storage{GetSavesPath() / "world"};
+		WorldGenerator m_Generator{1234};
+		ChunkStreamer m_Streaming{m_Jobs,
+								  m_World,
+								  m_Lighting,
+								  m_Storage,
+								  m_Generator,
+								  {.LoadRadius = MeshingPipeline::RenderDistance}};
+		WorldRenderer m_WorldRenderer{m_Jobs};
+		ParticleSystem m_Particles{m_WorldRenderer.GetAppearances()};
+		Camera m_Camera{{0.f, 90.f, 0.f}};
+		std::atomic_bool m_OcclusionCulling{true}; // Toggled by the render thread inputs
+		std::atomic_bool m_Raining{false};		   // Same
+		std::atomic_int m_ParticleBursts{0};	   // Bursts asked by the render thread inputs, not emitted yet
+
+		// Latest inputs polled by the render thread, not consumed by the logic thread yet
+		std::mutex m_MutexLogicInputs;
+		std::condition_variable_any m_LogicInputsAvailable;
+		std::shared_ptr<InputsSnapshot> m_LogicInputs;
+		// Mouse movement of all the snapshots polled since, a skipped snapshot doesn't lose its movement
+		double m_LogicMouseXoffset = 0.0;
+		double m_LogicMouseYoffset = 0.0;
+
 		//GLFW
 	  private:
 		GLFWwindow* m_Window = nullptr;
-		int m_WindowWidth = 800;
+		int m_WindowWidth = 800; // Render thread only
 		int m_WindowHeight = 600;
 		std::string m_WindowTitle = "Onion Voxel";
 
@@ -48,20 +104,35 @@ namespace onion::voxel
 		double m_DeltaTime = 0.0f;
 		double m_LastFrame = 0.0f;
 
+		// Max bytes of decoded textures uploaded per frame
+		size_t m_TextureUploadBudgetBytes = 4 * 1024 * 1024;
+
+		// Max time and bytes spent uploading chunk meshes per frame
+		double m_MeshUploadBudgetMilliseconds = 2.0;
+		size_t m_MeshUploadBudgetBytes = 2 * 1024 * 1024;
+
 	  private:
 		InputsManager m_InputsManager;
 		std::shared_ptr<InputsSnapshot> m_InputsSnapshot;
 
 		void RegisterInputs();
 		void ProcessInputs(const std::shared_ptr<InputsSnapshot>& inputs);
-
-		//int m_InputIdMoveForward = -1;
-		//int m_InputIdMoveBackward = -1;
-		//int m_InputIdMoveLeft = -1;
-		//int m_InputIdMoveRight = -1;
-		//int m_InputIdMoveUp = -1;
-		//int m_InputIdMoveDown = -1;
-		//int m_InputIdSpeedUp = -1;
+		// Logic thread
+		void ProcessCameraMovement(const InputsSnapshot& inputs,
+								   double mouseXoffset,
+								   double mouseYoffset,
+								   float deltaTime);
+
+		int m_InputIdMoveForward = -1;
+		int m_InputIdMoveBackward = -1;
+		int m_InputIdMoveLeft = -1;
+		int m_InputIdMoveRight = -1;
+		int m_InputIdMoveUp = -1;
+		int m_InputIdMoveDown = -1;
+		int m_InputIdSpeedUp = -1;
+		int m_InputIdToggleOcclusion = -1;
+		int m_InputIdToggleRain = -1;
+		int m_InputIdParticleBurst = -1;
 		int m_InputIdUnfocus = -1;
 		int m_InputIdFocus = -1;
 	};
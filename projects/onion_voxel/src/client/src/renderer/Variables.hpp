@@ -16,4 +16,10 @@ namespace onion::voxel
 		}
 		return assetsPath;
 	}
+
+	/// @brief Where the worlds are saved, created on first save.
+	inline std::filesystem::path GetSavesPath()
+	{
+		return std::filesystem::current_path() / "saves";
+	}
 } // namespace onion::voxel
@@ -0,0 +1,77 @@
+#include "RangeAllocator.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace onion::voxel
+{
+	RangeAllocator::RangeAllocator(uint32_t capacity) : m_Capacity(capacity)
+	{
+		if (capacity > 0)
+			m_FreeRanges.emplace(0, capacity);
+	}
+
+	uint32_t RangeAllocator::Allocate(uint32_t size)
+	{
+		if (size == 0)
+			return InvalidOffset;
+
+		for (auto it = m_FreeRanges.begin(); it != m_FreeRanges.end(); ++it)
+		{
+			if (it->second < size)
+				continue;
+
+			const uint32_t offset = it->first;
+			const uint32_t remaining = it->second - size;
+
+			m_FreeRanges.erase(it);
+			if (remaining > 0)
+				m_FreeRanges.emplace(offset + size, remaining);
+
+			m_Used += size;
+			return offset;
+		}
+
+		return InvalidOffset;
+	}
+
+	void RangeAllocator::Free(uint32_t offset, uint32_t size)
+	{
+		if (size == 0 || offset == InvalidOffset)
+			return;
+
+		assert(offset + size <= m_Capacity && "RangeAllocator::Free() range out of the capacity");
+		m_Used -= size;
+
+		auto next = m_FreeRanges.lower_bound(offset);
+
+		// Merged with the free range right after
+		if (next != m_FreeRanges.end() && offset + size == next->first)
+		{
+			size += next->second;
+			next = m_FreeRanges.erase(next);
+		}
+
+		// And with the one right before
+		if (next != m_FreeRanges.begin())
+		{
+			auto previous = std::prev(next);
+			if (previous->first + previous->second == offset)
+			{
+				previous->second += size;
+				return;
+			}
+		}
+
+		m_FreeRanges.emplace_hint(next, offset, size);
+	}
+
+	uint32_t RangeAllocator::GetLargestFree() const
+	{
+		uint32_t largest = 0;
+		for (const auto& [offset, size] : m_FreeRanges)
+			largest = std::max(largest, size);
+		return largest;
+	}
+} // namespace onion::voxel
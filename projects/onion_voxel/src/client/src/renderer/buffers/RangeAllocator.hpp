@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace onion::voxel
+{
+	/// @brief First fit allocator of ranges inside a fixed capacity, in any unit. Freed ranges are merged with their
+	/// free neighbours. Only does the bookkeeping, the memory itself lives elsewhere (a GPU buffer...).
+	class RangeAllocator
+	{
+	  public:
+		static constexpr uint32_t InvalidOffset = UINT32_MAX;
+
+		explicit RangeAllocator(uint32_t capacity = 0);
+
+		/// @return The offset of the range, InvalidOffset when no free range is large enough.
+		uint32_t Allocate(uint32_t size);
+		/// @brief The range must come from Allocate() with the same size.
+		void Free(uint32_t offset, uint32_t size);
+
+		uint32_t GetCapacity() const { return m_Capacity; }
+		uint32_t GetUsed() const { return m_Used; }
+		uint32_t GetLargestFree() const;
+		size_t GetFreeRangeCount() const { return m_FreeRanges.size(); }
+
+	  private:
+		uint32_t m_Capacity;
+		uint32_t m_Used = 0;
+		std::map<uint32_t, uint32_t> m_FreeRanges; // Offset to size, never adjacent
+	};
+} // namespace onion::voxel
@@ -0,0 +1,217 @@
+#include "StreamRingBuffer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <iostream>
+
+#include "../gl_state/GLExtensions.hpp"
+
+namespace onion::voxel
+{
+	// -------- Constructor / Destructor --------
+
+	StreamRingBuffer::StreamRingBuffer(size_t frameSize, int frameCount)
+		: m_FrameSize(frameSize), m_FrameCount(frameCount), m_Fences(frameCount, nullptr)
+	{
+	}
+
+	StreamRingBuffer::~StreamRingBuffer()
+	{
+		if (m_Buffer != 0)
+		{
+			std::cout << "[STREAM BUFFER] [ERROR] : Stream ring buffer not deleted before destruction. There is a "
+						 "memory leak."
+					  << std::endl;
+		}
+	}
+
+	// -------- Lifecycle --------
+
+	void StreamRingBuffer::Initialize()
+	{
+		CreateStorage();
+	}
+
+	void StreamRingBuffer::Delete()
+	{
+		DestroyStorage();
+	}
+
+	// -------- Frame --------
+
+	void StreamRingBuffer::BeginFrame()
+	{
+		if (m_RequiredFrameSize > m_FrameSize)
+		{
+			// Regions are only reused once their fence is signaled : wait for every one before replacing the buffer
+			for (int region = 0; region < m_FrameCount; region++)
+				WaitForRegion(region);
+
+			size_t newFrameSize = std::bit_ceil(m_RequiredFrameSize);
+			std::cout << "[STREAM BUFFER] [WARNING] : Frame region grown from " << m_FrameSize << " to "
+					  << newFrameSize << " bytes" << std::endl;
+
+			DestroyStorage();
+			m_FrameSize = newFrameSize;
+			CreateStorage();
+		}
+
+		m_RequiredFrameSize = 0;
+		m_Head = 0;
+
+		WaitForRegion(m_CurrentRegion);
+	}
+
+	void StreamRingBuffer::EndFrame()
+	{
+		m_Fences[m_CurrentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_CurrentRegion = (m_CurrentRegion + 1) % m_FrameCount;
+	}
+
+	// -------- Allocation --------
+
+	StreamRingBuffer::Allocation StreamRingBuffer::Allocate(size_t size, size_t alignment)
+	{
+		size_t start = (m_Head + alignment - 1) / alignment * alignment;
+
+		if (m_Buffer == 0 || start + size > m_FrameSize)
+		{
+			m_RequiredFrameSize = std::max(m_RequiredFrameSize, std::max(m_FrameSize, start) + size);
+			return {};
+		}
+
+		m_Head = start + size;
+
+		Allocation allocation;
+		allocation.Offset = static_cast<GLintptr>(m_CurrentRegion * m_FrameSize + start);
+		allocation.Size = size;
+
+		if (m_IsPersistent)
+		{
+			allocation.Data = m_PersistentData + allocation.Offset;
+		}
+		else
+		{
+			// The fence already guarantees the GPU is done with this range, no need for the driver to synchronize
+			glBindBuffer(GL_ARRAY_BUFFER, m_Buffer);
+			allocation.Data = static_cast<unsigned char*>(glMapBufferRange(
+				GL_ARRAY_BUFFER,
+				allocation.Offset,
+				static_cast<GLsizeiptr>(size),
+				GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT));
+		}
+
+		return allocation;
+	}
+
+	void StreamRingBuffer::Commit(const Allocation& allocation)
+	{
+		// Coherent mapping : writes are visible to the GPU without any call
+		if (m_IsPersistent || !allocation.IsValid())
+			return;
+
+		glBindBuffer(GL_ARRAY_BUFFER, m_Buffer);
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+	}
+
+	GLuint StreamRingBuffer::GetBufferID() const
+	{
+		return m_Buffer;
+	}
+
+	bool StreamRingBuffer::IsPersistent() const
+	{
+		return m_IsPersistent;
+	}
+
+	uint64_t StreamRingBuffer::GetStallCount() const
+	{
+		return m_StallCount;
+	}
+
+	// -------- Private --------
+
+	void StreamRingBuffer::CreateStorage()
+	{
+		GLsizeiptr totalSize = static_cast<GLsizeiptr>(m_FrameSize * m_FrameCount);
+
+		glGenBuffers(1, &m_Buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, m_Buffer);
+
+		m_IsPersistent = GLExtensions::HasBufferStorage();
+
+		if (m_IsPersistent)
+		{
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			GLExtensions::BufferStorage(GL_ARRAY_BUFFER, totalSize, nullptr, flags);
+			m_PersistentData = static_cast<unsigned char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, totalSize, flags));
+
+			if (!m_PersistentData)
+			{
+				std::cout << "[STREAM BUFFER] [ERROR] : Persistent mapping failed, falling back to unsynchronized maps"
+						  << std::endl;
+
+				glDeleteBuffers(1, &m_Buffer);
+				glGenBuffers(1, &m_Buffer);
+				glBindBuffer(GL_ARRAY_BUFFER, m_Buffer);
+				m_IsPersistent = false;
+			}
+		}
+
+		if (!m_IsPersistent)
+			glBufferData(GL_ARRAY_BUFFER, totalSize, nullptr, GL_STREAM_DRAW);
+
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		m_CurrentRegion = 0;
+		m_Head = 0;
+	}
+
+	void StreamRingBuffer::DestroyStorage()
+	{
+		for (GLsync& fence : m_Fences)
+		{
+			if (fence)
+				glDeleteSync(fence);
+			fence = nullptr;
+		}
+
+		if (m_Buffer == 0)
+			return;
+
+		if (m_PersistentData)
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, m_Buffer);
+			glUnmapBuffer(GL_ARRAY_BUFFER);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+
+		glDeleteBuffers(1, &m_Buffer);
+		m_Buffer = 0;
+		m_PersistentData = nullptr;
+	}
+
+	void StreamRingBuffer::WaitForRegion(int region)
+	{
+		GLsync& fence = m_Fences[region];
+		if (!fence)
+			return;
+
+		GLenum result = glClientWaitSync(fence, 0, 0);
+		if (result == GL_TIMEOUT_EXPIRED)
+		{
+			m_StallCount++;
+
+			// Flush once so the fence can't wait on commands still sitting in the driver queue
+			GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+			do
+			{
+				result = glClientWaitSync(fence, flags, 1'000'000); // 1 ms
+				flags = 0;
+			} while (result == GL_TIMEOUT_EXPIRED);
+		}
+
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+} // namespace onion::voxel
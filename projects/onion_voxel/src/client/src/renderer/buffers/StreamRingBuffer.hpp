@@ -0,0 +1,75 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace onion::voxel
+{
+	/// @brief Ring of per-frame regions in one vertex buffer, for geometry rewritten every frame (text, particles...).
+	///
+	/// With buffer storage (GL 4.4 / ARB_buffer_storage) the buffer is mapped once, persistent and coherent, and
+	/// allocations are written straight into GPU visible memory. Otherwise each allocation is mapped unsynchronized.
+	/// In both cases a fence per region guarantees the GPU is done reading it before it is written again, the
+	/// buffer is never orphaned or re-specified. Must only be used on the GL thread.
+	class StreamRingBuffer
+	{
+	  public:
+		struct Allocation
+		{
+			unsigned char* Data = nullptr;
+			GLintptr Offset = 0; // From the start of the buffer, to use as attribute base offset
+			size_t Size = 0;
+
+			bool IsValid() const { return Data != nullptr; }
+		};
+
+		StreamRingBuffer(size_t frameSize = 1024 * 1024, int frameCount = 3);
+		~StreamRingBuffer();
+
+		StreamRingBuffer(const StreamRingBuffer&) = delete;
+		StreamRingBuffer& operator=(const StreamRingBuffer&) = delete;
+
+		void Initialize();
+		void Delete();
+
+		/// @brief Moves to the next region, waiting for its fence if the GPU is more than frameCount frames late.
+		void BeginFrame();
+		/// @brief Fences the region written during this frame.
+		void EndFrame();
+
+		/// @brief Space in the region of the current frame. Invalid when the region is full : the ring grows on the
+		/// next BeginFrame(), the caller skips its draw for this frame.
+		Allocation Allocate(size_t size, size_t alignment = 16);
+		/// @brief Must be called once the allocation is written, before drawing from it.
+		void Commit(const Allocation& allocation);
+
+		GLuint GetBufferID() const;
+		bool IsPersistent() const;
+
+		/// @brief Number of BeginFrame() that had to wait for the GPU since the start.
+		uint64_t GetStallCount() const;
+
+	  private:
+		void CreateStorage();
+		void DestroyStorage();
+		void WaitForRegion(int region);
+
+	  private:
+		size_t m_FrameSize;
+		int m_FrameCount;
+
+		GLuint m_Buffer = 0;
+		unsigned char* m_PersistentData = nullptr;
+		bool m_IsPersistent = false;
+
+		std::vector<GLsync> m_Fences;
+		int m_CurrentRegion = 0;
+		size_t m_Head = 0;
+		size_t m_RequiredFrameSize = 0; // Set when an allocation didn't fit, the ring grows to it
+
+		uint64_t m_StallCount = 0;
+	};
+} // namespace onion::voxel
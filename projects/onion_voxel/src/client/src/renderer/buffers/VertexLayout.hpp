@@ -0,0 +1,46 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace onion::voxel
+{
+	struct VertexAttribute
+	{
+		GLuint Location;
+		GLint Components;
+		GLenum Type;
+		bool Normalized = false;
+		bool Integer = false; // glVertexAttribIPointer, read as int / uint in the shader
+		uint32_t Offset = 0;  // In bytes, inside one vertex
+	};
+
+	/// @brief Attribute pointers of vertices living in a shared stream buffer, re-applied at each new base offset.
+	/// Enabling the arrays and setting the divisors is done once on the VAO, this only moves the pointers.
+	struct VertexLayout
+	{
+		uint32_t Stride = 0;
+		std::vector<VertexAttribute> Attributes;
+
+		/// @brief Points the attributes of the bound VAO at the buffer bound to GL_ARRAY_BUFFER, from baseOffset.
+		void Apply(GLintptr baseOffset) const
+		{
+			for (const VertexAttribute& attribute : Attributes)
+			{
+				const void* pointer = reinterpret_cast<const void*>(baseOffset + attribute.Offset);
+
+				if (attribute.Integer)
+					glVertexAttribIPointer(attribute.Location, attribute.Components, attribute.Type, Stride, pointer);
+				else
+					glVertexAttribPointer(attribute.Location,
+										  attribute.Components,
+										  attribute.Type,
+										  attribute.Normalized ? GL_TRUE : GL_FALSE,
+										  Stride,
+										  pointer);
+			}
+		}
+	};
+} // namespace onion::voxel
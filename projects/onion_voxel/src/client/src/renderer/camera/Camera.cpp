@@ -0,0 +1,70 @@
+#include "Camera.hpp"
+
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace onion::voxel
+{
+	namespace
+	{
+		const glm::vec3 WorldUp{0.f, 1.f, 0.f};
+		constexpr float MaxPitch = 89.f;
+	} // namespace
+
+	Camera::Camera(const glm::vec3& position, float yaw, float pitch) : m_Position(position), m_Yaw(yaw), m_Pitch(pitch)
+	{
+		UpdateVectors();
+	}
+
+	void Camera::ProcessMouseMovement(float xoffset, float yoffset)
+	{
+		m_Yaw += xoffset * m_Sensitivity;
+		m_Pitch = glm::clamp(m_Pitch + yoffset * m_Sensitivity, -MaxPitch, MaxPitch);
+
+		// Keeps the float precise after many turns
+		m_Yaw = std::fmod(m_Yaw, 360.f);
+
+		UpdateVectors();
+	}
+
+	void Camera::Move(const glm::vec3& direction, float deltaTime, float speedMultiplier)
+	{
+		// Looking up or down doesn't slow the horizontal movement
+		glm::vec3 horizontalForward(m_Forward.x, 0.f, m_Forward.z);
+		if (glm::dot(horizontalForward, horizontalForward) > 0.f)
+			horizontalForward = glm::normalize(horizontalForward);
+
+		glm::vec3 movement = m_Right * direction.x + WorldUp * direction.y + horizontalForward * direction.z;
+		if (glm::dot(movement, movement) > 1.f)
+			movement = glm::normalize(movement);
+
+		m_Position += movement * (m_Speed * speedMultiplier * deltaTime);
+	}
+
+	glm::mat4 Camera::GetViewMatrix() const
+	{
+		return glm::lookAt(m_Position, m_Position + m_Forward, m_Up);
+	}
+
+	glm::mat4 Camera::GetProjectionMatrix() const
+	{
+		return glm::perspective(glm::radians(m_FieldOfView), m_AspectRatio, m_NearPlane, m_FarPlane);
+	}
+
+	glm::mat4 Camera::GetViewProjectionMatrix() const
+	{
+		return GetProjectionMatrix() * GetViewMatrix();
+	}
+
+	void Camera::UpdateVectors()
+	{
+		const float yaw = glm::radians(m_Yaw);
+		const float pitch = glm::radians(m_Pitch);
+
+		m_Forward = glm::normalize(
+			glm::vec3(std::cos(yaw) * std::cos(pitch), std::sin(pitch), std::sin(yaw) * std::cos(pitch)));
+		m_Right = glm::normalize(glm::cross(m_Forward, WorldUp));
+		m_Up = glm::normalize(glm::cross(m_Right, m_Forward));
+	}
+} // namespace onion::voxel
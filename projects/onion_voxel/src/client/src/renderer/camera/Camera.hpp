@@ -0,0 +1,59 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace onion::voxel
+{
+	/// @brief First person flying camera. Yaw and pitch in degrees, yaw -90 looks towards -Z.
+	class Camera
+	{
+	  public:
+		explicit Camera(const glm::vec3& position = {0.f, 0.f, 0.f}, float yaw = -90.f, float pitch = 0.f);
+
+		/// @brief Mouse offsets in pixels, Y up. Pitch is kept short of the poles.
+		void ProcessMouseMovement(float xoffset, float yoffset);
+
+		/// @brief Moves along the horizontal forward and right axes and the world up axis.
+		/// @param direction X right, Y up, Z forward, each in [-1, 1].
+		void Move(const glm::vec3& direction, float deltaTime, float speedMultiplier = 1.f);
+
+		void SetPosition(const glm::vec3& position) { m_Position = position; }
+		void SetAspectRatio(float aspectRatio) { m_AspectRatio = aspectRatio; }
+		void SetFieldOfView(float degrees) { m_FieldOfView = degrees; }
+		void SetSpeed(float blocksPerSecond) { m_Speed = blocksPerSecond; }
+		void SetSensitivity(float degreesPerPixel) { m_Sensitivity = degreesPerPixel; }
+
+		const glm::vec3& GetPosition() const { return m_Position; }
+		const glm::vec3& GetForward() const { return m_Forward; }
+		const glm::vec3& GetRight() const { return m_Right; }
+		const glm::vec3& GetUp() const { return m_Up; }
+		float GetYaw() const { return m_Yaw; }
+		float GetPitch() const { return m_Pitch; }
+		float GetNearPlane() const { return m_NearPlane; }
+		float GetFarPlane() const { return m_FarPlane; }
+
+		glm::mat4 GetViewMatrix() const;
+		glm::mat4 GetProjectionMatrix() const;
+		glm::mat4 GetViewProjectionMatrix() const;
+
+	  private:
+		void UpdateVectors();
+
+	  private:
+		glm::vec3 m_Position;
+		glm::vec3 m_Forward{0.f, 0.f, -1.f};
+		glm::vec3 m_Right{1.f, 0.f, 0.f};
+		glm::vec3 m_Up{0.f, 1.f, 0.f};
+
+		float m_Yaw;
+		float m_Pitch;
+
+		float m_FieldOfView = 70.f;
+		float m_AspectRatio = 4.f / 3.f;
+		float m_NearPlane = 0.1f;
+		float m_FarPlane = 1000.f;
+
+		float m_Speed = 20.f;
+		float m_Sensitivity = 0.1f;
+	};
+} // namespace onion::voxel
@@ -0,0 +1,47 @@
+#include "Frustum.hpp"
+
+namespace onion::voxel
+{
+	Frustum Frustum::FromViewProjection(const glm::mat4& viewProjection)
+	{
+		// glm is column major : row i is (m[0][i], m[1][i], m[2][i], m[3][i])
+		auto row = [&viewProjection](int i)
+		{ return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]); };
+
+		const glm::vec4 x = row(0);
+		const glm::vec4 y = row(1);
+		const glm::vec4 z = row(2);
+		const glm::vec4 w = row(3);
+
+		// -w <= x, y, z <= w
+		const glm::vec4 planes[PlaneCount] = {w + x, w - x, w + y, w - y, w + z, w - z};
+
+		Frustum frustum;
+		for (int i = 0; i < PlaneCount; i++)
+		{
+			const glm::vec3 normal(planes[i].x, planes[i].y, planes[i].z);
+			const float length = glm::length(normal);
+
+			frustum.Planes[i].Normal = normal / length;
+			frustum.Planes[i].Distance = planes[i].w / length;
+		}
+
+		return frustum;
+	}
+
+	bool Frustum::IntersectsBox(const glm::vec3& min, const glm::vec3& max) const
+	{
+		for (const FrustumPlane& plane : Planes)
+		{
+			// Corner of the box the furthest along the normal
+			const glm::vec3 corner(plane.Normal.x >= 0.f ? max.x : min.x,
+								   plane.Normal.y >= 0.f ? max.y : min.y,
+								   plane.Normal.z >= 0.f ? max.z : min.z);
+
+			if (glm::dot(plane.Normal, corner) + plane.Distance < 0.f)
+				return false;
+		}
+
+		return true;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <array>
+
+#include <glm/glm.hpp>
+
+namespace onion::voxel
+{
+	/// @brief Plane of points p where dot(Normal, p) + Distance = 0, the normal points inside the frustum.
+	struct FrustumPlane
+	{
+		glm::vec3 Normal{0.f, 1.f, 0.f};
+		float Distance = 0.f;
+	};
+
+	/// @brief The 6 planes of a view projection, in world space.
+	struct Frustum
+	{
+		enum PlaneIndex
+		{
+			Left,
+			Right,
+			Bottom,
+			Top,
+			Near,
+			Far,
+
+			PlaneCount
+		};
+
+		std::array<FrustumPlane, PlaneCount> Planes;
+
+		/// @brief Extracts the planes from the rows of the matrix (Gribb & Hartmann), for OpenGL clip space.
+		static Frustum FromViewProjection(const glm::mat4& viewProjection);
+
+		/// @brief False only when the box is entirely behind one of the planes. Boxes crossing a corner of the
+		/// frustum from outside may still pass, which is fine for culling.
+		bool IntersectsBox(const glm::vec3& min, const glm::vec3& max) const;
+	};
+} // namespace onion::voxel
@@ -0,0 +1,142 @@
+#include "FrustumCuller.hpp"
+
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ONION_FRUSTUM_CULLER_SSE
+#endif
+
+#include <platform/CpuFeatures.hpp>
+
+namespace onion::voxel
+{
+	namespace
+	{
+		bool UseAvx()
+		{
+			static const bool supported = detail::HasAvxCullPath() && CpuSupportsAvx();
+			return supported;
+		}
+
+#if defined(ONION_FRUSTUM_CULLER_SSE)
+		/// @return The number of boxes tested, a multiple of 4.
+		size_t CullBoxesSse(const detail::CullPlane* planes, size_t count, std::vector<uint32_t>& visibleIndices)
+		{
+			constexpr size_t Width = 4;
+			size_t first = 0;
+			for (; first + Width <= count; first += Width)
+			{
+				__m128 outside = _mm_setzero_ps();
+				for (int i = 0; i < Frustum::PlaneCount; i++)
+				{
+					const detail::CullPlane& plane = planes[i];
+					__m128 distance =
+						_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.NormalX), _mm_loadu_ps(plane.X + first)),
+											  _mm_mul_ps(_mm_set1_ps(plane.NormalY), _mm_loadu_ps(plane.Y + first))),
+								   _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.NormalZ), _mm_loadu_ps(plane.Z + first)),
+											  _mm_set1_ps(plane.Distance)));
+					outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, _mm_setzero_ps()));
+				}
+
+				unsigned int visible = ~static_cast<unsigned int>(_mm_movemask_ps(outside)) & 0xFu;
+				for (; visible != 0; visible &= visible - 1)
+					visibleIndices.push_back(static_cast<uint32_t>(first + std::countr_zero(visible)));
+			}
+			return first;
+		}
+#endif
+	} // namespace
+
+	void FrustumCuller::Clear()
+	{
+		m_MinX.clear();
+		m_MinY.clear();
+		m_MinZ.clear();
+		m_MaxX.clear();
+		m_MaxY.clear();
+		m_MaxZ.clear();
+	}
+
+	void FrustumCuller::Reserve(size_t count)
+	{
+		m_MinX.reserve(count);
+		m_MinY.reserve(count);
+		m_MinZ.reserve(count);
+		m_MaxX.reserve(count);
+		m_MaxY.reserve(count);
+		m_MaxZ.reserve(count);
+	}
+
+	uint32_t FrustumCuller::Add(const glm::vec3& min, const glm::vec3& max)
+	{
+		m_MinX.push_back(min.x);
+		m_MinY.push_back(min.y);
+		m_MinZ.push_back(min.z);
+		m_MaxX.push_back(max.x);
+		m_MaxY.push_back(max.y);
+		m_MaxZ.push_back(max.z);
+		return static_cast<uint32_t>(m_MinX.size() - 1);
+	}
+
+	const char* FrustumCuller::GetInstructionSet()
+	{
+		if (UseAvx())
+			return "AVX";
+
+#if defined(ONION_FRUSTUM_CULLER_SSE)
+		return "SSE";
+#else
+		return "scalar";
+#endif
+	}
+
+	void FrustumCuller::Cull(const Frustum& frustum, std::vector<uint32_t>& visibleIndices) const
+	{
+		visibleIndices.clear();
+		const size_t count = GetCount();
+
+		detail::CullPlane planes[Frustum::PlaneCount];
+		for (int i = 0; i < Frustum::PlaneCount; i++)
+		{
+			const FrustumPlane& plane = frustum.Planes[i];
+			planes[i] = {plane.Normal.x >= 0.f ? m_MaxX.data() : m_MinX.data(),
+						 plane.Normal.y >= 0.f ? m_MaxY.data() : m_MinY.data(),
+						 plane.Normal.z >= 0.f ? m_MaxZ.data() : m_MinZ.data(),
+						 plane.Normal.x,
+						 plane.Normal.y,
+						 plane.Normal.z,
+						 plane.Distance};
+		}
+
+		size_t first = 0;
+		if (UseAvx())
+		{
+			// Room for every box of the AVX path, trimmed to the visible ones
+			first = count - count % 8;
+			visibleIndices.resize(first);
+			visibleIndices.resize(detail::CullBoxesAvx(planes, first, visibleIndices.data()));
+		}
+#if defined(ONION_FRUSTUM_CULLER_SSE)
+		else
+		{
+			first = CullBoxesSse(planes, count, visibleIndices);
+		}
+#endif
+
+		// Remaining boxes, or all of them without SIMD
+		CullScalar(frustum, first, visibleIndices);
+	}
+
+	void FrustumCuller::CullScalar(const Frustum& frustum, size_t first, std::vector<uint32_t>& visibleIndices) const
+	{
+		for (size_t i = first; i < GetCount(); i++)
+		{
+			const glm::vec3 min(m_MinX[i], m_MinY[i], m_MinZ[i]);
+			const glm::vec3 max(m_MaxX[i], m_MaxY[i], m_MaxZ[i]);
+
+			if (frustum.IntersectsBox(min, max))
+				visibleIndices.push_back(static_cast<uint32_t>(i));
+		}
+	}
+} // namespace onion::voxel
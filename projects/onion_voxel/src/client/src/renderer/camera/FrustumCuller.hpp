@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Frustum.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Tests many boxes against a frustum at once. The bounds are stored as flat arrays, one per coordinate,
+	/// so 8 boxes (AVX, when the CPU has it) or 4 boxes (SSE) are tested against a plane by a handful of
+	/// instructions. Builds without x86 SIMD fall back to one box at a time.
+	class FrustumCuller
+	{
+	  public:
+		void Clear();
+		void Reserve(size_t count);
+
+		/// @return Index of the box, as reported by Cull().
+		uint32_t Add(const glm::vec3& min, const glm::vec3& max);
+		size_t GetCount() const { return m_MinX.size(); }
+
+		/// @brief Replaces the content of visibleIndices with the indices of the boxes inside or crossing the frustum,
+		/// in increasing order.
+		void Cull(const Frustum& frustum, std::vector<uint32_t>& visibleIndices) const;
+
+		/// @brief Name of the instruction set used by Cull(), for the stats.
+		static const char* GetInstructionSet();
+
+	  private:
+		void CullScalar(const Frustum& frustum, size_t first, std::vector<uint32_t>& visibleIndices) const;
+
+	  private:
+		std::vector<float> m_MinX;
+		std::vector<float> m_MinY;
+		std::vector<float> m_MinZ;
+		std::vector<float> m_MaxX;
+		std::vector<float> m_MaxY;
+		std::vector<float> m_MaxZ;
+	};
+
+	namespace detail
+	{
+		/// @brief Per plane, the bound arrays holding the corner furthest along the normal (the "positive vertex").
+		struct CullPlane
+		{
+			const float* X;
+			const float* Y;
+			const float* Z;
+			float NormalX;
+			float NormalY;
+			float NormalZ;
+			float Distance;
+		};
+
+		/// @brief False when the compiler or the target can't build the AVX path.
+		bool HasAvxCullPath();
+		/// @brief AVX path, in its own translation unit built with AVX enabled. Tests the boxes [0, count), count
+		/// being a multiple of 8, against Frustum::PlaneCount planes.
+		/// @param visibleIndices Holds count values.
+		/// @return The number of visible indices written, in increasing order.
+		size_t CullBoxesAvx(const CullPlane* planes, size_t count, uint32_t* visibleIndices);
+	} // namespace detail
+} // namespace onion::voxel
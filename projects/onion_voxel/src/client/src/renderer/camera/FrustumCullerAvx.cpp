@@ -0,0 +1,65 @@
+// Built with AVX enabled (see CMakeLists.txt), only called after a runtime check of the CPU.
+// No standard library here : an inline function instantiated in this file could be picked by the linker for the
+// whole program, and crash on CPUs without AVX.
+
+#include "FrustumCuller.hpp"
+
+#if defined(__AVX__)
+
+#include <immintrin.h>
+
+namespace onion::voxel
+{
+	bool detail::HasAvxCullPath()
+	{
+		return true;
+	}
+
+	size_t detail::CullBoxesAvx(const CullPlane* planes, size_t count, uint32_t* visibleIndices)
+	{
+		constexpr size_t Width = 8;
+		size_t visibleCount = 0;
+
+		for (size_t first = 0; first < count; first += Width)
+		{
+			__m256 outside = _mm256_setzero_ps();
+			for (int i = 0; i < Frustum::PlaneCount; i++)
+			{
+				const CullPlane& plane = planes[i];
+				__m256 distance = _mm256_add_ps(
+					_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.NormalX), _mm256_loadu_ps(plane.X + first)),
+								  _mm256_mul_ps(_mm256_set1_ps(plane.NormalY), _mm256_loadu_ps(plane.Y + first))),
+					_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.NormalZ), _mm256_loadu_ps(plane.Z + first)),
+								  _mm256_set1_ps(plane.Distance)));
+				outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_LT_OQ));
+			}
+
+			// Every lane is written, only the visible ones advance the output
+			const unsigned int visible = ~static_cast<unsigned int>(_mm256_movemask_ps(outside)) & 0xFFu;
+			for (unsigned int lane = 0; lane < Width; lane++)
+			{
+				visibleIndices[visibleCount] = static_cast<uint32_t>(first + lane);
+				visibleCount += (visible >> lane) & 1u;
+			}
+		}
+
+		return visibleCount;
+	}
+} // namespace onion::voxel
+
+#else
+
+namespace onion::voxel
+{
+	bool detail::HasAvxCullPath()
+	{
+		return false;
+	}
+
+	size_t detail::CullBoxesAvx(const CullPlane*, size_t, uint32_t*)
+	{
+		return 0;
+	}
+} // namespace onion::voxel
+
+#endif
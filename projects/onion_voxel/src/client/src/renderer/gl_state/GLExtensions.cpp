@@ -0,0 +1,70 @@
+#include "GLExtensions.hpp"
+
+#include <cstring>
+#include <iostream>
+
+namespace onion::voxel
+{
+	// -------- Static Member Definitions --------
+
+	GLExtensions::PFNGLBUFFERSTORAGEPROC GLExtensions::s_BufferStorage = nullptr;
+	GLExtensions::PFNGLMULTIDRAWELEMENTSINDIRECTPROC GLExtensions::s_MultiDrawElementsIndirect = nullptr;
+
+	// -------- Public API --------
+
+	void GLExtensions::Load(GLADloadproc loader)
+	{
+		bool isCore44 = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 4);
+
+		bool isCore43 = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 3);
+
+		if (isCore44 || HasExtension("GL_ARB_buffer_storage"))
+			s_BufferStorage = reinterpret_cast<PFNGLBUFFERSTORAGEPROC>(loader("glBufferStorage"));
+
+		if (isCore43 || (HasExtension("GL_ARB_multi_draw_indirect") && HasExtension("GL_ARB_base_instance")))
+			s_MultiDrawElementsIndirect =
+				reinterpret_cast<PFNGLMULTIDRAWELEMENTSINDIRECTPROC>(loader("glMultiDrawElementsIndirect"));
+
+		std::cout << "[OPENGL] : Version " << GLVersion.major << "." << GLVersion.minor
+				  << ", buffer storage : " << (HasBufferStorage() ? "yes" : "no")
+				  << ", multi draw indirect : " << (HasMultiDrawIndirect() ? "yes" : "no") << std::endl;
+	}
+
+	bool GLExtensions::HasBufferStorage()
+	{
+		return s_BufferStorage != nullptr;
+	}
+
+	void GLExtensions::BufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags)
+	{
+		s_BufferStorage(target, size, data, flags);
+	}
+
+	bool GLExtensions::HasMultiDrawIndirect()
+	{
+		return s_MultiDrawElementsIndirect != nullptr;
+	}
+
+	void GLExtensions::MultiDrawElementsIndirect(GLenum mode, GLenum type, GLintptr offset, GLsizei drawCount)
+	{
+		// Offset into the buffer bound to GL_DRAW_INDIRECT_BUFFER, commands tightly packed
+		s_MultiDrawElementsIndirect(mode, type, reinterpret_cast<const void*>(offset), drawCount, 0);
+	}
+
+	// -------- Private --------
+
+	bool GLExtensions::HasExtension(const char* name)
+	{
+		GLint count = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+		for (GLint i = 0; i < count; i++)
+		{
+			const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+			if (extension && std::strcmp(extension, name) == 0)
+				return true;
+		}
+
+		return false;
+	}
+} // namespace onion::voxel
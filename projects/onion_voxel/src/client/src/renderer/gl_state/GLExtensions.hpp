@@ -0,0 +1,57 @@
+#pragma once
+
+#include <glad/glad.h>
+
+// The glad loader of the project only covers OpenGL 3.3 core, entry points past it are loaded here
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+#ifndef GL_DYNAMIC_STORAGE_BIT
+#define GL_DYNAMIC_STORAGE_BIT 0x0100
+#endif
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+
+namespace onion::voxel
+{
+	/// @brief One draw of glMultiDrawElementsIndirect, layout fixed by the specification.
+	struct DrawElementsIndirectCommand
+	{
+		GLuint Count;
+		GLuint InstanceCount;
+		GLuint FirstIndex;
+		GLint BaseVertex;
+		GLuint BaseInstance;
+	};
+
+	/// @brief Optional OpenGL features above the 3.3 core baseline, detected once the context is created.
+	class GLExtensions
+	{
+	  public:
+		/// @brief Must be called on the GL thread, after gladLoadGLLoader() with the same loader.
+		static void Load(GLADloadproc loader);
+
+		/// @brief OpenGL 4.4 or ARB_buffer_storage : immutable storage, persistent and coherent mapping.
+		static bool HasBufferStorage();
+		static void BufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+
+		/// @brief OpenGL 4.3, or ARB_multi_draw_indirect with ARB_base_instance : many draws from one buffer of
+		/// DrawElementsIndirectCommand, BaseInstance offsetting the instanced attributes of each draw.
+		static bool HasMultiDrawIndirect();
+		static void MultiDrawElementsIndirect(GLenum mode, GLenum type, GLintptr offset, GLsizei drawCount);
+
+	  private:
+		static bool HasExtension(const char* name);
+
+	  private:
+		using PFNGLBUFFERSTORAGEPROC = void(APIENTRYP)(GLenum, GLsizeiptr, const void*, GLbitfield);
+		static PFNGLBUFFERSTORAGEPROC s_BufferStorage;
+
+		using PFNGLMULTIDRAWELEMENTSINDIRECTPROC = void(APIENTRYP)(GLenum, GLenum, const void*, GLsizei, GLsizei);
+		static PFNGLMULTIDRAWELEMENTSINDIRECTPROC s_MultiDrawElementsIndirect;
+	};
+} // namespace onion::voxel
@@ -0,0 +1,313 @@
+#include "GLStateCache.hpp"
+
+namespace onion::voxel
+{
+	// -------- Static Member Definitions --------
+
+	GLuint GLStateCache::s_Program = GLStateCache::s_Unknown;
+	GLuint GLStateCache::s_VertexArray = GLStateCache::s_Unknown;
+	GLuint GLStateCache::s_ActiveTextureUnit = GLStateCache::s_Unknown;
+	std::array<std::array<GLuint, GLStateCache::TextureTargetCount>, GLStateCache::MaxTextureUnits>
+		GLStateCache::s_Textures;
+
+	std::array<int8_t, GLStateCache::CapabilityCount> GLStateCache::s_Capabilities;
+
+	GLenum GLStateCache::s_BlendSource = GLStateCache::s_Unknown;
+	GLenum GLStateCache::s_BlendDestination = GLStateCache::s_Unknown;
+	GLenum GLStateCache::s_DepthFunc = GLStateCache::s_Unknown;
+	GLenum GLStateCache::s_CullFace = GLStateCache::s_Unknown;
+	std::array<GLint, 4> GLStateCache::s_Viewport;
+
+	GLStateCache::FrameStats GLStateCache::s_CurrentFrame;
+	std::atomic<uint32_t> GLStateCache::s_LastFrameIssued{0};
+	std::atomic<uint32_t> GLStateCache::s_LastFrameElided{0};
+
+	// -------- Frame --------
+
+	void GLStateCache::Invalidate()
+	{
+		s_Program = s_Unknown;
+		s_VertexArray = s_Unknown;
+		s_ActiveTextureUnit = s_Unknown;
+
+		for (auto& unit : s_Textures)
+			unit.fill(s_Unknown);
+
+		s_Capabilities.fill(-1);
+
+		s_BlendSource = s_Unknown;
+		s_BlendDestination = s_Unknown;
+		s_DepthFunc = s_Unknown;
+		s_CullFace = s_Unknown;
+		s_Viewport.fill(-1);
+	}
+
+	void GLStateCache::BeginFrame()
+	{
+		s_LastFrameIssued.store(s_CurrentFrame.Issued, std::memory_order_relaxed);
+		s_LastFrameElided.store(s_CurrentFrame.Elided, std::memory_order_relaxed);
+		s_CurrentFrame = FrameStats{};
+	}
+
+	GLStateCache::FrameStats GLStateCache::GetLastFrameStats()
+	{
+		return {s_LastFrameIssued.load(std::memory_order_relaxed), s_LastFrameElided.load(std::memory_order_relaxed)};
+	}
+
+	// -------- Bindings --------
+
+	void GLStateCache::UseProgram(GLuint program)
+	{
+		if (s_Program == program)
+		{
+			CountElided();
+			return;
+		}
+
+		glUseProgram(program);
+		s_Program = program;
+		CountIssued();
+	}
+
+	void GLStateCache::BindVertexArray(GLuint vertexArray)
+	{
+		if (s_VertexArray == vertexArray)
+		{
+			CountElided();
+			return;
+		}
+
+		glBindVertexArray(vertexArray);
+		s_VertexArray = vertexArray;
+		CountIssued();
+	}
+
+	void GLStateCache::ActiveTexture(GLuint unit)
+	{
+		if (s_ActiveTextureUnit == unit)
+		{
+			CountElided();
+			return;
+		}
+
+		glActiveTexture(GL_TEXTURE0 + unit);
+		s_ActiveTextureUnit = unit;
+		CountIssued();
+	}
+
+	void GLStateCache::BindTexture(GLenum target, GLuint texture)
+	{
+		int slot = GetTextureTargetSlot(target);
+
+		if (slot < 0 || s_ActiveTextureUnit >= MaxTextureUnits)
+		{
+			// Target or unit not shadowed
+			glBindTexture(target, texture);
+			CountIssued();
+			return;
+		}
+
+		GLuint& bound = s_Textures[s_ActiveTextureUnit][slot];
+		if (bound == texture)
+		{
+			CountElided();
+			return;
+		}
+
+		glBindTexture(target, texture);
+		bound = texture;
+		CountIssued();
+	}
+
+	void GLStateCache::BindTexture(GLuint unit, GLenum target, GLuint texture)
+	{
+		int slot = GetTextureTargetSlot(target);
+
+		// Don't switch the active unit for nothing
+		if (slot >= 0 && unit < MaxTextureUnits && s_Textures[unit][slot] == texture)
+		{
+			CountElided();
+			return;
+		}
+
+		ActiveTexture(unit);
+		BindTexture(target, texture);
+	}
+
+	// -------- Capabilities --------
+
+	void GLStateCache::SetEnabled(GLenum capability, bool enabled)
+	{
+		int slot = GetCapabilitySlot(capability);
+		int8_t value = enabled ? 1 : 0;
+
+		if (slot >= 0 && s_Capabilities[slot] == value)
+		{
+			CountElided();
+			return;
+		}
+
+		if (enabled)
+			glEnable(capability);
+		else
+			glDisable(capability);
+
+		if (slot >= 0)
+			s_Capabilities[slot] = value;
+
+		CountIssued();
+	}
+
+	bool GLStateCache::IsEnabled(GLenum capability)
+	{
+		int slot = GetCapabilitySlot(capability);
+
+		if (slot < 0)
+			return glIsEnabled(capability) == GL_TRUE;
+
+		if (s_Capabilities[slot] < 0)
+			s_Capabilities[slot] = glIsEnabled(capability) == GL_TRUE ? 1 : 0;
+
+		return s_Capabilities[slot] == 1;
+	}
+
+	void GLStateCache::BlendFunc(GLenum sourceFactor, GLenum destinationFactor)
+	{
+		if (s_BlendSource == sourceFactor && s_BlendDestination == destinationFactor)
+		{
+			CountElided();
+			return;
+		}
+
+		glBlendFunc(sourceFactor, destinationFactor);
+		s_BlendSource = sourceFactor;
+		s_BlendDestination = destinationFactor;
+		CountIssued();
+	}
+
+	void GLStateCache::DepthFunc(GLenum function)
+	{
+		if (s_DepthFunc == function)
+		{
+			CountElided();
+			return;
+		}
+
+		glDepthFunc(function);
+		s_DepthFunc = function;
+		CountIssued();
+	}
+
+	void GLStateCache::CullFace(GLenum mode)
+	{
+		if (s_CullFace == mode)
+		{
+			CountElided();
+			return;
+		}
+
+		glCullFace(mode);
+		s_CullFace = mode;
+		CountIssued();
+	}
+
+	void GLStateCache::Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+	{
+		std::array<GLint, 4> viewport{x, y, width, height};
+		if (s_Viewport == viewport)
+		{
+			CountElided();
+			return;
+		}
+
+		glViewport(x, y, width, height);
+		s_Viewport = viewport;
+		CountIssued();
+	}
+
+	// -------- Deletion --------
+
+	void GLStateCache::DeleteProgram(GLuint program)
+	{
+		if (program == 0)
+			return;
+
+		glDeleteProgram(program);
+
+		// A deleted program stays in use until another one is bound, but its name may be handed out again
+		if (s_Program == program)
+			s_Program = s_Unknown;
+	}
+
+	void GLStateCache::DeleteVertexArray(GLuint vertexArray)
+	{
+		if (vertexArray == 0)
+			return;
+
+		glDeleteVertexArrays(1, &vertexArray);
+
+		// GL reverts the binding to 0 when the bound vertex array is deleted
+		if (s_VertexArray == vertexArray)
+			s_VertexArray = 0;
+	}
+
+	void GLStateCache::DeleteTexture(GLuint texture)
+	{
+		if (texture == 0)
+			return;
+
+		glDeleteTextures(1, &texture);
+
+		// GL reverts every binding of a deleted texture to 0
+		for (auto& unit : s_Textures)
+		{
+			for (GLuint& bound : unit)
+			{
+				if (bound == texture)
+					bound = 0;
+			}
+		}
+	}
+
+	// -------- Private --------
+
+	int GLStateCache::GetTextureTargetSlot(GLenum target)
+	{
+		switch (target)
+		{
+			case GL_TEXTURE_2D:
+				return Texture2DSlot;
+			case GL_TEXTURE_2D_ARRAY:
+				return Texture2DArraySlot;
+			case GL_TEXTURE_BUFFER:
+				return TextureBufferSlot;
+			default:
+				return -1;
+		}
+	}
+
+	int GLStateCache::GetCapabilitySlot(GLenum capability)
+	{
+		switch (capability)
+		{
+			case GL_BLEND:
+				return BlendSlot;
+			case GL_DEPTH_TEST:
+				return DepthTestSlot;
+			case GL_CULL_FACE:
+				return CullFaceSlot;
+			default:
+				return -1;
+		}
+	}
+
+	void GLStateCache::CountIssued()
+	{
+		s_CurrentFrame.Issued++;
+	}
+
+	void GLStateCache::CountElided()
+	{
+		s_CurrentFrame.Elided++;
+	}
+} // namespace onion::voxel
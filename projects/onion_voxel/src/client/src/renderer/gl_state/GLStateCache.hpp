@@ -0,0 +1,102 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace onion::voxel
+{
+	/// @brief Shadow copy of the OpenGL state owned by the render thread.
+	/// Every bind / enable goes through here and is only forwarded to the driver when the value actually changes.
+	/// Must only be used from the thread owning the OpenGL context.
+	class GLStateCache
+	{
+	  public:
+		struct FrameStats
+		{
+			uint32_t Issued = 0; // Calls forwarded to the driver
+			uint32_t Elided = 0; // Calls skipped because the state was already set
+		};
+
+		static constexpr int MaxTextureUnits = 32;
+
+		/// @brief Forgets every shadowed value : the next call of each kind is always issued.
+		/// Call it once the context is created, and whenever the GL state was changed without going through the cache.
+		static void Invalidate();
+
+		/// @brief Publishes the counters of the frame that just ended and starts counting a new one.
+		static void BeginFrame();
+		/// @brief Any thread, for the stats : the two counters are read one after the other.
+		static FrameStats GetLastFrameStats();
+
+		// ----- Bindings -----
+		static void UseProgram(GLuint program);
+		static void BindVertexArray(GLuint vertexArray);
+
+		static void ActiveTexture(GLuint unit);
+		/// @brief Binds on the currently active texture unit.
+		static void BindTexture(GLenum target, GLuint texture);
+		static void BindTexture(GLuint unit, GLenum target, GLuint texture);
+
+		// ----- Capabilities -----
+		static void SetEnabled(GLenum capability, bool enabled);
+		/// @brief Answers from the shadow copy, the driver is only queried the first time after an Invalidate().
+		static bool IsEnabled(GLenum capability);
+
+		static void BlendFunc(GLenum sourceFactor, GLenum destinationFactor);
+		static void DepthFunc(GLenum function);
+		static void CullFace(GLenum mode);
+		static void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+		// ----- Deletion -----
+		// Deleting an object changes the bindings and its name can be reused : these keep the shadow state right.
+		static void DeleteProgram(GLuint program);
+		static void DeleteVertexArray(GLuint vertexArray);
+		static void DeleteTexture(GLuint texture);
+
+	  private:
+		static int GetTextureTargetSlot(GLenum target);
+		static int GetCapabilitySlot(GLenum capability);
+
+		static void CountIssued();
+		static void CountElided();
+
+	  private:
+		static constexpr GLuint s_Unknown = 0xFFFFFFFFu;
+
+		enum TextureTargetSlot : int
+		{
+			Texture2DSlot = 0,
+			Texture2DArraySlot,
+			TextureBufferSlot,
+			TextureTargetCount
+		};
+
+		enum CapabilitySlot : int
+		{
+			BlendSlot = 0,
+			DepthTestSlot,
+			CullFaceSlot,
+			CapabilityCount
+		};
+
+		static GLuint s_Program;
+		static GLuint s_VertexArray;
+		static GLuint s_ActiveTextureUnit;
+		static std::array<std::array<GLuint, TextureTargetCount>, MaxTextureUnits> s_Textures;
+
+		static std::array<int8_t, CapabilityCount> s_Capabilities; // -1 unknown, 0 disabled, 1 enabled
+
+		static GLenum s_BlendSource;
+		static GLenum s_BlendDestination;
+		static GLenum s_DepthFunc;
+		static GLenum s_CullFace;
+		static std::array<GLint, 4> s_Viewport;
+
+		static FrameStats s_CurrentFrame;
+		static std::atomic<uint32_t> s_LastFrameIssued; // Read by the logic thread for the debug overlay
+		static std::atomic<uint32_t> s_LastFrameElided;
+	};
+} // namespace onion::voxel
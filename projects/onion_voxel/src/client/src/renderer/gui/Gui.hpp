@@ -1,5 +1,6 @@
 #pragma once
 
+#include "layouts/debug_overlay/DebugOverlay.hpp"
 #include "layouts/demo_panel/DemoPanel.hpp"
 
 namespace onion::voxel
@@ -8,6 +9,10 @@ namespace onion::voxel
 	{
 	  public:
 		static void Initialize() { GuiElement::Load(); }
-		static void Shutdown() { GuiElement::Unload(); }
+		static void Shutdown()
+		{
+			Button::UnloadTextures();
+			GuiElement::Unload();
+		}
 	};
 } // namespace onion::voxel
@@ -15,6 +15,9 @@ namespace onion::voxel
 	Shader GuiElement::s_ShaderSprites((GetAssetsPath() / "shaders/sprite.vert").string().c_str(),
 									   (GetAssetsPath() / "shaders/sprite.frag").string().c_str());
 
+	Shader GuiElement::s_ShaderSpritesArray((GetAssetsPath() / "shaders/sprite.vert").string().c_str(),
+											(GetAssetsPath() / "shaders/sprite_array.frag").string().c_str());
+
 	Font GuiElement::s_TextFont{(GetAssetsPath() / "minecraft/textures/font/ascii.png").string(), 16, 16};
 
 	glm::mat4 GuiElement::s_ProjectionMatrix{1.0f};
@@ -22,6 +25,7 @@ namespace onion::voxel
 	int GuiElement::s_ScreenHeight = 600;
 
 	std::shared_ptr<InputsSnapshot> GuiElement::s_InputsSnapshot = nullptr;
+	CommandBuffer* GuiElement::s_CommandBuffer = nullptr;
 
 	// -------- Constructor / Destructor --------
 
@@ -59,10 +63,8 @@ namespace onion::voxel
 		s_ProjectionMatrix =
 			glm::ortho(0.0f, static_cast<float>(screenWidth), static_cast<float>(screenHeight), 0.0f, -1.0f, 1.0f);
 
+		// Uploaded to the shaders as frame uniforms by BeginFrame()
 		Font::SetProjectionMatrix(s_ProjectionMatrix);
-
-		s_ShaderSprites.Use();
-		s_ShaderSprites.setMat4("uProjection", s_ProjectionMatrix);
 	}
 
 	void GuiElement::SetInputsSnapshot(std::shared_ptr<InputsSnapshot> inputsSnapshot)
@@ -70,6 +72,15 @@ namespace onion::voxel
 		s_InputsSnapshot = inputsSnapshot;
 	}
 
+	void GuiElement::BeginFrame(CommandBuffer& commandBuffer)
+	{
+		s_CommandBuffer = &commandBuffer;
+
+		commandBuffer.SetFrameUniform(s_ShaderSprites, "uProjection", s_ProjectionMatrix);
+		commandBuffer.SetFrameUniform(s_ShaderSpritesArray, "uProjection", s_ProjectionMatrix);
+		Font::RecordFrameUniforms(commandBuffer);
+	}
+
 	void GuiElement::Load()
 	{
 		s_TextFont.Load();
@@ -7,6 +7,7 @@
 #include <glm/glm.hpp>
 
 #include "../inputs_manager/inputs_manager.hpp"
+#include "../render_queue/CommandBuffer.hpp"
 #include "../shader/shader.hpp"
 #include "font/font.hpp"
 
@@ -28,6 +29,10 @@ namespace onion::voxel
 		static void SetScreenSize(int screenWidth, int screenHeight);
 		static void SetInputsSnapshot(std::shared_ptr<InputsSnapshot> inputsSnapshot);
 
+		/// @brief Sets the command buffer the elements record into until the next call. Render() runs on the logic
+		/// thread and doesn't make any OpenGL call.
+		static void BeginFrame(CommandBuffer& commandBuffer);
+
 		static void Load();
 		static void Unload();
 
@@ -37,11 +42,13 @@ namespace onion::voxel
 
 	  protected:
 		static Shader s_ShaderSprites;
+		static Shader s_ShaderSpritesArray; // Same quad as s_ShaderSprites, sampling a layer of a texture array
 		static glm::mat4 s_ProjectionMatrix;
 		static int s_ScreenWidth;
 		static int s_ScreenHeight;
 
 		static std::shared_ptr<InputsSnapshot> s_InputsSnapshot;
+		static CommandBuffer* s_CommandBuffer;
 
 	  protected:
 		static Font s_TextFont;
@@ -3,6 +3,7 @@
 #include <iostream>
 
 #include "../../../Variables.hpp"
+#include "../../../gl_state/GLStateCache.hpp"
 
 namespace onion::voxel
 {
@@ -14,11 +15,11 @@ namespace onion::voxel
 
 	std::vector<unsigned int> Button::s_Indices = {0, 1, 2, 2, 3, 0};
 
-	Texture Button::s_Texture((GetAssetsPath() / "minecraft/textures/gui/sprites/widget/button.png").string().c_str());
-	Texture Button::s_TextureDisabled(
-		(GetAssetsPath() / "minecraft/textures/gui/sprites/widget/button_disabled.png").string().c_str());
-	Texture Button::s_TextureHighlighted(
-		(GetAssetsPath() / "minecraft/textures/gui/sprites/widget/button_highlighted.png").string().c_str());
+	TextureArray Button::s_Textures(
+		"Button",
+		{(GetAssetsPath() / "minecraft/textures/gui/sprites/widget/button.png").string(),
+		 (GetAssetsPath() / "minecraft/textures/gui/sprites/widget/button_disabled.png").string(),
+		 (GetAssetsPath() / "minecraft/textures/gui/sprites/widget/button_highlighted.png").string()});
 
 	// -------- Constructor --------
 
@@ -36,6 +37,12 @@ namespace onion::voxel
 			return;
 		}
 
+		if (!s_CommandBuffer)
+		{
+			std::cerr << "Error: Button::Render() called outside of GuiElement::BeginFrame()." << std::endl;
+			return;
+		}
+
 		bool isCurrentlyHovered = IsHovered();
 		bool isClicked = s_InputsSnapshot->Mouse.LeftButtonPressed;
 
@@ -83,29 +90,24 @@ namespace onion::voxel
 		glm::vec2 topLeft = m_Position - updatedSize * 0.5f;
 
 		// ----- Render Button -----
-		s_ShaderSprites.Use();
-		s_ShaderSprites.setVec2("uPos", topLeft.x, topLeft.y);
-		s_ShaderSprites.setVec2("uSize", updatedSize.x, updatedSize.y);
-
-		glActiveTexture(GL_TEXTURE0);
-
-		// Bind correct texture based on state
+		// The three states are layers of the same array : no texture rebind between buttons, only a uniform
+		TextureLayer layer = TextureLayer::Default;
 		if (!m_IsEnabled)
-		{
-			s_TextureDisabled.Bind();
-		}
+			layer = TextureLayer::Disabled;
 		else if (isCurrentlyHovered)
-		{
-			s_TextureHighlighted.Bind();
-		}
-		else
-		{
-			s_Texture.Bind();
-		}
+			layer = TextureLayer::Highlighted;
 
-		glBindVertexArray(m_VAO);
-		glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(s_Indices.size()), GL_UNSIGNED_INT, 0);
-		glBindVertexArray(0);
+		RenderState state;
+		state.DepthTest = false;
+		state.Blend = true;
+
+		uint64_t sortKey = SortKey::MakeSequenced(RenderPass::Gui, s_CommandBuffer->NextSequence());
+		s_CommandBuffer->Begin(sortKey, s_ShaderSpritesArray, m_VAO, state);
+		s_CommandBuffer->SetUniform("uPos", topLeft);
+		s_CommandBuffer->SetUniform("uSize", updatedSize);
+		s_CommandBuffer->SetUniform("uLayer", static_cast<float>(layer));
+		s_CommandBuffer->BindTexture(0, s_Textures); // Skipped until the array is resident
+		s_CommandBuffer->DrawElements(GL_TRIANGLES, static_cast<uint32_t>(s_Indices.size()));
 
 		// ----- Render Text -----
 		if (!m_Text.empty())
@@ -118,10 +120,14 @@ namespace onion::voxel
 			float textX = topLeft.x + (updatedSize.x - textSize.x) * 0.5f;
 			float textY = topLeft.y + (updatedSize.y - textSize.y) * 0.5f;
 
-			float shadowOffset = m_Size.y * 0.06f;
-			s_TextFont.RenderText(
-				m_Text, textX + shadowOffset, textY + shadowOffset, textScale, {0.247f, 0.247f, 0.247f});
-			s_TextFont.RenderText(m_Text, textX, textY, textScale, {1, 1, 1});
+			// Shadow is drawn by the distance field shader in the same pass
+			TextStyle style;
+			style.Color = {1, 1, 1};
+			style.HasShadow = true;
+			style.ShadowColor = {0.247f, 0.247f, 0.247f};
+			style.ShadowOffset = m_Size.y * 0.06f / textScale;
+
+			s_TextFont.RenderText(*s_CommandBuffer, m_Text, textX, textY, textScale, style);
 		}
 	}
 
@@ -130,8 +136,11 @@ namespace onion::voxel
 		GenerateBuffers();
 		InitBuffers();
 
-		s_ShaderSprites.Use();
-		s_ShaderSprites.setInt("uTexture", 0);
+		// Start decoding in the background, the button is drawn without its background until the array is resident
+		s_Textures.Load();
+
+		s_ShaderSpritesArray.Use();
+		s_ShaderSpritesArray.setInt("uTextures", 0);
 
 		SetInitState(true);
 	}
@@ -192,6 +201,11 @@ namespace onion::voxel
 		m_ScaleUpOnHover = scaleUp;
 	}
 
+	void Button::UnloadTextures()
+	{
+		s_Textures.Delete();
+	}
+
 	// -------- Hover Logic --------
 
 	bool Button::IsHovered() const
@@ -223,7 +237,7 @@ namespace onion::voxel
 
 	void Button::DeleteBuffers()
 	{
-		glDeleteVertexArrays(1, &m_VAO);
+		GLStateCache::DeleteVertexArray(m_VAO);
 		glDeleteBuffers(1, &m_VBO);
 		glDeleteBuffers(1, &m_EBO);
 
@@ -234,7 +248,7 @@ namespace onion::voxel
 
 	void Button::InitBuffers()
 	{
-		glBindVertexArray(m_VAO);
+		GLStateCache::BindVertexArray(m_VAO);
 
 		glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
 		glBufferData(GL_ARRAY_BUFFER, s_Vertices.size() * sizeof(Vertex), s_Vertices.data(), GL_STATIC_DRAW);
@@ -249,7 +263,7 @@ namespace onion::voxel
 		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*) offsetof(Vertex, texX));
 		glEnableVertexAttribArray(1);
 
-		glBindVertexArray(0);
+		GLStateCache::BindVertexArray(0);
 	}
 
 } // namespace onion::voxel
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "../../../texture/texture.hpp"
+#include "../../../texture/TextureArray.hpp"
 #include "../../GuiElement.hpp"
 
 #include <Event.hpp>
@@ -38,6 +38,9 @@ namespace onion::voxel
 
 		void SetScaleUpOnHover(bool scaleUp);
 
+		/// @brief Releases the textures shared by every button. Must be called before the OpenGL context is destroyed.
+		static void UnloadTextures();
+
 		// Events
 	  public:
 		Event<const Button&> OnClick;
@@ -59,9 +62,15 @@ namespace onion::voxel
 		glm::vec2 m_Position{0, 0};
 		glm::vec2 m_Size{1, 1};
 
-		static Texture s_Texture;
-		static Texture s_TextureDisabled;
-		static Texture s_TextureHighlighted;
+		// Layers of s_Textures
+		enum TextureLayer : int
+		{
+			Default = 0,
+			Disabled = 1,
+			Highlighted = 2
+		};
+
+		static TextureArray s_Textures;
 
 		struct Vertex
 		{
@@ -0,0 +1,145 @@
+#include "SdfGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace onion::voxel
+{
+	// -------- Public API --------
+
+	SdfGenerator::Atlas SdfGenerator::Generate(const unsigned char* pixels,
+												int width,
+												int height,
+												int nrChannels,
+												int atlasCols,
+												int atlasRows,
+												const Settings& settings)
+	{
+		Atlas atlas;
+		if (!pixels || nrChannels <= 0 || atlasCols <= 0 || atlasRows <= 0)
+			return atlas;
+
+		const int glyphPixelWidth = width / atlasCols;
+		const int glyphPixelHeight = height / atlasRows;
+		const int padding = settings.Padding * settings.Upscale;
+
+		atlas.CellWidth = glyphPixelWidth * settings.Upscale + 2 * padding;
+		atlas.CellHeight = glyphPixelHeight * settings.Upscale + 2 * padding;
+		atlas.Width = atlas.CellWidth * atlasCols;
+		atlas.Height = atlas.CellHeight * atlasRows;
+		atlas.Pixels.assign(static_cast<size_t>(atlas.Width) * atlas.Height, 0);
+
+		constexpr int kFar = 1 << 14;
+		const int alphaOffset = nrChannels == 4 ? 3 : (nrChannels == 2 ? 1 : 0);
+
+		// Distance to the nearest pixel outside / inside the glyph, computed per cell so glyphs never bleed
+		std::vector<Offset> toInside(static_cast<size_t>(atlas.CellWidth) * atlas.CellHeight);
+		std::vector<Offset> toOutside(toInside.size());
+
+		for (int row = 0; row < atlasRows; row++)
+		{
+			for (int col = 0; col < atlasCols; col++)
+			{
+				for (int y = 0; y < atlas.CellHeight; y++)
+				{
+					for (int x = 0; x < atlas.CellWidth; x++)
+					{
+						int srcX = (x - padding) / settings.Upscale;
+						int srcY = (y - padding) / settings.Upscale;
+
+						bool inside = false;
+						if (x >= padding && y >= padding && srcX < glyphPixelWidth && srcY < glyphPixelHeight)
+						{
+							int px = col * glyphPixelWidth + srcX;
+							int py = row * glyphPixelHeight + srcY;
+							inside = pixels[(py * width + px) * nrChannels + alphaOffset] > settings.AlphaThreshold;
+						}
+
+						size_t index = static_cast<size_t>(y) * atlas.CellWidth + x;
+						toInside[index] = inside ? Offset{0, 0} : Offset{kFar, kFar};
+						toOutside[index] = inside ? Offset{kFar, kFar} : Offset{0, 0};
+					}
+				}
+
+				Propagate(toInside, atlas.CellWidth, atlas.CellHeight);
+				Propagate(toOutside, atlas.CellWidth, atlas.CellHeight);
+
+				for (int y = 0; y < atlas.CellHeight; y++)
+				{
+					for (int x = 0; x < atlas.CellWidth; x++)
+					{
+						size_t index = static_cast<size_t>(y) * atlas.CellWidth + x;
+
+						// Positive outside, negative inside, the edge sits halfway between two pixel centers
+						float distance = std::sqrt(static_cast<float>(toInside[index].DistSq())) -
+							std::sqrt(static_cast<float>(toOutside[index].DistSq()));
+
+						float normalized = 0.5f - distance / (2.f * settings.Spread);
+						normalized = std::clamp(normalized, 0.f, 1.f);
+
+						int dstX = col * atlas.CellWidth + x;
+						int dstY = row * atlas.CellHeight + y;
+						atlas.Pixels[static_cast<size_t>(dstY) * atlas.Width + dstX] =
+							static_cast<unsigned char>(normalized * 255.f + 0.5f);
+					}
+				}
+			}
+		}
+
+		return atlas;
+	}
+
+	// -------- 8SSEDT --------
+
+	void SdfGenerator::Propagate(std::vector<Offset>& grid, int width, int height)
+	{
+		auto compare = [&](Offset& current, int x, int y, int offsetX, int offsetY)
+		{
+			int nx = x + offsetX;
+			int ny = y + offsetY;
+			if (nx < 0 || ny < 0 || nx >= width || ny >= height)
+				return;
+
+			Offset candidate = grid[static_cast<size_t>(ny) * width + nx];
+			candidate.dx += offsetX;
+			candidate.dy += offsetY;
+
+			if (candidate.DistSq() < current.DistSq())
+				current = candidate;
+		};
+
+		// Forward pass
+		for (int y = 0; y < height; y++)
+		{
+			for (int x = 0; x < width; x++)
+			{
+				Offset& current = grid[static_cast<size_t>(y) * width + x];
+				compare(current, x, y, -1, 0);
+				compare(current, x, y, 0, -1);
+				compare(current, x, y, -1, -1);
+				compare(current, x, y, 1, -1);
+			}
+			for (int x = width - 1; x >= 0; x--)
+			{
+				compare(grid[static_cast<size_t>(y) * width + x], x, y, 1, 0);
+			}
+		}
+
+		// Backward pass
+		for (int y = height - 1; y >= 0; y--)
+		{
+			for (int x = width - 1; x >= 0; x--)
+			{
+				Offset& current = grid[static_cast<size_t>(y) * width + x];
+				compare(current, x, y, 1, 0);
+				compare(current, x, y, 0, 1);
+				compare(current, x, y, -1, 1);
+				compare(current, x, y, 1, 1);
+			}
+			for (int x = 0; x < width; x++)
+			{
+				compare(grid[static_cast<size_t>(y) * width + x], x, y, -1, 0);
+			}
+		}
+	}
+} // namespace onion::voxel
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+
+namespace onion::voxel
+{
+	/// @brief Converts a bitmap glyph atlas into a single channel signed distance field atlas.
+	/// Each glyph cell is upscaled (nearest) and padded so the distance field can be sampled with linear filtering
+	/// at any scale, and so shadows and outlines can be drawn in the shader without bleeding into neighbour cells.
+	class SdfGenerator
+	{
+	  public:
+		struct Settings
+		{
+			int Upscale = 6;  // Output pixels per source pixel
+			int Padding = 2;  // Empty border around each cell, in source pixels
+			int Spread = 12; // Distance (in output pixels) mapped to the full [0, 255] range on each side of the edge
+			int AlphaThreshold = 127;
+		};
+
+		struct Atlas
+		{
+			int Width = 0;
+			int Height = 0;
+			int CellWidth = 0;	// Padded cell size in output pixels
+			int CellHeight = 0; // Padded cell size in output pixels
+			std::vector<unsigned char> Pixels; // 1 channel, 128 is the glyph edge, > 128 is inside
+		};
+
+		/// @brief Generates a distance field atlas with the same cols x rows cell layout as the source atlas.
+		/// @param pixels Source pixels, the glyph coverage is read from the alpha channel (or the only channel).
+		static Atlas Generate(const unsigned char* pixels,
+							  int width,
+							  int height,
+							  int nrChannels,
+							  int atlasCols,
+							  int atlasRows,
+							  const Settings& settings);
+
+	  private:
+		struct Offset
+		{
+			int dx;
+			int dy;
+			int DistSq() const { return dx * dx + dy * dy; }
+		};
+
+		static void Propagate(std::vector<Offset>& grid, int width, int height);
+	};
+} // namespace onion::voxel
@@ -1,9 +1,27 @@
 #include "font.hpp"
 
+#include <algorithm>
+
 #include "../../Variables.hpp"
+#include "../../gl_state/GLStateCache.hpp"
+#include "SdfGenerator.hpp"
 
 using namespace onion::voxel;
 
+// -------- Helpers --------
+
+namespace
+{
+	uint32_t PackColor(const glm::vec3& color)
+	{
+		auto toByte = [](float channel)
+		{ return static_cast<uint32_t>(std::clamp(channel, 0.f, 1.f) * 255.f + 0.5f); };
+
+		// Little endian : R is the first byte in memory, matching the GL_UNSIGNED_BYTE x4 attribute
+		return toByte(color.x) | (toByte(color.y) << 8) | (toByte(color.z) << 16) | (0xFFu << 24);
+	}
+} // namespace
+
 // -------- Static Member Definitions --------
 
 Shader Font::m_ShaderFont((GetAssetsPath() / "shaders/font.vert").string().c_str(),
@@ -11,12 +29,18 @@ Shader Font::m_ShaderFont((GetAssetsPath() / "shaders/font.vert").string().c_str
 
 glm::mat4 Font::s_ProjectionMatrix{1.0f};
 
+// Per-instance attributes, one GlyphInstance per character
+const VertexLayout Font::s_InstanceLayout{
+	sizeof(GlyphInstance),
+	{{0, 2, GL_FLOAT, false, false, offsetof(GlyphInstance, posX)},
+	 {1, 1, GL_UNSIGNED_INT, false, true, offsetof(GlyphInstance, glyphIndex)},
+	 {2, 4, GL_UNSIGNED_BYTE, true, false, offsetof(GlyphInstance, color)}}};
+
 // -------- Constructor / Destructor --------
 
 Font::Font(const std::string& fontFilePath, int atlasCols, int atlasRows)
 	: m_FontFilePath(fontFilePath), m_TextureAtlas(fontFilePath), m_AtlasCols(atlasCols), m_AtlasRows(atlasRows)
 {
-	InitializeGlyphs();
 }
 
 Font::~Font()
@@ -28,93 +52,108 @@ Font::~Font()
 
 void Font::Load()
 {
-	m_TextureAtlas.Bind(); // Upload texture
+	if (m_IsLoaded)
+		return;
+
+	// Decoded here rather than in the constructor, fonts are static members built before main()
+	InitializeGlyphs();
+	if (!m_SdfAtlas)
+		return;
+
+	m_SdfAtlas->Bind(); // Upload texture
 	m_ShaderFont.Use();
-	m_ShaderFont.setInt("uTexture", m_TextureAtlas.GetTextureID());
+	m_ShaderFont.setInt("uTexture", 0);
+	m_ShaderFont.setInt("uGlyphMetrics", 1);
+	m_ShaderFont.setFloat("uSdfSpread", m_SdfSpread);
 	GenerateBuffers();
+	UploadGlyphMetrics();
+
+	m_IsLoaded = true;
 }
 
 void Font::Unload()
 {
+	if (!m_IsLoaded)
+		return;
+
 	DeleteBuffers();
+	m_SdfAtlas->Delete();
+
+	m_IsLoaded = false;
 }
 
 void Font::SetProjectionMatrix(const glm::mat4& projection)
 {
+	// Applied on the GL thread by RecordFrameUniforms(), this can be called from the logic thread
 	s_ProjectionMatrix = projection;
-	m_ShaderFont.Use();
-	m_ShaderFont.setMat4("uProjection", s_ProjectionMatrix);
 }
 
-void Font::RenderText(const std::string& text, float x, float y, float scale, const glm::vec3& color)
+void Font::RecordFrameUniforms(CommandBuffer& commandBuffer)
 {
-	GLboolean depthTestEnabled = glIsEnabled(GL_DEPTH_TEST);
-	if (depthTestEnabled)
-		glDisable(GL_DEPTH_TEST);
+	commandBuffer.SetFrameUniform(m_ShaderFont, "uProjection", s_ProjectionMatrix);
+}
 
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+void Font::RenderText(CommandBuffer& commandBuffer,
+					  const std::string& text,
+					  float x,
+					  float y,
+					  float scale,
+					  const glm::vec3& color)
+{
+	TextStyle style;
+	style.Color = color;
+	RenderText(commandBuffer, text, x, y, scale, style);
+}
 
-	if (text.empty())
+void Font::RenderText(CommandBuffer& commandBuffer,
+					  const std::string& text,
+					  float x,
+					  float y,
+					  float scale,
+					  const TextStyle& style)
+{
+	if (text.empty() || !m_IsLoaded)
 		return;
 
-	m_Vertices.clear();
-
-	float uvStepX = 1.0f / m_AtlasCols;
-	float uvStepY = 1.0f / m_AtlasRows;
+	m_Instances.clear();
 
+	uint32_t packedColor = PackColor(style.Color);
 	float cursorX = x;
-	float cursorY = y;
-
-	int texWidth = m_TextureAtlas.GetWidth();
-	int texHeight = m_TextureAtlas.GetHeight();
-
-	float glyphPixelWidth = texWidth / m_AtlasCols;
-	float glyphPixelHeight = texHeight / m_AtlasRows;
-
-	float glyphSizeX = glyphPixelWidth * scale;
-	float glyphSizeY = glyphPixelHeight * scale;
 
 	for (char c : text)
 	{
 		int ascii = static_cast<unsigned char>(c);
 
-		const Glyph& glyph = m_Glyphs[ascii];
-
-		float x0 = cursorX;
-		float y0 = cursorY;
-		float x1 = x0 + glyph.width * scale;
-		float y1 = y0 + glyph.height * scale;
+		m_Instances.push_back({cursorX, y, static_cast<uint32_t>(ascii), packedColor});
 
-		m_Vertices.push_back({x0, y0, 0.f, glyph.u0, glyph.v0});
-		m_Vertices.push_back({x1, y0, 0.f, glyph.u1, glyph.v0});
-		m_Vertices.push_back({x1, y1, 0.f, glyph.u1, glyph.v1});
-
-		m_Vertices.push_back({x0, y0, 0.f, glyph.u0, glyph.v0});
-		m_Vertices.push_back({x1, y1, 0.f, glyph.u1, glyph.v1});
-		m_Vertices.push_back({x0, y1, 0.f, glyph.u0, glyph.v1});
-
-		cursorX += glyph.advance * scale;
+		cursorX += m_Glyphs[ascii].advance * scale;
 	}
 
-	glBindVertexArray(m_VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+	// The shadow is sampled inside the glyph padding, it can't be offset further than that
+	float shadowOffset = style.HasShadow ? std::min(style.ShadowOffset, m_GlyphPadding) : 0.f;
+	float shadowAlpha = style.HasShadow ? 1.f : 0.f;
 
-	glBufferData(GL_ARRAY_BUFFER, m_Vertices.size() * sizeof(Vertex), m_Vertices.data(), GL_DYNAMIC_DRAW);
+	// Text is drawn over everything recorded before it, without depth test
+	RenderState state;
+	state.DepthTest = false;
+	state.Blend = true;
 
-	glActiveTexture(GL_TEXTURE0);
-	m_TextureAtlas.Bind();
+	uint64_t sortKey = SortKey::MakeSequenced(RenderPass::Gui, commandBuffer.NextSequence());
+	commandBuffer.Begin(sortKey, m_ShaderFont, m_VAO, state);
 
-	m_ShaderFont.Use();
-	m_ShaderFont.setVec3("uTextColor", color);
-	m_ShaderFont.setInt("uTexture", 0);
+	commandBuffer.SetUniform("uScale", scale);
+	commandBuffer.SetUniform("uShadowOffset", shadowOffset);
+	commandBuffer.SetUniform("uShadowColor", glm::vec4(style.ShadowColor, shadowAlpha));
+	commandBuffer.SetUniform("uOutlineWidth", std::min(style.OutlineWidth, m_GlyphPadding));
+	commandBuffer.SetUniform("uOutlineColor", style.OutlineColor);
 
-	glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_Vertices.size()));
+	commandBuffer.BindTexture(0, *m_SdfAtlas);
+	commandBuffer.BindTexture(1, GL_TEXTURE_BUFFER, m_GlyphMetricsTexture);
 
-	glBindVertexArray(0);
+	commandBuffer.StreamVertices(s_InstanceLayout, m_Instances.data(), m_Instances.size() * sizeof(GlyphInstance));
 
-	if (depthTestEnabled)
-		glEnable(GL_DEPTH_TEST);
+	// 4 vertices per glyph, the quad corners are generated from gl_VertexID in font.vert
+	commandBuffer.DrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<uint32_t>(m_Instances.size()));
 }
 
 glm::vec2 Font::MeasureText(const std::string& text, float scale) const
@@ -142,36 +181,63 @@ glm::vec2 Font::MeasureText(const std::string& text, float scale) const
 void Font::GenerateBuffers()
 {
 	glGenVertexArrays(1, &m_VAO);
-	glGenBuffers(1, &m_VBO);
+	GLStateCache::BindVertexArray(m_VAO);
+
+	// The pointers are set by the render queue at each draw, into the stream ring buffer (s_InstanceLayout)
+	for (const VertexAttribute& attribute : s_InstanceLayout.Attributes)
+	{
+		glEnableVertexAttribArray(attribute.Location);
+		glVertexAttribDivisor(attribute.Location, 1);
+	}
 
-	glBindVertexArray(m_VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+	GLStateCache::BindVertexArray(0);
+}
 
-	glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_DYNAMIC_DRAW);
+void Font::DeleteBuffers()
+{
+	GLStateCache::DeleteVertexArray(m_VAO);
 
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*) offsetof(Vertex, posX));
-	glEnableVertexAttribArray(0);
+	GLStateCache::DeleteTexture(m_GlyphMetricsTexture);
 
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*) offsetof(Vertex, texX));
-	glEnableVertexAttribArray(1);
+	if (m_GlyphMetricsBuffer)
+		glDeleteBuffers(1, &m_GlyphMetricsBuffer);
 
-	glBindVertexArray(0);
+	m_VAO = 0;
+	m_GlyphMetricsTexture = 0;
+	m_GlyphMetricsBuffer = 0;
 }
 
-void Font::DeleteBuffers()
+void Font::UploadGlyphMetrics()
 {
-	if (m_VAO)
-		glDeleteVertexArrays(1, &m_VAO);
+	// 2 texels per glyph : (u0, v0, u1, v1) of the padded cell and (width, height, advance, padding)
+	std::vector<float> metrics;
+	metrics.reserve(256 * 8);
 
-	if (m_VBO)
-		glDeleteBuffers(1, &m_VBO);
+	for (const Glyph& glyph : m_Glyphs)
+	{
+		metrics.insert(metrics.end(), {glyph.u0, glyph.v0, glyph.u1, glyph.v1});
+		metrics.insert(metrics.end(), {glyph.width, glyph.height, glyph.advance, m_GlyphPadding});
+	}
 
-	m_VAO = 0;
-	m_VBO = 0;
+	glGenBuffers(1, &m_GlyphMetricsBuffer);
+	glBindBuffer(GL_TEXTURE_BUFFER, m_GlyphMetricsBuffer);
+	glBufferData(GL_TEXTURE_BUFFER, metrics.size() * sizeof(float), metrics.data(), GL_STATIC_DRAW);
+
+	glGenTextures(1, &m_GlyphMetricsTexture);
+	GLStateCache::BindTexture(GL_TEXTURE_BUFFER, m_GlyphMetricsTexture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_GlyphMetricsBuffer);
+
+	GLStateCache::BindTexture(GL_TEXTURE_BUFFER, 0);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
 }
 
-float GetGlyphAdvance(
-	unsigned char* data, int col, int row, int glyphPixelWidth, int glyphPixelHeight, int textureWidth, int nbChannels)
+float GetGlyphAdvance(const unsigned char* data,
+					  int col,
+					  int row,
+					  int glyphPixelWidth,
+					  int glyphPixelHeight,
+					  int textureWidth,
+					  int nbChannels)
 {
 	int startX = col * glyphPixelWidth;
 	int startY = row * glyphPixelHeight;
@@ -218,7 +284,11 @@ float GetGlyphAdvance(
 
 void onion::voxel::Font::InitializeGlyphs()
 {
-	auto data = m_TextureAtlas.GetData();
+	// The bitmap is only needed for the analysis below, it is never uploaded
+	if (!m_TextureAtlas.RequireCpuData())
+		return;
+
+	const unsigned char* data = m_TextureAtlas.GetPixels();
 	int width = m_TextureAtlas.GetWidth();
 	int height = m_TextureAtlas.GetHeight();
 	int nrChannels = m_TextureAtlas.GetNrChannels();
@@ -226,6 +296,15 @@ void onion::voxel::Font::InitializeGlyphs()
 	int glyphPixelWidth = width / m_AtlasCols;
 	int glyphPixelHeight = height / m_AtlasRows;
 
+	SdfGenerator::Settings sdfSettings;
+	SdfGenerator::Atlas sdf =
+		SdfGenerator::Generate(data, width, height, nrChannels, m_AtlasCols, m_AtlasRows, sdfSettings);
+
+	m_SdfAtlas = std::make_unique<Texture>(m_FontFilePath + " (SDF)", sdf.Width, sdf.Height, 1, sdf.Pixels.data());
+	m_SdfAtlas->SetFilter(TextureFilter::Linear);
+	m_GlyphPadding = static_cast<float>(sdfSettings.Padding);
+	m_SdfSpread = static_cast<float>(sdfSettings.Spread) / sdfSettings.Upscale;
+
 	for (int i = 0; i < 256; i++)
 	{
 		int col = i % m_AtlasCols;
@@ -235,8 +314,9 @@ void onion::voxel::Font::InitializeGlyphs()
 		m_Glyphs[i].height = (float) glyphPixelHeight;
 
 		m_Glyphs[i].advance =
-			GetGlyphAdvance(data.get(), col, row, glyphPixelWidth, glyphPixelHeight, width, nrChannels);
+			GetGlyphAdvance(data, col, row, glyphPixelWidth, glyphPixelHeight, width, nrChannels);
 
+		// UVs cover the padded cell of the distance field atlas
 		float uvStepX = 1.0f / m_AtlasCols;
 		float uvStepY = 1.0f / m_AtlasRows;
 
@@ -245,4 +325,6 @@ void onion::voxel::Font::InitializeGlyphs()
 		m_Glyphs[i].u1 = m_Glyphs[i].u0 + uvStepX;
 		m_Glyphs[i].v1 = m_Glyphs[i].v0 + uvStepY;
 	}
+
+	m_TextureAtlas.ReleaseCpuData();
 }
@@ -1,15 +1,31 @@
 #pragma once
 
+#include "../../render_queue/CommandBuffer.hpp"
 #include "../../shader/shader.hpp"
 #include "../../texture/texture.hpp"
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace onion::voxel
 {
+	/// @brief Effects applied in the distance field shader, in a single draw.
+	struct TextStyle
+	{
+		glm::vec3 Color{1.f, 1.f, 1.f};
+
+		bool HasShadow = false;
+		glm::vec3 ShadowColor{0.247f, 0.247f, 0.247f};
+		float ShadowOffset = 1.f; // In font pixels, towards the bottom right
+
+		float OutlineWidth = 0.f; // In font pixels, 0 disables the outline
+		glm::vec3 OutlineColor{0.f, 0.f, 0.f};
+	};
+
 	class Font
 	{
 	  public:
@@ -20,19 +36,38 @@ namespace onion::voxel
 		void Unload();
 
 		static void SetProjectionMatrix(const glm::mat4& projection);
+		static void RecordFrameUniforms(CommandBuffer& commandBuffer);
 
-		void RenderText(const std::string& text, float x, float y, float scale, const glm::vec3& color);
+		/// @brief Records the text as a single instanced draw in the GUI pass. Doesn't make any OpenGL call.
+		void RenderText(CommandBuffer& commandBuffer,
+						const std::string& text,
+						float x,
+						float y,
+						float scale,
+						const glm::vec3& color);
+		void RenderText(CommandBuffer& commandBuffer,
+						const std::string& text,
+						float x,
+						float y,
+						float scale,
+						const TextStyle& style);
 		glm::vec2 MeasureText(const std::string& text, float scale) const;
 
 	  private:
-		struct Vertex
+		// One record per character, expanded to a quad in font.vert (16 bytes instead of 6 full vertices)
+		struct GlyphInstance
 		{
-			float posX, posY, posZ;
-			float texX, texY;
+			float posX, posY;	 // Top-left corner in pixels
+			uint32_t glyphIndex; // Index into the glyph metrics buffer
+			uint32_t color;		 // RGBA8, normalized in the shader
 		};
+		static_assert(sizeof(GlyphInstance) == 16, "GlyphInstance must stay 16 bytes");
+
+		static const VertexLayout s_InstanceLayout;
 
 		void GenerateBuffers();
 		void DeleteBuffers();
+		void UploadGlyphMetrics();
 
 	  private:
 		struct Glyph
@@ -45,19 +80,29 @@ namespace onion::voxel
 
 	  private:
 		std::string m_FontFilePath;
-		Texture m_TextureAtlas;
+		Texture m_TextureAtlas; // Source bitmap, only read on the CPU
 		int m_AtlasCols = 16;
 		int m_AtlasRows = 16;
 
+		// Distance field generated from the bitmap at startup, serves every text scale
+		std::unique_ptr<Texture> m_SdfAtlas;
+		float m_GlyphPadding = 0.f; // Empty border around each glyph in the distance field, in font pixels
+		float m_SdfSpread = 1.f;	// Distance covered by the field on each side of the edge, in font pixels
+
 		Glyph m_Glyphs[256]{};
 		void InitializeGlyphs();
 
+		bool m_IsLoaded = false;
+
 		static glm::mat4 s_ProjectionMatrix;
 
 		GLuint m_VAO = 0;
-		GLuint m_VBO = 0;
 
-		std::vector<Vertex> m_Vertices;
+		// Glyph metrics table (uv rect + size per glyph), sampled as a samplerBuffer in font.vert
+		GLuint m_GlyphMetricsBuffer = 0;
+		GLuint m_GlyphMetricsTexture = 0;
+
+		std::vector<GlyphInstance> m_Instances; // Scratch buffer of the recording thread
 
 	  private:
 		static Shader m_ShaderFont;
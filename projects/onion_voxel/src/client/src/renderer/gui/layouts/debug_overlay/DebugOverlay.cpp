@@ -0,0 +1,45 @@
+#include "DebugOverlay.hpp"
+
+#include <algorithm>
+
+namespace onion::voxel
+{
+
+	DebugOverlay::DebugOverlay(const std::string& name) : GuiElement(name) {}
+
+	void DebugOverlay::Render()
+	{
+		// Readable from 600 pixels high, grows with the window
+		const float textScale = std::max(1.f, s_ScreenHeight / 600.f) * 1.5f;
+		const float lineHeight = s_TextFont.MeasureText("A", textScale).y * 1.2f;
+		const float margin = 4.f * textScale;
+
+		TextStyle style;
+		style.Color = {1.f, 1.f, 1.f};
+		style.HasShadow = true;
+
+		float y = margin;
+		for (const std::string& line : m_Lines)
+		{
+			s_TextFont.RenderText(*s_CommandBuffer, line, margin, y, textScale, style);
+			y += lineHeight;
+		}
+	}
+
+	void DebugOverlay::Initialize()
+	{
+		GuiElement::s_TextFont.Load();
+		SetInitState(true);
+	}
+
+	void DebugOverlay::Delete()
+	{
+		SetDeletedState(true);
+	}
+
+	void DebugOverlay::SetLines(std::vector<std::string> lines)
+	{
+		m_Lines = std::move(lines);
+	}
+
+} // namespace onion::voxel
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "../../GuiElement.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Lines of text in the top left corner : position, culling and meshing stats.
+	class DebugOverlay : public GuiElement
+	{
+	  public:
+		DebugOverlay(const std::string& name);
+		~DebugOverlay() override = default;
+
+		void Render() override;
+		void Initialize() override;
+		void Delete() override;
+
+		/// @brief Replaces the lines shown from the next Render().
+		void SetLines(std::vector<std::string> lines);
+
+	  private:
+		std::vector<std::string> m_Lines;
+	};
+} // namespace onion::voxel
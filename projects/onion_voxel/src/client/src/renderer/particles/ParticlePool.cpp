@@ -0,0 +1,199 @@
+#include "ParticlePool.hpp"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ONION_PARTICLE_POOL_SSE
+#endif
+
+#include <platform/CpuFeatures.hpp>
+
+namespace onion::voxel
+{
+	namespace
+	{
+		bool UseAvx()
+		{
+			static const bool supported = detail::HasAvxParticlePath() && CpuSupportsAvx();
+			return supported;
+		}
+
+#if defined(ONION_PARTICLE_POOL_SSE)
+		/// @return The number of particles integrated from the start, a multiple of 4.
+		size_t IntegrateParticlesSse(const detail::ParticleStreams& streams, size_t count, float deltaSeconds)
+		{
+			constexpr size_t Width = 4;
+			const __m128 dt = _mm_set1_ps(deltaSeconds);
+			const __m128 one = _mm_set1_ps(1.f);
+			const __m128 zero = _mm_setzero_ps();
+
+			size_t first = 0;
+			for (; first + Width <= count; first += Width)
+			{
+				// Velocity kept over the step, clamped so a long frame stops the particle rather than reversing it
+				const __m128 keep =
+					_mm_max_ps(_mm_sub_ps(one, _mm_mul_ps(_mm_loadu_ps(streams.Drag + first), dt)), zero);
+				const __m128 fall = _mm_mul_ps(_mm_loadu_ps(streams.Gravity + first), dt);
+
+				const __m128 vx = _mm_mul_ps(_mm_loadu_ps(streams.VelocityX + first), keep);
+				const __m128 vy = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(streams.VelocityY + first), fall), keep);
+				const __m128 vz = _mm_mul_ps(_mm_loadu_ps(streams.VelocityZ + first), keep);
+
+				_mm_storeu_ps(streams.VelocityX + first, vx);
+				_mm_storeu_ps(streams.VelocityY + first, vy);
+				_mm_storeu_ps(streams.VelocityZ + first, vz);
+				_mm_storeu_ps(streams.PositionX + first,
+							  _mm_add_ps(_mm_loadu_ps(streams.PositionX + first), _mm_mul_ps(vx, dt)));
+				_mm_storeu_ps(streams.PositionY + first,
+							  _mm_add_ps(_mm_loadu_ps(streams.PositionY + first), _mm_mul_ps(vy, dt)));
+				_mm_storeu_ps(streams.PositionZ + first,
+							  _mm_add_ps(_mm_loadu_ps(streams.PositionZ + first), _mm_mul_ps(vz, dt)));
+				_mm_storeu_ps(streams.Age + first, _mm_add_ps(_mm_loadu_ps(streams.Age + first), dt));
+			}
+			return first;
+		}
+#endif
+	} // namespace
+
+	// -------- Constructor --------
+
+	ParticlePool::ParticlePool(size_t capacity)
+		: m_Capacity(capacity),
+		  m_PositionX(capacity),
+		  m_PositionY(capacity),
+		  m_PositionZ(capacity),
+		  m_VelocityX(capacity),
+		  m_VelocityY(capacity),
+		  m_VelocityZ(capacity),
+		  m_Age(capacity),
+		  m_Lifetime(capacity),
+		  m_Size(capacity),
+		  m_Gravity(capacity),
+		  m_Drag(capacity),
+		  m_Sprite(capacity),
+		  m_FrameCount(capacity),
+		  m_Color(capacity)
+	{
+	}
+
+	// -------- Public API --------
+
+	bool ParticlePool::Emit(const ParticleSpawn& spawn)
+	{
+		if (m_Count == m_Capacity)
+		{
+			m_DroppedCount++;
+			return false;
+		}
+
+		const size_t i = m_Count++;
+		m_PositionX[i] = spawn.X;
+		m_PositionY[i] = spawn.Y;
+		m_PositionZ[i] = spawn.Z;
+		m_VelocityX[i] = spawn.VelocityX;
+		m_VelocityY[i] = spawn.VelocityY;
+		m_VelocityZ[i] = spawn.VelocityZ;
+		m_Age[i] = 0.f;
+		m_Lifetime[i] = spawn.Lifetime;
+		m_Size[i] = spawn.Size;
+		m_Gravity[i] = spawn.Gravity;
+		m_Drag[i] = spawn.Drag;
+		m_Sprite[i] = spawn.Sprite;
+		m_FrameCount[i] = std::max<uint16_t>(spawn.FrameCount, 1);
+		m_Color[i] = spawn.Color;
+		return true;
+	}
+
+	void ParticlePool::Update(float deltaSeconds)
+	{
+		const detail::ParticleStreams streams{m_PositionX.data(),
+											  m_PositionY.data(),
+											  m_PositionZ.data(),
+											  m_VelocityX.data(),
+											  m_VelocityY.data(),
+											  m_VelocityZ.data(),
+											  m_Age.data(),
+											  m_Gravity.data(),
+											  m_Drag.data()};
+
+		size_t first = 0;
+		if (UseAvx())
+			first = detail::IntegrateParticlesAvx(streams, m_Count, deltaSeconds);
+#if defined(ONION_PARTICLE_POOL_SSE)
+		else
+			first = IntegrateParticlesSse(streams, m_Count, deltaSeconds);
+#endif
+
+		// Remaining particles, or all of them without SIMD
+		IntegrateScalar(deltaSeconds, first);
+
+		RemoveExpired();
+	}
+
+	void ParticlePool::Clear()
+	{
+		m_Count = 0;
+	}
+
+	const char* ParticlePool::GetInstructionSet()
+	{
+		if (UseAvx())
+			return "AVX";
+
+#if defined(ONION_PARTICLE_POOL_SSE)
+		return "SSE";
+#else
+		return "scalar";
+#endif
+	}
+
+	// -------- Private --------
+
+	void ParticlePool::IntegrateScalar(float deltaSeconds, size_t first)
+	{
+		for (size_t i = first; i < m_Count; i++)
+		{
+			const float keep = std::max(1.f - m_Drag[i] * deltaSeconds, 0.f);
+
+			m_VelocityX[i] *= keep;
+			m_VelocityY[i] = (m_VelocityY[i] - m_Gravity[i] * deltaSeconds) * keep;
+			m_VelocityZ[i] *= keep;
+
+			m_PositionX[i] += m_VelocityX[i] * deltaSeconds;
+			m_PositionY[i] += m_VelocityY[i] * deltaSeconds;
+			m_PositionZ[i] += m_VelocityZ[i] * deltaSeconds;
+			m_Age[i] += deltaSeconds;
+		}
+	}
+
+	void ParticlePool::RemoveExpired()
+	{
+		size_t i = 0;
+		while (i < m_Count)
+		{
+			if (m_Age[i] < m_Lifetime[i])
+			{
+				i++;
+				continue;
+			}
+
+			// The last particle takes the place, it is tested next
+			const size_t last = --m_Count;
+			m_PositionX[i] = m_PositionX[last];
+			m_PositionY[i] = m_PositionY[last];
+			m_PositionZ[i] = m_PositionZ[last];
+			m_VelocityX[i] = m_VelocityX[last];
+			m_VelocityY[i] = m_VelocityY[last];
+			m_VelocityZ[i] = m_VelocityZ[last];
+			m_Age[i] = m_Age[last];
+			m_Lifetime[i] = m_Lifetime[last];
+			m_Size[i] = m_Size[last];
+			m_Gravity[i] = m_Gravity[last];
+			m_Drag[i] = m_Drag[last];
+			m_Sprite[i] = m_Sprite[last];
+			m_FrameCount[i] = m_FrameCount[last];
+			m_Color[i] = m_Color[last];
+		}
+	}
+} // namespace onion::voxel
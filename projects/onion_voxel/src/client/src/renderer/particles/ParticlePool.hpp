@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace onion::voxel
+{
+	struct ParticleSpawn
+	{
+		float X = 0.f; // Center, in blocks
+		float Y = 0.f;
+		float Z = 0.f;
+		float VelocityX = 0.f; // Blocks per second
+		float VelocityY = 0.f;
+		float VelocityZ = 0.f;
+		float Lifetime = 1.f;		 // Seconds
+		float Size = 0.1f;			 // Side of the quad, in blocks
+		float Gravity = 0.f;		 // Blocks per second squared, negative rises (smoke)
+		float Drag = 0.f;			 // Fraction of the velocity lost per second, in [0, 1]
+		uint32_t Sprite = 0;		 // First sprite, see ParticleSystem
+		uint16_t FrameCount = 1;	 // Sprites played in order over the lifetime, from Sprite
+		uint32_t Color = 0xFFFFFFFF; // RGBA8, multiplies the sprite
+	};
+
+	/// @brief Particles simulated on the CPU, one array per field, with a fixed capacity.
+	///
+	/// Every array is allocated once, at the capacity : emitting never allocates, and a full pool drops the new
+	/// particles. Living particles are kept dense in [0, GetCount()), an expired particle is replaced by the last
+	/// one. The integration streams through the arrays 8 particles (AVX, when the CPU has it) or 4 particles (SSE) at
+	/// a time, builds without x86 SIMD fall back to one particle at a time.
+	class ParticlePool
+	{
+	  public:
+		explicit ParticlePool(size_t capacity);
+
+		/// @return False when the pool is full, the particle is dropped.
+		bool Emit(const ParticleSpawn& spawn);
+
+		/// @brief Applies gravity and drag, moves the particles, then removes the expired ones.
+		void Update(float deltaSeconds);
+		void Clear();
+
+		size_t GetCount() const { return m_Count; }
+		size_t GetCapacity() const { return m_Capacity; }
+		/// @brief Particles dropped by a full pool since the start.
+		uint64_t GetDroppedCount() const { return m_DroppedCount; }
+
+		// GetCount() values each
+		const float* GetPositionX() const { return m_PositionX.data(); }
+		const float* GetPositionY() const { return m_PositionY.data(); }
+		const float* GetPositionZ() const { return m_PositionZ.data(); }
+		const float* GetAge() const { return m_Age.data(); } // Seconds since emitted
+		const float* GetLifetime() const { return m_Lifetime.data(); }
+		const float* GetSize() const { return m_Size.data(); }
+		const uint32_t* GetSprite() const { return m_Sprite.data(); }
+		const uint16_t* GetFrameCount() const { return m_FrameCount.data(); }
+		const uint32_t* GetColor() const { return m_Color.data(); }
+
+		/// @brief Name of the instruction set used by Update(), for the stats.
+		static const char* GetInstructionSet();
+
+	  private:
+		void IntegrateScalar(float deltaSeconds, size_t first);
+		void RemoveExpired();
+
+	  private:
+		size_t m_Capacity;
+		size_t m_Count = 0;
+		uint64_t m_DroppedCount = 0;
+
+		std::vector<float> m_PositionX;
+		std::vector<float> m_PositionY;
+		std::vector<float> m_PositionZ;
+		std::vector<float> m_VelocityX;
+		std::vector<float> m_VelocityY;
+		std::vector<float> m_VelocityZ;
+		std::vector<float> m_Age;
+		std::vector<float> m_Lifetime;
+		std::vector<float> m_Size;
+		std::vector<float> m_Gravity;
+		std::vector<float> m_Drag;
+		std::vector<uint32_t> m_Sprite;
+		std::vector<uint16_t> m_FrameCount;
+		std::vector<uint32_t> m_Color;
+	};
+
+	namespace detail
+	{
+		/// @brief The arrays integrated by ParticlePool::Update().
+		struct ParticleStreams
+		{
+			float* PositionX;
+			float* PositionY;
+			float* PositionZ;
+			float* VelocityX;
+			float* VelocityY;
+			float* VelocityZ;
+			float* Age;
+			const float* Gravity;
+			const float* Drag;
+		};
+
+		/// @brief False when the compiler or the target can't build the AVX path.
+		bool HasAvxParticlePath();
+		/// @brief AVX path, in its own translation unit built with AVX enabled.
+		/// @return The number of particles integrated from the start, a multiple of 8.
+		size_t IntegrateParticlesAvx(const ParticleStreams& streams, size_t count, float deltaSeconds);
+	} // namespace detail
+} // namespace onion::voxel
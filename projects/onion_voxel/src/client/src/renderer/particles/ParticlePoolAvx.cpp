@@ -0,0 +1,68 @@
+// Built with AVX enabled (see CMakeLists.txt), only called after a runtime check of the CPU.
+// No standard library here : an inline function instantiated in this file could be picked by the linker for the
+// whole program, and crash on CPUs without AVX.
+
+#include "ParticlePool.hpp"
+
+#if defined(__AVX__)
+
+#include <immintrin.h>
+
+namespace onion::voxel
+{
+	bool detail::HasAvxParticlePath()
+	{
+		return true;
+	}
+
+	size_t detail::IntegrateParticlesAvx(const ParticleStreams& streams, size_t count, float deltaSeconds)
+	{
+		constexpr size_t Width = 8;
+		const __m256 dt = _mm256_set1_ps(deltaSeconds);
+		const __m256 one = _mm256_set1_ps(1.f);
+		const __m256 zero = _mm256_setzero_ps();
+
+		size_t first = 0;
+		for (; first + Width <= count; first += Width)
+		{
+			// Velocity kept over the step, clamped so a long frame stops the particle rather than reversing it
+			const __m256 keep =
+				_mm256_max_ps(_mm256_sub_ps(one, _mm256_mul_ps(_mm256_loadu_ps(streams.Drag + first), dt)), zero);
+			const __m256 fall = _mm256_mul_ps(_mm256_loadu_ps(streams.Gravity + first), dt);
+
+			const __m256 vx = _mm256_mul_ps(_mm256_loadu_ps(streams.VelocityX + first), keep);
+			const __m256 vy = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(streams.VelocityY + first), fall), keep);
+			const __m256 vz = _mm256_mul_ps(_mm256_loadu_ps(streams.VelocityZ + first), keep);
+
+			_mm256_storeu_ps(streams.VelocityX + first, vx);
+			_mm256_storeu_ps(streams.VelocityY + first, vy);
+			_mm256_storeu_ps(streams.VelocityZ + first, vz);
+			_mm256_storeu_ps(streams.PositionX + first,
+							 _mm256_add_ps(_mm256_loadu_ps(streams.PositionX + first), _mm256_mul_ps(vx, dt)));
+			_mm256_storeu_ps(streams.PositionY + first,
+							 _mm256_add_ps(_mm256_loadu_ps(streams.PositionY + first), _mm256_mul_ps(vy, dt)));
+			_mm256_storeu_ps(streams.PositionZ + first,
+							 _mm256_add_ps(_mm256_loadu_ps(streams.PositionZ + first), _mm256_mul_ps(vz, dt)));
+			_mm256_storeu_ps(streams.Age + first, _mm256_add_ps(_mm256_loadu_ps(streams.Age + first), dt));
+		}
+
+		return first;
+	}
+} // namespace onion::voxel
+
+#else
+
+namespace onion::voxel
+{
+	bool detail::HasAvxParticlePath()
+	{
+		return false;
+	}
+
+	size_t detail::IntegrateParticlesAvx(const ParticleStreams&, size_t, float)
+	{
+		return 0;
+	}
+} // namespace onion::voxel
+
+#endif
@@ -0,0 +1,295 @@
+#include "ParticleSystem.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "../Variables.hpp"
+#include "../gl_state/GLStateCache.hpp"
+#include "../render_queue/CommandBuffer.hpp"
+
+namespace onion::voxel
+{
+	namespace
+	{
+		constexpr int GenericFrames = 8;
+		constexpr int SmokeFrames = 12;
+		constexpr int DebrisPerAxis = 4;
+
+		constexpr float RainRadius = 24.f; // Blocks around the camera
+		constexpr float RainHeight = 20.f; // Above the camera
+		constexpr float RainSpeed = 20.f;  // Blocks per second
+
+		/// @brief RGBA8, red in the lowest byte : the byte order of a normalized GL_UNSIGNED_BYTE attribute.
+		uint32_t PackColor(float r, float g, float b, float a = 1.f)
+		{
+			auto channel = [](float value)
+			{ return static_cast<uint32_t>(std::clamp(value, 0.f, 1.f) * 255.f + 0.5f); };
+			return channel(r) | (channel(g) << 8) | (channel(b) << 16) | (channel(a) << 24);
+		}
+
+		std::vector<std::string> GetFramePaths(const std::string& prefix, int frameCount)
+		{
+			std::vector<std::string> paths;
+			for (int frame = 0; frame < frameCount; frame++)
+				paths.push_back(prefix + std::to_string(frame) + ".png");
+			return paths;
+		}
+	} // namespace
+
+	// Per-instance attributes, one ParticleInstance per particle
+	const VertexLayout ParticleSystem::s_InstanceLayout{
+		sizeof(ParticleInstance),
+		{{0, 4, GL_FLOAT, false, false, offsetof(ParticleInstance, X)},
+		 {1, 1, GL_UNSIGNED_INT, false, true, offsetof(ParticleInstance, Sprite)},
+		 {2, 4, GL_UNSIGNED_BYTE, true, false, offsetof(ParticleInstance, Color)}}};
+
+	// -------- Constructor --------
+
+	ParticleSystem::ParticleSystem(const BlockAppearanceTable& appearances)
+		: m_Appearances(appearances),
+		  m_Shader((GetAssetsPath() / "shaders/particle.vert").string().c_str(),
+				   (GetAssetsPath() / "shaders/particle.frag").string().c_str())
+	{
+		m_Instances.reserve(MaxParticles);
+
+		m_GenericSprite = AddSprites(GetFramePaths("minecraft/textures/particle/generic_", GenericFrames));
+		m_SmokeSprite = AddSprites(GetFramePaths("minecraft/textures/particle/big_smoke_", SmokeFrames));
+		m_BlockSprite = AddSprites(appearances.GetTexturePaths());
+	}
+
+	// -------- GL thread --------
+
+	void ParticleSystem::Initialize()
+	{
+		m_Atlas.Load();
+
+		glGenVertexArrays(1, &m_VAO);
+		GLStateCache::BindVertexArray(m_VAO);
+
+		// The pointers are set by the render queue at each draw, into the stream ring buffer (s_InstanceLayout)
+		for (const VertexAttribute& attribute : s_InstanceLayout.Attributes)
+		{
+			glEnableVertexAttribArray(attribute.Location);
+			glVertexAttribDivisor(attribute.Location, 1);
+		}
+
+		GLStateCache::BindVertexArray(0);
+
+		// Empty rectangles until the atlas is packed, the draw is skipped meanwhile anyway
+		const std::vector<float> rects(m_SpritePaths.size() * 4, 0.f);
+
+		glGenBuffers(1, &m_SpriteBuffer);
+		glBindBuffer(GL_TEXTURE_BUFFER, m_SpriteBuffer);
+		glBufferData(GL_TEXTURE_BUFFER, rects.size() * sizeof(float), rects.data(), GL_STATIC_DRAW);
+
+		glGenTextures(1, &m_SpriteTexture);
+		GLStateCache::BindTexture(GL_TEXTURE_BUFFER, m_SpriteTexture);
+		glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_SpriteBuffer);
+
+		GLStateCache::BindTexture(GL_TEXTURE_BUFFER, 0);
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+		m_Shader.Use();
+		m_Shader.setInt("uAtlas", 0);
+		m_Shader.setInt("uSprites", 1);
+	}
+
+	void ParticleSystem::Update()
+	{
+		// Binding packs the atlas once every image is decoded
+		if (m_SpriteTableFilled || !m_Atlas.Bind(0))
+			return;
+
+		std::vector<float> rects;
+		rects.reserve(m_SpritePaths.size() * 4);
+		for (const std::string& path : m_SpritePaths)
+		{
+			// A missing image draws nothing
+			const TextureAtlas::Region* region = m_Atlas.GetRegion(path);
+			if (region)
+				rects.insert(rects.end(), {region->u0, region->v0, region->u1, region->v1});
+			else
+				rects.insert(rects.end(), {0.f, 0.f, 0.f, 0.f});
+		}
+
+		glBindBuffer(GL_TEXTURE_BUFFER, m_SpriteBuffer);
+		glBufferSubData(GL_TEXTURE_BUFFER, 0, rects.size() * sizeof(float), rects.data());
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+		m_SpriteTableFilled = true;
+	}
+
+	void ParticleSystem::Delete()
+	{
+		GLStateCache::DeleteVertexArray(m_VAO);
+		GLStateCache::DeleteTexture(m_SpriteTexture);
+
+		if (m_SpriteBuffer)
+			glDeleteBuffers(1, &m_SpriteBuffer);
+
+		m_VAO = 0;
+		m_SpriteTexture = 0;
+		m_SpriteBuffer = 0;
+		m_SpriteTableFilled = false;
+
+		m_Atlas.Delete();
+		m_Shader.Delete();
+	}
+
+	// -------- World thread --------
+
+	void ParticleSystem::EmitBlockBreak(const BlockPos& block, BlockId id)
+	{
+		const BlockAppearance& appearance = m_Appearances.Get(id);
+		if (appearance.RenderLayer == BlockRenderLayer::None)
+			return;
+
+		const uint32_t sprite = m_BlockSprite + appearance.FaceLayers[static_cast<size_t>(BlockFace::PosX)];
+		std::uniform_real_distribution<float> unit(0.f, 1.f);
+		std::uniform_int_distribution<uint32_t> cell(0, 3);
+
+		for (int x = 0; x < DebrisPerAxis; x++)
+		{
+			for (int y = 0; y < DebrisPerAxis; y++)
+			{
+				for (int z = 0; z < DebrisPerAxis; z++)
+				{
+					// Thrown outwards from the center of the block, and a little up
+					const float offsetX = (x + 0.5f) / DebrisPerAxis - 0.5f;
+					const float offsetY = (y + 0.5f) / DebrisPerAxis - 0.5f;
+					const float offsetZ = (z + 0.5f) / DebrisPerAxis - 0.5f;
+
+					ParticleSpawn spawn;
+					spawn.X = block.x + 0.5f + offsetX;
+					spawn.Y = block.y + 0.5f + offsetY;
+					spawn.Z = block.z + 0.5f + offsetZ;
+					spawn.VelocityX = offsetX * 4.f + (unit(m_Random) - 0.5f);
+					spawn.VelocityY = offsetY * 4.f + unit(m_Random) * 2.f;
+					spawn.VelocityZ = offsetZ * 4.f + (unit(m_Random) - 0.5f);
+					spawn.Lifetime = 0.3f + unit(m_Random) * 1.2f;
+					spawn.Size = 0.1f + unit(m_Random) * 0.1f;
+					spawn.Gravity = 16.f;
+					spawn.Drag = 0.4f;
+					spawn.Sprite = sprite | SpriteQuarterBit | (cell(m_Random) << SpriteCellXShift) |
+						(cell(m_Random) << SpriteCellYShift);
+					spawn.Color = PackColor(0.6f, 0.6f, 0.6f);
+
+					if (!m_Pool.Emit(spawn))
+						return;
+				}
+			}
+		}
+	}
+
+	void ParticleSystem::EmitSmoke(const glm::vec3& position, int count)
+	{
+		std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+		for (int i = 0; i < count; i++)
+		{
+			const float shade = 0.3f + unit(m_Random) * 0.3f;
+
+			ParticleSpawn spawn;
+			spawn.X = position.x + (unit(m_Random) - 0.5f) * 0.5f;
+			spawn.Y = position.y + (unit(m_Random) - 0.5f) * 0.5f;
+			spawn.Z = position.z + (unit(m_Random) - 0.5f) * 0.5f;
+			spawn.VelocityX = (unit(m_Random) - 0.5f) * 0.4f;
+			spawn.VelocityY = 0.5f + unit(m_Random) * 0.5f;
+			spawn.VelocityZ = (unit(m_Random) - 0.5f) * 0.4f;
+			spawn.Lifetime = 1.5f + unit(m_Random) * 1.5f;
+			spawn.Size = 0.4f + unit(m_Random) * 0.4f;
+			spawn.Gravity = -0.5f;
+			spawn.Drag = 0.5f;
+			spawn.Sprite = m_SmokeSprite;
+			spawn.FrameCount = SmokeFrames;
+			spawn.Color = PackColor(shade, shade, shade);
+
+			if (!m_Pool.Emit(spawn))
+				return;
+		}
+	}
+
+	void ParticleSystem::Simulate(float deltaSeconds, const glm::vec3& cameraPosition)
+	{
+		m_Pool.Update(deltaSeconds);
+
+		// Whole drops only, the fraction is carried to the next frame
+		m_RainCarry += m_RainRate * deltaSeconds;
+		const int dropCount = static_cast<int>(m_RainCarry);
+		m_RainCarry -= static_cast<float>(dropCount);
+
+		std::uniform_real_distribution<float> horizontal(-RainRadius, RainRadius);
+		std::uniform_real_distribution<float> unit(0.f, 1.f);
+		for (int i = 0; i < dropCount; i++)
+		{
+			ParticleSpawn spawn;
+			spawn.X = cameraPosition.x + horizontal(m_Random);
+			spawn.Y = cameraPosition.y + RainHeight * unit(m_Random);
+			spawn.Z = cameraPosition.z + horizontal(m_Random);
+			spawn.VelocityY = -RainSpeed;
+			spawn.Lifetime = 2.f * RainHeight / RainSpeed;
+			spawn.Size = 0.08f;
+			spawn.Sprite = m_GenericSprite;
+			spawn.Color = PackColor(0.5f, 0.6f, 1.f);
+
+			if (!m_Pool.Emit(spawn))
+				break;
+		}
+	}
+
+	void ParticleSystem::Record(CommandBuffer& commandBuffer, const Camera& camera)
+	{
+		const size_t count = m_Pool.GetCount();
+		if (count == 0)
+			return;
+
+		const float* positionX = m_Pool.GetPositionX();
+		const float* positionY = m_Pool.GetPositionY();
+		const float* positionZ = m_Pool.GetPositionZ();
+		const float* age = m_Pool.GetAge();
+		const float* lifetime = m_Pool.GetLifetime();
+		const float* size = m_Pool.GetSize();
+		const uint32_t* sprite = m_Pool.GetSprite();
+		const uint16_t* frameCount = m_Pool.GetFrameCount();
+		const uint32_t* color = m_Pool.GetColor();
+
+		// Reserved at MaxParticles, the pool never holds more
+		m_Instances.resize(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			const uint32_t frame =
+				std::min(static_cast<uint32_t>(age[i] / lifetime[i] * frameCount[i]), frameCount[i] - 1u);
+			m_Instances[i] = {positionX[i], positionY[i], positionZ[i], size[i], sprite[i] + frame, color[i]};
+		}
+
+		// Cutout and depth tested like the terrain, drawn with the opaque meshes in any order
+		RenderState state;
+		const uint64_t sortKey =
+			SortKey::Make(RenderPass::Opaque, m_Shader.GetSortId(), SortKey::FromPointer(&m_Atlas), 1.f);
+		commandBuffer.Begin(sortKey, m_Shader, m_VAO, state);
+		commandBuffer.SetUniform("uViewProjection", camera.GetViewProjectionMatrix());
+		commandBuffer.SetUniform("uCameraRight", camera.GetRight());
+		commandBuffer.SetUniform("uCameraUp", camera.GetUp());
+		commandBuffer.BindTexture(0, m_Atlas);
+		commandBuffer.BindTexture(1, GL_TEXTURE_BUFFER, m_SpriteTexture);
+
+		commandBuffer.StreamVertices(s_InstanceLayout, m_Instances.data(), count * sizeof(ParticleInstance));
+
+		// 4 vertices per particle, the quad corners are generated from gl_VertexID in particle.vert
+		commandBuffer.DrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<uint32_t>(count));
+	}
+
+	// -------- Private --------
+
+	uint32_t ParticleSystem::AddSprites(const std::vector<std::string>& relativePaths)
+	{
+		const uint32_t first = static_cast<uint32_t>(m_SpritePaths.size());
+		for (const std::string& relativePath : relativePaths)
+		{
+			m_SpritePaths.push_back((GetAssetsPath() / relativePath).string());
+			m_Atlas.AddImage(m_SpritePaths.back());
+		}
+		return first;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <world/BlockId.hpp>
+#include <world/WorldCoordinates.hpp>
+
+#include "../buffers/VertexLayout.hpp"
+#include "../camera/Camera.hpp"
+#include "../shader/shader.hpp"
+#include "../texture/TextureAtlas.hpp"
+#include "../world/BlockAppearance.hpp"
+#include "ParticlePool.hpp"
+
+namespace onion::voxel
+{
+	class CommandBuffer;
+
+	/// @brief Particles of the world (block debris, smoke, rain), all drawn by a single instanced draw.
+	///
+	/// The particles live in a ParticlePool of fixed capacity, updated on the world thread. Each frame the living
+	/// particles are written as 24 byte instances into a scratch array sized once, and streamed with the draw into
+	/// the ring buffer of the render queue : particle.vert expands each instance into a quad facing the camera.
+	/// Sprites and block textures share one atlas, the rectangle of each sprite is read from a buffer texture.
+	/// Particles are cutout (alpha tested) and depth tested, they need no sorting.
+	class ParticleSystem
+	{
+	  public:
+		static constexpr size_t MaxParticles = 16384; // Past it, new particles are dropped
+
+		explicit ParticleSystem(const BlockAppearanceTable& appearances);
+
+		// ----- GL thread -----
+
+		/// @brief Starts decoding the sprites, creates the vertex array and the sprite table.
+		void Initialize();
+		/// @brief Fills the sprite table once the atlas is packed. Once per frame.
+		void Update();
+		void Delete();
+
+		// ----- World thread -----
+
+		/// @brief The 4 x 4 x 4 fragments of a broken block, each showing a piece of its side texture.
+		void EmitBlockBreak(const BlockPos& block, BlockId id);
+		/// @brief A puff of smoke rising from the position.
+		void EmitSmoke(const glm::vec3& position, int count);
+		/// @brief Drops per second falling around the camera, 0 stops the rain.
+		void SetRainRate(float dropsPerSecond) { m_RainRate = dropsPerSecond; }
+
+		/// @brief Moves the particles and spawns the rain around the camera.
+		void Simulate(float deltaSeconds, const glm::vec3& cameraPosition);
+		/// @brief Records the single draw of every particle.
+		void Record(CommandBuffer& commandBuffer, const Camera& camera);
+
+		const ParticlePool& GetPool() const { return m_Pool; }
+
+	  private:
+		// One per particle, expanded to a quad in particle.vert
+		struct ParticleInstance
+		{
+			float X, Y, Z;
+			float Size;
+			uint32_t Sprite; // Index in the sprite table, and the SpriteBits below
+			uint32_t Color;	 // RGBA8, normalized in the shader
+		};
+		static_assert(sizeof(ParticleInstance) == 24, "ParticleInstance must stay 24 bytes");
+
+		// Upper bits of a sprite : only a quarter of it is drawn, at (cell X, cell Y) in 4 x 4 cells (block debris)
+		static constexpr uint32_t SpriteQuarterBit = 1u << 16;
+		static constexpr uint32_t SpriteCellXShift = 17;
+		static constexpr uint32_t SpriteCellYShift = 19;
+
+		static const VertexLayout s_InstanceLayout;
+
+		/// @brief Adds the images to the atlas, in order.
+		/// @return The sprite of the first one.
+		uint32_t AddSprites(const std::vector<std::string>& relativePaths);
+
+	  private:
+		const BlockAppearanceTable& m_Appearances;
+
+		ParticlePool m_Pool{MaxParticles};
+		std::vector<ParticleInstance> m_Instances; // Scratch of the world thread, MaxParticles reserved
+
+		std::mt19937 m_Random{1234};
+		float m_RainRate = 0.f;
+		float m_RainCarry = 0.f; // Fraction of a drop left from the last frames
+
+		// Sprite table, the index of an image in the atlas being its sprite
+		TextureAtlas m_Atlas{"particles"};
+		std::vector<std::string> m_SpritePaths;
+		uint32_t m_GenericSprite = 0; // 8 frames
+		uint32_t m_SmokeSprite = 0;	  // 12 frames
+		uint32_t m_BlockSprite = 0;	  // Block textures, in texture array layer order
+
+		Shader m_Shader;
+		GLuint m_VAO = 0;
+		GLuint m_SpriteBuffer = 0;	// (u0, v0, u1, v1) per sprite
+		GLuint m_SpriteTexture = 0; // Buffer texture over m_SpriteBuffer
+		bool m_SpriteTableFilled = false;
+	};
+} // namespace onion::voxel
@@ -0,0 +1,236 @@
+#include "CommandBuffer.hpp"
+
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+#include <glm/gtc/type_ptr.hpp>
+
+namespace onion::voxel
+{
+	// -------- Frame --------
+
+	void CommandBuffer::Reset()
+	{
+		m_Commands.clear();
+		m_FrameUniforms.clear();
+		m_Uniforms.clear();
+		m_UniformData.clear();
+		m_Textures.clear();
+		m_StreamData.clear();
+		m_IndirectDraws.clear();
+
+		m_Sequence = 0;
+		m_IsRecording = false;
+	}
+
+	uint32_t CommandBuffer::NextSequence()
+	{
+		return m_Sequence++;
+	}
+
+	void CommandBuffer::SetFrameUniform(const Shader& shader, const char* name, const glm::mat4& value)
+	{
+		m_FrameUniforms.push_back({&shader, PushUniformData(name, UniformType::Mat4, glm::value_ptr(value), 16)});
+	}
+
+	// -------- Command Recording --------
+
+	void CommandBuffer::Begin(uint64_t sortKey, const Shader& shader, GLuint vertexArray, const RenderState& state)
+	{
+		assert(!m_IsRecording && "CommandBuffer::Begin() called twice without a Draw*() call");
+
+		RenderCommand command;
+		command.SortKey = sortKey;
+		command.Program = &shader;
+		command.VertexArray = vertexArray;
+		command.State = state;
+		command.UniformOffset = static_cast<uint32_t>(m_Uniforms.size());
+		command.TextureOffset = static_cast<uint32_t>(m_Textures.size());
+
+		m_Commands.push_back(command);
+		m_IsRecording = true;
+	}
+
+	void CommandBuffer::SetUniform(const char* name, int value)
+	{
+		float data = std::bit_cast<float>(value);
+		PushUniform(name, UniformType::Int, &data, 1);
+	}
+
+	void CommandBuffer::SetUniform(const char* name, float value)
+	{
+		PushUniform(name, UniformType::Float, &value, 1);
+	}
+
+	void CommandBuffer::SetUniform(const char* name, const glm::vec2& value)
+	{
+		PushUniform(name, UniformType::Vec2, glm::value_ptr(value), 2);
+	}
+
+	void CommandBuffer::SetUniform(const char* name, const glm::vec3& value)
+	{
+		PushUniform(name, UniformType::Vec3, glm::value_ptr(value), 3);
+	}
+
+	void CommandBuffer::SetUniform(const char* name, const glm::vec4& value)
+	{
+		PushUniform(name, UniformType::Vec4, glm::value_ptr(value), 4);
+	}
+
+	void CommandBuffer::SetUniform(const char* name, const glm::mat4& value)
+	{
+		PushUniform(name, UniformType::Mat4, glm::value_ptr(value), 16);
+	}
+
+	void CommandBuffer::BindTexture(uint8_t unit, const Texture& texture)
+	{
+		PushTexture({TextureSource::Texture, unit, GL_TEXTURE_2D, 0, &texture});
+	}
+
+	void CommandBuffer::BindTexture(uint8_t unit, const TextureArray& textureArray)
+	{
+		PushTexture({TextureSource::TextureArray, unit, GL_TEXTURE_2D_ARRAY, 0, &textureArray});
+	}
+
+	void CommandBuffer::BindTexture(uint8_t unit, const TextureAtlas& textureAtlas)
+	{
+		PushTexture({TextureSource::TextureAtlas, unit, GL_TEXTURE_2D, 0, &textureAtlas});
+	}
+
+	void CommandBuffer::BindTexture(uint8_t unit, GLenum target, GLuint textureID)
+	{
+		PushTexture({TextureSource::Raw, unit, target, textureID, nullptr});
+	}
+
+	void CommandBuffer::StreamVertices(const VertexLayout& layout, const void* data, size_t size)
+	{
+		RenderCommand& command = Current();
+		command.StreamLayout = &layout;
+		command.StreamOffset = static_cast<uint32_t>(m_StreamData.size());
+		command.StreamSize = static_cast<uint32_t>(size);
+
+		m_StreamData.resize(m_StreamData.size() + size);
+		std::memcpy(m_StreamData.data() + command.StreamOffset, data, size);
+	}
+
+	void CommandBuffer::DrawElements(GLenum primitive, uint32_t count)
+	{
+		RenderCommand& command = Current();
+		command.Type = DrawType::Elements;
+		command.Primitive = primitive;
+		command.Count = count;
+		m_IsRecording = false;
+	}
+
+	void CommandBuffer::DrawElementsBaseVertex(GLenum primitive, uint32_t count, int32_t baseVertex)
+	{
+		RenderCommand& command = Current();
+		command.Type = DrawType::ElementsBaseVertex;
+		command.Primitive = primitive;
+		command.Count = count;
+		command.BaseVertex = baseVertex;
+		m_IsRecording = false;
+	}
+
+	void CommandBuffer::MultiDrawElementsIndirect(GLenum primitive,
+												  const DrawElementsIndirectCommand* draws,
+												  uint32_t drawCount)
+	{
+		RenderCommand& command = Current();
+		command.Type = DrawType::MultiElementsIndirect;
+		command.Primitive = primitive;
+		command.First = static_cast<uint32_t>(m_IndirectDraws.size());
+		command.Count = drawCount;
+
+		m_IndirectDraws.insert(m_IndirectDraws.end(), draws, draws + drawCount);
+		m_IsRecording = false;
+	}
+
+	void CommandBuffer::DrawArrays(GLenum primitive, uint32_t first, uint32_t count)
+	{
+		RenderCommand& command = Current();
+		command.Type = DrawType::Arrays;
+		command.Primitive = primitive;
+		command.First = first;
+		command.Count = count;
+		m_IsRecording = false;
+	}
+
+	void CommandBuffer::DrawArraysInstanced(GLenum primitive, uint32_t first, uint32_t count, uint32_t instanceCount)
+	{
+		RenderCommand& command = Current();
+		command.Type = DrawType::ArraysInstanced;
+		command.Primitive = primitive;
+		command.First = first;
+		command.Count = count;
+		command.InstanceCount = instanceCount;
+		m_IsRecording = false;
+	}
+
+	// -------- Execution Side --------
+
+	const std::vector<RenderCommand>& CommandBuffer::GetCommands() const
+	{
+		return m_Commands;
+	}
+
+	const std::vector<CommandBuffer::FrameUniform>& CommandBuffer::GetFrameUniforms() const
+	{
+		return m_FrameUniforms;
+	}
+
+	const std::vector<UniformValue>& CommandBuffer::GetUniforms() const
+	{
+		return m_Uniforms;
+	}
+
+	const std::vector<float>& CommandBuffer::GetUniformData() const
+	{
+		return m_UniformData;
+	}
+
+	const std::vector<TextureBinding>& CommandBuffer::GetTextures() const
+	{
+		return m_Textures;
+	}
+
+	const std::vector<unsigned char>& CommandBuffer::GetStreamData() const
+	{
+		return m_StreamData;
+	}
+
+	const std::vector<DrawElementsIndirectCommand>& CommandBuffer::GetIndirectDraws() const
+	{
+		return m_IndirectDraws;
+	}
+
+	// -------- Private --------
+
+	UniformValue CommandBuffer::PushUniformData(const char* name, UniformType type, const float* data, size_t count)
+	{
+		UniformValue value{name, type, static_cast<uint32_t>(m_UniformData.size())};
+		m_UniformData.insert(m_UniformData.end(), data, data + count);
+		return value;
+	}
+
+	void CommandBuffer::PushUniform(const char* name, UniformType type, const float* data, size_t count)
+	{
+		RenderCommand& command = Current();
+		m_Uniforms.push_back(PushUniformData(name, type, data, count));
+		command.UniformCount++;
+	}
+
+	void CommandBuffer::PushTexture(const TextureBinding& binding)
+	{
+		RenderCommand& command = Current();
+		m_Textures.push_back(binding);
+		command.TextureCount++;
+	}
+
+	RenderCommand& CommandBuffer::Current()
+	{
+		assert(m_IsRecording && "CommandBuffer : no command being recorded, call Begin() first");
+		return m_Commands.back();
+	}
+} // namespace onion::voxel
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../buffers/VertexLayout.hpp"
+#include "../gl_state/GLExtensions.hpp"
+#include "RenderCommand.hpp"
+
+namespace onion::voxel
+{
+	class Texture;
+	class TextureArray;
+	class TextureAtlas;
+
+	/// @brief Draw commands recorded by a single thread for one frame. No OpenGL call is made while recording.
+	///
+	/// A command is built between Begin() and one of the Draw*() calls :
+	///	  commandBuffer.Begin(key, shader, vao, state);
+	///	  commandBuffer.SetUniform("uPos", position);
+	///	  commandBuffer.BindTexture(0, texture);
+	///	  commandBuffer.DrawElements(GL_TRIANGLES, 6);
+	class CommandBuffer
+	{
+	  public:
+		/// @brief Clears every command, the arenas keep their capacity from one frame to the next.
+		void Reset();
+
+		/// @brief Increasing counter for RenderPass::Gui keys.
+		uint32_t NextSequence();
+
+		/// @brief Uniform set once on the shader before any command of the frame is executed (projection...).
+		void SetFrameUniform(const Shader& shader, const char* name, const glm::mat4& value);
+
+		// ----- Command recording -----
+		void Begin(uint64_t sortKey, const Shader& shader, GLuint vertexArray, const RenderState& state = {});
+
+		void SetUniform(const char* name, int value);
+		void SetUniform(const char* name, float value);
+		void SetUniform(const char* name, const glm::vec2& value);
+		void SetUniform(const char* name, const glm::vec3& value);
+		void SetUniform(const char* name, const glm::vec4& value);
+		void SetUniform(const char* name, const glm::mat4& value);
+
+		/// @brief The command is skipped if a TextureArray or TextureAtlas isn't resident yet at execution time.
+		void BindTexture(uint8_t unit, const Texture& texture);
+		void BindTexture(uint8_t unit, const TextureArray& textureArray);
+		void BindTexture(uint8_t unit, const TextureAtlas& textureAtlas);
+		void BindTexture(uint8_t unit, GLenum target, GLuint textureID);
+
+		/// @brief Copies the vertices now. They are written into the stream ring buffer right before the draw, and the
+		/// attributes of the command VAO are pointed at them with the layout (which must outlive the frame).
+		void StreamVertices(const VertexLayout& layout, const void* data, size_t size);
+
+		void DrawElements(GLenum primitive, uint32_t count);
+		void DrawElementsBaseVertex(GLenum primitive, uint32_t count, int32_t baseVertex);
+		/// @brief Copies the draws now, they are written into the stream ring buffer right before the call. Only when
+		/// GLExtensions::HasMultiDrawIndirect(), the indices are GL_UNSIGNED_INT.
+		void MultiDrawElementsIndirect(GLenum primitive, const DrawElementsIndirectCommand* draws, uint32_t drawCount);
+		void DrawArrays(GLenum primitive, uint32_t first, uint32_t count);
+		void DrawArraysInstanced(GLenum primitive, uint32_t first, uint32_t count, uint32_t instanceCount);
+
+		// ----- Execution side -----
+		struct FrameUniform
+		{
+			const Shader* Program;
+			UniformValue Value;
+		};
+
+		const std::vector<RenderCommand>& GetCommands() const;
+		const std::vector<FrameUniform>& GetFrameUniforms() const;
+		const std::vector<UniformValue>& GetUniforms() const;
+		const std::vector<float>& GetUniformData() const;
+		const std::vector<TextureBinding>& GetTextures() const;
+		const std::vector<unsigned char>& GetStreamData() const;
+		const std::vector<DrawElementsIndirectCommand>& GetIndirectDraws() const;
+
+	  private:
+		UniformValue PushUniformData(const char* name, UniformType type, const float* data, size_t count);
+		void PushUniform(const char* name, UniformType type, const float* data, size_t count);
+		void PushTexture(const TextureBinding& binding);
+		RenderCommand& Current();
+
+	  private:
+		std::vector<RenderCommand> m_Commands;
+		std::vector<FrameUniform> m_FrameUniforms;
+
+		std::vector<UniformValue> m_Uniforms;
+		std::vector<float> m_UniformData;
+		std::vector<TextureBinding> m_Textures;
+		std::vector<unsigned char> m_StreamData;
+		std::vector<DrawElementsIndirectCommand> m_IndirectDraws;
+
+		uint32_t m_Sequence = 0;
+		bool m_IsRecording = false;
+	};
+} // namespace onion::voxel
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace onion::voxel
+{
+	class Shader;
+	struct VertexLayout;
+
+	enum class RenderPass : uint8_t
+	{
+		Opaque = 0,
+		Transparent = 1,
+		Gui = 2
+	};
+
+	/// @brief 64-bit keys, commands of a frame are executed in increasing key order.
+	/// Opaque : pass | shader | texture | depth, front to back to help early depth rejection.
+	/// Transparent : pass | depth, back to front for correct blending | shader | texture.
+	/// Gui : pass | sequence, elements are painted in the order they were recorded.
+	namespace SortKey
+	{
+		constexpr int PassShift = 60;
+
+		/// @brief Depth in [0, 1] quantized to 24 bits.
+		inline uint64_t QuantizeDepth(float depth)
+		{
+			return static_cast<uint64_t>(std::clamp(depth, 0.f, 1.f) * 16777215.f);
+		}
+
+		/// @brief 16-bit id of any object, only used to group commands sharing the same texture.
+		inline uint16_t FromPointer(const void* object)
+		{
+			uintptr_t value = reinterpret_cast<uintptr_t>(object);
+			return static_cast<uint16_t>((value >> 4) ^ (value >> 20));
+		}
+
+		inline uint64_t Make(RenderPass pass, uint16_t shaderId, uint16_t textureId, float depth)
+		{
+			uint64_t key = static_cast<uint64_t>(pass) << PassShift;
+			uint64_t shader = shaderId & 0xFFFu;
+			uint64_t depthBits = QuantizeDepth(depth);
+
+			if (pass == RenderPass::Transparent)
+				return key | ((0xFFFFFFu - depthBits) << 36) | (shader << 24) | (static_cast<uint64_t>(textureId) << 8);
+
+			return key | (shader << 48) | (static_cast<uint64_t>(textureId) << 32) | (depthBits << 8);
+		}
+
+		inline uint64_t MakeSequenced(RenderPass pass, uint32_t sequence)
+		{
+			return (static_cast<uint64_t>(pass) << PassShift) | sequence;
+		}
+	} // namespace SortKey
+
+	enum class UniformType : uint8_t
+	{
+		Int,
+		Float,
+		Vec2,
+		Vec3,
+		Vec4,
+		Mat4
+	};
+
+	struct UniformValue
+	{
+		const char* Name; // String literals only : the address keys the location cache of the shader
+		UniformType Type;
+		uint32_t DataOffset; // Into the uniform data of the command buffer
+	};
+
+	enum class TextureSource : uint8_t
+	{
+		Texture,
+		TextureArray,
+		TextureAtlas,
+		Raw
+	};
+
+	struct TextureBinding
+	{
+		TextureSource Source;
+		uint8_t Unit;
+		GLenum Target;		// Raw only
+		GLuint RawID;		// Raw only
+		const void* Object; // Texture, TextureArray or TextureAtlas, bound (and uploaded if needed) on the GL thread
+	};
+
+	enum class DrawType : uint8_t
+	{
+		Elements,
+		ElementsBaseVertex,
+		MultiElementsIndirect, // First and Count : range of the indirect commands of the command buffer
+		Arrays,
+		ArraysInstanced
+	};
+
+	struct RenderState
+	{
+		bool DepthTest = true;
+		bool Blend = false;	   // GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA
+		bool CullFace = false; // Back faces, counter-clockwise front faces
+	};
+
+	/// @brief One draw call and everything it needs, recorded on any thread and executed on the GL thread.
+	/// Uniforms, textures and streamed vertices live in the arenas of the command buffer that recorded it.
+	struct RenderCommand
+	{
+		uint64_t SortKey = 0;
+		const Shader* Program = nullptr;
+		GLuint VertexArray = 0;
+		RenderState State;
+
+		DrawType Type = DrawType::Arrays;
+		GLenum Primitive = GL_TRIANGLES;
+		uint32_t First = 0;
+		uint32_t Count = 0;
+		uint32_t InstanceCount = 1;
+		int32_t BaseVertex = 0;
+
+		uint32_t UniformOffset = 0;
+		uint32_t UniformCount = 0;
+		uint32_t TextureOffset = 0;
+		uint32_t TextureCount = 0;
+
+		// Vertices copied at record time, written into the stream ring buffer right before the draw
+		const VertexLayout* StreamLayout = nullptr;
+		uint32_t StreamOffset = 0;
+		uint32_t StreamSize = 0;
+	};
+} // namespace onion::voxel
@@ -0,0 +1,283 @@
+#include "RenderQueue.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include <glad/glad.h>
+
+#include "../gl_state/GLExtensions.hpp"
+#include "../gl_state/GLStateCache.hpp"
+#include "../shader/shader.hpp"
+#include "../texture/TextureArray.hpp"
+#include "../texture/TextureAtlas.hpp"
+#include "../texture/texture.hpp"
+
+namespace onion::voxel
+{
+	// -------- Render Frame --------
+
+	CommandBuffer& RenderFrame::AcquireCommandBuffer()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (m_UsedCommandBuffers == m_CommandBuffers.size())
+			m_CommandBuffers.push_back(std::make_unique<CommandBuffer>());
+
+		return *m_CommandBuffers[m_UsedCommandBuffers++];
+	}
+
+	void RenderFrame::Reset()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		for (size_t i = 0; i < m_UsedCommandBuffers; i++)
+			m_CommandBuffers[i]->Reset();
+
+		m_UsedCommandBuffers = 0;
+		m_SortedCommands.clear();
+	}
+
+	void RenderFrame::Sort()
+	{
+		m_SortedCommands.clear();
+
+		for (size_t buffer = 0; buffer < m_UsedCommandBuffers; buffer++)
+		{
+			const std::vector<RenderCommand>& commands = m_CommandBuffers[buffer]->GetCommands();
+			for (size_t command = 0; command < commands.size(); command++)
+			{
+				m_SortedCommands.push_back(
+					{commands[command].SortKey, static_cast<uint32_t>(buffer), static_cast<uint32_t>(command)});
+			}
+		}
+
+		// Ties keep the recording order
+		std::sort(m_SortedCommands.begin(),
+				  m_SortedCommands.end(),
+				  [](const SortEntry& a, const SortEntry& b)
+				  {
+					  if (a.Key != b.Key)
+						  return a.Key < b.Key;
+					  if (a.Buffer != b.Buffer)
+						  return a.Buffer < b.Buffer;
+					  return a.Command < b.Command;
+				  });
+	}
+
+	// -------- Render Queue --------
+
+	RenderQueue::RenderQueue() {}
+
+	void RenderQueue::Initialize()
+	{
+		m_StreamBuffer.Initialize();
+	}
+
+	void RenderQueue::Delete()
+	{
+		m_StreamBuffer.Delete();
+	}
+
+	RenderFrame& RenderQueue::BeginFrame()
+	{
+		RenderFrame& frame = m_Frames[m_BackIndex];
+		frame.Reset();
+		return frame;
+	}
+
+	void RenderQueue::Publish()
+	{
+		uint8_t previous = m_ReadyIndex.exchange(static_cast<uint8_t>(m_BackIndex) | s_NewFrameFlag);
+		m_BackIndex = previous & s_IndexMask;
+	}
+
+	bool RenderQueue::Execute()
+	{
+		// Pick up the latest frame if the logic thread published one since last time
+		if (m_ReadyIndex.load(std::memory_order_relaxed) & s_NewFrameFlag)
+		{
+			uint8_t previous = m_ReadyIndex.exchange(static_cast<uint8_t>(m_FrontIndex));
+			m_FrontIndex = previous & s_IndexMask;
+			m_HasFrontFrame = true;
+			m_PickedUpFrameCount++;
+
+			m_Frames[m_FrontIndex].Sort();
+		}
+
+		m_ExecutedCommandCount = 0;
+		if (!m_HasFrontFrame)
+			return false;
+
+		RenderFrame& frame = m_Frames[m_FrontIndex];
+		m_StreamBuffer.BeginFrame();
+
+		for (size_t i = 0; i < frame.m_UsedCommandBuffers; i++)
+		{
+			const CommandBuffer& commandBuffer = *frame.m_CommandBuffers[i];
+			for (const CommandBuffer::FrameUniform& frameUniform : commandBuffer.GetFrameUniforms())
+			{
+				frameUniform.Program->Use();
+				ApplyUniform(*frameUniform.Program, frameUniform.Value, commandBuffer.GetUniformData().data());
+			}
+		}
+
+		for (const RenderFrame::SortEntry& entry : frame.m_SortedCommands)
+		{
+			const CommandBuffer& commandBuffer = *frame.m_CommandBuffers[entry.Buffer];
+			ExecuteCommand(commandBuffer, commandBuffer.GetCommands()[entry.Command]);
+		}
+
+		m_StreamBuffer.EndFrame();
+		return true;
+	}
+
+	size_t RenderQueue::GetExecutedCommandCount() const
+	{
+		return m_ExecutedCommandCount;
+	}
+
+	uint64_t RenderQueue::GetPickedUpFrameCount() const
+	{
+		return m_PickedUpFrameCount;
+	}
+
+	const StreamRingBuffer& RenderQueue::GetStreamBuffer() const
+	{
+		return m_StreamBuffer;
+	}
+
+	// -------- Execution --------
+
+	void RenderQueue::ExecuteCommand(const CommandBuffer& commandBuffer, const RenderCommand& command)
+	{
+		// Textures first : a texture array or atlas still decoding skips the whole command
+		const TextureBinding* textures = commandBuffer.GetTextures().data() + command.TextureOffset;
+		for (uint32_t i = 0; i < command.TextureCount; i++)
+		{
+			if (!BindTexture(textures[i]))
+				return;
+		}
+
+		GLStateCache::SetEnabled(GL_DEPTH_TEST, command.State.DepthTest);
+		GLStateCache::SetEnabled(GL_BLEND, command.State.Blend);
+		GLStateCache::SetEnabled(GL_CULL_FACE, command.State.CullFace);
+		if (command.State.Blend)
+			GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		command.Program->Use();
+
+		const UniformValue* uniforms = commandBuffer.GetUniforms().data() + command.UniformOffset;
+		for (uint32_t i = 0; i < command.UniformCount; i++)
+		{
+			ApplyUniform(*command.Program, uniforms[i], commandBuffer.GetUniformData().data());
+		}
+
+		GLStateCache::BindVertexArray(command.VertexArray);
+
+		if (command.StreamSize > 0)
+		{
+			StreamRingBuffer::Allocation allocation = m_StreamBuffer.Allocate(command.StreamSize);
+			if (!allocation.IsValid())
+				return; // Ring full, it grows on the next frame
+
+			const unsigned char* vertices = commandBuffer.GetStreamData().data() + command.StreamOffset;
+			std::memcpy(allocation.Data, vertices, command.StreamSize);
+			m_StreamBuffer.Commit(allocation);
+
+			glBindBuffer(GL_ARRAY_BUFFER, m_StreamBuffer.GetBufferID());
+			command.StreamLayout->Apply(allocation.Offset);
+		}
+
+		switch (command.Type)
+		{
+			case DrawType::Elements:
+				glDrawElements(command.Primitive, static_cast<GLsizei>(command.Count), GL_UNSIGNED_INT, nullptr);
+				break;
+			case DrawType::ElementsBaseVertex:
+				glDrawElementsBaseVertex(command.Primitive,
+										 static_cast<GLsizei>(command.Count),
+										 GL_UNSIGNED_INT,
+										 nullptr,
+										 command.BaseVertex);
+				break;
+			case DrawType::MultiElementsIndirect:
+			{
+				const size_t size = command.Count * sizeof(DrawElementsIndirectCommand);
+				StreamRingBuffer::Allocation allocation = m_StreamBuffer.Allocate(size);
+				if (!allocation.IsValid())
+					return; // Ring full, it grows on the next frame
+
+				std::memcpy(allocation.Data, commandBuffer.GetIndirectDraws().data() + command.First, size);
+				m_StreamBuffer.Commit(allocation);
+
+				glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_StreamBuffer.GetBufferID());
+				GLExtensions::MultiDrawElementsIndirect(command.Primitive,
+														GL_UNSIGNED_INT,
+														allocation.Offset,
+														static_cast<GLsizei>(command.Count));
+				break;
+			}
+			case DrawType::Arrays:
+				glDrawArrays(command.Primitive, static_cast<GLint>(command.First), static_cast<GLsizei>(command.Count));
+				break;
+			case DrawType::ArraysInstanced:
+				glDrawArraysInstanced(command.Primitive,
+									  static_cast<GLint>(command.First),
+									  static_cast<GLsizei>(command.Count),
+									  static_cast<GLsizei>(command.InstanceCount));
+				break;
+		}
+
+		m_ExecutedCommandCount++;
+	}
+
+	bool RenderQueue::BindTexture(const TextureBinding& binding)
+	{
+		switch (binding.Source)
+		{
+			case TextureSource::Texture:
+				// Falls back to the placeholder while not resident
+				static_cast<const Texture*>(binding.Object)->Bind(binding.Unit);
+				return true;
+			case TextureSource::TextureArray:
+				return static_cast<const TextureArray*>(binding.Object)->Bind(binding.Unit);
+			case TextureSource::TextureAtlas:
+				return static_cast<const TextureAtlas*>(binding.Object)->Bind(binding.Unit);
+			case TextureSource::Raw:
+				GLStateCache::BindTexture(binding.Unit, binding.Target, binding.RawID);
+				return true;
+		}
+
+		return false;
+	}
+
+	void RenderQueue::ApplyUniform(const Shader& shader, const UniformValue& uniform, const float* data)
+	{
+		// Cached per program by the address of the name, no string built per draw
+		GLint location = shader.GetUniformLocation(uniform.Name);
+		const float* value = data + uniform.DataOffset;
+
+		switch (uniform.Type)
+		{
+			case UniformType::Int:
+				glUniform1i(location, std::bit_cast<int>(value[0]));
+				break;
+			case UniformType::Float:
+				glUniform1f(location, value[0]);
+				break;
+			case UniformType::Vec2:
+				glUniform2fv(location, 1, value);
+				break;
+			case UniformType::Vec3:
+				glUniform3fv(location, 1, value);
+				break;
+			case UniformType::Vec4:
+				glUniform4fv(location, 1, value);
+				break;
+			case UniformType::Mat4:
+				glUniformMatrix4fv(location, 1, GL_FALSE, value);
+				break;
+		}
+	}
+} // namespace onion::voxel
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../buffers/StreamRingBuffer.hpp"
+#include "CommandBuffer.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Every command buffer recorded for one frame.
+	class RenderFrame
+	{
+	  public:
+		/// @brief Gives a command buffer to the calling thread. Thread safe, one buffer per recording thread.
+		CommandBuffer& AcquireCommandBuffer();
+
+	  private:
+		friend class RenderQueue;
+
+		void Reset();
+		void Sort();
+
+		struct SortEntry
+		{
+			uint64_t Key;
+			uint32_t Buffer;
+			uint32_t Command;
+		};
+
+		std::mutex m_Mutex;
+		std::vector<std::unique_ptr<CommandBuffer>> m_CommandBuffers;
+		size_t m_UsedCommandBuffers = 0;
+
+		std::vector<SortEntry> m_SortedCommands;
+	};
+
+	/// @brief Hands frames from the logic thread to the GL thread through a triple buffer, neither of them ever waits.
+	/// The logic thread records into the back frame and publishes it. The GL thread picks the latest published frame,
+	/// sorts it once, and executes it again every frame until a newer one is published.
+	class RenderQueue
+	{
+	  public:
+		RenderQueue();
+
+		// ----- GL thread, around the queue lifetime -----
+		void Initialize();
+		void Delete();
+
+		// ----- Logic thread -----
+
+		/// @brief Returns the cleared back frame to record into.
+		RenderFrame& BeginFrame();
+		/// @brief Makes the back frame the latest one, a frame the GL thread didn't pick up yet is dropped.
+		void Publish();
+
+		// ----- GL thread -----
+
+		/// @brief Executes the latest published frame, sorted by key.
+		/// @return False when no frame has been published yet.
+		bool Execute();
+
+		/// @brief Number of commands executed by the last Execute().
+		size_t GetExecutedCommandCount() const;
+
+		/// @brief Number of published frames picked up so far. Once it moved 3 past a point in time, every frame still
+		/// executed was recorded after that point : GL objects released then are no longer referenced.
+		uint64_t GetPickedUpFrameCount() const;
+
+		const StreamRingBuffer& GetStreamBuffer() const;
+
+	  private:
+		void ExecuteCommand(const CommandBuffer& commandBuffer, const RenderCommand& command);
+		static bool BindTexture(const TextureBinding& binding);
+		static void ApplyUniform(const Shader& shader, const UniformValue& uniform, const float* data);
+
+	  private:
+		static constexpr uint8_t s_IndexMask = 0x3;
+		static constexpr uint8_t s_NewFrameFlag = 0x4;
+
+		std::array<RenderFrame, 3> m_Frames;
+
+		int m_BackIndex = 0;					 // Owned by the logic thread
+		int m_FrontIndex = 1;					 // Owned by the GL thread
+		std::atomic<uint8_t> m_ReadyIndex{2};	 // Exchanged between both, with s_NewFrameFlag when not picked up yet
+		bool m_HasFrontFrame = false;
+
+		size_t m_ExecutedCommandCount = 0;
+		uint64_t m_PickedUpFrameCount = 0;
+
+		// Streamed vertices of every command, 3 frames in flight
+		StreamRingBuffer m_StreamBuffer;
+	};
+} // namespace onion::voxel
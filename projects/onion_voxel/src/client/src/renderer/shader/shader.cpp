@@ -1,15 +1,20 @@
 #include "shader.hpp"
 
+#include <atomic>
 #include <fstream>
 #include <glad/glad.h>
 #include <iostream>
 #include <sstream>
 
+#include "../gl_state/GLStateCache.hpp"
+
 using namespace onion::voxel;
 
 Shader::Shader(const char* vertexPath, const char* fragmentPath)
 	: m_FragmentPath(fragmentPath), m_VertexPath(vertexPath)
 {
+	static std::atomic<uint16_t> s_NextSortId{0};
+	m_SortId = s_NextSortId.fetch_add(1);
 }
 
 Shader& Shader::operator=(Shader&& other) noexcept
@@ -19,6 +24,9 @@ Shader& Shader::operator=(Shader&& other) noexcept
 		m_ProgramID = other.m_ProgramID; // Transfer ownership
 		other.m_ProgramID = 0;			 // Reset the moved-from object
 		m_HasBeenCompiled = other.m_HasBeenCompiled;
+		m_UniformLocations = std::move(other.m_UniformLocations);
+		m_LiteralUniformLocations = std::move(other.m_LiteralUniformLocations);
+		m_SortId = other.m_SortId;
 	}
 	return *this;
 }
@@ -115,6 +123,8 @@ void Shader::Compile() const
 	glDeleteShader(vertex);
 	glDeleteShader(fragment);
 
+	m_UniformLocations.clear();
+	m_LiteralUniformLocations.clear();
 	m_HasBeenCompiled = true; // Mark shader as compiled
 }
 
@@ -132,61 +142,97 @@ void Shader::Use() const
 	{
 		Compile();
 	}
-	glUseProgram(m_ProgramID);
+	GLStateCache::UseProgram(m_ProgramID);
 }
 
 void Shader::Delete()
 {
-	glDeleteProgram(m_ProgramID);
+	GLStateCache::DeleteProgram(m_ProgramID);
 	m_ProgramID = 0;
+	m_UniformLocations.clear();
+	m_LiteralUniformLocations.clear();
+}
+
+int Shader::GetUniformLocation(const std::string& name) const
+{
+	auto it = m_UniformLocations.find(name);
+	if (it != m_UniformLocations.end())
+		return it->second;
+
+	int location = glGetUniformLocation(m_ProgramID, name.c_str());
+	m_UniformLocations.emplace(name, location);
+	return location;
+}
+
+int Shader::GetUniformLocation(const char* name) const
+{
+	for (const auto& [literal, location] : m_LiteralUniformLocations)
+	{
+		if (literal == name)
+			return location;
+	}
+
+	int location = glGetUniformLocation(m_ProgramID, name);
+	m_LiteralUniformLocations.emplace_back(name, location);
+	return location;
 }
 
 void Shader::setBool(const std::string& name, bool value) const
 {
-	glUniform1i(glGetUniformLocation(m_ProgramID, name.c_str()), (int) value);
+	glUniform1i(GetUniformLocation(name), (int) value);
 }
 
 void Shader::setInt(const std::string& name, int value) const
 {
-	glUniform1i(glGetUniformLocation(m_ProgramID, name.c_str()), value);
+	glUniform1i(GetUniformLocation(name), value);
 }
 
 void Shader::setFloat(const std::string& name, float value) const
 {
-	glUniform1f(glGetUniformLocation(m_ProgramID, name.c_str()), value);
+	glUniform1f(GetUniformLocation(name), value);
 }
 
 void Shader::setVec2(const std::string& name, const glm::vec2& value) const
 {
-	glUniform2fv(glGetUniformLocation(m_ProgramID, name.c_str()), 1, &value[0]);
+	glUniform2fv(GetUniformLocation(name), 1, &value[0]);
 }
 
 void Shader::setVec2(const std::string& name, float x, float y) const
 {
-	glUniform2f(glGetUniformLocation(m_ProgramID, name.c_str()), x, y);
+	glUniform2f(GetUniformLocation(name), x, y);
 }
 
 void Shader::setVec3(const std::string& name, const glm::vec3& value) const
 {
-	glUniform3fv(glGetUniformLocation(m_ProgramID, name.c_str()), 1, &value[0]);
+	glUniform3fv(GetUniformLocation(name), 1, &value[0]);
 }
 
 void Shader::setVec3(const std::string& name, float x, float y, float z) const
 {
-	glUniform3f(glGetUniformLocation(m_ProgramID, name.c_str()), x, y, z);
+	glUniform3f(GetUniformLocation(name), x, y, z);
+}
+
+void Shader::setVec4(const std::string& name, const glm::vec4& value) const
+{
+	glUniform4fv(GetUniformLocation(name), 1, &value[0]);
+}
+
+void Shader::setVec4(const std::string& name, float x, float y, float z, float w) const
+{
+	glUniform4f(GetUniformLocation(name), x, y, z, w);
 }
 
 void Shader::setMat2(const std::string& name, const glm::mat2& mat) const
 {
-	glUniformMatrix2fv(glGetUniformLocation(m_ProgramID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+	glUniformMatrix2fv(GetUniformLocation(name), 1, GL_FALSE, &mat[0][0]);
 }
 
 void Shader::setMat3(const std::string& name, const glm::mat3& mat) const
 {
-	glUniformMatrix3fv(glGetUniformLocation(m_ProgramID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+	glUniformMatrix3fv(GetUniformLocation(name), 1, GL_FALSE, &mat[0][0]);
 }
 
 void Shader::setMat4(const std::string& name, const glm::mat4& mat) const
 {
-	glUniformMatrix4fv(glGetUniformLocation(m_ProgramID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+	glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &mat[0][0]);
 }
@@ -1,7 +1,11 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace onion::voxel
 {
@@ -17,10 +21,12 @@ namespace onion::voxel
 		Shader& operator=(const Shader&) = delete;
 
 		// Implement move constructor
-		Shader(Shader&& other) noexcept : m_ProgramID(other.m_ProgramID)
+		Shader(Shader&& other) noexcept : m_ProgramID(other.m_ProgramID), m_SortId(other.m_SortId)
 		{
 			other.m_ProgramID = 0;
 			m_HasBeenCompiled = other.m_HasBeenCompiled;
+			m_UniformLocations = std::move(other.m_UniformLocations);
+			m_LiteralUniformLocations = std::move(other.m_LiteralUniformLocations);
 		}
 		// Implement move assignment
 		Shader& operator=(Shader&& other) noexcept;
@@ -31,6 +37,15 @@ namespace onion::voxel
 		void Use() const;
 		void Delete();
 
+		// Looked up once per name, then served from a cache
+		int GetUniformLocation(const std::string& name) const;
+		// Same, cached by the address of the name : no string is built. For names living as long as the program
+		// (string literals), like the uniforms recorded by the render queue
+		int GetUniformLocation(const char* name) const;
+
+		// Small id grouping the draw commands of a same shader in the render queue sort keys
+		uint16_t GetSortId() const { return m_SortId; }
+
 		void setBool(const std::string& name, bool value) const;
 		void setInt(const std::string& name, int value) const;
 		void setFloat(const std::string& name, float value) const;
@@ -38,6 +53,8 @@ namespace onion::voxel
 		void setVec2(const std::string& name, float x, float y) const;
 		void setVec3(const std::string& name, const glm::vec3& value) const;
 		void setVec3(const std::string& name, float x, float y, float z) const;
+		void setVec4(const std::string& name, const glm::vec4& value) const;
+		void setVec4(const std::string& name, float x, float y, float z, float w) const;
 		void setMat2(const std::string& name, const glm::mat2& mat) const;
 		void setMat3(const std::string& name, const glm::mat3& mat) const;
 		void setMat4(const std::string& name, const glm::mat4& mat) const;
@@ -45,6 +62,9 @@ namespace onion::voxel
 	  private:
 		mutable unsigned int m_ProgramID = 0;
 		mutable bool m_HasBeenCompiled = false;
+		mutable std::unordered_map<std::string, int> m_UniformLocations;
+		mutable std::vector<std::pair<const char*, int>> m_LiteralUniformLocations; // A few per program, scanned
+		uint16_t m_SortId = 0;
 		std::string m_VertexPath;
 		std::string m_FragmentPath;
 	};
@@ -0,0 +1,112 @@
+#include "RectanglePacker.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace onion::voxel
+{
+	RectanglePacker::RectanglePacker(int width, int height)
+	{
+		Reset(width, height);
+	}
+
+	void RectanglePacker::Reset(int width, int height)
+	{
+		m_Width = width;
+		m_Height = height;
+
+		m_Skyline.clear();
+		m_Skyline.push_back({0, 0, width});
+	}
+
+	std::optional<RectanglePacker::Rect> RectanglePacker::Pack(int width, int height)
+	{
+		int bestY = std::numeric_limits<int>::max();
+		int bestWidth = std::numeric_limits<int>::max();
+		size_t bestIndex = m_Skyline.size();
+
+		// Lowest resting position, ties broken by the narrowest node to keep the skyline flat
+		for (size_t i = 0; i < m_Skyline.size(); i++)
+		{
+			int y = Fit(i, width, height);
+			if (y < 0)
+				continue;
+
+			if (y < bestY || (y == bestY && m_Skyline[i].Width < bestWidth))
+			{
+				bestY = y;
+				bestWidth = m_Skyline[i].Width;
+				bestIndex = i;
+			}
+		}
+
+		if (bestIndex == m_Skyline.size())
+			return std::nullopt;
+
+		Rect rect{m_Skyline[bestIndex].X, bestY, width, height};
+		AddSkylineLevel(bestIndex, rect);
+		return rect;
+	}
+
+	int RectanglePacker::Fit(size_t nodeIndex, int width, int height) const
+	{
+		int x = m_Skyline[nodeIndex].X;
+		if (x + width > m_Width)
+			return -1;
+
+		int y = m_Skyline[nodeIndex].Y;
+		int widthLeft = width;
+
+		for (size_t i = nodeIndex; widthLeft > 0; i++)
+		{
+			if (i >= m_Skyline.size())
+				return -1;
+
+			y = std::max(y, m_Skyline[i].Y);
+			if (y + height > m_Height)
+				return -1;
+
+			widthLeft -= m_Skyline[i].Width;
+		}
+
+		return y;
+	}
+
+	void RectanglePacker::AddSkylineLevel(size_t nodeIndex, const Rect& rect)
+	{
+		m_Skyline.insert(m_Skyline.begin() + nodeIndex, {rect.X, rect.Y + rect.Height, rect.Width});
+
+		// Shrink or remove the nodes now covered by the new one
+		for (size_t i = nodeIndex + 1; i < m_Skyline.size();)
+		{
+			SkylineNode& previous = m_Skyline[i - 1];
+			SkylineNode& node = m_Skyline[i];
+
+			if (node.X >= previous.X + previous.Width)
+				break;
+
+			int shrink = previous.X + previous.Width - node.X;
+			node.X += shrink;
+			node.Width -= shrink;
+
+			if (node.Width > 0)
+				break;
+
+			m_Skyline.erase(m_Skyline.begin() + i);
+		}
+
+		// Merge neighbours at the same height
+		for (size_t i = 0; i + 1 < m_Skyline.size();)
+		{
+			if (m_Skyline[i].Y == m_Skyline[i + 1].Y)
+			{
+				m_Skyline[i].Width += m_Skyline[i + 1].Width;
+				m_Skyline.erase(m_Skyline.begin() + i + 1);
+			}
+			else
+			{
+				i++;
+			}
+		}
+	}
+} // namespace onion::voxel
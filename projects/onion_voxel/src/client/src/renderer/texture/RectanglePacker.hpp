@@ -0,0 +1,47 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+namespace onion::voxel
+{
+	/// @brief Skyline bottom-left rectangle packer, used to build texture atlases from images of different sizes.
+	class RectanglePacker
+	{
+	  public:
+		struct Rect
+		{
+			int X = 0;
+			int Y = 0;
+			int Width = 0;
+			int Height = 0;
+		};
+
+		RectanglePacker(int width, int height);
+
+		/// @brief Finds room for a rectangle, or std::nullopt if the packer is full.
+		std::optional<Rect> Pack(int width, int height);
+		void Reset(int width, int height);
+
+		int GetWidth() const { return m_Width; }
+		int GetHeight() const { return m_Height; }
+
+	  private:
+		// Top edge of the packed area, from left to right
+		struct SkylineNode
+		{
+			int X;
+			int Y;
+			int Width;
+		};
+
+		// Returns the Y the rectangle would rest at if placed on the node, or -1 if it doesn't fit
+		int Fit(size_t nodeIndex, int width, int height) const;
+		void AddSkylineLevel(size_t nodeIndex, const Rect& rect);
+
+	  private:
+		int m_Width;
+		int m_Height;
+		std::vector<SkylineNode> m_Skyline;
+	};
+} // namespace onion::voxel
@@ -0,0 +1,244 @@
+#include "TextureArray.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#include <glad/glad.h>
+
+#include "../gl_state/GLStateCache.hpp"
+
+namespace onion::voxel
+{
+	namespace
+	{
+		/// @brief A vertical strip of square frames, frames are contiguous so the first one is a prefix of the pixels.
+		bool IsFrameStrip(const DecodedImage& image, int frameSize)
+		{
+			return image.Width == frameSize && image.Height > frameSize && image.Height % frameSize == 0;
+		}
+	} // namespace
+
+	// -------- Constructor / Destructor --------
+
+	TextureArray::TextureArray(const std::string& name, const std::vector<std::string>& layerFilePaths)
+		: m_Name(name), m_LayerFilePaths(layerFilePaths)
+	{
+	}
+
+	TextureArray::~TextureArray()
+	{
+		if (m_TextureID != 0)
+		{
+			std::cout << "[TEXTURE ARRAY] [ERROR] : Texture array '" << m_Name
+					  << "' not deleted before destruction. There is a memory leak." << std::endl;
+		}
+	}
+
+	// -------- Layers --------
+
+	int TextureArray::AddLayer(const std::string& filePath)
+	{
+		int existing = GetLayer(filePath);
+		if (existing >= 0)
+			return existing;
+
+		m_LayerFilePaths.push_back(filePath);
+		return static_cast<int>(m_LayerFilePaths.size()) - 1;
+	}
+
+	int TextureArray::GetLayer(const std::string& filePath) const
+	{
+		auto it = std::find(m_LayerFilePaths.begin(), m_LayerFilePaths.end(), filePath);
+		if (it == m_LayerFilePaths.end())
+			return -1;
+
+		return static_cast<int>(std::distance(m_LayerFilePaths.begin(), it));
+	}
+
+	int TextureArray::GetLayerCount() const
+	{
+		return static_cast<int>(m_LayerFilePaths.size());
+	}
+
+	// -------- Load / Upload --------
+
+	void TextureArray::Load()
+	{
+		if (m_TextureID != 0 || !m_PendingLayers.empty())
+			return;
+
+		for (const std::string& filePath : m_LayerFilePaths)
+		{
+			m_PendingLayers.push_back(TextureLoader::DecodeAsync(filePath, 4));
+		}
+	}
+
+	bool TextureArray::Bind(unsigned int unit) const
+	{
+		if (m_TextureID == 0)
+		{
+			if (m_PendingLayers.empty())
+				return false;
+
+			for (const std::future<DecodedImage>& layer : m_PendingLayers)
+			{
+				if (layer.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+					return false;
+			}
+
+			Upload();
+		}
+
+		GLStateCache::BindTexture(unit, GL_TEXTURE_2D_ARRAY, m_TextureID);
+		return true;
+	}
+
+	bool TextureArray::IsResident() const
+	{
+		return m_TextureID != 0;
+	}
+
+	void TextureArray::Upload() const
+	{
+		std::vector<DecodedImage> layers;
+		layers.reserve(m_PendingLayers.size());
+		for (std::future<DecodedImage>& layer : m_PendingLayers)
+		{
+			try
+			{
+				layers.push_back(layer.get());
+			}
+			catch (const std::future_error&)
+			{
+				// The TextureLoader was shut down before decoding this layer
+				layers.emplace_back();
+			}
+		}
+		m_PendingLayers.clear();
+
+		// The first valid layer gives the size of the whole array
+		auto reference = std::find_if(layers.begin(), layers.end(), [](const DecodedImage& l) { return l.IsValid(); });
+		if (reference == layers.end())
+		{
+			std::cout << "[TEXTURE ARRAY] [ERROR] : No valid layer in texture array '" << m_Name << "'" << std::endl;
+			return;
+		}
+
+		// Animated textures are vertical strips of square frames, only their first frame is kept
+		m_Width = reference->Width;
+		m_Height = IsFrameStrip(*reference, m_Width) ? m_Width : reference->Height;
+
+		int levels = 1 + static_cast<int>(std::floor(std::log2(std::max(m_Width, m_Height))));
+
+		glGenTextures(1, &m_TextureID);
+		GLStateCache::BindTexture(GL_TEXTURE_2D_ARRAY, m_TextureID);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		glTexImage3D(GL_TEXTURE_2D_ARRAY,
+					 0,
+					 GL_RGBA8,
+					 m_Width,
+					 m_Height,
+					 static_cast<GLsizei>(layers.size()),
+					 0,
+					 GL_RGBA,
+					 GL_UNSIGNED_BYTE,
+					 nullptr);
+
+		std::vector<unsigned char> transparentLayer;
+		for (size_t i = 0; i < layers.size(); i++)
+		{
+			const DecodedImage& layer = layers[i];
+			const unsigned char* pixels = layer.Pixels.data();
+
+			bool fits = layer.Height == m_Height || IsFrameStrip(layer, m_Height);
+			if (!layer.IsValid() || layer.Width != m_Width || !fits)
+			{
+				// Odd sizes belong in a TextureAtlas, the layer is left transparent so indices stay stable
+				std::cout << "[TEXTURE ARRAY] [ERROR] : Layer '" << m_LayerFilePaths[i] << "' is missing or is not "
+						  << m_Width << "x" << m_Height << " in texture array '" << m_Name << "'" << std::endl;
+
+				transparentLayer.resize(static_cast<size_t>(m_Width) * m_Height * 4, 0);
+				pixels = transparentLayer.data();
+			}
+
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY,
+							0,
+							0,
+							0,
+							static_cast<GLint>(i),
+							m_Width,
+							m_Height,
+							1,
+							GL_RGBA,
+							GL_UNSIGNED_BYTE,
+							pixels);
+		}
+
+		// Mipmaps are generated per layer, levels never mix two layers
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levels - 1);
+		glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		ApplyFilter();
+	}
+
+	// -------- Sampling --------
+
+	void TextureArray::SetFilter(TextureFilter filter)
+	{
+		m_Filter = filter;
+
+		if (m_TextureID != 0)
+		{
+			GLStateCache::BindTexture(GL_TEXTURE_2D_ARRAY, m_TextureID);
+			ApplyFilter();
+		}
+	}
+
+	void TextureArray::ApplyFilter() const
+	{
+		if (m_Filter == TextureFilter::Linear)
+		{
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		}
+		else
+		{
+			// Pixel art : sharp when magnified, blended between mip levels when far away
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		}
+	}
+
+	void TextureArray::Delete()
+	{
+		for (std::future<DecodedImage>& layer : m_PendingLayers)
+		{
+			// Without the workers, a queued decode never completes : drop it
+			if (layer.valid() && TextureLoader::IsRunning())
+				layer.wait();
+		}
+		m_PendingLayers.clear();
+
+		if (m_TextureID != 0)
+			GLStateCache::DeleteTexture(m_TextureID);
+
+		m_TextureID = 0;
+	}
+
+	// -------- Getters --------
+
+	int TextureArray::GetWidth() const
+	{
+		return m_Width;
+	}
+
+	int TextureArray::GetHeight() const
+	{
+		return m_Height;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <future>
+#include <string>
+#include <vector>
+
+#include "TextureLoader.hpp"
+#include "texture.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Same-size images packed as the layers of a single GL_TEXTURE_2D_ARRAY, with per-layer mipmaps.
+	/// Renderers reference an image by its layer index and can draw whole batches without rebinding.
+	class TextureArray
+	{
+	  public:
+		TextureArray(const std::string& name, const std::vector<std::string>& layerFilePaths = {});
+		~TextureArray();
+
+		TextureArray(const TextureArray&) = delete;
+		TextureArray& operator=(const TextureArray&) = delete;
+
+		/// @brief Adds a layer before Load() and returns its index.
+		int AddLayer(const std::string& filePath);
+		int GetLayer(const std::string& filePath) const;
+		int GetLayerCount() const;
+
+		/// @brief Starts decoding every layer on the TextureLoader workers. Does nothing if already loading.
+		void Load();
+
+		/// @brief Binds the array to the given texture unit, uploading it once every layer is decoded.
+		/// @return False while the array is not resident yet, nothing is bound in that case.
+		bool Bind(unsigned int unit = 0) const;
+		bool IsResident() const;
+
+		void SetFilter(TextureFilter filter);
+		void Delete();
+
+		int GetWidth() const;
+		int GetHeight() const;
+
+	  private:
+		void Upload() const;
+		void ApplyFilter() const;
+
+	  private:
+		std::string m_Name;
+		std::vector<std::string> m_LayerFilePaths;
+
+		mutable std::vector<std::future<DecodedImage>> m_PendingLayers;
+		mutable unsigned int m_TextureID = 0;
+		mutable int m_Width = 0;
+		mutable int m_Height = 0;
+
+		TextureFilter m_Filter = TextureFilter::Nearest;
+	};
+} // namespace onion::voxel
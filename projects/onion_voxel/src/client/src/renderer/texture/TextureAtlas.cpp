@@ -0,0 +1,220 @@
+#include "TextureAtlas.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+
+#include <glad/glad.h>
+
+#include "../gl_state/GLStateCache.hpp"
+#include "RectanglePacker.hpp"
+
+namespace onion::voxel
+{
+	// -------- Constructor / Destructor --------
+
+	TextureAtlas::TextureAtlas(const std::string& name, int padding, int maxSize)
+		: m_Name(name), m_Padding(padding), m_MaxSize(maxSize)
+	{
+	}
+
+	TextureAtlas::~TextureAtlas()
+	{
+		if (m_TextureID != 0)
+		{
+			std::cout << "[TEXTURE ATLAS] [ERROR] : Texture atlas '" << m_Name
+					  << "' not deleted before destruction. There is a memory leak." << std::endl;
+		}
+	}
+
+	// -------- Public API --------
+
+	void TextureAtlas::AddImage(const std::string& filePath)
+	{
+		if (std::find(m_FilePaths.begin(), m_FilePaths.end(), filePath) == m_FilePaths.end())
+			m_FilePaths.push_back(filePath);
+	}
+
+	void TextureAtlas::Load()
+	{
+		if (m_TextureID != 0 || !m_PendingImages.empty())
+			return;
+
+		for (const std::string& filePath : m_FilePaths)
+		{
+			m_PendingImages.push_back(TextureLoader::DecodeAsync(filePath, 4));
+		}
+	}
+
+	bool TextureAtlas::Bind(unsigned int unit) const
+	{
+		if (m_TextureID == 0)
+		{
+			if (m_PendingImages.empty())
+				return false;
+
+			for (const std::future<DecodedImage>& image : m_PendingImages)
+			{
+				if (image.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+					return false;
+			}
+
+			PackAndUpload();
+		}
+
+		GLStateCache::BindTexture(unit, GL_TEXTURE_2D, m_TextureID);
+		return true;
+	}
+
+	bool TextureAtlas::IsResident() const
+	{
+		return m_TextureID != 0;
+	}
+
+	const TextureAtlas::Region* TextureAtlas::GetRegion(const std::string& filePath) const
+	{
+		auto it = m_Regions.find(filePath);
+		return it != m_Regions.end() ? &it->second : nullptr;
+	}
+
+	void TextureAtlas::Delete()
+	{
+		for (std::future<DecodedImage>& image : m_PendingImages)
+		{
+			// Without the workers, a queued decode never completes : drop it
+			if (image.valid() && TextureLoader::IsRunning())
+				image.wait();
+		}
+		m_PendingImages.clear();
+
+		if (m_TextureID != 0)
+			GLStateCache::DeleteTexture(m_TextureID);
+
+		m_TextureID = 0;
+		m_Regions.clear();
+	}
+
+	int TextureAtlas::GetWidth() const
+	{
+		return m_Width;
+	}
+
+	int TextureAtlas::GetHeight() const
+	{
+		return m_Height;
+	}
+
+	// -------- Packing --------
+
+	void TextureAtlas::PackAndUpload() const
+	{
+		std::vector<DecodedImage> images;
+		images.reserve(m_PendingImages.size());
+		for (std::future<DecodedImage>& image : m_PendingImages)
+		{
+			try
+			{
+				images.push_back(image.get());
+			}
+			catch (const std::future_error&)
+			{
+				images.emplace_back(); // The TextureLoader was shut down before decoding this image
+			}
+		}
+		m_PendingImages.clear();
+
+		// Tallest first packs tighter with a skyline
+		std::vector<size_t> order(images.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return images[a].Height > images[b].Height; });
+
+		std::vector<RectanglePacker::Rect> rects(images.size());
+		int size = 64;
+		bool packed = false;
+
+		while (!packed && size <= m_MaxSize)
+		{
+			RectanglePacker packer(size, size);
+			packed = true;
+
+			for (size_t index : order)
+			{
+				if (!images[index].IsValid())
+					continue;
+
+				auto rect = packer.Pack(images[index].Width + 2 * m_Padding, images[index].Height + 2 * m_Padding);
+				if (!rect)
+				{
+					packed = false;
+					size *= 2;
+					break;
+				}
+				rects[index] = *rect;
+			}
+		}
+
+		if (!packed)
+		{
+			std::cout << "[TEXTURE ATLAS] [ERROR] : Images of '" << m_Name << "' don't fit in " << m_MaxSize << "x"
+					  << m_MaxSize << std::endl;
+			return;
+		}
+
+		m_Width = size;
+		m_Height = size;
+		std::vector<unsigned char> pixels(static_cast<size_t>(m_Width) * m_Height * 4, 0);
+
+		for (size_t i = 0; i < images.size(); i++)
+		{
+			const DecodedImage& image = images[i];
+			if (!image.IsValid())
+				continue;
+
+			const RectanglePacker::Rect& rect = rects[i];
+
+			// Copy the image and extrude its edges into the gutter
+			for (int y = 0; y < rect.Height; y++)
+			{
+				int srcY = std::clamp(y - m_Padding, 0, image.Height - 1);
+				for (int x = 0; x < rect.Width; x++)
+				{
+					int srcX = std::clamp(x - m_Padding, 0, image.Width - 1);
+
+					const unsigned char* src = &image.Pixels[(static_cast<size_t>(srcY) * image.Width + srcX) * 4];
+					unsigned char* dst = &pixels[(static_cast<size_t>(rect.Y + y) * m_Width + rect.X + x) * 4];
+					std::copy(src, src + 4, dst);
+				}
+			}
+
+			Region region;
+			region.x = rect.X + m_Padding;
+			region.y = rect.Y + m_Padding;
+			region.width = image.Width;
+			region.height = image.Height;
+			region.u0 = static_cast<float>(region.x) / m_Width;
+			region.v0 = static_cast<float>(region.y) / m_Height;
+			region.u1 = static_cast<float>(region.x + region.width) / m_Width;
+			region.v1 = static_cast<float>(region.y + region.height) / m_Height;
+
+			m_Regions[m_FilePaths[i]] = region;
+		}
+
+		// Each mip level halves the gutter, stop before it disappears
+		int levels = std::max(1, static_cast<int>(std::bit_width(static_cast<unsigned int>(m_Padding))));
+
+		glGenTextures(1, &m_TextureID);
+		GLStateCache::BindTexture(GL_TEXTURE_2D, m_TextureID);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+		glGenerateMipmap(GL_TEXTURE_2D);
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	}
+} // namespace onion::voxel
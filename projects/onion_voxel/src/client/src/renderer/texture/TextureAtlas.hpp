@@ -0,0 +1,65 @@
+#pragma once
+
+#include <future>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "TextureLoader.hpp"
+#include "texture.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Images of different sizes rectangle-packed into a single GL_TEXTURE_2D.
+	/// Each image is surrounded by a gutter of extruded edge pixels so filtering and mipmaps don't bleed.
+	class TextureAtlas
+	{
+	  public:
+		struct Region
+		{
+			float u0, v0, u1, v1;
+			int x, y, width, height; // In atlas pixels
+		};
+
+		TextureAtlas(const std::string& name, int padding = 4, int maxSize = 4096);
+		~TextureAtlas();
+
+		TextureAtlas(const TextureAtlas&) = delete;
+		TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+		/// @brief Adds an image before Load(). The file path is also the key to retrieve its region.
+		void AddImage(const std::string& filePath);
+
+		/// @brief Starts decoding every image on the TextureLoader workers.
+		void Load();
+
+		/// @brief Binds the atlas to the given texture unit, packing and uploading it once every image is decoded.
+		/// @return False while the atlas is not resident yet, nothing is bound in that case.
+		bool Bind(unsigned int unit = 0) const;
+		bool IsResident() const;
+
+		/// @brief Region of an image once the atlas is resident, nullptr otherwise.
+		const Region* GetRegion(const std::string& filePath) const;
+
+		void Delete();
+
+		int GetWidth() const;
+		int GetHeight() const;
+
+	  private:
+		void PackAndUpload() const;
+
+	  private:
+		std::string m_Name;
+		int m_Padding;
+		int m_MaxSize;
+
+		std::vector<std::string> m_FilePaths;
+		mutable std::vector<std::future<DecodedImage>> m_PendingImages;
+		mutable std::unordered_map<std::string, Region> m_Regions;
+
+		mutable unsigned int m_TextureID = 0;
+		mutable int m_Width = 0;
+		mutable int m_Height = 0;
+	};
+} // namespace onion::voxel
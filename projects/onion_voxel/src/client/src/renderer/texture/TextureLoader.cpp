@@ -0,0 +1,293 @@
+#include "TextureLoader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <glad/glad.h>
+
+#include <stb_image.h>
+
+#include "../gl_state/GLStateCache.hpp"
+#include "texture.hpp"
+
+namespace onion::voxel
+{
+	// -------- Static Member Definitions --------
+
+	std::mutex TextureLoader::s_Mutex;
+	std::condition_variable_any TextureLoader::s_WorkAvailable;
+	std::condition_variable TextureLoader::s_DecodeFinished;
+
+	std::deque<Texture*> TextureLoader::s_DecodeQueue;
+	std::deque<std::packaged_task<DecodedImage()>> TextureLoader::s_TaskQueue;
+	std::deque<Texture*> TextureLoader::s_UploadQueue;
+	std::vector<Texture*> TextureLoader::s_Decoding;
+	size_t TextureLoader::s_RunningTaskCount = 0;
+
+	std::vector<std::jthread> TextureLoader::s_Workers;
+	std::atomic_bool TextureLoader::s_Running{false};
+
+	unsigned int TextureLoader::s_PlaceholderID = 0;
+	unsigned int TextureLoader::s_PixelBuffer = 0;
+
+	// -------- Lifecycle --------
+
+	void TextureLoader::Initialize(unsigned int workerCount)
+	{
+		// Transparent 1x1 placeholder : GUI elements simply don't show up until their texture is resident
+		const unsigned char placeholderPixel[4] = {0, 0, 0, 0};
+
+		glGenTextures(1, &s_PlaceholderID);
+		GLStateCache::BindTexture(GL_TEXTURE_2D, s_PlaceholderID);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholderPixel);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		GLStateCache::BindTexture(GL_TEXTURE_2D, 0);
+
+		glGenBuffers(1, &s_PixelBuffer);
+
+		workerCount = std::max(1u, workerCount);
+		for (unsigned int i = 0; i < workerCount; i++)
+		{
+			s_Workers.emplace_back([](std::stop_token st) { WorkerFunction(st); });
+		}
+		s_Running.store(true);
+	}
+
+	void TextureLoader::Shutdown()
+	{
+		s_Running.store(false);
+
+		for (std::jthread& worker : s_Workers)
+		{
+			worker.request_stop();
+		}
+		s_WorkAvailable.notify_all();
+		s_Workers.clear(); // Joins
+
+		{
+			std::lock_guard<std::mutex> lock(s_Mutex);
+
+			for (Texture* texture : s_DecodeQueue)
+				texture->m_State.store(TextureState::Unloaded);
+
+			for (Texture* texture : s_UploadQueue)
+			{
+				texture->m_Data.reset();
+				texture->m_State.store(TextureState::Unloaded);
+			}
+
+			s_DecodeQueue.clear();
+			s_TaskQueue.clear(); // Broken promises, waiting futures get an exception
+			s_UploadQueue.clear();
+		}
+
+		GLStateCache::DeleteTexture(s_PlaceholderID);
+		glDeleteBuffers(1, &s_PixelBuffer);
+		s_PlaceholderID = 0;
+		s_PixelBuffer = 0;
+	}
+
+	// -------- Public API --------
+
+	void TextureLoader::Request(const Texture& texture)
+	{
+		if (!texture.m_IsFileBacked)
+			return;
+
+		TextureState expected = TextureState::Unloaded;
+		if (!texture.m_State.compare_exchange_strong(expected, TextureState::Decoding))
+			return; // Already queued, decoded or resident
+
+		{
+			std::lock_guard<std::mutex> lock(s_Mutex);
+			s_DecodeQueue.push_back(const_cast<Texture*>(&texture));
+		}
+		s_WorkAvailable.notify_one();
+	}
+
+	void TextureLoader::Cancel(const Texture& texture)
+	{
+		Texture* target = const_cast<Texture*>(&texture);
+
+		std::unique_lock<std::mutex> lock(s_Mutex);
+
+		s_DecodeFinished.wait(lock,
+							  [target]
+							  { return std::find(s_Decoding.begin(), s_Decoding.end(), target) == s_Decoding.end(); });
+
+		std::erase(s_DecodeQueue, target);
+		std::erase(s_UploadQueue, target);
+
+		TextureState state = target->m_State.load();
+		if (state == TextureState::Decoding)
+			target->m_State.store(TextureState::Unloaded);
+		else if (state == TextureState::PendingUpload)
+			target->m_State.store(TextureState::Decoded);
+	}
+
+	std::future<DecodedImage> TextureLoader::DecodeAsync(const std::string& filePath, int desiredChannels)
+	{
+		std::packaged_task<DecodedImage()> task(
+			[filePath, desiredChannels]()
+			{
+				DecodedImage image;
+				int fileChannels = 0;
+				unsigned char* data =
+					stbi_load(filePath.c_str(), &image.Width, &image.Height, &fileChannels, desiredChannels);
+
+				if (data)
+				{
+					image.NrChannels = desiredChannels != 0 ? desiredChannels : fileChannels;
+					image.Pixels.assign(data, data + static_cast<size_t>(image.Width) * image.Height * image.NrChannels);
+					stbi_image_free(data);
+				}
+				else
+				{
+					std::cout << "[TEXTURE] [ERROR] : Failed to load texture: " << filePath << std::endl;
+				}
+
+				return image;
+			});
+		std::future<DecodedImage> future = task.get_future();
+
+		{
+			std::lock_guard<std::mutex> lock(s_Mutex);
+			s_TaskQueue.push_back(std::move(task));
+		}
+		s_WorkAvailable.notify_one();
+
+		return future;
+	}
+
+	void TextureLoader::Update(size_t uploadBudgetBytes)
+	{
+		size_t uploadedBytes = 0;
+
+		while (true)
+		{
+			Texture* texture = nullptr;
+			{
+				std::lock_guard<std::mutex> lock(s_Mutex);
+
+				if (s_UploadQueue.empty())
+					break;
+
+				texture = s_UploadQueue.front();
+				if (uploadedBytes > 0 && uploadedBytes + texture->GetSizeInBytes() > uploadBudgetBytes)
+					break;
+
+				s_UploadQueue.pop_front();
+			}
+
+			UploadThroughPixelBuffer(*texture);
+			uploadedBytes += texture->GetSizeInBytes();
+		}
+	}
+
+	unsigned int TextureLoader::GetPlaceholderID()
+	{
+		return s_PlaceholderID;
+	}
+
+	size_t TextureLoader::GetPendingCount()
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		return s_DecodeQueue.size() + s_TaskQueue.size() + s_RunningTaskCount + s_Decoding.size() +
+			s_UploadQueue.size();
+	}
+
+	bool TextureLoader::IsRunning()
+	{
+		return s_Running.load();
+	}
+
+	// -------- Workers --------
+
+	void TextureLoader::WorkerFunction(std::stop_token st)
+	{
+		while (!st.stop_requested())
+		{
+			Texture* texture = nullptr;
+			std::packaged_task<DecodedImage()> task;
+			{
+				std::unique_lock<std::mutex> lock(s_Mutex);
+				if (!s_WorkAvailable.wait(
+						lock, st, [] { return !s_DecodeQueue.empty() || !s_TaskQueue.empty(); }))
+					return; // Stop requested
+
+				if (!s_TaskQueue.empty())
+				{
+					task = std::move(s_TaskQueue.front());
+					s_TaskQueue.pop_front();
+					s_RunningTaskCount++;
+				}
+				else
+				{
+					texture = s_DecodeQueue.front();
+					s_DecodeQueue.pop_front();
+					s_Decoding.push_back(texture);
+				}
+			}
+
+			if (task.valid())
+			{
+				task();
+
+				std::lock_guard<std::mutex> lock(s_Mutex);
+				s_RunningTaskCount--;
+				continue;
+			}
+
+			bool decoded = texture->DecodeFile();
+
+			{
+				std::lock_guard<std::mutex> lock(s_Mutex);
+				std::erase(s_Decoding, texture);
+
+				if (decoded)
+				{
+					texture->m_State.store(TextureState::PendingUpload);
+					s_UploadQueue.push_back(texture);
+				}
+				else
+				{
+					texture->m_State.store(TextureState::Failed);
+				}
+			}
+			s_DecodeFinished.notify_all();
+		}
+	}
+
+	// -------- Upload --------
+
+	void TextureLoader::UploadThroughPixelBuffer(Texture& texture)
+	{
+		size_t size = texture.GetSizeInBytes();
+
+		// Orphan the previous storage so the copy doesn't wait for the last upload to be consumed
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, s_PixelBuffer);
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+
+		void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+		if (!mapped)
+		{
+			// Fall back to a direct upload from client memory
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			texture.UploadToGPU();
+			return;
+		}
+
+		std::memcpy(mapped, texture.m_Data.get(), size);
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+		// Pixels are read from offset 0 of the bound pixel buffer, the driver can copy them asynchronously
+		bool created = texture.CreateGLTexture(nullptr);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		if (created)
+			texture.FinishUpload();
+	}
+} // namespace onion::voxel
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace onion::voxel
+{
+	class Texture;
+
+	struct DecodedImage
+	{
+		int Width = 0;
+		int Height = 0;
+		int NrChannels = 0;
+		std::vector<unsigned char> Pixels; // Empty if decoding failed
+
+		bool IsValid() const { return !Pixels.empty(); }
+	};
+
+	/// @brief Decodes textures on a pool of worker threads and uploads them from the render thread through a pixel
+	/// buffer object, within a per-frame byte budget. Textures bind a placeholder until they are resident.
+	class TextureLoader
+	{
+	  public:
+		/// @brief Creates the placeholder texture and the pixel buffer, and starts the workers. Render thread only.
+		static void Initialize(unsigned int workerCount = 2);
+		/// @brief Stops the workers and deletes the GL objects. Pending textures go back to the Unloaded state.
+		static void Shutdown();
+
+		/// @brief Queues a file-backed texture for decoding. Does nothing if it's already queued or resident.
+		static void Request(const Texture& texture);
+		/// @brief Removes a texture from the queues, waiting for its decoding to finish if a worker is on it.
+		static void Cancel(const Texture& texture);
+
+		/// @brief Decodes an image file on the workers, for textures that are not a plain Texture (arrays, atlases).
+		/// @param desiredChannels Forces the channel count (0 keeps the file's own).
+		static std::future<DecodedImage> DecodeAsync(const std::string& filePath, int desiredChannels = 0);
+
+		/// @brief Uploads decoded textures until the byte budget is spent. At least one texture is uploaded per call
+		/// so textures larger than the budget still make progress. Render thread only, once per frame.
+		static void Update(size_t uploadBudgetBytes);
+
+		static unsigned int GetPlaceholderID();
+		/// @brief Textures and images queued, decoding or waiting for their upload.
+		static size_t GetPendingCount();
+		/// @brief Between Initialize() and Shutdown() : only then are the futures of DecodeAsync() bound to complete.
+		static bool IsRunning();
+
+	  private:
+		static void WorkerFunction(std::stop_token st);
+		static void UploadThroughPixelBuffer(Texture& texture);
+
+	  private:
+		static std::mutex s_Mutex;
+		static std::condition_variable_any s_WorkAvailable;
+		static std::condition_variable s_DecodeFinished;
+
+		static std::deque<Texture*> s_DecodeQueue;
+		static std::deque<std::packaged_task<DecodedImage()>> s_TaskQueue;
+		static std::deque<Texture*> s_UploadQueue;
+		static std::vector<Texture*> s_Decoding; // Currently held by a worker
+		static size_t s_RunningTaskCount;		 // Tasks of DecodeAsync() currently held by a worker
+
+		static std::vector<std::jthread> s_Workers;
+		static std::atomic_bool s_Running;
+
+		static unsigned int s_PlaceholderID;
+		static unsigned int s_PixelBuffer;
+	};
+} // namespace onion::voxel
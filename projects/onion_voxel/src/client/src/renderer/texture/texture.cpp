@@ -1,9 +1,13 @@
 #include "texture.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #include <glad/glad.h>
 
+#include "../gl_state/GLStateCache.hpp"
+#include "TextureLoader.hpp"
+
 namespace
 {
 	void FreePixels(unsigned char* ptr)
@@ -13,20 +17,36 @@ namespace
 			stbi_image_free(ptr); // or delete[] ptr;
 		}
 	}
+
+	void DeletePixels(unsigned char* ptr)
+	{
+		delete[] ptr;
+	}
 } // namespace
 
 namespace onion::voxel
 {
-	Texture::Texture(const std::string& filePath)
+	Texture::Texture(const std::string& filePath) : m_FilePath(filePath), m_IsFileBacked(true) {}
+
+	Texture::Texture(const std::string& name, int width, int height, int nrChannels, const unsigned char* pixels)
+		: m_FilePath(name), m_Width(width), m_Height(height), m_NrChannels(nrChannels)
 	{
-		if (!LoadFromFile(filePath))
-		{
-			std::cout << "[TEXTURE] [ERROR] : Failed to load texture from file: " << filePath << std::endl;
-		}
+		size_t size = static_cast<size_t>(width) * height * nrChannels;
+
+		m_Data = std::unique_ptr<unsigned char[], PixelDeleter>(new unsigned char[size], DeletePixels);
+		std::copy(pixels, pixels + size, m_Data.get());
+
+		m_State.store(TextureState::Decoded);
 	}
 
 	Texture::~Texture()
 	{
+		TextureState state = m_State.load();
+		if (state == TextureState::Decoding || state == TextureState::PendingUpload)
+		{
+			TextureLoader::Cancel(*this);
+		}
+
 		if (m_TextureID != 0)
 		{
 			std::cout << "[TEXTURE] [ERROR] : Texture '" << m_FilePath
@@ -37,8 +57,27 @@ namespace onion::voxel
 	bool Texture::LoadFromFile(const std::string& filePath)
 	{
 		m_FilePath = filePath;
+		m_IsFileBacked = true;
+
+		if (!DecodeFile())
+		{
+			m_State.store(TextureState::Failed);
+			return false;
+		}
+
+		if (m_State.load() != TextureState::Resident)
+		{
+			m_State.store(TextureState::Decoded);
+		}
+
+		return true;
+	}
+
+	bool Texture::DecodeFile()
+	{
+		// stbi_set_flip_vertically_on_load() is not called here : it sets a global flag, which is not thread safe.
+		// stb_image doesn't flip by default, which is what the GUI expects.
 		int width, height, nrChannels;
-		stbi_set_flip_vertically_on_load(false); // For OpenGL coordinate system
 		unsigned char* data = stbi_load(m_FilePath.c_str(), &width, &height, &nrChannels, 0);
 		if (!data)
 		{
@@ -52,8 +91,8 @@ namespace onion::voxel
 		m_Height = height;
 		m_NrChannels = nrChannels;
 
-		// Saves the raw data, it will be freed after uploading to GPU
-		m_Data = data;
+		// Saves the raw data, it will be freed after uploading to GPU unless CpuResidency::Keep is set
+		m_Data = std::unique_ptr<unsigned char[], PixelDeleter>(data, FreePixels);
 
 		return true;
 	}
@@ -63,11 +102,22 @@ namespace onion::voxel
 		if (!m_Data)
 		{
 			std::cout << "[TEXTURE] [ERROR] : No data to upload for texture: " << m_FilePath << std::endl;
+			m_State.store(TextureState::Failed);
+			return;
+		}
+
+		if (!CreateGLTexture(m_Data.get()))
+		{
 			return;
 		}
 
+		FinishUpload();
+	}
+
+	bool Texture::CreateGLTexture(const void* pixels) const
+	{
 		glGenTextures(1, &m_TextureID);
-		glBindTexture(GL_TEXTURE_2D, m_TextureID);
+		GLStateCache::BindTexture(GL_TEXTURE_2D, m_TextureID);
 
 		// Safe default for any channel count
 		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
@@ -98,58 +148,134 @@ namespace onion::voxel
 		{
 			std::cout << "[TEXTURE] [ERROR] : Unsupported channel count (" << m_NrChannels
 					  << ") for texture: " << m_FilePath << std::endl;
-			glBindTexture(GL_TEXTURE_2D, 0);
-			return;
+			GLStateCache::DeleteTexture(m_TextureID);
+			m_TextureID = 0;
+			m_State.store(TextureState::Failed);
+			return false;
 		}
 
-		glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_Width, m_Height, 0, srcFormat, GL_UNSIGNED_BYTE, m_Data);
-
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_Width, m_Height, 0, srcFormat, GL_UNSIGNED_BYTE, pixels);
 
-		stbi_image_free(m_Data);
-		m_Data = nullptr;
+		ApplyFilter();
 
-		m_HasBeenUploadedToGPU = true;
+		return true;
 	}
 
-	void Texture::Bind() const
+	void Texture::FinishUpload() const
 	{
+		if (m_CpuResidency == CpuResidency::ReleaseAfterUpload)
+		{
+			m_Data.reset();
+		}
 
-		if (!m_HasBeenUploadedToGPU)
+		m_State.store(TextureState::Resident);
+	}
+
+	void Texture::Bind(unsigned int unit) const
+	{
+		switch (m_State.load())
 		{
-			UploadToGPU();
+			case TextureState::Decoded:
+				UploadToGPU();
+				break;
+			case TextureState::Unloaded:
+				TextureLoader::Request(*this);
+				break;
+			default:
+				break;
 		}
 
-		glActiveTexture(GL_TEXTURE0);			   // Activate texture slot 0
-		glBindTexture(GL_TEXTURE_2D, m_TextureID); // Bind our atlas to slot 0
+		// Keep drawing with the placeholder until the texture is resident
+		GLuint textureID = m_State.load() == TextureState::Resident ? m_TextureID : TextureLoader::GetPlaceholderID();
+
+		GLStateCache::BindTexture(unit, GL_TEXTURE_2D, textureID);
 	}
 
 	void Texture::Unbind() const
 	{
-		glBindTexture(GL_TEXTURE_2D, 0);
+		GLStateCache::BindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	void Texture::SetFilter(TextureFilter filter)
+	{
+		m_Filter = filter;
+
+		if (m_State.load() == TextureState::Resident)
+		{
+			GLStateCache::BindTexture(GL_TEXTURE_2D, m_TextureID);
+			ApplyFilter();
+		}
+	}
+
+	void Texture::ApplyFilter() const
+	{
+		GLint filter = m_Filter == TextureFilter::Linear ? GL_LINEAR : GL_NEAREST;
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
 	}
 
 	void Texture::Delete()
 	{
-		glDeleteTextures(1, &m_TextureID);
+		TextureState state = m_State.load();
+		if (state == TextureState::Decoding || state == TextureState::PendingUpload)
+		{
+			TextureLoader::Cancel(*this);
+		}
+
+		GLStateCache::DeleteTexture(m_TextureID);
 		m_TextureID = 0;
+
+		if (m_Data)
+			m_State.store(TextureState::Decoded);
+		else
+			m_State.store(m_IsFileBacked ? TextureState::Unloaded : TextureState::Failed);
 	}
 
-	using PixelDeleter = void (*)(unsigned char*);
-	std::unique_ptr<unsigned char[], PixelDeleter> Texture::GetData() const
+	void Texture::SetCpuResidency(CpuResidency residency)
 	{
-		int width, height, nrChannels;
-		stbi_set_flip_vertically_on_load(false); // For OpenGL coordinate system
-		unsigned char* data = stbi_load(m_FilePath.c_str(), &width, &height, &nrChannels, 0);
-		if (!data)
+		m_CpuResidency = residency;
+	}
+
+	CpuResidency Texture::GetCpuResidency() const
+	{
+		return m_CpuResidency;
+	}
+
+	const unsigned char* Texture::GetPixels() const
+	{
+		return m_Data.get();
+	}
+
+	bool Texture::HasCpuData() const
+	{
+		return m_Data != nullptr;
+	}
+
+	bool Texture::RequireCpuData()
+	{
+		if (m_Data)
 		{
-			// handle error
-			std::cout << "[TEXTURE] [ERROR] : Failed to load texture: " << m_FilePath << std::endl;
-			return {nullptr, FreePixels};
+			return true;
 		}
 
-		return std::unique_ptr<unsigned char[], PixelDeleter>(data, FreePixels);
+		if (!m_IsFileBacked)
+		{
+			std::cout << "[TEXTURE] [ERROR] : CPU data of '" << m_FilePath
+					  << "' has been released and can't be decoded again." << std::endl;
+			return false;
+		}
+
+		return LoadFromFile(m_FilePath);
+	}
+
+	void Texture::ReleaseCpuData()
+	{
+		m_Data.reset();
+
+		if (m_State.load() == TextureState::Decoded)
+		{
+			m_State.store(m_IsFileBacked ? TextureState::Unloaded : TextureState::Failed);
+		}
 	}
 
 	unsigned int Texture::GetTextureID() const
@@ -162,6 +288,16 @@ namespace onion::voxel
 		return m_TextureID != 0;
 	}
 
+	TextureState Texture::GetState() const
+	{
+		return m_State.load();
+	}
+
+	const std::string& Texture::GetFilePath() const
+	{
+		return m_FilePath;
+	}
+
 	int Texture::GetWidth() const
 	{
 		return m_Width;
@@ -174,4 +310,8 @@ namespace onion::voxel
 	{
 		return m_NrChannels;
 	}
+	size_t Texture::GetSizeInBytes() const
+	{
+		return static_cast<size_t>(m_Width) * m_Height * m_NrChannels;
+	}
 }; // namespace onion::voxel
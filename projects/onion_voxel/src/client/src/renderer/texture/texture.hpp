@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -7,32 +8,76 @@
 
 namespace onion::voxel
 {
+	enum class TextureFilter
+	{
+		Nearest,
+		Linear
+	};
+
+	// What happens to the decoded pixels once the texture has been uploaded to the GPU
+	enum class CpuResidency
+	{
+		ReleaseAfterUpload, // Default, the CPU copy is freed as soon as it's on the GPU
+		Keep				// The CPU copy stays until ReleaseCpuData() is called
+	};
+
+	enum class TextureState
+	{
+		Unloaded,	   // File-backed, nothing decoded yet
+		Decoding,	   // Being decoded by the TextureLoader workers
+		PendingUpload, // Decoded by the TextureLoader, waiting for its upload budget on the render thread
+		Decoded,	   // Pixels on the CPU, uploaded synchronously on first Bind()
+		Resident,	   // Uploaded to the GPU
+		Failed
+	};
 
 	class Texture
 	{
+		friend class TextureLoader;
+
 		// ------------ CONSTRUCTOR & DESTRUCTOR ------------
 	  public:
 		Texture() = delete;
+		// Only stores the path, the file is decoded by the TextureLoader on first Bind() or by LoadFromFile()
 		Texture(const std::string& filePath);
+		// Creates a texture from pixels generated at runtime, the pixels are copied. The name is only used in logs.
+		Texture(const std::string& name, int width, int height, int nrChannels, const unsigned char* pixels);
 		~Texture();
 
 		// ------------ LOAD ------------
 	  public:
+		// Decodes the file synchronously on the calling thread
 		bool LoadFromFile(const std::string& filePath);
 
 		// ------------ BIND & UNBIND ------------
 	  public:
-		void Bind() const;
+		// Binds the texture, or the TextureLoader placeholder while the texture is not resident yet
+		void Bind(unsigned int unit = 0) const;
 		void Unbind() const;
 
+		// ------------ SAMPLING ------------
+	  public:
+		void SetFilter(TextureFilter filter);
+
 		// ------------ DELETE ------------
 	  public:
 		void Delete();
 
-		// ------------ RETREVE TEXTURE DATA ------------
+		// ------------ CPU PIXELS ------------
 	  public:
 		using PixelDeleter = void (*)(unsigned char*);
-		std::unique_ptr<unsigned char[], PixelDeleter> GetData() const;
+
+		void SetCpuResidency(CpuResidency residency);
+		CpuResidency GetCpuResidency() const;
+
+		// Decoded pixels (width * height * nrChannels), or nullptr if they are not resident. Never decodes.
+		const unsigned char* GetPixels() const;
+		bool HasCpuData() const;
+
+		// Decodes the file again if the CPU copy has been released. Returns false if there is nothing to decode.
+		bool RequireCpuData();
+		// Frees the CPU copy. If the texture has not been uploaded yet, it will be decoded again on the next Bind().
+		void ReleaseCpuData();
 
 		// ------------ OPENGL ------------
 	  private:
@@ -40,11 +85,24 @@ namespace onion::voxel
 		mutable unsigned int m_TextureID = 0;
 
 		void UploadToGPU() const;
-		mutable bool m_HasBeenUploadedToGPU = false;
+		// Creates the GL texture from pixels, or from an offset in the bound GL_PIXEL_UNPACK_BUFFER
+		bool CreateGLTexture(const void* pixels) const;
+		void FinishUpload() const;
+
+		mutable std::atomic<TextureState> m_State{TextureState::Unloaded};
+
+		TextureFilter m_Filter = TextureFilter::Nearest;
+		void ApplyFilter() const;
 
 		// ------------- RAW TEXTURE DATA -------------
 	  private:
-		mutable unsigned char* m_Data = nullptr;
+		// Freed with stbi_image_free() or delete[] depending on where the pixels come from
+		mutable std::unique_ptr<unsigned char[], PixelDeleter> m_Data{nullptr, nullptr};
+		CpuResidency m_CpuResidency = CpuResidency::ReleaseAfterUpload;
+		bool m_IsFileBacked = false;
+
+		// Decodes m_FilePath into m_Data, safe to call from a worker thread
+		bool DecodeFile();
 
 		// ------------ TEXTURE INFO ------------
 	  private:
@@ -56,9 +114,12 @@ namespace onion::voxel
 	  public:
 		unsigned int GetTextureID() const;
 		bool HasBeenLoaded() const;
+		TextureState GetState() const;
+		const std::string& GetFilePath() const;
 
 		int GetWidth() const;
 		int GetHeight() const;
 		int GetNrChannels() const;
+		size_t GetSizeInBytes() const;
 	};
 } // namespace onion::voxel
@@ -0,0 +1,61 @@
+#include "BlockAppearance.hpp"
+
+#include <algorithm>
+
+#include <world/Blocks.hpp>
+
+namespace onion::voxel
+{
+	BlockAppearanceTable BlockAppearanceTable::CreateDefault()
+	{
+		BlockAppearanceTable table;
+		table.m_Appearances.resize(Blocks::Count);
+
+		table.SetAll(Blocks::Stone, BlockRenderLayer::Opaque, "stone");
+		table.SetAll(Blocks::Dirt, BlockRenderLayer::Opaque, "dirt");
+		table.SetColumn(Blocks::Grass, BlockRenderLayer::Opaque, "grass_block_top", "dirt", "grass_block_side");
+		table.SetAll(Blocks::Water, BlockRenderLayer::Transparent, "water_still");
+		table.SetAll(Blocks::Bedrock, BlockRenderLayer::Opaque, "bedrock");
+		table.SetAll(Blocks::Sand, BlockRenderLayer::Opaque, "sand");
+		table.SetAll(Blocks::Gravel, BlockRenderLayer::Opaque, "gravel");
+		table.SetColumn(Blocks::OakLog, BlockRenderLayer::Opaque, "oak_log_top", "oak_log_top", "oak_log");
+		table.SetAll(Blocks::OakLeaves, BlockRenderLayer::Opaque, "oak_leaves");
+		table.SetAll(Blocks::CoalOre, BlockRenderLayer::Opaque, "coal_ore");
+		table.SetAll(Blocks::IronOre, BlockRenderLayer::Opaque, "iron_ore");
+		table.SetAll(Blocks::Glowstone, BlockRenderLayer::Opaque, "glowstone");
+
+		return table;
+	}
+
+	uint16_t BlockAppearanceTable::GetOrAddTexture(const std::string& textureName)
+	{
+		std::string path = "minecraft/textures/block/" + textureName + ".png";
+
+		auto it = std::find(m_TexturePaths.begin(), m_TexturePaths.end(), path);
+		if (it != m_TexturePaths.end())
+			return static_cast<uint16_t>(it - m_TexturePaths.begin());
+
+		m_TexturePaths.push_back(path);
+		return static_cast<uint16_t>(m_TexturePaths.size() - 1);
+	}
+
+	void BlockAppearanceTable::SetAll(BlockId block, BlockRenderLayer renderLayer, const std::string& texture)
+	{
+		SetColumn(block, renderLayer, texture, texture, texture);
+	}
+
+	void BlockAppearanceTable::SetColumn(BlockId block,
+										 BlockRenderLayer renderLayer,
+										 const std::string& top,
+										 const std::string& bottom,
+										 const std::string& side)
+	{
+		BlockAppearance& appearance = m_Appearances[block];
+		appearance.RenderLayer = renderLayer;
+
+		uint16_t sideLayer = GetOrAddTexture(side);
+		appearance.FaceLayers.fill(sideLayer);
+		appearance.FaceLayers[static_cast<size_t>(BlockFace::PosY)] = GetOrAddTexture(top);
+		appearance.FaceLayers[static_cast<size_t>(BlockFace::NegY)] = GetOrAddTexture(bottom);
+	}
+} // namespace onion::voxel
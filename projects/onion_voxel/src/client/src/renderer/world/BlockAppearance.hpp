@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <world/BlockId.hpp>
+
+#include "VoxelVertex.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Which mesh of the section a block goes to.
+	enum class BlockRenderLayer : uint8_t
+	{
+		None,		 // Not drawn (air)
+		Opaque,		 // Depth tested and written, drawn front to back
+		Transparent, // Blended, drawn back to front after the opaque meshes
+	};
+
+	struct BlockAppearance
+	{
+		BlockRenderLayer RenderLayer = BlockRenderLayer::None;
+		std::array<uint16_t, static_cast<size_t>(BlockFace::Count)> FaceLayers{}; // Texture layer per BlockFace
+	};
+
+	/// @brief How every block id looks : its render layer and the texture array layer of each face.
+	/// Read only once built, so meshing workers can share it.
+	class BlockAppearanceTable
+	{
+	  public:
+		/// @brief Appearances of the blocks of world/Blocks.hpp, with the vanilla block textures.
+		static BlockAppearanceTable CreateDefault();
+
+		/// @brief Unknown ids are not drawn.
+		const BlockAppearance& Get(BlockId block) const
+		{
+			return block < m_Appearances.size() ? m_Appearances[block] : m_Appearances[AirBlock];
+		}
+
+		size_t GetBlockCount() const { return m_Appearances.size(); }
+
+		/// @brief Texture paths relative to the assets directory, the index is the texture array layer.
+		const std::vector<std::string>& GetTexturePaths() const { return m_TexturePaths; }
+
+	  private:
+		uint16_t GetOrAddTexture(const std::string& textureName);
+
+		void SetAll(BlockId block, BlockRenderLayer renderLayer, const std::string& texture);
+		void SetColumn(BlockId block,
+					   BlockRenderLayer renderLayer,
+					   const std::string& top,
+					   const std::string& bottom,
+					   const std::string& side);
+
+	  private:
+		std::vector<BlockAppearance> m_Appearances;
+		std::vector<std::string> m_TexturePaths;
+	};
+} // namespace onion::voxel
@@ -0,0 +1,396 @@
+#include "ChunkMesher.hpp"
+
+#include <cstdlib>
+
+#include <world/Blocks.hpp>
+
+namespace onion::voxel
+{
+	namespace
+	{
+		constexpr uint32_t TransparentKeyBit = 1u << 16;
+		constexpr uint32_t LayerKeyMask = 0xFFFF;
+
+		// A face corner : ambient occlusion [0, 2) | block light [2, 8) | sky light [8, 14), 4 corners per uint64_t
+		constexpr int CornerBits = 16;
+		constexpr uint64_t CornerMask = 0xFFFF;
+
+		/// @brief Corners in EmitQuad() order : (u0 v0) (u1 v0) (u1 v1) (u0 v1), as steps from the face center.
+		constexpr int CornerStepU[4] = {-1, 1, 1, -1};
+		constexpr int CornerStepV[4] = {-1, -1, 1, 1};
+
+		uint32_t GetCorner(uint64_t corners, int corner)
+		{
+			return static_cast<uint32_t>((corners >> (corner * CornerBits)) & CornerMask);
+		}
+
+		/// @brief Same corners at both ends of the U edges : faces can merge along U.
+		bool IsUniformAlongU(uint64_t corners)
+		{
+			return GetCorner(corners, 0) == GetCorner(corners, 1) && GetCorner(corners, 3) == GetCorner(corners, 2);
+		}
+
+		bool IsUniformAlongV(uint64_t corners)
+		{
+			return GetCorner(corners, 0) == GetCorner(corners, 3) && GetCorner(corners, 1) == GetCorner(corners, 2);
+		}
+
+		/// @brief Roughly the brightness voxel.vert gives the corner, to pick the diagonal of the quad.
+		int GetCornerShade(uint32_t corner)
+		{
+			const int light = static_cast<int>(std::max((corner >> 2) & 63, (corner >> 8) & 63));
+			return static_cast<int>((corner & 3) + 1) * (light + 4);
+		}
+
+		/// @brief Axes of a face : A along the normal, U and V span the face, (A, U, V) is a cyclic permutation of
+		/// (X, Y, Z) so U x V points along +A.
+		struct FaceAxes
+		{
+			int A;
+			int U;
+			int V;
+			int Direction; // +1 or -1 along A
+		};
+
+		constexpr FaceAxes GetFaceAxes(BlockFace face)
+		{
+			const int a = static_cast<int>(face) / 2;
+			return {a, (a + 1) % 3, (a + 2) % 3, static_cast<int>(face) % 2 == 0 ? 1 : -1};
+		}
+
+		/// @brief Faces of the section a cell of the snapshot border is beyond, bit i being BlockFace i.
+		constexpr uint8_t GetBorderFaces(int x, int y, int z)
+		{
+			return static_cast<uint8_t>((x == ChunkSize) << static_cast<int>(BlockFace::PosX) |
+										(x == -1) << static_cast<int>(BlockFace::NegX) |
+										(y == ChunkSize) << static_cast<int>(BlockFace::PosY) |
+										(y == -1) << static_cast<int>(BlockFace::NegY) |
+										(z == ChunkSize) << static_cast<int>(BlockFace::PosZ) |
+										(z == -1) << static_cast<int>(BlockFace::NegZ));
+		}
+	} // namespace
+
+	ChunkMesher::ChunkMesher(const BlockAppearanceTable& appearances)
+	{
+		// Cells beyond a single face of the section, the edges and corners are never reached from inside
+		for (int y = -1; y <= ChunkSize; y++)
+			for (int z = -1; z <= ChunkSize; z++)
+				for (int x = -1; x <= ChunkSize; x++)
+					m_FloodBorder[SectionSnapshot::Index(x, y, z)] = GetBorderFaces(x, y, z);
+
+		const size_t blockCount = appearances.GetBlockCount();
+		m_UnknownIndex = blockCount;
+		m_FaceKeys.resize((blockCount + 1) * static_cast<size_t>(BlockFace::Count), 0);
+		m_IsOpaque.resize(blockCount + 1, 1);
+
+		for (size_t block = 0; block < blockCount; block++)
+		{
+			const BlockId id = static_cast<BlockId>(block);
+			const BlockAppearance& appearance = appearances.Get(id);
+			m_IsOpaque[block] = GetBlockProperties(id).IsOpaque;
+
+			if (appearance.RenderLayer == BlockRenderLayer::None)
+				continue;
+
+			for (size_t face = 0; face < static_cast<size_t>(BlockFace::Count); face++)
+			{
+				// The layer is stored + 1 so layer 0 is not mistaken for an empty cell
+				uint32_t key = appearance.FaceLayers[face] + 1u;
+				if (appearance.RenderLayer == BlockRenderLayer::Transparent)
+					key |= TransparentKeyBit;
+
+				m_FaceKeys[block * static_cast<size_t>(BlockFace::Count) + face] = key;
+			}
+		}
+	}
+
+	void ChunkMesher::Mesh(const SectionSnapshot& snapshot, SectionMesh& mesh)
+	{
+		mesh.Clear();
+
+		if (snapshot.IsEmpty())
+		{
+			mesh.Connectivity = SectionConnectivity::All();
+			return;
+		}
+
+		ComputeConnectivity(snapshot, mesh.Connectivity);
+
+		for (int face = 0; face < static_cast<int>(BlockFace::Count); face++)
+			MeshFace(snapshot, static_cast<BlockFace>(face), mesh);
+	}
+
+	void ChunkMesher::ComputeConnectivity(const SectionSnapshot& snapshot, SectionConnectivity& connectivity)
+	{
+		connectivity = SectionConnectivity();
+
+		// Same layout as the snapshot : the border cells hold the face they are beyond, so the fill needs no bounds
+		// check, reaching one records the face
+		m_FloodCells = m_FloodBorder;
+
+		size_t openCount = 0;
+		for (int y = 0; y < ChunkSize; y++)
+		{
+			for (int z = 0; z < ChunkSize; z++)
+			{
+				const int row = SectionSnapshot::Index(0, y, z);
+				for (int x = 0; x < ChunkSize; x++)
+				{
+					const size_t block = std::min<size_t>(snapshot.Get(row + x), m_UnknownIndex);
+					const uint8_t open = m_IsOpaque[block] ^ 1u;
+					m_FloodCells[row + x] = open * OpenCell;
+					openCount += open;
+				}
+			}
+		}
+
+		// Solid rock, or nothing but air, water and leaves
+		if (openCount == 0)
+			return;
+		if (openCount == ChunkSize * ChunkSize * ChunkSize)
+		{
+			connectivity = SectionConnectivity::All();
+			return;
+		}
+
+		constexpr int StrideY = SectionSnapshot::Size * SectionSnapshot::Size;
+		constexpr int StrideZ = SectionSnapshot::Size;
+
+		// Every open block is filled once, pockets that reach no face connect nothing
+		for (int y = 0; y < ChunkSize; y++)
+		{
+			for (int z = 0; z < ChunkSize; z++)
+			{
+				const int row = SectionSnapshot::Index(0, y, z);
+				for (int seed = row; seed < row + ChunkSize; seed++)
+				{
+					if (m_FloodCells[seed] != OpenCell)
+						continue;
+
+					size_t top = 0;
+					m_FloodStack[top++] = static_cast<uint16_t>(seed);
+					m_FloodCells[seed] = 0;
+					uint8_t faces = 0;
+
+					auto visit = [&](int index)
+					{
+						const uint8_t cell = m_FloodCells[index];
+						faces |= cell;
+						if (cell == OpenCell)
+						{
+							m_FloodCells[index] = 0;
+							m_FloodStack[top++] = static_cast<uint16_t>(index);
+						}
+					};
+
+					while (top > 0)
+					{
+						const int index = m_FloodStack[--top];
+						visit(index - 1);
+						visit(index + 1);
+						visit(index - StrideY);
+						visit(index + StrideY);
+						visit(index - StrideZ);
+						visit(index + StrideZ);
+					}
+
+					connectivity.ConnectFaces(faces & SectionConnectivity::AllFacesMask);
+				}
+			}
+		}
+	}
+
+	void ChunkMesher::MeshFace(const SectionSnapshot& snapshot, BlockFace face, SectionMesh& mesh)
+	{
+		const FaceAxes axes = GetFaceAxes(face);
+
+		// Snapshot index steps along each axis
+		constexpr int Strides[3] = {1, SectionSnapshot::Size * SectionSnapshot::Size, SectionSnapshot::Size};
+		const int strideU = Strides[axes.U];
+		const int strideV = Strides[axes.V];
+		const int neighbourOffset = Strides[axes.A] * axes.Direction;
+
+		for (int slice = 0; slice < ChunkSize; slice++)
+		{
+			// -------- Visible faces of the slice --------
+			int position[3] = {0, 0, 0};
+			position[axes.A] = slice;
+			const int sliceIndex = SectionSnapshot::Index(position[0], position[1], position[2]);
+
+			bool anyFace = false;
+			for (int v = 0; v < ChunkSize; v++)
+			{
+				int index = sliceIndex + v * strideV;
+				for (int u = 0; u < ChunkSize; u++, index += strideU)
+				{
+					uint32_t key = GetFaceKey(snapshot.Get(index), snapshot.Get(index + neighbourOffset), face);
+					m_Mask[v * ChunkSize + u] = key;
+					anyFace |= key != 0;
+
+					if (key != 0)
+						m_Corners[v * ChunkSize + u] =
+							GetFaceCorners(snapshot, index + neighbourOffset, strideU, strideV);
+				}
+			}
+
+			if (!anyFace)
+				continue;
+
+			// -------- Merge into rectangles --------
+			for (int v = 0; v < ChunkSize; v++)
+			{
+				for (int u = 0; u < ChunkSize;)
+				{
+					const uint32_t key = m_Mask[v * ChunkSize + u];
+					if (key == 0)
+					{
+						u++;
+						continue;
+					}
+
+					const uint64_t corners = m_Corners[v * ChunkSize + u];
+					int width = 1;
+					int height = 1;
+
+					if (m_Greedy)
+					{
+						// Faces with shading that varies along an axis stay one block wide along it
+						auto matches = [&](int index) { return m_Mask[index] == key && m_Corners[index] == corners; };
+
+						if (IsUniformAlongU(corners))
+							while (u + width < ChunkSize && matches(v * ChunkSize + u + width))
+								width++;
+
+						if (IsUniformAlongV(corners))
+						{
+							for (; v + height < ChunkSize; height++)
+							{
+								const int row = (v + height) * ChunkSize + u;
+
+								bool rowMatches = true;
+								for (int i = 0; i < width && rowMatches; i++)
+									rowMatches = matches(row + i);
+
+								if (!rowMatches)
+									break;
+							}
+						}
+					}
+
+					for (int j = 0; j < height; j++)
+						for (int i = 0; i < width; i++)
+							m_Mask[(v + j) * ChunkSize + u + i] = 0;
+
+					EmitQuad(face, slice, u, v, width, height, key, corners, mesh);
+					u += width;
+				}
+			}
+		}
+	}
+
+	uint64_t ChunkMesher::GetFaceCorners(const SectionSnapshot& snapshot,
+										 int frontIndex,
+										 int strideU,
+										 int strideV) const
+	{
+		// The 3x3 blocks around the block in front of the face, in its plane
+		uint32_t opaque[3][3];
+		uint32_t light[3][3];
+		for (int v = 0; v < 3; v++)
+		{
+			for (int u = 0; u < 3; u++)
+			{
+				const int index = frontIndex + (u - 1) * strideU + (v - 1) * strideV;
+				opaque[v][u] = m_IsOpaque[std::min<size_t>(snapshot.Get(index), m_UnknownIndex)];
+				light[v][u] = snapshot.GetLight(index);
+			}
+		}
+
+		uint64_t corners = 0;
+		for (int corner = 0; corner < 4; corner++)
+		{
+			const int u = 1 + CornerStepU[corner];
+			const int v = 1 + CornerStepV[corner];
+			const uint32_t sideU = opaque[1][u];
+			const uint32_t sideV = opaque[v][1];
+			const uint32_t diagonal = opaque[v][u];
+
+			// Two sides close the corner, the diagonal block can't be seen from it
+			const uint32_t occlusion = sideU & sideV ? 0 : 3 - (sideU + sideV + diagonal);
+
+			// Smooth light : the average of the open blocks around the corner, the one in front is always open
+			uint32_t blockSum = light[1][1] & 0xF;
+			uint32_t skySum = light[1][1] >> 4;
+			uint32_t count = 1;
+
+			auto add = [&](uint32_t isOpaque, uint32_t packed)
+			{
+				if (isOpaque)
+					return;
+				blockSum += packed & 0xF;
+				skySum += packed >> 4;
+				count++;
+			};
+			add(sideU, light[1][u]);
+			add(sideV, light[v][1]);
+			add(diagonal | (sideU & sideV), light[v][u]);
+
+			const uint32_t blockLight = (blockSum * 4 + count / 2) / count;
+			const uint32_t skyLight = (skySum * 4 + count / 2) / count;
+			corners |= static_cast<uint64_t>(occlusion | (blockLight << 2) | (skyLight << 8)) << (corner * CornerBits);
+		}
+
+		return corners;
+	}
+
+	void ChunkMesher::EmitQuad(BlockFace face,
+							   int slice,
+							   int u,
+							   int v,
+							   int width,
+							   int height,
+							   uint32_t key,
+							   uint64_t corners,
+							   SectionMesh& mesh) const
+	{
+		const FaceAxes axes = GetFaceAxes(face);
+		const int plane = axes.Direction > 0 ? slice + 1 : slice;
+		const uint32_t layer = (key & LayerKeyMask) - 1;
+
+		// Counter-clockwise seen from outside : (u0 v0) (u1 v0) (u1 v1) (u0 v1), reversed for negative faces
+		const int cornersU[4] = {u, u + width, u + width, u};
+		const int cornersV[4] = {v, v, v + height, v + height};
+		constexpr int PositiveOrder[4] = {0, 1, 2, 3};
+		constexpr int NegativeOrder[4] = {0, 3, 2, 1};
+		const int* order = axes.Direction > 0 ? PositiveOrder : NegativeOrder;
+
+		// The shared index pattern splits along the first and third vertices. Starting one corner later keeps the
+		// winding and splits along the other diagonal.
+		const int shade02 = std::abs(GetCornerShade(GetCorner(corners, 0)) - GetCornerShade(GetCorner(corners, 2)));
+		const int shade13 = std::abs(GetCornerShade(GetCorner(corners, 1)) - GetCornerShade(GetCorner(corners, 3)));
+		const int first = shade02 > shade13 ? 1 : 0;
+
+		std::vector<VoxelVertex>& vertices =
+			(key & TransparentKeyBit) ? mesh.TransparentVertices : mesh.OpaqueVertices;
+
+		for (int i = 0; i < 4; i++)
+		{
+			const int cornerIndex = order[(i + first) & 3];
+			const uint32_t cornerData = GetCorner(corners, cornerIndex);
+
+			int corner[3];
+			corner[axes.A] = plane;
+			corner[axes.U] = cornersU[cornerIndex];
+			corner[axes.V] = cornersV[cornerIndex];
+
+			vertices.push_back(VoxelVertex::Pack(static_cast<uint32_t>(corner[0]),
+												 static_cast<uint32_t>(corner[1]),
+												 static_cast<uint32_t>(corner[2]),
+												 face,
+												 cornerData & 3,
+												 layer,
+												 (cornerData >> 2) & 63,
+												 (cornerData >> 8) & 63));
+		}
+	}
+} // namespace onion::voxel
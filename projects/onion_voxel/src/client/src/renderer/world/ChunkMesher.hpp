@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <world/SectionSnapshot.hpp>
+
+#include "BlockAppearance.hpp"
+#include "SectionConnectivity.hpp"
+#include "VoxelVertex.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Quads of a section, 4 vertices each, drawn with the shared quad index pattern (0 1 2 2 3 0).
+	struct SectionMesh
+	{
+		std::vector<VoxelVertex> OpaqueVertices;
+		std::vector<VoxelVertex> TransparentVertices;
+		SectionConnectivity Connectivity;
+
+		void Clear()
+		{
+			OpaqueVertices.clear();
+			TransparentVertices.clear();
+			Connectivity = SectionConnectivity();
+		}
+
+		bool IsEmpty() const { return OpaqueVertices.empty() && TransparentVertices.empty(); }
+		size_t GetQuadCount() const { return (OpaqueVertices.size() + TransparentVertices.size()) / 4; }
+	};
+
+	/// @brief Builds the mesh of a section from a snapshot, on any thread.
+	///
+	/// A face is kept when the neighbouring block is not opaque and is not the same block, so the inside of a lake
+	/// or of a tree crown has no faces. The snapshot border gives the neighbours across section and chunk edges.
+	/// Visible faces of a slice that share a texture layer are then merged into rectangles (greedy meshing) : a flat
+	/// grass field is 1 quad per section instead of 256. Textures repeat over the merged quads in voxel.frag.
+	/// The same pass floods the non-opaque blocks to find which faces of the section see each other.
+	///
+	/// Each corner of a face gets ambient occlusion from the 3 blocks touching it in front of the face, and smooth
+	/// light from the average of the 4 blocks around it, both baked in the vertices. Faces only merge along an axis
+	/// their corners don't vary on, so merged quads shade exactly as the faces they replace. Quads are split along
+	/// the diagonal whose ends are closest in shade, so occlusion doesn't follow the triangles.
+	///
+	/// Holds scratch memory, use one mesher per thread.
+	class ChunkMesher
+	{
+	  public:
+		explicit ChunkMesher(const BlockAppearanceTable& appearances);
+
+		/// @brief Replaces the content of the mesh, keeping its capacity, and its connectivity.
+		void Mesh(const SectionSnapshot& snapshot, SectionMesh& mesh);
+
+		/// @brief Disables the merging of faces, one quad per visible face. For comparisons only.
+		void SetGreedy(bool greedy) { m_Greedy = greedy; }
+
+		/// @brief Only the connectivity, Mesh() computes it too.
+		void ComputeConnectivity(const SectionSnapshot& snapshot, SectionConnectivity& connectivity);
+
+	  private:
+		void MeshFace(const SectionSnapshot& snapshot, BlockFace face, SectionMesh& mesh);
+
+		/// @return 0 when the face is hidden, otherwise a key equal for faces that can be merged.
+		uint32_t GetFaceKey(BlockId block, BlockId neighbour, BlockFace face) const
+		{
+			// Branchless, terrain alternates between air and solid blocks too often for the predictor.
+			// Unknown ids share the last entry of the tables : not drawn and opaque, as in GetBlockProperties().
+			const size_t blockIndex = std::min<size_t>(block, m_UnknownIndex);
+			const size_t neighbourIndex = std::min<size_t>(neighbour, m_UnknownIndex);
+
+			const size_t faceIndex = static_cast<size_t>(face);
+			const uint32_t key = m_FaceKeys[blockIndex * static_cast<size_t>(BlockFace::Count) + faceIndex];
+			const uint32_t hidden = static_cast<uint32_t>(neighbour == block) | m_IsOpaque[neighbourIndex];
+			return key & (hidden - 1u);
+		}
+
+		/// @brief Ambient occlusion and light of the 4 corners of a face, 16 bits each in the EmitQuad() corner order.
+		/// @param frontIndex Snapshot index of the block in front of the face.
+		uint64_t GetFaceCorners(const SectionSnapshot& snapshot, int frontIndex, int strideU, int strideV) const;
+
+		void EmitQuad(BlockFace face,
+					  int slice,
+					  int u,
+					  int v,
+					  int width,
+					  int height,
+					  uint32_t key,
+					  uint64_t corners,
+					  SectionMesh& mesh) const;
+
+	  private:
+		bool m_Greedy = true;
+
+		// Flattened from the appearance table and the block properties, indexed by block id
+		std::vector<uint32_t> m_FaceKeys; // BlockFace::Count keys per block
+		std::vector<uint8_t> m_IsOpaque;
+		size_t m_UnknownIndex = 0;
+
+		std::array<uint32_t, ChunkSize * ChunkSize> m_Mask{};	 // Face keys of the current slice, V major
+		std::array<uint64_t, ChunkSize * ChunkSize> m_Corners{}; // GetFaceCorners() of the faces of m_Mask
+
+		// Connectivity flood fill, indexed as the snapshot
+		static constexpr uint8_t OpenCell = 1u << 7; // Non-opaque and not reached by a fill yet
+		static constexpr size_t SnapshotVolume = SectionSnapshot::Size * SectionSnapshot::Size * SectionSnapshot::Size;
+		std::array<uint8_t, SnapshotVolume> m_FloodBorder{}; // Faces of the border cells, 0 inside
+		std::array<uint8_t, SnapshotVolume> m_FloodCells{};
+		std::array<uint16_t, ChunkSize * ChunkSize * ChunkSize> m_FloodStack{};
+	};
+} // namespace onion::voxel
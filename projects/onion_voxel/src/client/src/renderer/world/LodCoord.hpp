@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <world/SectionRegion.hpp>
+
+namespace onion::voxel
+{
+	/// @brief Level 0 meshes a section at full resolution. Level L meshes a cube of 2^L sections per axis downsampled
+	/// to 16x16x16, each block of the mesh standing for 2^L blocks per axis.
+	constexpr int LodLevelCount = SectionRegion::MaxLevel + 1;
+
+	/// @brief A mesh of the terrain : a section, or a region of a coarser level of detail.
+	struct LodCoord
+	{
+		SectionCoord Coord; // In units of 2^Level sections
+		uint8_t Level = 0;
+
+		bool operator==(const LodCoord&) const = default;
+
+		/// @brief Blocks along each axis.
+		int GetSize() const { return ChunkSize << Level; }
+
+		LodCoord GetParent() const
+		{
+			return {{Coord.x >> 1, Coord.y >> 1, Coord.z >> 1}, static_cast<uint8_t>(Level + 1)};
+		}
+
+		/// @brief The region of the level containing the section.
+		static LodCoord FromSection(const SectionCoord& section, int level)
+		{
+			return {{section.x >> level, section.y >> level, section.z >> level}, static_cast<uint8_t>(level)};
+		}
+	};
+
+	struct LodCoordHash
+	{
+		size_t operator()(const LodCoord& coord) const noexcept
+		{
+			// The level goes into the high bits of Y, which only spans a few sections
+			return SectionCoordHash{}({coord.Coord.x, coord.Coord.y ^ (coord.Level << 5), coord.Coord.z});
+		}
+	};
+} // namespace onion::voxel
@@ -0,0 +1,100 @@
+#include "LodSelector.hpp"
+
+#include <algorithm>
+
+namespace onion::voxel
+{
+	LodSelector::LodSelector(int fullDetailDistance, int renderDistance)
+		: m_FullDetailDistance(fullDetailDistance), m_RenderDistance(renderDistance)
+	{
+	}
+
+	int LodSelector::GetRingRadius(int level) const
+	{
+		return level == LodLevelCount - 1 ? m_RenderDistance
+										  : std::min(m_FullDetailDistance << level, m_RenderDistance);
+	}
+
+	int LodSelector::GetDistance(const LodCoord& coord) const
+	{
+		const int size = 1 << coord.Level; // Chunks
+		const int firstX = coord.Coord.x * size;
+		const int firstZ = coord.Coord.z * size;
+
+		const int distanceX = std::max({firstX - m_CameraChunk.x, m_CameraChunk.x - (firstX + size - 1), 0});
+		const int distanceZ = std::max({firstZ - m_CameraChunk.z, m_CameraChunk.z - (firstZ + size - 1), 0});
+		return std::max(distanceX, distanceZ);
+	}
+
+	bool LodSelector::Update(ChunkCoord cameraChunk)
+	{
+		if (m_HasSelection && cameraChunk == m_CameraChunk)
+			return false;
+
+		m_CameraChunk = cameraChunk;
+		m_HasSelection = true;
+
+		std::swap(m_PreviousList, m_SelectedList);
+		m_SelectedList.clear();
+
+		// Every region of the coarsest level touching the render distance, over the whole height of the world
+		constexpr int TopLevel = LodLevelCount - 1;
+		constexpr int TopSize = 1 << TopLevel;
+		const int firstX = (cameraChunk.x - m_RenderDistance) >> TopLevel;
+		const int lastX = (cameraChunk.x + m_RenderDistance) >> TopLevel;
+		const int firstZ = (cameraChunk.z - m_RenderDistance) >> TopLevel;
+		const int lastZ = (cameraChunk.z + m_RenderDistance) >> TopLevel;
+
+		for (int y = 0; y * TopSize < Chunk::SectionCount; y++)
+			for (int z = firstZ; z <= lastZ; z++)
+				for (int x = firstX; x <= lastX; x++)
+					Select({{x, y, z}, static_cast<uint8_t>(TopLevel)});
+
+		m_Selected.clear();
+		m_Selected.insert(m_SelectedList.begin(), m_SelectedList.end());
+
+		m_Added.clear();
+		m_Removed.clear();
+
+		std::unordered_set<LodCoord, LodCoordHash> previous(m_PreviousList.begin(), m_PreviousList.end());
+		for (const LodCoord& coord : m_SelectedList)
+			if (!previous.contains(coord))
+				m_Added.push_back(coord);
+		for (const LodCoord& coord : m_PreviousList)
+			if (!m_Selected.contains(coord))
+				m_Removed.push_back(coord);
+
+		if (m_Added.empty() && m_Removed.empty())
+			return false;
+
+		m_Version++;
+		return true;
+	}
+
+	void LodSelector::Select(const LodCoord& coord)
+	{
+		const int distance = GetDistance(coord);
+		if (distance > m_RenderDistance)
+			return;
+
+		// Close enough for the ring of the finer level
+		if (coord.Level > 0 && distance < GetRingRadius(coord.Level - 1))
+		{
+			const uint8_t childLevel = static_cast<uint8_t>(coord.Level - 1);
+			for (int y = 0; y < 2; y++)
+			{
+				// Regions of the top level can stick out of the world
+				const int childY = coord.Coord.y * 2 + y;
+				if ((childY << childLevel) >= Chunk::SectionCount)
+					break;
+
+				for (int z = 0; z < 2; z++)
+					for (int x = 0; x < 2; x++)
+						Select({{coord.Coord.x * 2 + x, childY, coord.Coord.z * 2 + z}, childLevel});
+			}
+			return;
+		}
+
+		m_SelectedList.push_back(coord);
+	}
+} // namespace onion::voxel
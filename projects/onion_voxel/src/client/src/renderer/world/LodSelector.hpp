@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "LodCoord.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Picks the level of detail of each part of the terrain around the camera, in rings that double in radius
+	/// with each level : full detail up to fullDetailDistance chunks, 2x up to twice that, and so on.
+	///
+	/// Works like an octree : the regions of the coarsest level within the render distance are split into their 8
+	/// children while the camera is closer than the ring of the children. The selected meshes cover the area exactly
+	/// once, without overlaps or holes. World thread only.
+	class LodSelector
+	{
+	  public:
+		/// @param fullDetailDistance Chunks from the camera chunk drawn at level 0.
+		/// @param renderDistance Chunks from the camera chunk drawn at all.
+		LodSelector(int fullDetailDistance, int renderDistance);
+
+		/// @brief Selects the meshes around the camera chunk, when it changed.
+		/// @return True when the selection changed, GetAdded() and GetRemoved() then hold the difference.
+		bool Update(ChunkCoord cameraChunk);
+
+		bool IsSelected(const LodCoord& coord) const { return m_Selected.contains(coord); }
+		const std::vector<LodCoord>& GetSelected() const { return m_SelectedList; }
+		const std::vector<LodCoord>& GetAdded() const { return m_Added; }
+		const std::vector<LodCoord>& GetRemoved() const { return m_Removed; }
+
+		/// @brief Bumped by each change of the selection.
+		uint64_t GetVersion() const { return m_Version; }
+
+		/// @brief Chunks from the camera chunk up to which the level is drawn.
+		int GetRingRadius(int level) const;
+
+	  private:
+		void Select(const LodCoord& coord);
+		/// @brief Chunks between the camera chunk and the nearest column of the region, along X or Z.
+		int GetDistance(const LodCoord& coord) const;
+
+	  private:
+		int m_FullDetailDistance;
+		int m_RenderDistance;
+
+		ChunkCoord m_CameraChunk;
+		bool m_HasSelection = false;
+		uint64_t m_Version = 0;
+
+		std::unordered_set<LodCoord, LodCoordHash> m_Selected;
+		std::vector<LodCoord> m_SelectedList;
+		std::vector<LodCoord> m_PreviousList;
+		std::vector<LodCoord> m_Added;
+		std::vector<LodCoord> m_Removed;
+	};
+} // namespace onion::voxel
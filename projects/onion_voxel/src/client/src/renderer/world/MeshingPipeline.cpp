@@ -0,0 +1,468 @@
+#include "MeshingPipeline.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+namespace onion::voxel
+{
+	// -------- Constructor / Destructor --------
+
+	MeshingPipeline::MeshingPipeline(JobSystem& jobs, const BlockAppearanceTable& appearances)
+		: m_Jobs(jobs), m_MaxInFlight(static_cast<size_t>(jobs.GetWorkerCount()) * 2)
+	{
+		for (unsigned int i = 0; i < jobs.GetWorkerCount(); i++)
+			m_Meshers.push_back(std::make_unique<ChunkMesher>(appearances));
+	}
+
+	MeshingPipeline::~MeshingPipeline()
+	{
+		m_Jobs.WaitIdle();
+	}
+
+	// -------- World thread --------
+
+	std::shared_ptr<MeshingPipeline::SectionTicket>& MeshingPipeline::GetTicket(const LodCoord& coord)
+	{
+		std::shared_ptr<SectionTicket>& ticket = m_Tickets[coord];
+		if (!ticket)
+			ticket = std::make_shared<SectionTicket>();
+		return ticket;
+	}
+
+	void MeshingPipeline::MarkDirty(const LodCoord& coord)
+	{
+		if (coord.Coord.y < 0 || (coord.Coord.y << coord.Level) >= Chunk::SectionCount)
+			return;
+
+		// Any job already running for the mesh is now stale
+		GetTicket(coord)->Version.fetch_add(1, std::memory_order_release);
+
+		if (m_LodSelector.IsSelected(coord))
+			m_Dirty.insert(coord);
+		else
+			m_DirtyIdle.insert(coord);
+
+		m_DirtyCount.store(m_Dirty.size(), std::memory_order_relaxed);
+	}
+
+	void MeshingPipeline::MarkSectionDirty(const SectionCoord& coord)
+	{
+		for (int level = 0; level < LodLevelCount; level++)
+			MarkDirty(LodCoord::FromSection(coord, level));
+	}
+
+	void MeshingPipeline::MarkBlockDirty(const BlockPos& pos)
+	{
+		const SectionCoord section = SectionCoord::FromBlock(pos);
+
+		// A block on a border is also in the snapshot border of the sections touching it, diagonals included
+		auto range = [](int32_t blockCoord, int& first, int& last)
+		{
+			first = ToLocal(blockCoord) == 0 ? -1 : 0;
+			last = ToLocal(blockCoord) == ChunkSizeMask ? 1 : 0;
+		};
+
+		int firstX, lastX, firstY, lastY, firstZ, lastZ;
+		range(pos.x, firstX, lastX);
+		range(pos.y, firstY, lastY);
+		range(pos.z, firstZ, lastZ);
+
+		// Coarser levels have no border, only the regions holding the block change
+		MarkSectionDirty(section);
+
+		for (int dy = firstY; dy <= lastY; dy++)
+			for (int dz = firstZ; dz <= lastZ; dz++)
+				for (int dx = firstX; dx <= lastX; dx++)
+					if (dx != 0 || dy != 0 || dz != 0)
+						MarkDirty({{section.x + dx, section.y + dy, section.z + dz}, 0});
+	}
+
+	void MeshingPipeline::MarkChunkDirty(const ChunkStore& world, ChunkCoord coord)
+	{
+		for (int dz = -1; dz <= 1; dz++)
+		{
+			for (int dx = -1; dx <= 1; dx++)
+			{
+				const ChunkCoord neighbour{coord.x + dx, coord.z + dz};
+				if (!world.HasChunk(neighbour))
+					continue;
+
+				const bool self = dx == 0 && dz == 0;
+				for (int sectionY = 0; sectionY < Chunk::SectionCount; sectionY++)
+				{
+					if (self)
+						MarkSectionDirty({neighbour.x, sectionY, neighbour.z});
+					else
+						MarkDirty({{neighbour.x, sectionY, neighbour.z}, 0});
+				}
+			}
+		}
+	}
+
+	void MeshingPipeline::RemoveChunk(ChunkCoord coord)
+	{
+		for (int sectionY = 0; sectionY < Chunk::SectionCount; sectionY++)
+		{
+			const LodCoord section{{coord.x, sectionY, coord.z}, 0};
+			m_Dirty.erase(section);
+			m_DirtyIdle.erase(section);
+			m_Meshed.erase(section);
+			m_Cached.erase(section);
+
+			auto it = m_Tickets.find(section);
+			if (it == m_Tickets.end())
+				continue;
+
+			// Stales the jobs in flight, the empty result then releases the GPU mesh
+			const uint32_t version = it->second->Version.fetch_add(1, std::memory_order_release) + 1;
+			PushEmptyResult(section, version, std::move(it->second), true);
+			m_Tickets.erase(it);
+		}
+
+		m_DirtyCount.store(m_Dirty.size(), std::memory_order_relaxed);
+	}
+
+	void MeshingPipeline::UpdateSelection(ChunkCoord cameraChunk)
+	{
+		if (!m_LodSelector.Update(cameraChunk))
+			return;
+
+		for (const LodCoord& coord : m_LodSelector.GetRemoved())
+		{
+			if (m_Dirty.erase(coord) > 0)
+				m_DirtyIdle.insert(coord);
+			if (m_Meshed.contains(coord))
+				m_Cached.emplace(coord, m_LodSelector.GetVersion());
+		}
+
+		for (const LodCoord& coord : m_LodSelector.GetAdded())
+		{
+			if (m_DirtyIdle.erase(coord) > 0)
+				m_Dirty.insert(coord);
+			m_Cached.erase(coord);
+		}
+
+		m_DirtyCount.store(m_Dirty.size(), std::memory_order_relaxed);
+
+		if (m_Cached.size() <= MaxCachedMeshes)
+			return;
+
+		// Least recently selected first
+		std::vector<std::pair<uint64_t, LodCoord>> cached;
+		cached.reserve(m_Cached.size());
+		for (const auto& [coord, version] : m_Cached)
+			cached.emplace_back(version, coord);
+
+		const size_t evictCount = cached.size() - MaxCachedMeshes;
+		std::nth_element(cached.begin(),
+						 cached.begin() + evictCount,
+						 cached.end(),
+						 [](const auto& a, const auto& b) { return a.first < b.first; });
+
+		for (size_t i = 0; i < evictCount; i++)
+		{
+			const LodCoord coord = cached[i].second;
+			m_Cached.erase(coord);
+			m_Meshed.erase(coord);
+
+			// The empty result releases the mesh, it is meshed again when selected. Like for an unloaded chunk, the
+			// ticket goes with it : coarse regions are never unloaded, their tickets would pile up as the camera moves
+			auto ticket = m_Tickets.find(coord);
+			if (ticket != m_Tickets.end())
+			{
+				const uint32_t version = ticket->second->Version.fetch_add(1, std::memory_order_release) + 1;
+				PushEmptyResult(coord, version, std::move(ticket->second), true);
+				m_Tickets.erase(ticket);
+			}
+			m_DirtyIdle.insert(coord);
+		}
+	}
+
+	void MeshingPipeline::Dispatch(const ChunkStore& world, const glm::vec3& cameraPosition)
+	{
+		UpdateSelection(ChunkCoord::FromBlock(static_cast<int32_t>(std::floor(cameraPosition.x)),
+											  static_cast<int32_t>(std::floor(cameraPosition.z))));
+
+		const size_t inFlight = m_InFlightCount.load(std::memory_order_acquire);
+		if (m_Dirty.empty() || inFlight >= m_MaxInFlight)
+			return;
+
+		const size_t capacity = m_MaxInFlight - inFlight;
+
+		auto distanceSquared = [&cameraPosition](const LodCoord& coord)
+		{
+			const float size = static_cast<float>(coord.GetSize());
+			const glm::vec3 center = (glm::vec3(coord.Coord.x, coord.Coord.y, coord.Coord.z) + 0.5f) * size;
+			const glm::vec3 delta = center - cameraPosition;
+			return glm::dot(delta, delta);
+		};
+
+		m_Candidates.assign(m_Dirty.begin(), m_Dirty.end());
+		const size_t count = std::min(capacity, m_Candidates.size());
+		std::partial_sort(m_Candidates.begin(),
+						  m_Candidates.begin() + count,
+						  m_Candidates.end(),
+						  [&](const LodCoord& a, const LodCoord& b)
+						  { return distanceSquared(a) < distanceSquared(b); });
+
+		for (size_t i = 0; i < count; i++)
+		{
+			const LodCoord coord = m_Candidates[i];
+			m_Dirty.erase(coord);
+
+			// Marked dirty as a neighbour of a chunk that is gone since
+			const Chunk* chunk = coord.Level == 0 ? world.GetChunk(coord.Coord.GetChunk()) : nullptr;
+			if (coord.Level == 0 && !chunk)
+				continue;
+
+			std::shared_ptr<SectionTicket> ticket = GetTicket(coord);
+			const uint32_t version = ticket->Version.load(std::memory_order_acquire);
+
+			auto job = std::make_shared<MeshJob>();
+			const bool empty = coord.Level == 0 ? SectionSnapshot::IsSectionEmpty(*chunk, coord.Coord.y)
+												: !job->Region.Capture(world, coord.Coord, coord.Level);
+
+			// Resident once applied, even empty : the connectivity is listed
+			m_Meshed.insert(coord);
+
+			// Nothing to mesh, only the previous mesh to release
+			if (empty)
+			{
+				PushEmptyResult(coord, version, std::move(ticket), false);
+				continue;
+			}
+
+			job->Coord = coord;
+			job->Version = version;
+			job->Ticket = std::move(ticket);
+			if (coord.Level == 0)
+				job->Snapshot.Capture(world, coord.Coord.GetChunk(), coord.Coord.y);
+
+			m_InFlightCount.fetch_add(1, std::memory_order_relaxed);
+			m_Jobs.Submit([this, job]() { RunJob(*job); });
+		}
+
+		m_DirtyCount.store(m_Dirty.size(), std::memory_order_relaxed);
+	}
+
+	void MeshingPipeline::PushEmptyResult(const LodCoord& coord,
+										  uint32_t version,
+										  std::shared_ptr<SectionTicket> ticket,
+										  bool removed)
+	{
+		auto result = std::make_unique<MeshResult>();
+		result->Coord = coord;
+		result->Version = version;
+		result->Ticket = std::move(ticket);
+		result->Removed = removed;
+		if (!removed)
+			result->Mesh.Connectivity = SectionConnectivity::All();
+		m_Completed.Push(std::move(result));
+	}
+
+	// -------- Workers --------
+
+	void MeshingPipeline::RunJob(MeshJob& job)
+	{
+		auto isStale = [&job]() { return job.Ticket->Version.load(std::memory_order_acquire) != job.Version; };
+
+		if (!isStale())
+		{
+			auto result = std::make_unique<MeshResult>();
+			result->Coord = job.Coord;
+			result->Version = job.Version;
+			result->Ticket = job.Ticket;
+
+			if (job.Coord.Level > 0)
+				job.Snapshot.Downsample(job.Region);
+
+			m_Meshers[m_Jobs.GetCurrentWorkerIndex()]->Mesh(job.Snapshot, result->Mesh);
+
+			if (!isStale())
+				m_Completed.Push(std::move(result));
+			else
+				m_CancelledCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+		{
+			m_CancelledCount.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		m_InFlightCount.fetch_sub(1, std::memory_order_release);
+	}
+
+	// -------- GL thread --------
+
+	void MeshingPipeline::UploadCompleted(double budgetMilliseconds, size_t budgetBytes, uint64_t pickedUpFrameCount)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		auto elapsedMilliseconds = [&start]()
+		{ return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(); };
+
+		ReleaseRetired(pickedUpFrameCount);
+
+		uint32_t uploadCount = 0;
+		size_t uploadBytes = 0;
+		bool changed = false;
+
+		std::unique_ptr<MeshResult> result;
+		while (uploadCount == 0 || (uploadBytes < budgetBytes && elapsedMilliseconds() < budgetMilliseconds))
+		{
+			if (!m_Completed.TryPop(result))
+				break;
+
+			// Modified again after the snapshot, a newer result is on its way. Removals always apply : marking the
+			// mesh dirty again doesn't dispatch it until it is selected, and any newer result is queued after them
+			if (!result->Removed && result->Ticket->Version.load(std::memory_order_acquire) != result->Version)
+			{
+				m_CancelledCount.fetch_add(1, std::memory_order_relaxed);
+				continue;
+			}
+
+			if (result->Removed)
+			{
+				changed |= m_Connectivity.erase(result->Coord) > 0;
+			}
+			else
+			{
+				auto [connectivity, inserted] = m_Connectivity.try_emplace(result->Coord, result->Mesh.Connectivity);
+				changed |= inserted || connectivity->second != result->Mesh.Connectivity;
+				connectivity->second = result->Mesh.Connectivity;
+			}
+
+			// Frames in flight may still draw the previous mesh, it is kept alive for a few frames
+			LevelStats& level = m_Levels[result->Coord.Level];
+			auto it = m_Buffers.find(result->Coord);
+			if (it != m_Buffers.end())
+			{
+				level.MeshCount--;
+				level.VertexCount -= it->second.GetQuadCount() * 4ull;
+				Retire(std::move(it->second), pickedUpFrameCount);
+				m_Buffers.erase(it);
+				changed = true;
+			}
+
+			if (!result->Mesh.IsEmpty())
+			{
+				SectionMeshBuffer buffer;
+				buffer.Upload(result->Mesh, m_Arenas);
+				level.MeshCount++;
+				level.VertexCount += buffer.GetQuadCount() * 4ull;
+				m_Buffers.emplace(result->Coord, std::move(buffer));
+
+				uploadBytes += (result->Mesh.OpaqueVertices.size() + result->Mesh.TransparentVertices.size()) *
+					sizeof(VoxelVertex);
+				changed = true;
+			}
+
+			uploadCount++;
+			m_CompletedCount.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if (changed)
+			PublishDrawList();
+
+		m_ResidentCount.store(m_Buffers.size(), std::memory_order_relaxed);
+		m_ArenaCount.store(m_Arenas.GetArenaCount(), std::memory_order_relaxed);
+		m_ArenaUsedBytes.store(m_Arenas.GetUsedBytes(), std::memory_order_relaxed);
+		m_LastUploadCount.store(uploadCount, std::memory_order_relaxed);
+		m_LastUploadBytes.store(uploadBytes, std::memory_order_relaxed);
+		m_LastUploadMilliseconds.store(elapsedMilliseconds(), std::memory_order_relaxed);
+	}
+
+	void MeshingPipeline::Retire(SectionMeshBuffer&& buffer, uint64_t pickedUpFrameCount)
+	{
+		m_Retired.push_back({pickedUpFrameCount + FramesInFlight, std::move(buffer)});
+	}
+
+	void MeshingPipeline::ReleaseRetired(uint64_t pickedUpFrameCount)
+	{
+		auto released = std::partition(m_Retired.begin(),
+									   m_Retired.end(),
+									   [pickedUpFrameCount](const RetiredBuffer& retired)
+									   { return retired.ReleaseFrame > pickedUpFrameCount; });
+
+		for (auto it = released; it != m_Retired.end(); ++it)
+			it->Buffer.Delete(m_Arenas);
+
+		m_Retired.erase(released, m_Retired.end());
+	}
+
+	void MeshingPipeline::PublishDrawList()
+	{
+		std::lock_guard<std::mutex> lock(m_DrawListMutex);
+
+		m_DrawList.clear();
+		for (const auto& [coord, connectivity] : m_Connectivity)
+		{
+			auto buffer = m_Buffers.find(coord);
+			SectionDrawInfo& info = m_DrawList.emplace_back();
+			if (buffer != m_Buffers.end())
+				info = buffer->second.GetDrawInfo(coord.Coord, m_Arenas);
+			info.Coord = coord.Coord;
+			info.Level = coord.Level;
+			info.Connectivity = connectivity;
+		}
+		m_DrawListVersion++;
+
+		m_PublishedLevels = m_Levels;
+		for (LevelStats& level : m_PublishedLevels)
+			level.Bytes = level.VertexCount * sizeof(VoxelVertex);
+	}
+
+	void MeshingPipeline::Delete()
+	{
+		// The arenas hold every buffer, deleting them releases everything at once
+		m_Arenas.Delete();
+
+		m_Buffers.clear();
+		m_Connectivity.clear();
+		m_Retired.clear();
+		m_Levels = {};
+
+		std::lock_guard<std::mutex> lock(m_DrawListMutex);
+		m_DrawList.clear();
+		m_DrawListVersion++;
+		m_PublishedLevels = {};
+	}
+
+	// -------- Any thread --------
+
+	void MeshingPipeline::GetDrawList(std::vector<SectionDrawInfo>& drawList) const
+	{
+		std::lock_guard<std::mutex> lock(m_DrawListMutex);
+		drawList = m_DrawList;
+	}
+
+	bool MeshingPipeline::GetDrawListIfChanged(std::vector<SectionDrawInfo>& drawList, uint64_t& knownVersion) const
+	{
+		std::lock_guard<std::mutex> lock(m_DrawListMutex);
+		if (knownVersion == m_DrawListVersion)
+			return false;
+
+		drawList = m_DrawList;
+		knownVersion = m_DrawListVersion;
+		return true;
+	}
+
+	MeshingPipeline::Stats MeshingPipeline::GetStats() const
+	{
+		Stats stats;
+		stats.DirtyCount = m_DirtyCount.load(std::memory_order_relaxed);
+		stats.InFlightCount = m_InFlightCount.load(std::memory_order_relaxed);
+		stats.ResidentCount = m_ResidentCount.load(std::memory_order_relaxed);
+		stats.ArenaCount = m_ArenaCount.load(std::memory_order_relaxed);
+		stats.ArenaUsedBytes = m_ArenaUsedBytes.load(std::memory_order_relaxed);
+		stats.CompletedCount = m_CompletedCount.load(std::memory_order_relaxed);
+		stats.CancelledCount = m_CancelledCount.load(std::memory_order_relaxed);
+		stats.LastUploadCount = m_LastUploadCount.load(std::memory_order_relaxed);
+		stats.LastUploadBytes = m_LastUploadBytes.load(std::memory_order_relaxed);
+		stats.LastUploadMilliseconds = m_LastUploadMilliseconds.load(std::memory_order_relaxed);
+
+		std::lock_guard<std::mutex> lock(m_DrawListMutex);
+		stats.Levels = m_PublishedLevels;
+		return stats;
+	}
+} // namespace onion::voxel
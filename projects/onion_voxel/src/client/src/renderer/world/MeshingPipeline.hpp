@@ -0,0 +1,208 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <jobs/JobSystem.hpp>
+#include <jobs/MpscQueue.hpp>
+#include <world/ChunkStore.hpp>
+#include <world/SectionRegion.hpp>
+#include <world/SectionSnapshot.hpp>
+
+#include "ChunkMesher.hpp"
+#include "LodCoord.hpp"
+#include "LodSelector.hpp"
+#include "SectionMeshBuffer.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Keeps the GPU meshes of the sections in sync with the world, without meshing on the GL thread.
+	///
+	///	World thread : sections marked dirty wait in a set. Dispatch() snapshots the ones nearest to the camera and
+	///	submits a meshing job for each, keeping only a few jobs in flight so a new nearby edit never waits behind a
+	///	long backlog.
+	///	Workers : mesh the immutable snapshot and push the result to a lock-free completion queue.
+	///	GL thread : UploadCompleted() uploads results within a time and byte budget, then publishes the draw list.
+	///
+	/// Every section has a version, bumped each time it is marked dirty. A job or a result carrying an older version
+	/// is stale : the section changed again while it was meshed, it is dropped and the newer job wins. Results
+	/// releasing a mesh (unloaded chunk, evicted region) are never stale, the mesh may not be dispatched again soon.
+	///
+	/// Levels of detail : the regions of the coarser levels are meshed the same way, from a SectionRegion downsampled
+	/// on the worker. Only the meshes picked by the LodSelector are dispatched, the others stay dirty until they are
+	/// picked again. Meshes leaving the selection are kept for a while, so moving back and forth across a ring does
+	/// not mesh them again, and released oldest first past MaxCachedMeshes. Coarse meshes are kept when their chunks
+	/// unload, far terrain stays visible without its blocks.
+	class MeshingPipeline
+	{
+	  public:
+		struct LevelStats
+		{
+			size_t MeshCount = 0; // Resident, with quads
+			uint64_t VertexCount = 0;
+			uint64_t Bytes = 0; // Vertices in the arenas
+		};
+
+		struct Stats
+		{
+			size_t DirtyCount = 0; // Selected meshes only
+			size_t InFlightCount = 0;
+			size_t ResidentCount = 0;
+			size_t ArenaCount = 0;
+			uint64_t ArenaUsedBytes = 0; // Vertices of the resident and retired meshes
+			uint64_t CompletedCount = 0; // Meshes applied since the start
+			uint64_t CancelledCount = 0; // Stale jobs and results dropped since the start
+			uint32_t LastUploadCount = 0;
+			size_t LastUploadBytes = 0;
+			double LastUploadMilliseconds = 0.0;
+			std::array<LevelStats, LodLevelCount> Levels;
+		};
+
+		/// @brief Chunks from the camera drawn at full detail, then each coarser level to twice the previous distance.
+		static constexpr int FullDetailDistance = 6;
+		static constexpr int RenderDistance = 32;
+		/// @brief Resident meshes kept outside of the selection.
+		static constexpr size_t MaxCachedMeshes = 4096;
+
+		MeshingPipeline(JobSystem& jobs, const BlockAppearanceTable& appearances);
+		/// @brief Waits for the jobs in flight, they reference the pipeline.
+		~MeshingPipeline();
+
+		MeshingPipeline(const MeshingPipeline&) = delete;
+		MeshingPipeline& operator=(const MeshingPipeline&) = delete;
+
+		// ----- World thread : the one that modifies the ChunkStore -----
+
+		/// @brief The section, and the regions of the coarser levels containing it.
+		void MarkSectionDirty(const SectionCoord& coord);
+		/// @brief The section of the block, and the neighbour sections whose border it is part of.
+		void MarkBlockDirty(const BlockPos& pos);
+		/// @brief Every section of a chunk just loaded or generated, and the borders of its loaded neighbours.
+		void MarkChunkDirty(const ChunkStore& world, ChunkCoord coord);
+		/// @brief Cancels the jobs of the chunk and releases its full detail meshes.
+		void RemoveChunk(ChunkCoord coord);
+
+		/// @brief Updates the selected levels of detail, then snapshots and submits the selected dirty meshes nearest
+		/// to the camera, up to the in flight limit.
+		void Dispatch(const ChunkStore& world, const glm::vec3& cameraPosition);
+
+		/// @brief The meshes to draw, as of the last Dispatch().
+		const LodSelector& GetLodSelector() const { return m_LodSelector; }
+
+		// ----- GL thread -----
+
+		/// @brief Applies completed meshes until one of the budgets is spent, at least one per call.
+		/// @param pickedUpFrameCount RenderQueue::GetPickedUpFrameCount(), tells when replaced meshes can be released.
+		void UploadCompleted(double budgetMilliseconds, size_t budgetBytes, uint64_t pickedUpFrameCount);
+		void Delete();
+
+		// ----- Any thread -----
+
+		/// @brief Copies the meshed sections and regions, as published by the last UploadCompleted(). Sections without
+		/// quads are listed too, their connectivity is needed by the occlusion culling. Meshes outside of the
+		/// selection are listed as long as they are cached, to stand in for the selected ones not meshed yet.
+		void GetDrawList(std::vector<SectionDrawInfo>& drawList) const;
+		/// @brief Same, only when the list changed since knownVersion, which is then updated.
+		/// @return False when drawList was left untouched.
+		bool GetDrawListIfChanged(std::vector<SectionDrawInfo>& drawList, uint64_t& knownVersion) const;
+		Stats GetStats() const;
+
+	  private:
+		struct SectionTicket
+		{
+			std::atomic<uint32_t> Version{0};
+		};
+
+		struct MeshJob
+		{
+			LodCoord Coord;
+			uint32_t Version = 0;
+			std::shared_ptr<SectionTicket> Ticket;
+			SectionSnapshot Snapshot; // Captured on the world thread at level 0, downsampled from Region otherwise
+			SectionRegion Region;
+		};
+
+		struct MeshResult
+		{
+			LodCoord Coord;
+			uint32_t Version = 0;
+			std::shared_ptr<SectionTicket> Ticket;
+			SectionMesh Mesh;
+			bool Removed = false; // The chunk is unloaded or the mesh evicted, rather than the section empty
+		};
+
+		struct RetiredBuffer
+		{
+			uint64_t ReleaseFrame;
+			SectionMeshBuffer Buffer;
+		};
+
+		std::shared_ptr<SectionTicket>& GetTicket(const LodCoord& coord);
+		void MarkDirty(const LodCoord& coord);
+		/// @brief Moves the dirty meshes between the selected and idle sets, and evicts the oldest cached meshes.
+		void UpdateSelection(ChunkCoord cameraChunk);
+		void RunJob(MeshJob& job);
+		void PushEmptyResult(const LodCoord& coord,
+							 uint32_t version,
+							 std::shared_ptr<SectionTicket> ticket,
+							 bool removed);
+
+		void Retire(SectionMeshBuffer&& buffer, uint64_t pickedUpFrameCount);
+		void ReleaseRetired(uint64_t pickedUpFrameCount);
+		void PublishDrawList();
+
+	  private:
+		// Frames of the render queue that may still reference a replaced mesh
+		static constexpr uint64_t FramesInFlight = 3;
+
+		JobSystem& m_Jobs;
+		std::vector<std::unique_ptr<ChunkMesher>> m_Meshers; // One per worker
+		const size_t m_MaxInFlight;
+
+		// ----- World thread -----
+		LodSelector m_LodSelector{FullDetailDistance, RenderDistance};
+		std::unordered_map<LodCoord, std::shared_ptr<SectionTicket>, LodCoordHash> m_Tickets;
+		std::unordered_set<LodCoord, LodCoordHash> m_Dirty;	 // Selected
+		std::unordered_set<LodCoord, LodCoordHash> m_DirtyIdle; // Not selected, dispatched once selected again
+		std::unordered_set<LodCoord, LodCoordHash> m_Meshed;	 // Dispatched, resident once the result is applied
+		std::unordered_map<LodCoord, uint64_t, LodCoordHash> m_Cached; // Meshed and not selected, since which version
+		std::vector<LodCoord> m_Candidates;
+
+		// ----- Workers to GL thread -----
+		MpscQueue<std::unique_ptr<MeshResult>> m_Completed;
+		std::atomic<size_t> m_InFlightCount{0};
+
+		// ----- GL thread -----
+		SectionArenaPool m_Arenas;
+		std::unordered_map<LodCoord, SectionMeshBuffer, LodCoordHash> m_Buffers;
+		std::unordered_map<LodCoord, SectionConnectivity, LodCoordHash> m_Connectivity; // Every meshed section
+		std::vector<RetiredBuffer> m_Retired;
+		std::array<LevelStats, LodLevelCount> m_Levels; // Of m_Buffers
+
+		// ----- GL thread to logic thread -----
+		mutable std::mutex m_DrawListMutex;
+		std::vector<SectionDrawInfo> m_DrawList;
+		uint64_t m_DrawListVersion = 0;
+		std::array<LevelStats, LodLevelCount> m_PublishedLevels; // Copy of m_Levels for GetStats()
+
+		// ----- Stats -----
+		std::atomic<size_t> m_DirtyCount{0};
+		std::atomic<size_t> m_ResidentCount{0};
+		std::atomic<size_t> m_ArenaCount{0};
+		std::atomic<uint64_t> m_ArenaUsedBytes{0};
+		std::atomic<uint64_t> m_CompletedCount{0};
+		std::atomic<uint64_t> m_CancelledCount{0};
+		std::atomic<uint32_t> m_LastUploadCount{0};
+		std::atomic<size_t> m_LastUploadBytes{0};
+		std::atomic<double> m_LastUploadMilliseconds{0.0};
+	};
+} // namespace onion::voxel
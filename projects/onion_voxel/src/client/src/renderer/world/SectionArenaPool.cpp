@@ -0,0 +1,143 @@
+#include "SectionArenaPool.hpp"
+
+#include <iostream>
+
+#include "../gl_state/GLExtensions.hpp"
+#include "../gl_state/GLStateCache.hpp"
+
+namespace onion::voxel
+{
+	// -------- Allocation --------
+
+	SectionArenaPool::Range SectionArenaPool::Allocate(uint32_t quadCount)
+	{
+		if (quadCount == 0)
+			return {};
+
+		const uint32_t capacity = (quadCount + QuadGranularity - 1) / QuadGranularity * QuadGranularity;
+
+		for (size_t arena = 0; arena < m_Arenas.size(); arena++)
+		{
+			const uint32_t first = m_Arenas[arena].Allocator.Allocate(capacity);
+			if (first != RangeAllocator::InvalidOffset)
+				return {static_cast<uint16_t>(arena), first, capacity};
+		}
+
+		CreateArena();
+		const uint32_t first = m_Arenas.back().Allocator.Allocate(capacity);
+		return {static_cast<uint16_t>(m_Arenas.size() - 1), first, capacity};
+	}
+
+	void SectionArenaPool::Write(const Range& range, std::span<const VoxelVertex> vertices)
+	{
+		if (vertices.empty())
+			return;
+
+		glBindBuffer(GL_ARRAY_BUFFER, m_Arenas[range.Arena].VBO);
+		glBufferSubData(GL_ARRAY_BUFFER,
+						static_cast<GLintptr>(range.FirstQuad) * 4 * sizeof(VoxelVertex),
+						static_cast<GLsizeiptr>(vertices.size_bytes()),
+						vertices.data());
+	}
+
+	void SectionArenaPool::Free(Range& range)
+	{
+		if (!range.IsValid())
+			return;
+
+		m_Arenas[range.Arena].Allocator.Free(range.FirstQuad, range.CapacityQuads);
+		range = {};
+	}
+
+	void SectionArenaPool::Delete()
+	{
+		for (Arena& arena : m_Arenas)
+		{
+			GLStateCache::DeleteVertexArray(arena.VAO);
+			glDeleteBuffers(1, &arena.VBO);
+		}
+		m_Arenas.clear();
+
+		if (m_QuadIndices != 0)
+		{
+			glDeleteBuffers(1, &m_QuadIndices);
+			m_QuadIndices = 0;
+		}
+	}
+
+	// -------- Stats --------
+
+	uint64_t SectionArenaPool::GetUsedBytes() const
+	{
+		uint64_t quads = 0;
+		for (const Arena& arena : m_Arenas)
+			quads += arena.Allocator.GetUsed();
+		return quads * 4 * sizeof(VoxelVertex);
+	}
+
+	uint64_t SectionArenaPool::GetCapacityBytes() const
+	{
+		return static_cast<uint64_t>(m_Arenas.size()) * ArenaQuads * 4 * sizeof(VoxelVertex);
+	}
+
+	const VertexLayout& SectionArenaPool::GetDrawOriginLayout()
+	{
+		static const VertexLayout layout{sizeof(float) * 4, {{1, 4, GL_FLOAT}}};
+		return layout;
+	}
+
+	// -------- Private --------
+
+	void SectionArenaPool::CreateArena()
+	{
+		Arena& arena = m_Arenas.emplace_back();
+		arena.Allocator = RangeAllocator(ArenaQuads);
+
+		glGenVertexArrays(1, &arena.VAO);
+		glGenBuffers(1, &arena.VBO);
+
+		GLStateCache::BindVertexArray(arena.VAO);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, GetSharedIndices());
+		glBindBuffer(GL_ARRAY_BUFFER, arena.VBO);
+		glBufferData(GL_ARRAY_BUFFER,
+					 static_cast<GLsizeiptr>(ArenaQuads) * 4 * sizeof(VoxelVertex),
+					 nullptr,
+					 GL_STATIC_DRAW);
+
+		glEnableVertexAttribArray(0);
+		glVertexAttribIPointer(0, 2, GL_UNSIGNED_INT, sizeof(VoxelVertex), nullptr);
+
+		// Pointed at the streamed origins by each indirect command, one per draw through BaseInstance
+		if (GLExtensions::HasMultiDrawIndirect())
+		{
+			glEnableVertexAttribArray(1);
+			glVertexAttribDivisor(1, 1);
+		}
+
+		std::cout << "[WORLD] : Section arena " << m_Arenas.size() << " created ("
+				  << GetCapacityBytes() / (1024 * 1024) << " MiB of vertices in total)" << std::endl;
+	}
+
+	GLuint SectionArenaPool::GetSharedIndices()
+	{
+		if (m_QuadIndices != 0)
+			return m_QuadIndices;
+
+		std::vector<uint32_t> indices;
+		indices.reserve(static_cast<size_t>(MaxDrawQuads) * 6);
+		for (uint32_t quad = 0; quad < MaxDrawQuads; quad++)
+		{
+			const uint32_t first = quad * 4;
+			indices.insert(indices.end(), {first, first + 1, first + 2, first + 2, first + 3, first});
+		}
+
+		glGenBuffers(1, &m_QuadIndices);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_QuadIndices);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+					 static_cast<GLsizeiptr>(indices.size() * sizeof(uint32_t)),
+					 indices.data(),
+					 GL_STATIC_DRAW);
+
+		return m_QuadIndices;
+	}
+} // namespace onion::voxel
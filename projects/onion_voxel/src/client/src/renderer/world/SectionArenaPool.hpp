@@ -0,0 +1,84 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <world/WorldCoordinates.hpp>
+
+#include "../buffers/RangeAllocator.hpp"
+#include "../buffers/VertexLayout.hpp"
+#include "VoxelVertex.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Large vertex buffers shared by every section mesh, each with its VAO. GL thread only.
+	///
+	/// Sections sharing an arena are drawn without rebinding anything : by one glMultiDrawElementsIndirect per
+	/// render layer when available, or one glDrawElementsBaseVertex each otherwise. Every arena uses the same quad
+	/// index buffer, a draw starts at index 0 and offsets its vertices with BaseVertex.
+	class SectionArenaPool
+	{
+	  public:
+		/// @brief Quads of one arena, 32 MiB of vertices. About ten thousand sections of average terrain.
+		static constexpr uint32_t ArenaQuads = 1u << 20;
+		/// @brief Ranges are rounded up to it, for fewer holes too small to be reused.
+		static constexpr uint32_t QuadGranularity = 16;
+		/// @brief Quads of the shared index buffer, the largest single draw : a render layer of a section where every
+		/// block shows its 6 faces. A checkerboard of two blocks that don't hide each other's faces (stone and
+		/// leaves, leaves not being opaque) gets close to it.
+		static constexpr uint32_t MaxDrawQuads = ChunkSize * ChunkSize * ChunkSize * 6;
+
+		struct Range
+		{
+			uint16_t Arena = 0;
+			uint32_t FirstQuad = 0;
+			uint32_t CapacityQuads = 0;
+
+			bool IsValid() const { return CapacityQuads > 0; }
+		};
+
+		SectionArenaPool() = default;
+		~SectionArenaPool() = default;
+
+		SectionArenaPool(const SectionArenaPool&) = delete;
+		SectionArenaPool& operator=(const SectionArenaPool&) = delete;
+
+		/// @brief Room for quadCount quads in the first arena that has it, a new arena is created when none has.
+		Range Allocate(uint32_t quadCount);
+		/// @brief Writes from the first quad of the range, the vertices must fit in it.
+		void Write(const Range& range, std::span<const VoxelVertex> vertices);
+		/// @brief Returns the range to its arena and invalidates it.
+		void Free(Range& range);
+		void Delete();
+
+		GLuint GetVertexArray(uint16_t arena) const { return m_Arenas[arena].VAO; }
+
+		size_t GetArenaCount() const { return m_Arenas.size(); }
+		uint64_t GetUsedBytes() const;
+		uint64_t GetCapacityBytes() const;
+
+		/// @brief Per draw origin and scale of the sections (location 1, one vec4 per draw), streamed with the
+		/// indirect commands. The arenas only enable it when multi draw indirect is available, the fallback path
+		/// leaves the attribute at its default of (0, 0, 0, 1) and sets uChunkOrigin and uChunkScale instead.
+		static const VertexLayout& GetDrawOriginLayout();
+
+	  private:
+		struct Arena
+		{
+			GLuint VAO = 0;
+			GLuint VBO = 0;
+			RangeAllocator Allocator;
+		};
+
+		void CreateArena();
+		GLuint GetSharedIndices();
+
+	  private:
+		std::vector<Arena> m_Arenas;
+		GLuint m_QuadIndices = 0;
+	};
+} // namespace onion::voxel
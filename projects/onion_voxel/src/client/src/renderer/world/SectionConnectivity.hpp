@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+#include "VoxelVertex.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Which faces of a section can see each other through its non-opaque blocks.
+	///
+	/// Two faces are connected when a path of non-opaque blocks, moving between blocks sharing a face, goes from one to
+	/// the other. The occlusion culling of WorldRenderer only walks through a section from the face it entered by to
+	/// the faces connected to it.
+	class SectionConnectivity
+	{
+	  public:
+		/// @brief Nothing connected, a section full of opaque blocks.
+		SectionConnectivity() = default;
+
+		/// @brief Every face connected, an empty section or one not meshed yet.
+		static SectionConnectivity All()
+		{
+			SectionConnectivity connectivity;
+			connectivity.ConnectFaces(AllFacesMask);
+			return connectivity;
+		}
+
+		/// @brief Connects every pair of the faces in the mask, bit i being BlockFace i.
+		void ConnectFaces(uint8_t faceMask)
+		{
+			for (int face = 0; face < FaceCount; face++)
+				if (faceMask & (1u << face))
+					m_Bits |= static_cast<uint64_t>(faceMask) << (face * FaceCount);
+		}
+
+		bool IsConnected(BlockFace from, BlockFace to) const
+		{
+			return (m_Bits >> (static_cast<int>(from) * FaceCount + static_cast<int>(to))) & 1u;
+		}
+
+		bool IsEmpty() const { return m_Bits == 0; }
+
+		bool operator==(const SectionConnectivity&) const = default;
+
+	  public:
+		static constexpr int FaceCount = static_cast<int>(BlockFace::Count);
+		static constexpr uint8_t AllFacesMask = (1u << FaceCount) - 1;
+
+	  private:
+		uint64_t m_Bits = 0; // Row per face, bit FaceCount * from + to
+	};
+} // namespace onion::voxel
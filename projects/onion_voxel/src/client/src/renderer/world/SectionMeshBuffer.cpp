@@ -0,0 +1,144 @@
+#include "SectionMeshBuffer.hpp"
+
+#include <iostream>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "../render_queue/CommandBuffer.hpp"
+#include "../shader/shader.hpp"
+#include "../texture/TextureArray.hpp"
+
+namespace onion::voxel
+{
+	// -------- Constructor / Destructor --------
+
+	SectionMeshBuffer::SectionMeshBuffer(SectionMeshBuffer&& other) noexcept
+		: m_Opaque(other.m_Opaque), m_Transparent(other.m_Transparent)
+	{
+		other.m_Opaque = {};
+		other.m_Transparent = {};
+	}
+
+	SectionMeshBuffer& SectionMeshBuffer::operator=(SectionMeshBuffer&& other) noexcept
+	{
+		if (this != &other)
+		{
+			std::swap(m_Opaque, other.m_Opaque);
+			std::swap(m_Transparent, other.m_Transparent);
+		}
+		return *this;
+	}
+
+	// -------- Upload --------
+
+	void SectionMeshBuffer::Upload(const SectionMesh& mesh, SectionArenaPool& arenas)
+	{
+		UploadLayer(m_Opaque, mesh.OpaqueVertices, arenas);
+		UploadLayer(m_Transparent, mesh.TransparentVertices, arenas);
+	}
+
+	void SectionMeshBuffer::UploadLayer(LayerBuffer& layer,
+										const std::vector<VoxelVertex>& vertices,
+										SectionArenaPool& arenas)
+	{
+		layer.QuadCount = static_cast<uint32_t>(vertices.size() / 4);
+		if (layer.QuadCount == 0)
+			return;
+
+		// Draws index the shared quad indices from 0, quads past them would read beyond the index buffer
+		if (layer.QuadCount > MaxQuads)
+		{
+			std::cout << "[WORLD] [WARNING] : Section layer of " << layer.QuadCount << " quads clamped to " << MaxQuads
+					  << std::endl;
+			layer.QuadCount = MaxQuads;
+		}
+
+		if (layer.QuadCount > layer.Range.CapacityQuads)
+		{
+			arenas.Free(layer.Range);
+			layer.Range = arenas.Allocate(layer.QuadCount);
+		}
+
+		arenas.Write(layer.Range, std::span(vertices).first(static_cast<size_t>(layer.QuadCount) * 4));
+	}
+
+	// -------- Recording --------
+
+	SectionDrawInfo SectionMeshBuffer::GetDrawInfo(const SectionCoord& coord, const SectionArenaPool& arenas) const
+	{
+		SectionDrawInfo info;
+		info.Coord = coord;
+
+		if (m_Opaque.QuadCount > 0)
+		{
+			info.OpaqueVertexArray = arenas.GetVertexArray(m_Opaque.Range.Arena);
+			info.OpaqueFirstQuad = m_Opaque.Range.FirstQuad;
+			info.OpaqueQuadCount = m_Opaque.QuadCount;
+		}
+
+		if (m_Transparent.QuadCount > 0)
+		{
+			info.TransparentVertexArray = arenas.GetVertexArray(m_Transparent.Range.Arena);
+			info.TransparentFirstQuad = m_Transparent.Range.FirstQuad;
+			info.TransparentQuadCount = m_Transparent.QuadCount;
+		}
+
+		return info;
+	}
+
+	void SectionMeshBuffer::Record(CommandBuffer& commandBuffer,
+								   const SectionDrawInfo& section,
+								   const Shader& shader,
+								   const TextureArray& blockTextures,
+								   float depth)
+	{
+		const uint16_t textureId = SortKey::FromPointer(&blockTextures);
+		const glm::vec3 origin = section.GetOrigin();
+		const float scale = static_cast<float>(1 << section.Level);
+
+		if (section.OpaqueQuadCount > 0)
+		{
+			RenderState state;
+			state.CullFace = true;
+
+			commandBuffer.Begin(SortKey::Make(RenderPass::Opaque, shader.GetSortId(), textureId, depth),
+								shader,
+								section.OpaqueVertexArray,
+								state);
+			commandBuffer.SetUniform("uChunkOrigin", origin);
+			commandBuffer.SetUniform("uChunkScale", scale);
+			commandBuffer.BindTexture(0, blockTextures);
+			commandBuffer.DrawElementsBaseVertex(GL_TRIANGLES,
+												 section.OpaqueQuadCount * 6,
+												 static_cast<int32_t>(section.OpaqueFirstQuad * 4));
+		}
+
+		if (section.TransparentQuadCount > 0)
+		{
+			RenderState state;
+			state.Blend = true;
+
+			commandBuffer.Begin(SortKey::Make(RenderPass::Transparent, shader.GetSortId(), textureId, depth),
+								shader,
+								section.TransparentVertexArray,
+								state);
+			commandBuffer.SetUniform("uChunkOrigin", origin);
+			commandBuffer.SetUniform("uChunkScale", scale);
+			commandBuffer.BindTexture(0, blockTextures);
+			commandBuffer.DrawElementsBaseVertex(GL_TRIANGLES,
+												 section.TransparentQuadCount * 6,
+												 static_cast<int32_t>(section.TransparentFirstQuad * 4));
+		}
+	}
+
+	// -------- Delete --------
+
+	void SectionMeshBuffer::Delete(SectionArenaPool& arenas)
+	{
+		arenas.Free(m_Opaque.Range);
+		arenas.Free(m_Transparent.Range);
+		m_Opaque = {};
+		m_Transparent = {};
+	}
+} // namespace onion::voxel
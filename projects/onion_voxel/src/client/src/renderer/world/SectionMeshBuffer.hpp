@@ -0,0 +1,91 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "ChunkMesher.hpp"
+#include "SectionArenaPool.hpp"
+
+namespace onion::voxel
+{
+	class CommandBuffer;
+	class Shader;
+	class TextureArray;
+
+	/// @brief What the logic thread needs to record the draws of a resident section. The arena ranges stay untouched
+	/// for a few frames after the section is replaced or unloaded, see MeshingPipeline.
+	struct SectionDrawInfo
+	{
+		SectionCoord Coord; // In units of 2^Level sections, see LodCoord
+		uint8_t Level = 0;
+		GLuint OpaqueVertexArray = 0; // Of the arena holding the layer
+		uint32_t OpaqueFirstQuad = 0;
+		uint32_t OpaqueQuadCount = 0;
+		GLuint TransparentVertexArray = 0;
+		uint32_t TransparentFirstQuad = 0;
+		uint32_t TransparentQuadCount = 0;
+		SectionConnectivity Connectivity;
+
+		bool HasQuads() const { return OpaqueQuadCount > 0 || TransparentQuadCount > 0; }
+
+		/// @brief Blocks along each axis.
+		float GetSize() const { return static_cast<float>(ChunkSize << Level); }
+		/// @brief World position of the minimum corner.
+		glm::vec3 GetOrigin() const { return glm::vec3(Coord.x, Coord.y, Coord.z) * GetSize(); }
+	};
+
+	/// @brief GPU copy of a SectionMesh : a range of a SectionArenaPool per render layer. GL thread only.
+	class SectionMeshBuffer
+	{
+	  public:
+		/// @brief Most quads of a render layer in a section.
+		static constexpr uint32_t MaxQuads = SectionArenaPool::MaxDrawQuads;
+
+		SectionMeshBuffer() = default;
+		~SectionMeshBuffer() = default;
+
+		SectionMeshBuffer(const SectionMeshBuffer&) = delete;
+		SectionMeshBuffer& operator=(const SectionMeshBuffer&) = delete;
+
+		SectionMeshBuffer(SectionMeshBuffer&& other) noexcept;
+		SectionMeshBuffer& operator=(SectionMeshBuffer&& other) noexcept;
+
+		/// @brief Replaces the GPU vertices, the ranges are reused while the new mesh fits.
+		void Upload(const SectionMesh& mesh, SectionArenaPool& arenas);
+		/// @brief Returns the ranges to the arenas.
+		void Delete(SectionArenaPool& arenas);
+
+		bool IsEmpty() const { return m_Opaque.QuadCount == 0 && m_Transparent.QuadCount == 0; }
+		uint32_t GetQuadCount() const { return m_Opaque.QuadCount + m_Transparent.QuadCount; }
+
+		SectionDrawInfo GetDrawInfo(const SectionCoord& coord, const SectionArenaPool& arenas) const;
+
+		/// @brief Records one draw per layer, any thread. The shader needs uViewProjection as a frame uniform.
+		/// The vertices of coarser levels of detail are scaled by uChunkScale.
+		/// Used without multi draw indirect, WorldRenderer batches the sections otherwise.
+		/// @param depth Normalized distance to the camera, for the sort keys.
+		static void Record(CommandBuffer& commandBuffer,
+						   const SectionDrawInfo& section,
+						   const Shader& shader,
+						   const TextureArray& blockTextures,
+						   float depth);
+
+	  private:
+		struct LayerBuffer
+		{
+			SectionArenaPool::Range Range;
+			uint32_t QuadCount = 0;
+		};
+
+		static void UploadLayer(LayerBuffer& layer,
+								const std::vector<VoxelVertex>& vertices,
+								SectionArenaPool& arenas);
+
+	  private:
+		LayerBuffer m_Opaque;
+		LayerBuffer m_Transparent;
+	};
+} // namespace onion::voxel
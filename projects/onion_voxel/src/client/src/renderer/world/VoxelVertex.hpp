@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+#include <world/BlockFace.hpp>
+
+namespace onion::voxel
+{
+	/// @brief A chunk section vertex packed in 8 bytes, decoded by voxel.vert.
+	///
+	/// Data0 : X [0, 6) | Y [6, 12) | Z [12, 18) | normal [18, 21) | ambient occlusion [21, 23)
+	/// Data1 : texture layer [0, 16) | block light [16, 22) | sky light [22, 28)
+	///
+	/// Positions are corners relative to the section origin, in [0, 16], so they need 5 bits and the 6th is spare.
+	/// Coarser levels of detail keep the same range, voxel.vert scales them. Ambient occlusion goes from 0 (darkest)
+	/// to 3 (none). Lights are the average of the 4 blocks around the corner, times 4 to stay exact : [0, 60].
+	struct VoxelVertex
+	{
+		uint32_t Data0;
+		uint32_t Data1;
+
+		static constexpr VoxelVertex Pack(uint32_t x,
+										  uint32_t y,
+										  uint32_t z,
+										  BlockFace face,
+										  uint32_t ambientOcclusion,
+										  uint32_t layer,
+										  uint32_t blockLight,
+										  uint32_t skyLight)
+		{
+			return {x | (y << 6) | (z << 12) | (static_cast<uint32_t>(face) << 18) | (ambientOcclusion << 21),
+					layer | (blockLight << 16) | (skyLight << 22)};
+		}
+
+		constexpr uint32_t GetX() const { return Data0 & 63; }
+		constexpr uint32_t GetY() const { return (Data0 >> 6) & 63; }
+		constexpr uint32_t GetZ() const { return (Data0 >> 12) & 63; }
+		constexpr BlockFace GetFace() const { return static_cast<BlockFace>((Data0 >> 18) & 7); }
+		constexpr uint32_t GetAmbientOcclusion() const { return (Data0 >> 21) & 3; }
+		constexpr uint32_t GetLayer() const { return Data1 & 0xFFFF; }
+		constexpr uint32_t GetBlockLight() const { return (Data1 >> 16) & 63; }
+		constexpr uint32_t GetSkyLight() const { return (Data1 >> 22) & 63; }
+	};
+
+	static_assert(sizeof(VoxelVertex) == 8);
+} // namespace onion::voxel
@@ -0,0 +1,386 @@
+#include "WorldRenderer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+
+#include "../Variables.hpp"
+#include "../gl_state/GLExtensions.hpp"
+#include "../render_queue/CommandBuffer.hpp"
+#include "../render_queue/RenderQueue.hpp"
+
+namespace onion::voxel
+{
+	namespace
+	{
+		float GetDistance(const SectionDrawInfo& section, const glm::vec3& position)
+		{
+			return glm::length(section.GetOrigin() + section.GetSize() * 0.5f - position);
+		}
+
+		// Section offset across each face, in BlockFace order
+		const glm::ivec3 FaceOffsets[static_cast<int>(BlockFace::Count)] = {
+			{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+
+		std::vector<std::string> GetBlockTextureFilePaths(const BlockAppearanceTable& appearances)
+		{
+			std::vector<std::string> filePaths;
+			for (const std::string& path : appearances.GetTexturePaths())
+				filePaths.push_back((GetAssetsPath() / path).string());
+			return filePaths;
+		}
+	} // namespace
+
+	WorldRenderer::WorldRenderer(JobSystem& jobs)
+		: m_Appearances(BlockAppearanceTable::CreateDefault()),
+		  m_BlockTextures("blocks", GetBlockTextureFilePaths(m_Appearances)),
+		  m_Shader((GetAssetsPath() / "shaders/voxel.vert").string().c_str(),
+				   (GetAssetsPath() / "shaders/voxel.frag").string().c_str()),
+		  m_Meshing(jobs, m_Appearances)
+	{
+	}
+
+	// -------- GL thread --------
+
+	void WorldRenderer::Initialize()
+	{
+		m_BlockTextures.Load();
+	}
+
+	void WorldRenderer::Update(const RenderQueue& renderQueue,
+							   double uploadBudgetMilliseconds,
+							   size_t uploadBudgetBytes)
+	{
+		m_Meshing.UploadCompleted(uploadBudgetMilliseconds, uploadBudgetBytes, renderQueue.GetPickedUpFrameCount());
+	}
+
+	void WorldRenderer::Delete()
+	{
+		m_Meshing.Delete();
+		m_BlockTextures.Delete();
+		m_Shader.Delete();
+	}
+
+	// -------- World thread --------
+
+	void WorldRenderer::Record(CommandBuffer& commandBuffer, const Camera& camera)
+	{
+		const glm::mat4 viewProjection = camera.GetViewProjectionMatrix();
+		const glm::vec3& cameraPosition = camera.GetPosition();
+
+		commandBuffer.SetFrameUniform(m_Shader, "uViewProjection", viewProjection);
+
+		const LodSelector& selector = m_Meshing.GetLodSelector();
+		const bool drawListChanged = m_Meshing.GetDrawListIfChanged(m_Sections, m_DrawListVersion);
+		if (drawListChanged || selector.GetVersion() != m_LodVersion)
+		{
+			m_LodVersion = selector.GetVersion();
+			SelectDrawList(selector);
+
+			m_Culler.Clear();
+			m_Culler.Reserve(m_DrawList.size());
+			m_SectionIndices.clear();
+			m_MeshedCount = 0;
+
+			for (const SectionDrawInfo& section : m_DrawList)
+			{
+				const glm::vec3 min = section.GetOrigin();
+				const uint32_t index = m_Culler.Add(min, min + glm::vec3(section.GetSize()));
+
+				if (section.Level == 0)
+					m_SectionIndices.emplace(section.Coord, index);
+				m_MeshedCount += section.HasQuads() ? 1 : 0;
+			}
+		}
+
+		// -------- Frustum --------
+		const auto cullStart = std::chrono::steady_clock::now();
+		m_Culler.Cull(Frustum::FromViewProjection(viewProjection), m_VisibleIndices);
+		const auto cullEnd = std::chrono::steady_clock::now();
+
+		m_InFrustum.assign(m_DrawList.size(), 0);
+		size_t frustumCount = 0;
+		for (uint32_t index : m_VisibleIndices)
+		{
+			m_InFrustum[index] = 1;
+			frustumCount += m_DrawList[index].HasQuads() ? 1 : 0;
+		}
+
+		// -------- Occlusion --------
+		const BlockPos cameraBlock{static_cast<int32_t>(std::floor(cameraPosition.x)),
+								   static_cast<int32_t>(std::floor(cameraPosition.y)),
+								   static_cast<int32_t>(std::floor(cameraPosition.z))};
+
+		const bool occlusionCulled =
+			m_OcclusionCulling && CollectReachableSections(SectionCoord::FromBlock(cameraBlock), m_DrawIndices);
+		if (!occlusionCulled)
+			m_DrawIndices.clear();
+
+		// Coarser levels are only frustum culled
+		for (uint32_t index : m_VisibleIndices)
+			if (m_DrawList[index].HasQuads() && (!occlusionCulled || m_DrawList[index].Level > 0))
+				m_DrawIndices.push_back(index);
+		const auto occlusionEnd = std::chrono::steady_clock::now();
+
+		m_FrameStats.SectionCount = m_MeshedCount;
+		m_FrameStats.FrustumCount = frustumCount;
+		m_FrameStats.VisibleCount = m_DrawIndices.size();
+		m_FrameStats.OcclusionCulled = occlusionCulled;
+		m_FrameStats.CullMicroseconds = std::chrono::duration<double, std::micro>(cullEnd - cullStart).count();
+		m_FrameStats.OcclusionMicroseconds =
+			std::chrono::duration<double, std::micro>(occlusionEnd - cullEnd).count();
+		m_FrameStats.DrawCalls = 0;
+		m_FrameStats.IndirectDraws = 0;
+		m_FrameStats.MultiDrawIndirect = GLExtensions::HasMultiDrawIndirect();
+
+		m_FrameStats.Levels = {};
+		for (uint32_t index : m_DrawIndices)
+		{
+			const SectionDrawInfo& section = m_DrawList[index];
+			LevelFrameStats& level = m_FrameStats.Levels[section.Level];
+			level.DrawnCount++;
+			level.VertexCount += (section.OpaqueQuadCount + section.TransparentQuadCount) * 4ull;
+		}
+
+		if (m_FrameStats.MultiDrawIndirect)
+		{
+			RecordBatches(commandBuffer, cameraPosition);
+			return;
+		}
+
+		for (uint32_t index : m_DrawIndices)
+		{
+			const SectionDrawInfo& section = m_DrawList[index];
+			const float depth = std::min(GetDistance(section, cameraPosition) / MaxSortDistance, 1.f);
+
+			SectionMeshBuffer::Record(commandBuffer, section, m_Shader, m_BlockTextures, depth);
+			m_FrameStats.DrawCalls += section.OpaqueQuadCount > 0 ? 1 : 0;
+			m_FrameStats.DrawCalls += section.TransparentQuadCount > 0 ? 1 : 0;
+		}
+	}
+
+	void WorldRenderer::RecordBatches(CommandBuffer& commandBuffer, const glm::vec3& cameraPosition)
+	{
+		for (DrawBatch& batch : m_Batches)
+		{
+			batch.Draws.clear();
+			batch.Origins.clear();
+		}
+
+		auto addDraw = [this](GLuint vertexArray,
+							  bool transparent,
+							  uint32_t firstQuad,
+							  uint32_t quadCount,
+							  const SectionDrawInfo& section)
+		{
+			auto it = std::find_if(m_Batches.begin(),
+								   m_Batches.end(),
+								   [&](const DrawBatch& batch)
+								   { return batch.VertexArray == vertexArray && batch.Transparent == transparent; });
+			DrawBatch& batch = it != m_Batches.end() ? *it : m_Batches.emplace_back(vertexArray, transparent);
+
+			// BaseInstance picks the origin of the draw in the instanced attribute
+			batch.Draws.push_back({quadCount * 6,
+								   1,
+								   0,
+								   static_cast<GLint>(firstQuad * 4),
+								   static_cast<GLuint>(batch.Origins.size())});
+			batch.Origins.emplace_back(section.GetOrigin(), static_cast<float>(1 << section.Level));
+		};
+
+		// Opaque in walk order, about front to back. Transparent sorted back to front for blending.
+		m_TransparentIndices.clear();
+		for (uint32_t index : m_DrawIndices)
+		{
+			const SectionDrawInfo& section = m_DrawList[index];
+			if (section.OpaqueQuadCount > 0)
+				addDraw(section.OpaqueVertexArray,
+						false,
+						section.OpaqueFirstQuad,
+						section.OpaqueQuadCount,
+						section);
+			if (section.TransparentQuadCount > 0)
+				m_TransparentIndices.push_back(index);
+		}
+
+		std::sort(m_TransparentIndices.begin(),
+				  m_TransparentIndices.end(),
+				  [&](uint32_t a, uint32_t b)
+				  {
+					  return GetDistance(m_DrawList[a], cameraPosition) > GetDistance(m_DrawList[b], cameraPosition);
+				  });
+
+		for (uint32_t index : m_TransparentIndices)
+		{
+			const SectionDrawInfo& section = m_DrawList[index];
+			addDraw(section.TransparentVertexArray,
+					true,
+					section.TransparentFirstQuad,
+					section.TransparentQuadCount,
+					section);
+		}
+
+		const uint16_t textureId = SortKey::FromPointer(&m_BlockTextures);
+
+		for (const DrawBatch& batch : m_Batches)
+		{
+			if (batch.Draws.empty())
+				continue;
+
+			RenderState state;
+			state.CullFace = !batch.Transparent;
+			state.Blend = batch.Transparent;
+
+			const RenderPass pass = batch.Transparent ? RenderPass::Transparent : RenderPass::Opaque;
+			commandBuffer.Begin(SortKey::Make(pass, m_Shader.GetSortId(), textureId, 0.f),
+								m_Shader,
+								batch.VertexArray,
+								state);
+			commandBuffer.SetUniform("uChunkOrigin", glm::vec3(0.f));
+			commandBuffer.SetUniform("uChunkScale", 1.f);
+			commandBuffer.BindTexture(0, m_BlockTextures);
+			commandBuffer.StreamVertices(SectionArenaPool::GetDrawOriginLayout(),
+										 batch.Origins.data(),
+										 batch.Origins.size() * sizeof(glm::vec4));
+			commandBuffer.MultiDrawElementsIndirect(GL_TRIANGLES,
+													batch.Draws.data(),
+													static_cast<uint32_t>(batch.Draws.size()));
+
+			m_FrameStats.DrawCalls++;
+			m_FrameStats.IndirectDraws += static_cast<uint32_t>(batch.Draws.size());
+		}
+	}
+
+	void WorldRenderer::SelectDrawList(const LodSelector& selector)
+	{
+		m_ResidentIndices.clear();
+		for (uint32_t i = 0; i < m_Sections.size(); i++)
+			m_ResidentIndices.emplace(LodCoord{m_Sections[i].Coord, m_Sections[i].Level}, i);
+
+		m_DrawList.clear();
+		m_Chosen.assign(m_Sections.size(), 0);
+
+		// False when the mesh is not resident
+		auto choose = [this](const LodCoord& coord)
+		{
+			auto it = m_ResidentIndices.find(coord);
+			if (it == m_ResidentIndices.end())
+				return false;
+
+			if (!m_Chosen[it->second])
+			{
+				m_Chosen[it->second] = 1;
+				m_DrawList.push_back(m_Sections[it->second]);
+			}
+			return true;
+		};
+
+		auto isResident = [this](const LodCoord& coord) { return m_ResidentIndices.contains(coord); };
+
+		// A stand-in among the ancestors, the mesh is inside of it
+		auto isCovered = [this](LodCoord coord)
+		{
+			while (coord.Level + 1 < LodLevelCount)
+			{
+				coord = coord.GetParent();
+				if (m_StandIns.contains(coord))
+					return true;
+			}
+			return false;
+		};
+
+		// The nearest resident ancestor of each selected mesh not resident
+		m_StandIns.clear();
+		for (const LodCoord& coord : selector.GetSelected())
+		{
+			if (isResident(coord))
+				continue;
+
+			for (LodCoord parent = coord; parent.Level + 1 < LodLevelCount;)
+			{
+				parent = parent.GetParent();
+				if (isResident(parent))
+				{
+					m_StandIns.insert(parent);
+					break;
+				}
+			}
+		}
+
+		// Drawn alone, neither with the selected meshes they contain nor with a coarser stand-in containing them
+		for (const LodCoord& standIn : m_StandIns)
+		{
+			if (!isCovered(standIn))
+				choose(standIn);
+		}
+
+		for (const LodCoord& coord : selector.GetSelected())
+		{
+			if (isCovered(coord) || choose(coord) || coord.Level == 0)
+				continue;
+
+			// No coarser mesh either
+			for (int y = 0; y < 2; y++)
+				for (int z = 0; z < 2; z++)
+					for (int x = 0; x < 2; x++)
+						choose({{coord.Coord.x * 2 + x, coord.Coord.y * 2 + y, coord.Coord.z * 2 + z},
+								static_cast<uint8_t>(coord.Level - 1)});
+		}
+	}
+
+	bool WorldRenderer::CollectReachableSections(const SectionCoord& cameraSection, std::vector<uint32_t>& drawIndices)
+	{
+		auto start = m_SectionIndices.find(cameraSection);
+		if (start == m_SectionIndices.end())
+			return false;
+
+		drawIndices.clear();
+		m_Reached.assign(m_DrawList.size(), 0);
+		m_OcclusionQueue.clear();
+
+		// Every face of the section holding the camera is seen from inside
+		m_Reached[start->second] = 1;
+		m_OcclusionQueue.push_back({start->second, static_cast<uint8_t>(BlockFace::Count), 0});
+
+		for (size_t next = 0; next < m_OcclusionQueue.size(); next++)
+		{
+			const OcclusionStep step = m_OcclusionQueue[next];
+			const SectionDrawInfo& section = m_DrawList[step.Index];
+
+			if (section.HasQuads())
+				drawIndices.push_back(step.Index);
+
+			for (int face = 0; face < SectionConnectivity::FaceCount; face++)
+			{
+				const BlockFace exit = static_cast<BlockFace>(face);
+				const int opposite = face ^ 1; // Faces come in +/- pairs
+
+				// Never back towards the camera : a path that went +X can't see anything by going -X
+				if (step.Directions & (1u << opposite))
+					continue;
+				if (step.EntryFace != static_cast<uint8_t>(BlockFace::Count) &&
+					!section.Connectivity.IsConnected(static_cast<BlockFace>(step.EntryFace), exit))
+					continue;
+
+				const glm::ivec3& offset = FaceOffsets[face];
+				auto neighbour = m_SectionIndices.find(
+					{section.Coord.x + offset.x, section.Coord.y + offset.y, section.Coord.z + offset.z});
+
+				// Not meshed yet, or outside of the world
+				if (neighbour == m_SectionIndices.end())
+					continue;
+
+				const uint32_t index = neighbour->second;
+				if (m_Reached[index] || !m_InFrustum[index])
+					continue;
+
+				m_Reached[index] = 1;
+				m_OcclusionQueue.push_back(
+					{index, static_cast<uint8_t>(opposite), static_cast<uint8_t>(step.Directions | (1u << face))});
+			}
+		}
+
+		return true;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <jobs/JobSystem.hpp>
+
+#include "../camera/Camera.hpp"
+#include "../camera/FrustumCuller.hpp"
+#include "../gl_state/GLExtensions.hpp"
+#include "../shader/shader.hpp"
+#include "../texture/TextureArray.hpp"
+#include "BlockAppearance.hpp"
+#include "MeshingPipeline.hpp"
+
+namespace onion::voxel
+{
+	class CommandBuffer;
+	class RenderQueue;
+
+	/// @brief Draws the chunk sections : owns the voxel shader, the block texture array and the meshing pipeline.
+	class WorldRenderer
+	{
+	  public:
+		struct LevelFrameStats
+		{
+			size_t DrawnCount = 0;
+			uint64_t VertexCount = 0;
+		};
+
+		struct FrameStats
+		{
+			size_t SectionCount = 0; // Selected and resident, with a mesh
+			size_t FrustumCount = 0; // In the view frustum
+			size_t VisibleCount = 0; // Drawn : in the frustum and reachable from the camera
+			uint32_t DrawCalls = 0;		// Recorded commands
+			uint32_t IndirectDraws = 0; // Section layers drawn by the multi draw indirect commands
+			bool MultiDrawIndirect = false;
+			double CullMicroseconds = 0.0;
+			double OcclusionMicroseconds = 0.0;
+			bool OcclusionCulled = false; // False when disabled, or when the camera is not in a meshed section
+			std::array<LevelFrameStats, LodLevelCount> Levels;
+		};
+
+		explicit WorldRenderer(JobSystem& jobs);
+
+		// ----- GL thread -----
+
+		/// @brief Starts decoding the block textures.
+		void Initialize();
+		/// @brief Uploads the meshes completed by the workers, within the budgets. Once per frame.
+		void Update(const RenderQueue& renderQueue, double uploadBudgetMilliseconds, size_t uploadBudgetBytes);
+		void Delete();
+
+		// ----- World thread -----
+
+		MeshingPipeline& GetMeshing() { return m_Meshing; }
+		const MeshingPipeline& GetMeshing() const { return m_Meshing; }
+		const BlockAppearanceTable& GetAppearances() const { return m_Appearances; }
+
+		/// @brief Records the draws of the selected levels of detail inside the camera frustum. Full detail sections
+		/// are also culled when not seen from the camera section through the non-opaque blocks.
+		void Record(CommandBuffer& commandBuffer, const Camera& camera);
+
+		void SetOcclusionCulling(bool enabled) { m_OcclusionCulling = enabled; }
+		bool IsOcclusionCulling() const { return m_OcclusionCulling; }
+
+		/// @brief Stats of the last Record().
+		const FrameStats& GetFrameStats() const { return m_FrameStats; }
+
+	  private:
+		/// @brief Picks the meshes of m_Sections to draw. A selected mesh not meshed yet is replaced by the coarser
+		/// mesh containing it, or else by the finer meshes it contains, so the terrain has no holes while the
+		/// selection changes. A coarser stand-in is drawn alone : the selected meshes it contains wait until all of
+		/// them are resident, they would overlap it otherwise.
+		void SelectDrawList(const LodSelector& selector);
+		/// @brief Breadth first walk from the camera section, through the connected faces of the sections in the
+		/// frustum, at full detail only. Collects the reached sections with quads, nearest first.
+		/// @return False when the camera section is not meshed, nothing to start from.
+		bool CollectReachableSections(const SectionCoord& cameraSection, std::vector<uint32_t>& drawIndices);
+		/// @brief One glMultiDrawElementsIndirect per arena and render layer for the sections of m_DrawIndices.
+		void RecordBatches(CommandBuffer& commandBuffer, const glm::vec3& cameraPosition);
+
+	  private:
+		struct DrawBatch
+		{
+			DrawBatch(GLuint vertexArray, bool transparent) : VertexArray(vertexArray), Transparent(transparent) {}
+
+			GLuint VertexArray;
+			bool Transparent;
+			std::vector<DrawElementsIndirectCommand> Draws;
+			std::vector<glm::vec4> Origins; // Origin and scale per draw, read through BaseInstance
+		};
+
+		struct OcclusionStep
+		{
+			uint32_t Index;		// In m_DrawList
+			uint8_t EntryFace;	// Face of the section the walk came through, BlockFace::Count for the first one
+			uint8_t Directions; // Faces crossed since the camera section, bit i being BlockFace i
+		};
+
+		// Distance mapped to the depth of the sort keys, farther sections share the last value
+		static constexpr float MaxSortDistance = 1024.f;
+
+		BlockAppearanceTable m_Appearances;
+		TextureArray m_BlockTextures;
+		Shader m_Shader;
+		MeshingPipeline m_Meshing;
+
+		// ----- World thread -----
+		std::vector<SectionDrawInfo> m_Sections; // Every resident mesh, as published by the pipeline
+		uint64_t m_DrawListVersion = 0;
+		uint64_t m_LodVersion = 0;
+		std::unordered_map<LodCoord, uint32_t, LodCoordHash> m_ResidentIndices; // In m_Sections
+		std::vector<uint8_t> m_Chosen;
+		std::unordered_set<LodCoord, LodCoordHash> m_StandIns; // Coarser meshes drawn for selected ones not resident
+
+		std::vector<SectionDrawInfo> m_DrawList; // The meshes to draw, picked from m_Sections
+		FrustumCuller m_Culler;					 // Bounds of m_DrawList, rebuilt when the list changes
+		std::unordered_map<SectionCoord, uint32_t, SectionCoordHash> m_SectionIndices; // Full detail only
+		size_t m_MeshedCount = 0;
+
+		std::vector<uint32_t> m_VisibleIndices; // In the frustum
+		std::vector<uint8_t> m_InFrustum;
+		std::vector<uint8_t> m_Reached;
+		std::vector<OcclusionStep> m_OcclusionQueue;
+		std::vector<uint32_t> m_DrawIndices;
+		std::vector<uint32_t> m_TransparentIndices;
+		std::vector<DrawBatch> m_Batches; // Kept from frame to frame for their capacity
+
+		bool m_OcclusionCulling = true;
+		FrameStats m_FrameStats;
+	};
+} // namespace onion::voxel
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+namespace onion::voxel::benchmark
+{
+	inline volatile double g_Sink = 0.0;
+
+	/// @brief Keeps the compiler from optimizing a result away.
+	template <typename T> inline void DoNotOptimize(const T& value)
+	{
+		static_assert(std::is_arithmetic_v<T>, "Reduce the result to a number first");
+		g_Sink = g_Sink + static_cast<double>(value);
+	}
+
+	/// @brief Prints a result line, aligned with the other benchmarks.
+	inline void PrintResult(const std::string& name, double nsPerOperation)
+	{
+		std::cout << std::left << std::setw(48) << name << std::right << std::fixed << std::setprecision(2)
+				  << std::setw(10) << nsPerOperation << " ns/op" << std::setw(12) << std::setprecision(1)
+				  << (1000.0 / nsPerOperation) << " Mop/s" << std::endl;
+	}
+
+	/// @brief Runs the function (which performs operationCount operations) a few times and prints the best run.
+	template <typename Function> double Measure(const std::string& name, uint64_t operationCount, Function&& function)
+	{
+		constexpr int Runs = 5;
+		double bestNs = 0.0;
+
+		for (int run = 0; run < Runs; run++)
+		{
+			auto start = std::chrono::steady_clock::now();
+			function();
+			auto end = std::chrono::steady_clock::now();
+
+			double ns = std::chrono::duration<double, std::nano>(end - start).count();
+			if (run == 0 || ns < bestNs)
+				bestNs = ns;
+		}
+
+		double nsPerOperation = bestNs / static_cast<double>(operationCount);
+		PrintResult(name, nsPerOperation);
+
+		return nsPerOperation;
+	}
+} // namespace onion::voxel::benchmark
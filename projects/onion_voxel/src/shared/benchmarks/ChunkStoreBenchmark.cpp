@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <world/Blocks.hpp>
+#include <world/ChunkStore.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace onion::voxel;
+using namespace onion::voxel::benchmark;
+
+namespace
+{
+	constexpr int WorldRadius = 8; // 16 x 16 chunks
+	using namespace onion::voxel::Blocks;
+
+	/// @brief Rolling hills around Y 64 with a few ores : the usual 1 to 4 palette entries per section.
+	void GenerateTerrain(ChunkStore& store)
+	{
+		std::mt19937 random(1234);
+		std::uniform_int_distribution<int> oreChance(0, 99);
+
+		for (int chunkX = -WorldRadius; chunkX < WorldRadius; chunkX++)
+		{
+			for (int chunkZ = -WorldRadius; chunkZ < WorldRadius; chunkZ++)
+			{
+				Chunk& chunk = store.GetOrCreateChunk({chunkX, chunkZ});
+
+				for (int x = 0; x < ChunkSize; x++)
+				{
+					for (int z = 0; z < ChunkSize; z++)
+					{
+						int worldX = chunkX * ChunkSize + x;
+						int worldZ = chunkZ * ChunkSize + z;
+						int height = 64 + static_cast<int>(8.0 * std::sin(worldX * 0.05) * std::cos(worldZ * 0.07));
+
+						for (int y = 0; y <= std::max(height, 62); y++)
+						{
+							BlockId block = Stone;
+							if (y == 0)
+								block = Bedrock;
+							else if (y > height)
+								block = Water;
+							else if (y == height)
+								block = height >= 62 ? Grass : Dirt;
+							else if (y > height - 4)
+								block = Dirt;
+							else if (oreChance(random) == 0)
+								block = CoalOre;
+
+							chunk.SetBlock(x, y, z, block);
+						}
+					}
+				}
+
+				chunk.Compact();
+			}
+		}
+	}
+} // namespace
+
+int main()
+{
+	std::cout << "-------------- Benchmark Chunk Store --------------" << std::endl;
+
+	ChunkStore store;
+	GenerateTerrain(store);
+
+	const int worldSize = 2 * WorldRadius * ChunkSize;
+	const uint64_t blockCount = static_cast<uint64_t>(worldSize) * worldSize * Chunk::Height;
+
+	size_t memory = store.GetMemoryUsage();
+	std::cout << store.GetChunkCount() << " chunks, " << blockCount << " blocks, " << memory / 1024 << " KiB : "
+			  << static_cast<double>(memory) / blockCount << " byte per block" << std::endl;
+
+	int histogram[17] = {};
+	for (const auto& [coord, chunk] : store.GetChunks())
+		for (int section = 0; section < Chunk::SectionCount; section++)
+			histogram[chunk->GetSection(section).GetBitsPerEntry()]++;
+
+	std::cout << "Sections by bits per block :";
+	for (int bits : {0, 1, 2, 4, 8, 16})
+		std::cout << " " << bits << "b=" << histogram[bits];
+	std::cout << std::endl << std::endl;
+
+	// ----- Sequential -----
+	Measure("Sequential get, world coordinates",
+			blockCount,
+			[&]()
+			{
+				uint64_t sum = 0;
+				for (int x = -WorldRadius * ChunkSize; x < WorldRadius * ChunkSize; x++)
+					for (int z = -WorldRadius * ChunkSize; z < WorldRadius * ChunkSize; z++)
+						for (int y = 0; y < Chunk::Height; y++)
+							sum += store.GetBlock({x, y, z});
+				DoNotOptimize(sum);
+			});
+
+	Measure("Sequential get, chunk resolved once",
+			blockCount,
+			[&]()
+			{
+				uint64_t sum = 0;
+				for (const auto& [coord, chunk] : store.GetChunks())
+					for (int y = 0; y < Chunk::Height; y++)
+						for (int z = 0; z < ChunkSize; z++)
+							for (int x = 0; x < ChunkSize; x++)
+								sum += chunk->GetBlock(x, y, z);
+				DoNotOptimize(sum);
+			});
+
+	// ----- Random -----
+	constexpr int RandomCount = 4'000'000;
+	std::mt19937 random(42);
+	std::uniform_int_distribution<int> horizontal(-WorldRadius * ChunkSize, WorldRadius * ChunkSize - 1);
+	std::uniform_int_distribution<int> vertical(0, Chunk::Height - 1);
+
+	std::vector<BlockPos> positions(RandomCount);
+	for (BlockPos& pos : positions)
+		pos = {horizontal(random), vertical(random), horizontal(random)};
+
+	Measure("Random get",
+			RandomCount,
+			[&]()
+			{
+				uint64_t sum = 0;
+				for (const BlockPos& pos : positions)
+					sum += store.GetBlock(pos);
+				DoNotOptimize(sum);
+			});
+
+	Measure("Random set (existing palette entry)",
+			RandomCount,
+			[&]()
+			{
+				for (const BlockPos& pos : positions)
+					store.SetBlock(pos, pos.y < 60 ? Stone : AirBlock);
+			});
+
+	size_t memoryAfterEdits = store.GetMemoryUsage();
+	std::cout << std::endl
+			  << "After random edits : " << static_cast<double>(memoryAfterEdits) / blockCount << " byte per block"
+			  << std::endl;
+
+	return 0;
+}
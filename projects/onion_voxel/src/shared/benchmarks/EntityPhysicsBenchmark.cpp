@@ -0,0 +1,157 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <jobs/JobSystem.hpp>
+#include <physics/EntityPhysics.hpp>
+#include <worldgen/WorldGenerator.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace onion::voxel;
+using namespace onion::voxel::benchmark;
+
+namespace
+{
+	constexpr int WorldRadius = 16; // Chunks, 32 x 32 around the origin
+	constexpr int MeasuredTicks = 20;
+	constexpr float WalkSpeed = 4.3f; // Blocks per second
+	constexpr float TickMilliseconds = 50.f;
+
+	/// @brief Mobs dropped over the terrain, each walking its own way : they land, follow the slopes and bump into
+	/// hills and water edges.
+	struct Mobs
+	{
+		PhysicsBodies Bodies;
+		std::vector<float> HeadingX;
+		std::vector<float> HeadingZ;
+
+		explicit Mobs(size_t count)
+		{
+			std::mt19937 random(1234);
+			const float extent = (WorldRadius - 2) * ChunkSize;
+			std::uniform_real_distribution<float> horizontal(-extent, extent);
+			std::uniform_real_distribution<float> angle(0.f, 6.2831853f);
+
+			Bodies.Reserve(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				Bodies.Add(horizontal(random), 140.f, horizontal(random), 0.3f, 1.8f);
+				const float heading = angle(random);
+				HeadingX.push_back(std::cos(heading) * WalkSpeed);
+				HeadingZ.push_back(std::sin(heading) * WalkSpeed);
+			}
+		}
+
+		/// @brief What the AI does each tick : keep walking.
+		void Walk()
+		{
+			for (size_t i = 0; i < Bodies.GetCount(); i++)
+			{
+				Bodies.VelocityX[i] = HeadingX[i];
+				Bodies.VelocityZ[i] = HeadingZ[i];
+			}
+		}
+	};
+
+	void Run(const ChunkStore& world, JobSystem& jobs, size_t count)
+	{
+		const EntityPhysics physics;
+		Mobs mobs(count);
+
+		// Falling from above the hills to the ground
+		for (int tick = 0; tick < 60; tick++)
+		{
+			mobs.Walk();
+			physics.Step(jobs, world, mobs.Bodies);
+		}
+
+		const std::string name = std::to_string(count) + " mobs";
+		auto printEntitiesPerTick = [](double nsPerEntity)
+		{
+			std::cout << "  -> " << static_cast<uint64_t>(TickMilliseconds * 1e6 / nsPerEntity)
+					  << " entities per 50 ms tick" << std::endl;
+		};
+
+		printEntitiesPerTick(Measure(name + " : step (per entity)",
+									 count * MeasuredTicks,
+									 [&]()
+									 {
+										 for (int tick = 0; tick < MeasuredTicks; tick++)
+										 {
+											 mobs.Walk();
+											 physics.Step(world, mobs.Bodies);
+										 }
+									 }));
+
+		printEntitiesPerTick(Measure(name + " : step, " + std::to_string(jobs.GetWorkerCount()) +
+										 " workers (per entity)",
+									 count * MeasuredTicks,
+									 [&]()
+									 {
+										 for (int tick = 0; tick < MeasuredTicks; tick++)
+										 {
+											 mobs.Walk();
+											 physics.Step(jobs, world, mobs.Bodies);
+										 }
+									 }));
+
+		size_t onGround = 0;
+		size_t hitWall = 0;
+		size_t inside = 0;
+		VoxelCollider collider(world);
+		const PhysicsBodies& bodies = mobs.Bodies;
+		for (size_t i = 0; i < count; i++)
+		{
+			onGround += (bodies.Flags[i] & BodyFlags::OnGround) ? 1 : 0;
+			hitWall += (bodies.Flags[i] & BodyFlags::HitWall) ? 1 : 0;
+
+			const float halfWidth = bodies.HalfWidth[i];
+			inside += collider.IsColliding({bodies.PositionX[i] - halfWidth,
+											bodies.PositionY[i],
+											bodies.PositionZ[i] - halfWidth,
+											bodies.PositionX[i] + halfWidth,
+											bodies.PositionY[i] + bodies.Height[i],
+											bodies.PositionZ[i] + halfWidth})
+				? 1
+				: 0;
+		}
+
+		std::cout << "  -> " << onGround * 100 / count << "% on the ground, " << hitWall * 100 / count
+				  << "% against a wall" << std::endl;
+		if (inside != 0)
+			std::cout << "  -> " << inside << " mobs inside blocks !" << std::endl;
+
+		std::cout << std::endl;
+	}
+} // namespace
+
+int main()
+{
+	std::cout << "-------------- Benchmark Entity Physics --------------" << std::endl;
+
+	JobSystem jobs;
+	const WorldGenerator generator(1234);
+
+	std::vector<ChunkCoord> coords;
+	for (int z = -WorldRadius; z < WorldRadius; z++)
+		for (int x = -WorldRadius; x < WorldRadius; x++)
+			coords.push_back({x, z});
+
+	ChunkStore world;
+	for (std::unique_ptr<Chunk>& chunk : generator.GenerateChunks(jobs, coords))
+		world.InsertChunk(std::move(chunk));
+
+	std::cout << world.GetChunkCount() << " generated chunks, mobs of 0.6 x 1.8 blocks walking at " << WalkSpeed
+			  << " blocks/s" << std::endl
+			  << std::endl;
+
+	for (size_t count : {1000, 10000, 100000})
+		Run(world, jobs, count);
+
+	return 0;
+}
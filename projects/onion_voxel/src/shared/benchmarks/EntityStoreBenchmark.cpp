@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <ecs/EntityStore.hpp>
+#include <jobs/JobSystem.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace onion::voxel;
+using namespace onion::voxel::benchmark;
+
+namespace
+{
+	constexpr float TickSeconds = 1.f / 20.f;
+
+	struct Position
+	{
+		float X, Y, Z;
+	};
+
+	struct Velocity
+	{
+		float X, Y, Z;
+	};
+
+	struct Health
+	{
+		float Value;
+	};
+
+	struct Lifetime
+	{
+		uint32_t Ticks;
+	};
+
+	struct ItemStack
+	{
+		uint16_t Id;
+		uint8_t Count;
+	};
+
+	struct Damage
+	{
+		float Value;
+	};
+
+	struct Burning
+	{
+		uint32_t Ticks;
+	};
+
+	/// @brief The baseline : one heap object per entity, updated through a virtual call.
+	class GameObject
+	{
+	  public:
+		virtual ~GameObject() = default;
+		virtual void Update(float dt) = 0;
+
+		float X = 0.f, Y = 0.f, Z = 0.f;
+		float VelocityX = 0.f, VelocityY = 0.f, VelocityZ = 0.f;
+	};
+
+	class Mob : public GameObject
+	{
+	  public:
+		void Update(float dt) override
+		{
+			X += VelocityX * dt;
+			Y += VelocityY * dt;
+			Z += VelocityZ * dt;
+		}
+
+		float HealthValue = 20.f;
+		uint8_t Ai[64] = {}; // Pathfinding, targets... : fields the update doesn't touch
+	};
+
+	class Item : public GameObject
+	{
+	  public:
+		void Update(float dt) override
+		{
+			X += VelocityX * dt;
+			Y += VelocityY * dt;
+			Z += VelocityZ * dt;
+			LifetimeTicks--;
+		}
+
+		uint32_t LifetimeTicks = 6000;
+		ItemStack Stack{1, 1};
+	};
+
+	/// @brief Mobs, dropped items and projectiles in the proportions of a busy server.
+	void Populate(EntityStore& store, std::vector<Entity>& entities, size_t count)
+	{
+		std::mt19937 random(1234);
+		std::uniform_real_distribution<float> coordinate(-512.f, 512.f);
+		std::uniform_real_distribution<float> speed(-4.f, 4.f);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			const Position position{coordinate(random), 64.f, coordinate(random)};
+			const Velocity velocity{speed(random), 0.f, speed(random)};
+
+			if (i % 10 < 5)
+				entities.push_back(store.Create(position, velocity, Health{20.f}));
+			else if (i % 10 < 8)
+				entities.push_back(store.Create(position, velocity, Lifetime{6000}, ItemStack{1, 1}));
+			else
+				entities.push_back(store.Create(position, velocity, Lifetime{1200}, Damage{4.f}));
+		}
+	}
+
+	float SumX(EntityStore& store)
+	{
+		float sum = 0.f;
+		store.ForEach<const Position>([&sum](Entity, const Position& position) { sum += position.X; });
+		return sum;
+	}
+
+	void Run(JobSystem& jobs, size_t count)
+	{
+		const std::string name = std::to_string(count) + " entities";
+
+		Measure(name + " : create (per entity)",
+				count,
+				[&]()
+				{
+					EntityStore store;
+					std::vector<Entity> entities;
+					Populate(store, entities, count);
+					DoNotOptimize(store.GetEntityCount());
+				});
+
+		EntityStore store;
+		std::vector<Entity> entities;
+		Populate(store, entities, count);
+
+		Measure(name + " : ForEach move (per entity)",
+				count,
+				[&]()
+				{
+					store.ForEach<Position, const Velocity>(
+						[](Entity, Position& position, const Velocity& velocity)
+						{
+							position.X += velocity.X * TickSeconds;
+							position.Y += velocity.Y * TickSeconds;
+							position.Z += velocity.Z * TickSeconds;
+						});
+				});
+
+		Measure(name + " : ForEachChunk move (per entity)",
+				count,
+				[&]()
+				{
+					store.ForEachChunk<Position, const Velocity>(
+						[](uint32_t rowCount, const Entity*, Position* positions, const Velocity* velocities)
+						{
+							for (uint32_t i = 0; i < rowCount; i++)
+							{
+								positions[i].X += velocities[i].X * TickSeconds;
+								positions[i].Y += velocities[i].Y * TickSeconds;
+								positions[i].Z += velocities[i].Z * TickSeconds;
+							}
+						});
+				});
+
+		Measure(name + " : ParallelForEach move, " + std::to_string(jobs.GetWorkerCount()) + " workers",
+				count,
+				[&]()
+				{
+					store.ParallelForEach<Position, const Velocity>(
+						jobs,
+						[](Entity, Position& position, const Velocity& velocity)
+						{
+							position.X += velocity.X * TickSeconds;
+							position.Y += velocity.Y * TickSeconds;
+							position.Z += velocity.Z * TickSeconds;
+						});
+				});
+
+		// Only items and projectiles age : the mob archetype is never visited
+		const size_t agingCount = store.Count<Lifetime>();
+		Measure(name + " : ForEach lifetime (per aging entity)",
+				agingCount,
+				[&]() { store.ForEach<Lifetime>([](Entity, Lifetime& lifetime) { lifetime.Ticks--; }); });
+
+		// Mobs catching fire and putting it out : each change moves the entity to another archetype
+		const size_t mobCount = store.Count<Health>();
+		Measure(name + " : add + remove component (per mob)",
+				mobCount,
+				[&]()
+				{
+					for (size_t i = 0; i < entities.size(); i += 10)
+					{
+						for (size_t mob = i; mob < i + 5 && mob < entities.size(); mob++)
+							store.Add<Burning>(entities[mob], {100});
+					}
+					for (size_t i = 0; i < entities.size(); i += 10)
+					{
+						for (size_t mob = i; mob < i + 5 && mob < entities.size(); mob++)
+							store.Remove<Burning>(entities[mob]);
+					}
+				});
+
+		Measure(name + " : destroy + create (per entity)",
+				count,
+				[&]()
+				{
+					for (Entity entity : entities)
+						store.Destroy(entity);
+					entities.clear();
+					Populate(store, entities, count);
+				});
+
+		DoNotOptimize(SumX(store));
+		std::cout << "  -> " << store.GetArchetypeCount() << " archetypes, "
+				  << store.GetMemoryUsage() / 1024 << " KiB" << std::endl;
+
+		// Baseline, the same entities as objects scattered on the heap
+		std::vector<std::unique_ptr<GameObject>> objects;
+		{
+			std::mt19937 random(1234);
+			std::uniform_real_distribution<float> coordinate(-512.f, 512.f);
+			std::uniform_real_distribution<float> speed(-4.f, 4.f);
+
+			for (size_t i = 0; i < count; i++)
+			{
+				std::unique_ptr<GameObject> object;
+				if (i % 10 < 5)
+					object = std::make_unique<Mob>();
+				else
+					object = std::make_unique<Item>();
+
+				object->X = coordinate(random);
+				object->Y = 64.f;
+				object->Z = coordinate(random);
+				object->VelocityX = speed(random);
+				object->VelocityZ = speed(random);
+				objects.push_back(std::move(object));
+			}
+
+			// Shuffled, as after a while of spawning and despawning
+			std::shuffle(objects.begin(), objects.end(), random);
+		}
+
+		Measure(name + " : virtual objects, update (per entity)",
+				count,
+				[&]()
+				{
+					for (std::unique_ptr<GameObject>& object : objects)
+						object->Update(TickSeconds);
+				});
+
+		float sum = 0.f;
+		for (const std::unique_ptr<GameObject>& object : objects)
+			sum += object->X;
+		DoNotOptimize(sum);
+
+		std::cout << std::endl;
+	}
+} // namespace
+
+int main()
+{
+	std::cout << "-------------- Benchmark Entity Store --------------" << std::endl;
+
+	JobSystem jobs;
+	std::cout << "Half mobs, 3/10 dropped items, 1/5 projectiles" << std::endl << std::endl;
+
+	for (size_t count : {1000, 10000, 100000})
+		Run(jobs, count);
+
+	return 0;
+}
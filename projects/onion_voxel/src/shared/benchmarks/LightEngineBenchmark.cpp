@@ -0,0 +1,175 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <world/Blocks.hpp>
+#include <world/LightEngine.hpp>
+#include <worldgen/WorldGenerator.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace onion::voxel;
+using namespace onion::voxel::benchmark;
+
+namespace
+{
+	constexpr int WorldRadius = 8; // 16 x 16 chunks
+
+	// A cave under the center of the world, opened to the sky by a one block shaft
+	constexpr int CaveRadius = 16;
+	constexpr int CaveFloor = 20;
+	constexpr int CaveCeiling = 44;
+
+	struct Edit
+	{
+		BlockPos Pos;
+		BlockId Block;
+	};
+
+	void ApplyEdit(ChunkStore& world, LightEngine& light, const Edit& edit)
+	{
+		const BlockId previous = world.GetBlock(edit.Pos);
+		world.SetBlock(edit.Pos, edit.Block);
+		light.OnBlockChanged(edit.Pos, previous);
+		light.Propagate();
+	}
+
+	/// @brief Times the second edit of each pair, the first one sets the scene. Prints the best of a few runs, with
+	/// the light levels the timed edits visited and wrote.
+	void MeasureEdits(const std::string& name,
+					  ChunkStore& world,
+					  LightEngine& light,
+					  const std::vector<Edit>& setups,
+					  const std::vector<Edit>& edits)
+	{
+		constexpr int Runs = 5;
+		double bestNs = 0.0;
+		LightEngine::Stats stats;
+
+		for (int run = 0; run < Runs; run++)
+		{
+			double ns = 0.0;
+			const LightEngine::Stats before = light.GetStats();
+			LightEngine::Stats setupStats;
+
+			for (size_t i = 0; i < edits.size(); i++)
+			{
+				const LightEngine::Stats beforeSetup = light.GetStats();
+				ApplyEdit(world, light, setups[i]);
+				setupStats.VisitedCount += light.GetStats().VisitedCount - beforeSetup.VisitedCount;
+				setupStats.ChangedCount += light.GetStats().ChangedCount - beforeSetup.ChangedCount;
+
+				auto start = std::chrono::steady_clock::now();
+				ApplyEdit(world, light, edits[i]);
+				auto end = std::chrono::steady_clock::now();
+				ns += std::chrono::duration<double, std::nano>(end - start).count();
+			}
+
+			if (run == 0 || ns < bestNs)
+				bestNs = ns;
+
+			stats.VisitedCount = light.GetStats().VisitedCount - before.VisitedCount - setupStats.VisitedCount;
+			stats.ChangedCount = light.GetStats().ChangedCount - before.ChangedCount - setupStats.ChangedCount;
+		}
+
+		PrintResult(name, bestNs / static_cast<double>(edits.size()));
+		std::cout << "  -> " << stats.VisitedCount / edits.size() << " blocks visited, "
+				  << stats.ChangedCount / edits.size() << " light levels written per edit" << std::endl;
+
+		light.TakeChangedSections();
+	}
+
+	void CarveCave(ChunkStore& world)
+	{
+		for (int y = CaveFloor; y < CaveCeiling; y++)
+			for (int z = -CaveRadius; z < CaveRadius; z++)
+				for (int x = -CaveRadius; x < CaveRadius; x++)
+					world.SetBlock({x, y, z}, AirBlock);
+
+		// The shaft, up to the surface
+		for (int y = CaveCeiling; GetBlockProperties(world.GetBlock({0, y, 0})).IsOpaque; y++)
+			world.SetBlock({0, y, 0}, AirBlock);
+	}
+} // namespace
+
+int main()
+{
+	std::cout << "-------------- Benchmark Light Engine --------------" << std::endl;
+
+	ChunkStore world;
+	const WorldGenerator generator(1234);
+
+	std::vector<ChunkCoord> coords;
+	for (int z = -WorldRadius; z < WorldRadius; z++)
+		for (int x = -WorldRadius; x < WorldRadius; x++)
+			coords.push_back({x, z});
+
+	for (const ChunkCoord& coord : coords)
+		world.InsertChunk(generator.Generate(coord));
+	CarveCave(world);
+
+	LightEngine light(world);
+
+	// ----- Whole chunks -----
+	Measure("Light new chunks (per chunk)",
+			coords.size(),
+			[&]()
+			{
+				for (const ChunkCoord& coord : coords)
+					light.AddChunk(coord);
+				light.Propagate();
+				DoNotOptimize(light.TakeChangedSections().size());
+			});
+
+	std::cout << coords.size() << " chunks, " << world.GetMemoryUsage() / 1024 << " KiB with light" << std::endl
+			  << std::endl;
+
+	// ----- Block light -----
+	// Lights in open air, far enough apart not to overlap : the largest volume a single light reaches
+	std::vector<Edit> place;
+	std::vector<Edit> remove;
+	for (int z = -WorldRadius + 2; z < WorldRadius - 2; z += 4)
+	{
+		for (int x = -WorldRadius + 2; x < WorldRadius - 2; x += 4)
+		{
+			const BlockPos pos{x * ChunkSize, 200, z * ChunkSize};
+			place.push_back({pos, Blocks::Glowstone});
+			remove.push_back({pos, AirBlock});
+		}
+	}
+
+	MeasureEdits("Place a light, open air", world, light, remove, place);
+	MeasureEdits("Remove a light, open air (worst case)", world, light, place, remove);
+
+	// ----- Sky light -----
+	// Sealing the shaft darkens the whole cave
+	const std::vector<Edit> open{{{0, CaveCeiling, 0}, AirBlock}};
+	const std::vector<Edit> seal{{{0, CaveCeiling, 0}, Blocks::Stone}};
+
+	MeasureEdits("Open a cave to the sky", world, light, seal, open);
+	MeasureEdits("Seal a cave from the sky (worst case)", world, light, open, seal);
+
+	// ----- Everyday edits -----
+	// Digging into the ground and filling the hole back
+	std::vector<Edit> dig;
+	std::vector<Edit> fill;
+	for (int z = -WorldRadius * ChunkSize + 8; z < WorldRadius * ChunkSize - 8; z += 37)
+	{
+		for (int x = -WorldRadius * ChunkSize + 8; x < WorldRadius * ChunkSize - 8; x += 41)
+		{
+			int y = Chunk::Height - 1;
+			while (y > 0 && !GetBlockProperties(world.GetBlock({x, y, z})).IsOpaque)
+				y--;
+
+			dig.push_back({{x, y, z}, AirBlock});
+			fill.push_back({{x, y, z}, world.GetBlock({x, y, z})});
+		}
+	}
+
+	MeasureEdits("Break a surface block", world, light, fill, dig);
+	MeasureEdits("Place a surface block", world, light, dig, fill);
+
+	return 0;
+}
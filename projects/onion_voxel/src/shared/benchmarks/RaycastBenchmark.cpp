@@ -0,0 +1,175 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <jobs/JobSystem.hpp>
+#include <physics/VoxelRaycaster.hpp>
+#include <world/Blocks.hpp>
+#include <worldgen/WorldGenerator.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace onion::voxel;
+using namespace onion::voxel::benchmark;
+
+namespace
+{
+	constexpr int WorldRadius = 16; // Chunks, 32 x 32 around the origin
+	constexpr size_t RayCount = 100000;
+	constexpr float Infinity = std::numeric_limits<float>::infinity();
+
+	/// @brief The same walk with a ChunkStore lookup per block, what the raycaster avoids.
+	RayHit CastPerBlock(const ChunkStore& world, const Ray& ray)
+	{
+		RayHit hit;
+
+		const float length = std::sqrt(ray.DirectionX * ray.DirectionX + ray.DirectionY * ray.DirectionY +
+									   ray.DirectionZ * ray.DirectionZ);
+		const float origin[3] = {ray.OriginX, ray.OriginY, ray.OriginZ};
+		const float direction[3] = {ray.DirectionX / length, ray.DirectionY / length, ray.DirectionZ / length};
+
+		int cell[3];
+		int step[3];
+		float tDelta[3];
+		float tMax[3];
+		for (int axis = 0; axis < 3; axis++)
+		{
+			cell[axis] = static_cast<int>(std::floor(origin[axis]));
+			step[axis] = direction[axis] > 0.f ? 1 : (direction[axis] < 0.f ? -1 : 0);
+			tDelta[axis] = step[axis] != 0 ? std::abs(1.f / direction[axis]) : Infinity;
+			tMax[axis] = step[axis] != 0
+				? (static_cast<float>(step[axis] > 0 ? cell[axis] + 1 : cell[axis]) - origin[axis]) / direction[axis]
+				: Infinity;
+		}
+
+		float distance = 0.f;
+		BlockFace face = BlockFace::Count;
+		while (distance <= ray.MaxDistance)
+		{
+			const BlockId block = world.GetBlock({cell[0], cell[1], cell[2]});
+			if (GetBlockProperties(block).IsSolid)
+			{
+				hit = {{cell[0], cell[1], cell[2]}, block, face, distance, true};
+				return hit;
+			}
+
+			const int axis = tMax[0] < tMax[1] ? (tMax[0] < tMax[2] ? 0 : 2) : (tMax[1] < tMax[2] ? 1 : 2);
+			distance = tMax[axis];
+			cell[axis] += step[axis];
+			tMax[axis] += tDelta[axis];
+			face = static_cast<BlockFace>(axis * 2 + (step[axis] > 0 ? 1 : 0));
+		}
+
+		return hit;
+	}
+
+	/// @brief From the air above the terrain, in every direction : a mix of rays hitting the ground early and rays
+	/// running their full length.
+	std::vector<Ray> MakeRays(float maxDistance)
+	{
+		std::mt19937 random(1234);
+		const float extent = WorldRadius * ChunkSize * 0.5f; // Rays up to 512 blocks long stay mostly in the world
+		std::uniform_real_distribution<float> horizontal(-extent, extent);
+		std::uniform_real_distribution<float> height(WorldGenerator::SeaLevel + 10.f, WorldGenerator::SeaLevel + 40.f);
+		std::normal_distribution<float> direction(0.f, 1.f);
+
+		std::vector<Ray> rays(RayCount);
+		for (Ray& ray : rays)
+			ray = {horizontal(random),
+				   height(random),
+				   horizontal(random),
+				   direction(random),
+				   direction(random),
+				   direction(random),
+				   maxDistance};
+
+		return rays;
+	}
+
+	void Run(const ChunkStore& world, JobSystem& jobs, float maxDistance)
+	{
+		const std::vector<Ray> rays = MakeRays(maxDistance);
+		const std::string name = std::to_string(static_cast<int>(maxDistance)) + " blocks";
+
+		VoxelRaycaster raycaster(world);
+		std::vector<RayHit> hits;
+		raycaster.Cast(rays, hits);
+
+		size_t hitCount = 0;
+		size_t mismatches = 0;
+		for (size_t i = 0; i < rays.size(); i++)
+		{
+			const RayHit expected = CastPerBlock(world, rays[i]);
+			hitCount += hits[i].Hit ? 1 : 0;
+			const bool same = hits[i].Hit == expected.Hit &&
+				(!expected.Hit ||
+				 (hits[i].Block == expected.Block && hits[i].Face == expected.Face &&
+				  std::abs(hits[i].Distance - expected.Distance) < 1e-3f));
+			mismatches += same ? 0 : 1;
+		}
+
+		std::cout << name << " : " << hitCount * 100 / rays.size() << "% of the rays hit" << std::endl;
+		if (mismatches != 0)
+			std::cout << "  -> " << mismatches << " rays differ from the per block walk !" << std::endl;
+
+		auto printRaysPerSecond = [](double nsPerRay)
+		{ std::cout << "  -> " << static_cast<uint64_t>(1e9 / nsPerRay) << " rays/s" << std::endl; };
+
+		printRaysPerSecond(Measure(name + " : lookup per block (per ray)",
+								   rays.size(),
+								   [&]()
+								   {
+									   for (const Ray& ray : rays)
+										   DoNotOptimize(CastPerBlock(world, ray).Distance);
+								   }));
+
+		printRaysPerSecond(Measure(name + " : raycaster (per ray)",
+								   rays.size(),
+								   [&]()
+								   {
+									   raycaster.Cast(rays, hits);
+									   DoNotOptimize(hits.back().Distance);
+								   }));
+
+		printRaysPerSecond(Measure(name + " : raycaster, " + std::to_string(jobs.GetWorkerCount()) +
+									   " workers (per ray)",
+								   rays.size(),
+								   [&]()
+								   {
+									   raycaster.Cast(jobs, rays, hits);
+									   DoNotOptimize(hits.back().Distance);
+								   }));
+
+		std::cout << std::endl;
+	}
+} // namespace
+
+int main()
+{
+	std::cout << "-------------- Benchmark Voxel Raycaster --------------" << std::endl;
+
+	JobSystem jobs;
+	const WorldGenerator generator(1234);
+
+	std::vector<ChunkCoord> coords;
+	for (int z = -WorldRadius; z < WorldRadius; z++)
+		for (int x = -WorldRadius; x < WorldRadius; x++)
+			coords.push_back({x, z});
+
+	ChunkStore world;
+	for (std::unique_ptr<Chunk>& chunk : generator.GenerateChunks(jobs, coords))
+		world.InsertChunk(std::move(chunk));
+
+	std::cout << world.GetChunkCount() << " generated chunks, rays from 10 to 40 blocks above the sea" << std::endl
+			  << std::endl;
+
+	for (float maxDistance : {8.f, 32.f, 128.f, 512.f})
+		Run(world, jobs, maxDistance);
+
+	return 0;
+}
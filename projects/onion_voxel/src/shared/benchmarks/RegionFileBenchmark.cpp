@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <storage/ChunkSerializer.hpp>
+#include <storage/WorldStorage.hpp>
+#include <worldgen/WorldGenerator.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace onion::voxel;
+using namespace onion::voxel::benchmark;
+
+namespace
+{
+	constexpr int RegionCount = 2; // 2 x 2 regions, 64 x 64 chunks
+
+	bool HasSameBlocks(const Chunk& a, const Chunk& b)
+	{
+		for (int y = 0; y < Chunk::Height; y++)
+			for (int z = 0; z < ChunkSize; z++)
+				for (int x = 0; x < ChunkSize; x++)
+					if (a.GetBlock(x, y, z) != b.GetBlock(x, y, z))
+						return false;
+
+		return true;
+	}
+
+	/// @brief Throughput of the uncompressed chunk data, what the game sends to and gets back from the disk.
+	void PrintThroughput(double nsPerChunk, double bytesPerChunk)
+	{
+		std::cout << "  -> " << static_cast<uint64_t>(1e9 / nsPerChunk) << " chunks/s, "
+				  << bytesPerChunk / nsPerChunk * 1e3 << " MB/s" << std::endl;
+	}
+
+	void Run(const std::string& name,
+			 CompressionType compression,
+			 const std::vector<std::unique_ptr<Chunk>>& chunks,
+			 double bytesPerChunk)
+	{
+		const std::filesystem::path directory =
+			std::filesystem::temp_directory_path() / "onion_voxel_benchmark_regions" / name;
+		std::filesystem::remove_all(directory);
+
+		std::vector<ChunkCoord> shuffled;
+		for (const auto& chunk : chunks)
+			shuffled.push_back(chunk->GetCoord());
+		std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(1234));
+
+		{
+			WorldStorage storage(directory, compression);
+
+			// Every run after the first one rewrites the chunks over the previous copies, as autosaves do
+			PrintThroughput(Measure(name + " : save (per chunk)",
+									chunks.size(),
+									[&]()
+									{
+										for (const auto& chunk : chunks)
+											storage.SaveChunk(*chunk);
+									}),
+							bytesPerChunk);
+			std::cout << "  -> " << storage.GetFileSize() / 1024 << " KiB of region files, "
+					  << bytesPerChunk * chunks.size() / storage.GetFileSize() << "x smaller" << std::endl;
+
+			// As SaveAll() and the streamer's write-back do : one flush per region for the whole batch
+			PrintThroughput(Measure(name + " : save batch (per chunk)",
+									chunks.size(),
+									[&]()
+									{
+										for (const auto& chunk : chunks)
+											storage.WriteChunk(*chunk);
+										storage.Flush();
+									}),
+							bytesPerChunk);
+		}
+
+		// Reopened : loads only see what reached the files
+		WorldStorage storage(directory, compression);
+
+		size_t mismatches = 0;
+		for (const auto& chunk : chunks)
+			mismatches += HasSameBlocks(*chunk, *storage.LoadChunk(chunk->GetCoord())) ? 0 : 1;
+		if (mismatches != 0)
+			std::cout << "  -> " << mismatches << " chunks loaded with different blocks !" << std::endl;
+
+		PrintThroughput(Measure(name + " : load, in order (per chunk)",
+								chunks.size(),
+								[&]()
+								{
+									for (const auto& chunk : chunks)
+										DoNotOptimize(storage.LoadChunk(chunk->GetCoord())->GetSection(0).Get(0));
+								}),
+						bytesPerChunk);
+
+		PrintThroughput(Measure(name + " : load, random order (per chunk)",
+								shuffled.size(),
+								[&]()
+								{
+									for (const ChunkCoord& coord : shuffled)
+										DoNotOptimize(storage.LoadChunk(coord)->GetSection(0).Get(0));
+								}),
+						bytesPerChunk);
+
+		std::cout << std::endl;
+		std::filesystem::remove_all(directory);
+	}
+} // namespace
+
+int main()
+{
+	std::cout << "-------------- Benchmark Region File --------------" << std::endl;
+
+	const WorldGenerator generator(1234);
+	std::vector<std::unique_ptr<Chunk>> chunks;
+
+	const int chunksPerAxis = RegionCount * RegionFile::Size;
+	for (int z = -chunksPerAxis / 2; z < chunksPerAxis / 2; z++)
+		for (int x = -chunksPerAxis / 2; x < chunksPerAxis / 2; x++)
+			chunks.push_back(generator.Generate({x, z}));
+
+	size_t serializedBytes = 0;
+	std::vector<uint8_t> serialized;
+	for (const auto& chunk : chunks)
+	{
+		serialized.clear();
+		ChunkSerializer::Write(*chunk, serialized);
+		serializedBytes += serialized.size();
+	}
+
+	const double bytesPerChunk = static_cast<double>(serializedBytes) / chunks.size();
+	std::cout << chunks.size() << " generated chunks, " << bytesPerChunk / 1024 << " KiB per chunk uncompressed"
+			  << std::endl
+			  << "Reads come from the page cache : no disk latency, only the cost of the format" << std::endl
+			  << std::endl;
+
+	Run("No compression", CompressionType::None, chunks, bytesPerChunk);
+	Run("LZ4", CompressionType::Lz4, chunks, bytesPerChunk);
+	if (IsCompressionSupported(CompressionType::Zstd))
+		Run("Zstd", CompressionType::Zstd, chunks, bytesPerChunk);
+	else
+		std::cout << "Zstd : not built in (ONION_VOXEL_WITH_ZSTD)" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,182 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <physics/SpatialHashGrid.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace onion::voxel;
+using namespace onion::voxel::benchmark;
+
+namespace
+{
+	constexpr float WorldExtent = 512.f; // Blocks around the origin, along X and Z
+	constexpr size_t QueryCount = 10000;
+	constexpr size_t MaxResults = 4096;
+
+	struct Positions
+	{
+		std::vector<float> X;
+		std::vector<float> Y;
+		std::vector<float> Z;
+
+		Positions(size_t count, uint32_t seed)
+		{
+			std::mt19937 random(seed);
+			std::uniform_real_distribution<float> horizontal(-WorldExtent, WorldExtent);
+			std::uniform_real_distribution<float> height(60.f, 90.f);
+
+			for (size_t i = 0; i < count; i++)
+			{
+				X.push_back(horizontal(random));
+				Y.push_back(height(random));
+				Z.push_back(horizontal(random));
+			}
+		}
+	};
+
+	/// @brief Tests every entity, what the grid replaces.
+	size_t QueryRadiusLinear(const Positions& positions, float x, float y, float z, float radius, uint32_t* results)
+	{
+		size_t found = 0;
+		for (size_t i = 0; i < positions.X.size(); i++)
+		{
+			const float dx = positions.X[i] - x;
+			const float dy = positions.Y[i] - y;
+			const float dz = positions.Z[i] - z;
+			if (dx * dx + dy * dy + dz * dz <= radius * radius)
+				results[found++] = static_cast<uint32_t>(i);
+		}
+		return found;
+	}
+
+	void Run(size_t count)
+	{
+		const std::string name = std::to_string(count) + " entities";
+		const Positions positions(count, 1234);
+		const Positions queries(QueryCount, 5678);
+		std::vector<uint32_t> results(MaxResults);
+
+		SpatialHashGrid grid;
+		Measure(name + " : insert (per entity)",
+				count,
+				[&]()
+				{
+					grid.Clear();
+					for (size_t i = 0; i < count; i++)
+						grid.Insert(static_cast<uint32_t>(i), positions.X[i], positions.Y[i], positions.Z[i]);
+				});
+
+		// A tick of walking mobs : most stay in their cell
+		std::vector<float> x = positions.X;
+		std::vector<float> z = positions.Z;
+		Measure(name + " : move 0.2 blocks (per entity)",
+				count,
+				[&]()
+				{
+					for (size_t i = 0; i < count; i++)
+					{
+						x[i] += 0.2f;
+						z[i] -= 0.1f;
+						grid.Move(static_cast<uint32_t>(i), x[i], positions.Y[i], z[i]);
+					}
+				});
+
+		Measure(name + " : move 8 blocks (per entity)",
+				count,
+				[&]()
+				{
+					for (size_t i = 0; i < count; i++)
+					{
+						x[i] += 8.f;
+						grid.Move(static_cast<uint32_t>(i), x[i], positions.Y[i], z[i]);
+					}
+				});
+
+		for (size_t i = 0; i < count; i++)
+			grid.Move(static_cast<uint32_t>(i), positions.X[i], positions.Y[i], positions.Z[i]);
+
+		for (float radius : {4.f, 16.f, 64.f})
+		{
+			const std::string radiusName = name + " : radius " + std::to_string(static_cast<int>(radius));
+
+			size_t found = 0;
+			Measure(radiusName + " query (per query)",
+					QueryCount,
+					[&]()
+					{
+						found = 0;
+						for (size_t q = 0; q < QueryCount; q++)
+							found += grid.QueryRadius(queries.X[q], queries.Y[q], queries.Z[q], radius, results);
+					});
+			DoNotOptimize(found);
+			std::cout << "  -> " << static_cast<double>(found) / QueryCount << " entities found per query"
+					  << std::endl;
+
+			// Only a sample for the linear scan, it is slow at 100k
+			const size_t linearCount = QueryCount / 10;
+			Measure(radiusName + " linear scan (per query)",
+					linearCount,
+					[&]()
+					{
+						size_t linearFound = 0;
+						for (size_t q = 0; q < linearCount; q++)
+							linearFound += QueryRadiusLinear(
+								positions, queries.X[q], queries.Y[q], queries.Z[q], radius, results.data());
+						DoNotOptimize(linearFound);
+					});
+		}
+
+		size_t found = 0;
+		Measure(name + " : 16 x 16 x 16 box query (per query)",
+				QueryCount,
+				[&]()
+				{
+					found = 0;
+					for (size_t q = 0; q < QueryCount; q++)
+					{
+						const Aabb box{queries.X[q] - 8.f,
+									   queries.Y[q] - 8.f,
+									   queries.Z[q] - 8.f,
+									   queries.X[q] + 8.f,
+									   queries.Y[q] + 8.f,
+									   queries.Z[q] + 8.f};
+						found += grid.QueryAabb(box, results);
+					}
+				});
+		DoNotOptimize(found);
+
+		// Far more cells than buckets, like a network interest query over the whole map
+		constexpr size_t WholeMapCount = 10;
+		const Aabb wholeMap{-1e9f, 0.f, -1e9f, 1e9f, 256.f, 1e9f};
+		Measure(name + " : whole map box query (per query)",
+				WholeMapCount,
+				[&]()
+				{
+					for (size_t q = 0; q < WholeMapCount; q++)
+						found = grid.QueryAabb(wholeMap, results);
+				});
+		std::cout << "  -> " << found << " entities found" << std::endl;
+
+		std::cout << std::endl;
+	}
+} // namespace
+
+int main()
+{
+	std::cout << "-------------- Benchmark Spatial Hash Grid --------------" << std::endl;
+
+	const SpatialHashGrid::Settings settings;
+	std::cout << "Entities spread over " << 2 * WorldExtent << " x " << 2 * WorldExtent << " blocks, cells of "
+			  << settings.CellSize << " blocks, " << settings.BucketCount << " buckets" << std::endl
+			  << std::endl;
+
+	for (size_t count : {1000, 10000, 100000})
+		Run(count);
+
+	return 0;
+}
@@ -0,0 +1,145 @@
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <jobs/JobSystem.hpp>
+#include <worldgen/WorldGenerator.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace onion::voxel;
+using namespace onion::voxel::benchmark;
+
+namespace
+{
+	constexpr uint32_t Seed = 1234;
+	constexpr int SpawnRadius = 12; // 24 x 24 chunks, the spawn area
+
+	std::vector<ChunkCoord> GetSpawnArea()
+	{
+		std::vector<ChunkCoord> coords;
+		for (int z = -SpawnRadius; z < SpawnRadius; z++)
+			for (int x = -SpawnRadius; x < SpawnRadius; x++)
+				coords.push_back({x, z});
+		return coords;
+	}
+
+	/// @return The number of chunks whose scalar and AVX2 samples differ in any bit.
+	int CompareInstructionSets(const std::vector<ChunkCoord>& coords)
+	{
+		TerrainNoise scalar(Seed);
+		TerrainNoise simd(Seed);
+		scalar.SetInstructionSet(NoiseInstructionSet::Scalar);
+		simd.SetInstructionSet(NoiseInstructionSet::Avx2);
+
+		int mismatches = 0;
+		ColumnSamples scalarSamples;
+		ColumnSamples simdSamples;
+
+		for (const ChunkCoord& coord : coords)
+		{
+			scalar.SampleChunk(coord, scalarSamples);
+			simd.SampleChunk(coord, simdSamples);
+
+			if (std::memcmp(&scalarSamples, &simdSamples, sizeof(ColumnSamples)) != 0)
+				mismatches++;
+		}
+
+		return mismatches;
+	}
+
+	void PrintChunksPerSecond(double nsPerChunk, unsigned int cores)
+	{
+		const double chunksPerSecond = 1e9 / nsPerChunk;
+		std::cout << "  -> " << chunksPerSecond << " chunks/s, " << chunksPerSecond / cores << " chunks/s/core ("
+				  << cores << (cores == 1 ? " core)" : " cores)") << std::endl;
+	}
+} // namespace
+
+int main()
+{
+	std::cout << "-------------- Benchmark World Generator --------------" << std::endl;
+
+	const std::vector<ChunkCoord> coords = GetSpawnArea();
+	const bool hasAvx2 = TerrainNoise::IsSupported(NoiseInstructionSet::Avx2);
+	std::cout << coords.size() << " chunks, AVX2 " << (hasAvx2 ? "available" : "not available") << std::endl
+			  << std::endl;
+
+	// ----- Reproducibility -----
+	if (hasAvx2)
+	{
+		// The spawn area, and chunks far from the origin where the float coordinates lose precision
+		std::vector<ChunkCoord> checked = coords;
+		for (int i = 0; i < 64; i++)
+			checked.push_back({100'000 + i * 7, -250'000 + i * 13});
+
+		const int mismatches = CompareInstructionSets(checked);
+		std::cout << "Scalar vs AVX2 noise : " << checked.size() - mismatches << " / " << checked.size()
+				  << " chunks bit-identical" << std::endl
+				  << std::endl;
+
+		if (mismatches != 0)
+			return 1;
+	}
+
+	// ----- Noise -----
+	for (NoiseInstructionSet instructionSet : {NoiseInstructionSet::Scalar, NoiseInstructionSet::Avx2})
+	{
+		TerrainNoise noise(Seed);
+		if (!noise.SetInstructionSet(instructionSet))
+			continue;
+
+		const bool scalar = instructionSet == NoiseInstructionSet::Scalar;
+		Measure(scalar ? "Noise, scalar (per column)" : "Noise, AVX2 (per column)",
+				coords.size() * ChunkSize * ChunkSize,
+				[&]()
+				{
+					ColumnSamples samples;
+					float sum = 0.f;
+					for (const ChunkCoord& coord : coords)
+					{
+						noise.SampleChunk(coord, samples);
+						sum += samples.Height[0];
+					}
+					DoNotOptimize(sum);
+				});
+	}
+	std::cout << std::endl;
+
+	// ----- Chunks -----
+	WorldGenerator generator(Seed);
+
+	for (NoiseInstructionSet instructionSet : {NoiseInstructionSet::Scalar, NoiseInstructionSet::Avx2})
+	{
+		if (!generator.GetNoise().SetInstructionSet(instructionSet))
+			continue;
+
+		const bool scalar = instructionSet == NoiseInstructionSet::Scalar;
+		const double nsPerChunk =
+			Measure(scalar ? "Generate chunk, 1 thread, scalar noise" : "Generate chunk, 1 thread, AVX2 noise",
+					coords.size(),
+					[&]()
+					{
+						size_t memory = 0;
+						for (const ChunkCoord& coord : coords)
+							memory += generator.Generate(coord)->GetMemoryUsage();
+						DoNotOptimize(memory);
+					});
+		PrintChunksPerSecond(nsPerChunk, 1);
+	}
+
+	JobSystem jobs;
+	const double nsPerChunk = Measure("Generate chunks, job system",
+									  coords.size(),
+									  [&]()
+									  {
+										  size_t memory = 0;
+										  for (const auto& chunk : generator.GenerateChunks(jobs, coords))
+											  memory += chunk->GetMemoryUsage();
+										  DoNotOptimize(memory);
+									  });
+	PrintChunksPerSecond(nsPerChunk, jobs.GetWorkerCount());
+
+	return 0;
+}
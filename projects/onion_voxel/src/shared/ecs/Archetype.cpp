@@ -0,0 +1,93 @@
+#include "Archetype.hpp"
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+namespace onion::voxel
+{
+	namespace
+	{
+		size_t AlignUp(size_t value, size_t alignment)
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+	} // namespace
+
+	// -------- Constructor --------
+
+	Archetype::Archetype(const ComponentMask& mask) : m_Mask(mask)
+	{
+		size_t rowBytes = sizeof(Entity);
+		for (ComponentId id = 0; id < MaxComponentTypes; id++)
+		{
+			if (!mask.test(id))
+				continue;
+
+			m_ComponentIds.push_back(id);
+			rowBytes += GetComponentInfo(id).Size;
+		}
+
+		// Largest capacity whose arrays, each padded to a cache line, fit in a chunk
+		auto layout = [this](uint32_t capacity)
+		{
+			size_t offset = AlignUp(capacity * sizeof(Entity), ArrayAlignment);
+			for (ComponentId id : m_ComponentIds)
+			{
+				m_Offsets[id] = static_cast<uint32_t>(offset);
+				offset = AlignUp(offset + capacity * GetComponentInfo(id).Size, ArrayAlignment);
+			}
+			return offset;
+		};
+
+		m_Capacity = static_cast<uint32_t>(ChunkBytes / rowBytes);
+		while (m_Capacity > 1 && layout(m_Capacity) > ChunkBytes)
+			m_Capacity--;
+
+		// Not even one row : the arrays would overlap and run past the chunk
+		if (m_Capacity == 0 || layout(m_Capacity) > ChunkBytes)
+			throw std::runtime_error("Components of an archetype larger than a chunk (" + std::to_string(rowBytes) +
+									 " bytes per entity)");
+	}
+
+	// -------- Rows --------
+
+	Archetype::Row Archetype::AddRow(Entity entity)
+	{
+		if (m_Chunks.empty() || m_Chunks.back().RowCount == m_Capacity)
+		{
+			Chunk& chunk = m_Chunks.emplace_back();
+			chunk.Data.reset(new (std::align_val_t(ArrayAlignment)) std::byte[ChunkBytes]);
+		}
+
+		const Row row{static_cast<uint32_t>(m_Chunks.size() - 1), m_Chunks.back().RowCount++};
+		GetEntities(row.Chunk)[row.Index] = entity;
+		return row;
+	}
+
+	Entity Archetype::RemoveRow(Row row)
+	{
+		const Row last{static_cast<uint32_t>(m_Chunks.size() - 1), m_Chunks.back().RowCount - 1};
+
+		Entity moved;
+		if (row.Chunk != last.Chunk || row.Index != last.Index)
+		{
+			moved = GetEntities(last.Chunk)[last.Index];
+			GetEntities(row.Chunk)[row.Index] = moved;
+
+			for (ComponentId id : m_ComponentIds)
+				std::memcpy(GetComponent(row, id), GetComponent(last, id), GetComponentInfo(id).Size);
+		}
+
+		if (--m_Chunks.back().RowCount == 0)
+			m_Chunks.pop_back();
+
+		return moved;
+	}
+
+	size_t Archetype::GetEntityCount() const
+	{
+		return m_Chunks.empty() ? 0 : (m_Chunks.size() - 1) * m_Capacity + m_Chunks.back().RowCount;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Entity.hpp"
+
+namespace onion::voxel
+{
+	/// @brief The entities having exactly one set of components, stored as structure of arrays in fixed size chunks.
+	///
+	/// A chunk holds up to GetCapacity() rows : the array of their entities, then one array per component, each
+	/// aligned on a cache line. A query walks each array linearly, a chunk at a time. Rows are kept dense : removing
+	/// one moves the last row of the archetype into the hole, only the last chunk is partly filled.
+	class Archetype
+	{
+	  public:
+		static constexpr size_t ChunkBytes = 16 * 1024;
+		static constexpr size_t ArrayAlignment = 64;
+
+		struct Row
+		{
+			uint32_t Chunk = 0;
+			uint32_t Index = 0;
+		};
+
+		/// @brief Throws std::runtime_error when one row of the components doesn't fit in a chunk.
+		explicit Archetype(const ComponentMask& mask);
+
+		Archetype(const Archetype&) = delete;
+		Archetype& operator=(const Archetype&) = delete;
+
+		/// @brief Appends a row for the entity. Its components are left uninitialized.
+		Row AddRow(Entity entity);
+		/// @brief Removes the row, moving the last row into it.
+		/// @return The entity moved into the row, null when the row was the last one.
+		Entity RemoveRow(Row row);
+
+		const ComponentMask& GetMask() const { return m_Mask; }
+		bool HasComponent(ComponentId id) const { return m_Mask.test(id); }
+		const std::vector<ComponentId>& GetComponentIds() const { return m_ComponentIds; }
+
+		uint32_t GetCapacity() const { return m_Capacity; }
+		size_t GetChunkCount() const { return m_Chunks.size(); }
+		uint32_t GetRowCount(size_t chunk) const { return m_Chunks[chunk].RowCount; }
+		size_t GetEntityCount() const;
+
+		Entity* GetEntities(size_t chunk) { return reinterpret_cast<Entity*>(m_Chunks[chunk].Data.get()); }
+		/// @brief The component array of a chunk, the archetype must have the component.
+		void* GetComponents(size_t chunk, ComponentId id) { return m_Chunks[chunk].Data.get() + m_Offsets[id]; }
+		void* GetComponent(Row row, ComponentId id)
+		{
+			return static_cast<std::byte*>(GetComponents(row.Chunk, id)) + row.Index * GetComponentInfo(id).Size;
+		}
+
+		template <typename T> T* GetComponents(size_t chunk)
+		{
+			return static_cast<T*>(GetComponents(chunk, GetComponentId<T>()));
+		}
+
+		size_t GetMemoryUsage() const { return sizeof(*this) + m_Chunks.size() * (ChunkBytes + sizeof(Chunk)); }
+
+	  private:
+		struct AlignedDelete
+		{
+			void operator()(std::byte* data) const { ::operator delete[](data, std::align_val_t(ArrayAlignment)); }
+		};
+
+		struct Chunk
+		{
+			std::unique_ptr<std::byte[], AlignedDelete> Data;
+			uint32_t RowCount = 0;
+		};
+
+	  private:
+		ComponentMask m_Mask;
+		std::vector<ComponentId> m_ComponentIds;
+		std::array<uint32_t, MaxComponentTypes> m_Offsets{}; // In a chunk, of each component array
+		uint32_t m_Capacity = 0;
+
+		std::vector<Chunk> m_Chunks;
+	};
+} // namespace onion::voxel
@@ -0,0 +1,36 @@
+#include "Entity.hpp"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace onion::voxel
+{
+	namespace
+	{
+		// Written once per type under the mutex, before its id is handed out
+		std::array<ComponentInfo, MaxComponentTypes> g_Components;
+		std::atomic<ComponentId> g_ComponentCount{0};
+		std::mutex g_RegisterMutex;
+	} // namespace
+
+	ComponentId detail::RegisterComponent(size_t size, size_t alignment)
+	{
+		std::lock_guard<std::mutex> lock(g_RegisterMutex);
+
+		const ComponentId id = g_ComponentCount.load(std::memory_order_relaxed);
+		if (id >= MaxComponentTypes)
+			throw std::runtime_error("More than " + std::to_string(MaxComponentTypes) + " component types");
+
+		g_Components[id] = {size, alignment};
+		g_ComponentCount.store(id + 1, std::memory_order_release);
+		return id;
+	}
+
+	const ComponentInfo& GetComponentInfo(ComponentId id)
+	{
+		return g_Components[id];
+	}
+} // namespace onion::voxel
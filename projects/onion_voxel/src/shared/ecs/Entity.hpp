@@ -0,0 +1,64 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace onion::voxel
+{
+	/// @brief Handle of an entity of an EntityStore. The generation tells a destroyed entity from the one reusing its
+	/// index : a stale handle is simply not alive.
+	struct Entity
+	{
+		uint32_t Index = 0;
+		uint32_t Generation = 0; // 0 : null entity
+
+		bool operator==(const Entity&) const = default;
+		bool IsNull() const { return Generation == 0; }
+	};
+
+	using ComponentId = uint32_t;
+
+	constexpr size_t MaxComponentTypes = 64;
+	using ComponentMask = std::bitset<MaxComponentTypes>;
+
+	struct ComponentInfo
+	{
+		size_t Size = 0;
+		size_t Alignment = 0;
+	};
+
+	namespace detail
+	{
+		/// @brief Thread safe. Throws std::runtime_error past MaxComponentTypes.
+		ComponentId RegisterComponent(size_t size, size_t alignment);
+
+		template <typename Component> ComponentId GetComponentId()
+		{
+			static_assert(std::is_trivially_copyable_v<Component>, "Components must be trivially copyable");
+			static_assert(alignof(Component) <= 64, "Component arrays are aligned on a cache line");
+
+			static const ComponentId id = RegisterComponent(sizeof(Component), alignof(Component));
+			return id;
+		}
+	} // namespace detail
+
+	const ComponentInfo& GetComponentInfo(ComponentId id);
+
+	/// @brief Id of a component type, the same in every EntityStore, given on first use. T and const T share it.
+	///
+	/// Components are plain data : rows of an archetype move with memcpy and are dropped without destructors. Refer
+	/// to other data (names, inventories) by index or handle.
+	template <typename T> ComponentId GetComponentId()
+	{
+		return detail::GetComponentId<std::remove_cv_t<T>>();
+	}
+
+	template <typename... Components> ComponentMask GetComponentMask()
+	{
+		ComponentMask mask;
+		(mask.set(GetComponentId<Components>()), ...);
+		return mask;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,142 @@
+#include "EntityStore.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace onion::voxel
+{
+	// -------- Public API --------
+
+	void EntityStore::Destroy(Entity entity)
+	{
+		if (!IsAlive(entity))
+			return;
+
+		RemoveRow(m_Locations[entity.Index]);
+		m_Locations[entity.Index].Owner = nullptr;
+
+		// 0 is the null generation, skipped when it wraps
+		uint32_t& generation = m_Generations[entity.Index];
+		generation = generation == UINT32_MAX ? 1 : generation + 1;
+
+		m_FreeIndices.push_back(entity.Index);
+		m_EntityCount--;
+	}
+
+	bool EntityStore::IsAlive(Entity entity) const
+	{
+		return !entity.IsNull() && entity.Index < m_Generations.size() &&
+			m_Generations[entity.Index] == entity.Generation;
+	}
+
+	size_t EntityStore::GetMemoryUsage() const
+	{
+		size_t bytes = sizeof(*this) + m_Generations.capacity() * sizeof(uint32_t) +
+			m_Locations.capacity() * sizeof(Location) + m_FreeIndices.capacity() * sizeof(uint32_t);
+
+		for (const Archetype* archetype : m_Archetypes)
+			bytes += archetype->GetMemoryUsage();
+
+		return bytes;
+	}
+
+	// -------- Private --------
+
+	EntityStore::Location EntityStore::CreateEntity(const ComponentMask& mask)
+	{
+		uint32_t index = 0;
+		if (!m_FreeIndices.empty())
+		{
+			index = m_FreeIndices.back();
+			m_FreeIndices.pop_back();
+		}
+		else
+		{
+			index = static_cast<uint32_t>(m_Generations.size());
+			m_Generations.push_back(1);
+			m_Locations.emplace_back();
+		}
+
+		Archetype& archetype = GetArchetype(mask);
+		const Entity entity{index, m_Generations[index]};
+		m_Locations[index] = {&archetype, archetype.AddRow(entity)};
+		m_EntityCount++;
+
+		return m_Locations[index];
+	}
+
+	const EntityStore::Location& EntityStore::MoveEntity(Entity entity, ComponentId id, bool add)
+	{
+		if (!IsAlive(entity))
+			throw std::runtime_error("Adding or removing a component of an entity not alive");
+
+		Location& location = m_Locations[entity.Index];
+		ComponentMask mask = location.Owner->GetMask();
+		if (mask.test(id) == add)
+			return location;
+
+		mask.set(id, add);
+		Archetype& target = GetArchetype(mask);
+		const Archetype::Row row = target.AddRow(entity);
+
+		for (ComponentId shared : target.GetComponentIds())
+		{
+			if (location.Owner->HasComponent(shared))
+				std::memcpy(target.GetComponent(row, shared),
+							location.Owner->GetComponent(location.Row, shared),
+							GetComponentInfo(shared).Size);
+		}
+
+		RemoveRow(location);
+		location = {&target, row};
+		return location;
+	}
+
+	void EntityStore::RemoveRow(const Location& location)
+	{
+		const Location removed = location;
+		const Entity moved = removed.Owner->RemoveRow(removed.Row);
+		if (!moved.IsNull())
+			m_Locations[moved.Index].Row = removed.Row;
+	}
+
+	bool EntityStore::HasComponent(Entity entity, ComponentId id) const
+	{
+		return IsAlive(entity) && m_Locations[entity.Index].Owner->HasComponent(id);
+	}
+
+	void* EntityStore::GetComponent(Entity entity, ComponentId id)
+	{
+		if (!HasComponent(entity, id))
+			return nullptr;
+
+		const Location& location = m_Locations[entity.Index];
+		return location.Owner->GetComponent(location.Row, id);
+	}
+
+	Archetype& EntityStore::GetArchetype(const ComponentMask& mask)
+	{
+		auto it = m_ArchetypesByMask.find(mask);
+		if (it != m_ArchetypesByMask.end())
+			return *it->second;
+
+		// Created before it is listed : when its components don't fit in a chunk, nothing changes
+		auto archetype = std::make_unique<Archetype>(mask);
+		m_Archetypes.push_back(archetype.get());
+		return *m_ArchetypesByMask.emplace(mask, std::move(archetype)).first->second;
+	}
+
+	const std::vector<Archetype*>& EntityStore::GetMatchingArchetypes(const ComponentMask& mask)
+	{
+		Query& query = m_Queries[mask];
+		for (; query.CheckedCount < m_Archetypes.size(); query.CheckedCount++)
+		{
+			Archetype* archetype = m_Archetypes[query.CheckedCount];
+			if ((archetype->GetMask() & mask) == mask)
+				query.Archetypes.push_back(archetype);
+		}
+
+		return query.Archetypes;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <latch>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+#include <jobs/JobSystem.hpp>
+
+#include "Archetype.hpp"
+#include "Entity.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Entities (mobs, dropped items, projectiles...) and their components, grouped in archetypes by the set
+	/// of components they have.
+	///
+	/// A query visits the archetypes having all of its components, chunk by chunk : each component is read from a
+	/// dense array, and archetypes without them cost nothing. The archetypes matching a query are found once and
+	/// cached, new archetypes are added to the cached lists as they appear.
+	///
+	/// Adding or removing a component moves the entity to another archetype, copying its other components : cheap,
+	/// but not free, prefer a flag in a component for states that change every tick.
+	///
+	/// Not thread safe. Nothing may create, destroy, add or remove during a query, including from its function.
+	/// Parallel queries run the function on the workers at once, each call on other entities.
+	class EntityStore
+	{
+	  public:
+		EntityStore() = default;
+
+		EntityStore(const EntityStore&) = delete;
+		EntityStore& operator=(const EntityStore&) = delete;
+
+		template <typename... Components> Entity Create(const Components&... components)
+		{
+			const Location location = CreateEntity(GetComponentMask<Components...>());
+			(new (location.Owner->GetComponent(location.Row, GetComponentId<Components>())) Components(components),
+			 ...);
+			return location.Owner->GetEntities(location.Row.Chunk)[location.Row.Index];
+		}
+
+		/// @brief Does nothing for an entity not alive.
+		void Destroy(Entity entity);
+		bool IsAlive(Entity entity) const;
+
+		template <typename T> bool Has(Entity entity) const { return HasComponent(entity, GetComponentId<T>()); }
+
+		/// @return Null when the entity is not alive or doesn't have the component. Valid until the next structural
+		/// change (create, destroy, add or remove).
+		template <typename T> T* Get(Entity entity)
+		{
+			return static_cast<T*>(GetComponent(entity, GetComponentId<T>()));
+		}
+
+		/// @brief Sets the component, adding it first when the entity doesn't have it. The entity must be alive.
+		template <typename T> T& Add(Entity entity, const T& component = {})
+		{
+			const ComponentId id = GetComponentId<T>();
+			const Location& location = MoveEntity(entity, id, true);
+			return *new (location.Owner->GetComponent(location.Row, id)) T(component);
+		}
+
+		/// @brief Does nothing when the entity doesn't have the component. The entity must be alive.
+		template <typename T> void Remove(Entity entity) { MoveEntity(entity, GetComponentId<T>(), false); }
+
+		/// @brief Calls function(rowCount, const Entity*, Components*...) for every chunk having the components, each
+		/// pointer to rowCount values. Components taken as const T are only read.
+		template <typename... Components, typename Function> void ForEachChunk(Function&& function)
+		{
+			for (Archetype* archetype : GetMatchingArchetypes(GetComponentMask<Components...>()))
+			{
+				for (size_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++)
+					function(archetype->GetRowCount(chunk),
+							 static_cast<const Entity*>(archetype->GetEntities(chunk)),
+							 archetype->GetComponents<Components>(chunk)...);
+			}
+		}
+
+		/// @brief Calls function(Entity, Components&...) for every entity having the components.
+		template <typename... Components, typename Function> void ForEach(Function&& function)
+		{
+			ForEachChunk<Components...>(
+				[&function](uint32_t count, const Entity* entities, Components*... components)
+				{
+					for (uint32_t i = 0; i < count; i++)
+						function(entities[i], components[i]...);
+				});
+		}
+
+		/// @brief ForEachChunk with one job per chunk. Blocks until done, not from inside a job.
+		template <typename... Components, typename Function>
+		void ParallelForEachChunk(JobSystem& jobs, Function&& function)
+		{
+			const std::vector<Archetype*>& archetypes = GetMatchingArchetypes(GetComponentMask<Components...>());
+
+			size_t jobCount = 0;
+			for (const Archetype* archetype : archetypes)
+				jobCount += archetype->GetChunkCount();
+			if (jobCount == 0)
+				return;
+
+			std::latch done(static_cast<std::ptrdiff_t>(jobCount));
+			for (Archetype* archetype : archetypes)
+			{
+				for (size_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++)
+				{
+					jobs.Submit(
+						[&function, &done, archetype, chunk]()
+						{
+							function(archetype->GetRowCount(chunk),
+									 static_cast<const Entity*>(archetype->GetEntities(chunk)),
+									 archetype->GetComponents<Components>(chunk)...);
+							done.count_down();
+						});
+				}
+			}
+
+			done.wait();
+		}
+
+		/// @brief ForEach with one job per chunk. Blocks until done, not from inside a job.
+		template <typename... Components, typename Function> void ParallelForEach(JobSystem& jobs, Function&& function)
+		{
+			ParallelForEachChunk<Components...>(
+				jobs,
+				[&function](uint32_t count, const Entity* entities, Components*... components)
+				{
+					for (uint32_t i = 0; i < count; i++)
+						function(entities[i], components[i]...);
+				});
+		}
+
+		/// @return The number of entities having the components.
+		template <typename... Components> size_t Count()
+		{
+			size_t count = 0;
+			for (const Archetype* archetype : GetMatchingArchetypes(GetComponentMask<Components...>()))
+				count += archetype->GetEntityCount();
+			return count;
+		}
+
+		size_t GetEntityCount() const { return m_EntityCount; }
+		size_t GetArchetypeCount() const { return m_Archetypes.size(); }
+		size_t GetMemoryUsage() const;
+
+	  private:
+		struct Location
+		{
+			Archetype* Owner = nullptr; // Null once destroyed
+			Archetype::Row Row;
+		};
+
+		struct Query
+		{
+			std::vector<Archetype*> Archetypes;
+			size_t CheckedCount = 0; // Of m_Archetypes, the newer ones are not checked yet
+		};
+
+		Location CreateEntity(const ComponentMask& mask);
+		/// @brief Moves the entity to the archetype with the component added or removed, a no-op when already there.
+		const Location& MoveEntity(Entity entity, ComponentId id, bool add);
+		/// @brief Removes the row, and follows the entity moved into it.
+		void RemoveRow(const Location& location);
+
+		bool HasComponent(Entity entity, ComponentId id) const;
+		void* GetComponent(Entity entity, ComponentId id);
+
+		Archetype& GetArchetype(const ComponentMask& mask);
+		const std::vector<Archetype*>& GetMatchingArchetypes(const ComponentMask& mask);
+
+	  private:
+		// Indexed by Entity::Index
+		std::vector<uint32_t> m_Generations;
+		std::vector<Location> m_Locations;
+		std::vector<uint32_t> m_FreeIndices;
+		size_t m_EntityCount = 0;
+
+		std::unordered_map<ComponentMask, std::unique_ptr<Archetype>> m_ArchetypesByMask;
+		std::vector<Archetype*> m_Archetypes; // In creation order
+		std::unordered_map<ComponentMask, Query> m_Queries;
+	};
+} // namespace onion::voxel
@@ -0,0 +1,147 @@
+#include "JobSystem.hpp"
+
+#include <algorithm>
+
+namespace onion::voxel
+{
+	namespace
+	{
+		// Set on the worker threads, tells Submit() and jobs which deque is theirs
+		thread_local const JobSystem* t_CurrentSystem = nullptr;
+		thread_local int t_CurrentWorker = -1;
+	} // namespace
+
+	// -------- Constructor / Destructor --------
+
+	JobSystem::JobSystem(unsigned int workerCount)
+	{
+		if (workerCount == 0)
+			workerCount = std::max(2u, std::thread::hardware_concurrency()) - 1;
+
+		m_Workers.reserve(workerCount);
+		for (unsigned int i = 0; i < workerCount; i++)
+			m_Workers.push_back(std::make_unique<Worker>());
+
+		// Every deque exists before the first worker may try to steal from it
+		for (unsigned int i = 0; i < workerCount; i++)
+			m_Workers[i]->Thread = std::jthread([this, i](std::stop_token st) { WorkerFunction(st, i); });
+	}
+
+	JobSystem::~JobSystem()
+	{
+		WaitIdle();
+
+		for (auto& worker : m_Workers)
+			worker->Thread.request_stop();
+
+		for (auto& worker : m_Workers)
+		{
+			if (worker->Thread.joinable())
+				worker->Thread.join();
+		}
+	}
+
+	// -------- Submission --------
+
+	void JobSystem::Submit(Job job)
+	{
+		m_UnfinishedCount.fetch_add(1, std::memory_order_relaxed);
+
+		int current = GetCurrentWorkerIndex();
+		unsigned int index = current >= 0
+			? static_cast<unsigned int>(current)
+			: m_NextWorker.fetch_add(1, std::memory_order_relaxed) % GetWorkerCount();
+
+		{
+			std::lock_guard<std::mutex> lock(m_Workers[index]->Mutex);
+			m_Workers[index]->Jobs.push_back(std::move(job));
+		}
+		m_QueuedCount.fetch_add(1, std::memory_order_release);
+
+		// Taking the lock orders the increment before a worker that is about to sleep checks the count
+		{
+			std::lock_guard<std::mutex> lock(m_SleepMutex);
+		}
+		m_WorkAvailable.notify_one();
+	}
+
+	void JobSystem::WaitIdle()
+	{
+		std::unique_lock<std::mutex> lock(m_SleepMutex);
+		m_Idle.wait(lock, [this]() { return m_UnfinishedCount.load(std::memory_order_acquire) == 0; });
+	}
+
+	int JobSystem::GetCurrentWorkerIndex() const
+	{
+		return t_CurrentSystem == this ? t_CurrentWorker : -1;
+	}
+
+	// -------- Workers --------
+
+	void JobSystem::WorkerFunction(std::stop_token st, unsigned int index)
+	{
+		t_CurrentSystem = this;
+		t_CurrentWorker = static_cast<int>(index);
+
+		while (true)
+		{
+			Job job;
+			if (PopLocal(index, job) || Steal(index, job))
+			{
+				m_QueuedCount.fetch_sub(1, std::memory_order_relaxed);
+				job();
+
+				if (m_UnfinishedCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					std::lock_guard<std::mutex> lock(m_SleepMutex);
+					m_Idle.notify_all();
+				}
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(m_SleepMutex);
+			if (!m_WorkAvailable.wait(
+					lock, st, [this]() { return m_QueuedCount.load(std::memory_order_acquire) > 0; }))
+				break;
+		}
+
+		t_CurrentSystem = nullptr;
+		t_CurrentWorker = -1;
+	}
+
+	bool JobSystem::PopLocal(unsigned int index, Job& job)
+	{
+		Worker& worker = *m_Workers[index];
+		std::lock_guard<std::mutex> lock(worker.Mutex);
+
+		if (worker.Jobs.empty())
+			return false;
+
+		// Newest first : its data is the most likely to still be in cache
+		job = std::move(worker.Jobs.back());
+		worker.Jobs.pop_back();
+		return true;
+	}
+
+	bool JobSystem::Steal(unsigned int thief, Job& job)
+	{
+		const unsigned int count = GetWorkerCount();
+
+		for (unsigned int offset = 1; offset < count; offset++)
+		{
+			Worker& victim = *m_Workers[(thief + offset) % count];
+			std::lock_guard<std::mutex> lock(victim.Mutex);
+
+			if (victim.Jobs.empty())
+				continue;
+
+			// Oldest first, the owner works on the other end
+			job = std::move(victim.Jobs.front());
+			victim.Jobs.pop_front();
+			m_StolenCount.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		return false;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace onion::voxel
+{
+	/// @brief Pool of worker threads running short CPU jobs (meshing, lighting, generation...).
+	///
+	/// Each worker has its own deque : it takes its newest job first (still warm in cache), and when it runs dry it
+	/// steals the oldest job of another worker. Jobs submitted from a worker go to that worker's deque, jobs from
+	/// other threads are spread round robin. Ordering between jobs is not guaranteed, callers that need priorities
+	/// submit in priority order and keep the number of jobs in flight small.
+	class JobSystem
+	{
+	  public:
+		using Job = std::function<void()>;
+
+		/// @param workerCount 0 picks one worker per hardware thread, minus one for the main and render threads.
+		explicit JobSystem(unsigned int workerCount = 0);
+		/// @brief Runs the jobs still queued, then joins the workers.
+		~JobSystem();
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		/// @brief Any thread, including from inside a job.
+		void Submit(Job job);
+
+		/// @brief Blocks until every submitted job has finished. Not from inside a job.
+		void WaitIdle();
+
+		unsigned int GetWorkerCount() const { return static_cast<unsigned int>(m_Workers.size()); }
+		size_t GetUnfinishedCount() const { return m_UnfinishedCount.load(std::memory_order_relaxed); }
+		uint64_t GetStolenCount() const { return m_StolenCount.load(std::memory_order_relaxed); }
+
+		/// @return Index of the calling worker in [0, GetWorkerCount()), -1 outside of this system's workers.
+		/// Lets jobs use per-worker scratch data without locks.
+		int GetCurrentWorkerIndex() const;
+
+	  private:
+		struct Worker
+		{
+			std::mutex Mutex;
+			std::deque<Job> Jobs;
+			std::jthread Thread;
+		};
+
+		void WorkerFunction(std::stop_token st, unsigned int index);
+		bool PopLocal(unsigned int index, Job& job);
+		bool Steal(unsigned int thief, Job& job);
+
+	  private:
+		std::vector<std::unique_ptr<Worker>> m_Workers;
+
+		std::mutex m_SleepMutex;
+		std::condition_variable_any m_WorkAvailable;
+		std::condition_variable m_Idle;
+
+		std::atomic<size_t> m_QueuedCount{0};	   // In a deque
+		std::atomic<size_t> m_UnfinishedCount{0}; // Queued or running
+		std::atomic<unsigned int> m_NextWorker{0};
+		std::atomic<uint64_t> m_StolenCount{0};
+	};
+} // namespace onion::voxel
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+namespace onion::voxel
+{
+	/// @brief Unbounded lock-free queue, any number of producer threads and a single consumer thread.
+	///
+	/// Linked list with a stub node (D. Vyukov) : Push() is one atomic exchange and never waits, TryPop() never
+	/// waits either. A Push() caught between its two steps hides the items behind it until it finishes, TryPop()
+	/// then reports an empty queue and the consumer simply gets them on its next call.
+	template <typename T> class MpscQueue
+	{
+	  public:
+		MpscQueue() : m_Head(new Node()), m_Tail(m_Head.load(std::memory_order_relaxed)) {}
+
+		~MpscQueue()
+		{
+			T value;
+			while (TryPop(value))
+			{
+			}
+			delete m_Tail;
+		}
+
+		MpscQueue(const MpscQueue&) = delete;
+		MpscQueue& operator=(const MpscQueue&) = delete;
+
+		/// @brief Any thread.
+		void Push(T value)
+		{
+			Node* node = new Node();
+			node->Value = std::move(value);
+
+			Node* previous = m_Head.exchange(node, std::memory_order_acq_rel);
+			previous->Next.store(node, std::memory_order_release);
+		}
+
+		/// @brief Consumer thread only.
+		bool TryPop(T& value)
+		{
+			Node* next = m_Tail->Next.load(std::memory_order_acquire);
+			if (!next)
+				return false;
+
+			// The next node becomes the stub, its value is moved out
+			value = std::move(next->Value);
+			delete m_Tail;
+			m_Tail = next;
+			return true;
+		}
+
+		/// @brief Consumer thread only, may miss items being pushed at the same time.
+		bool IsEmpty() const { return m_Tail->Next.load(std::memory_order_acquire) == nullptr; }
+
+	  private:
+		struct Node
+		{
+			std::atomic<Node*> Next{nullptr};
+			T Value{};
+		};
+
+		std::atomic<Node*> m_Head; // Last pushed node, producers
+		Node* m_Tail;			   // Stub, consumer
+	};
+} // namespace onion::voxel
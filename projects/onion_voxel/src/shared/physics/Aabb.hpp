@@ -0,0 +1,41 @@
+#pragma once
+
+namespace onion::voxel
+{
+	/// @brief Axis aligned box, in blocks. Boxes only touching along a face don't overlap.
+	struct Aabb
+	{
+		float MinX = 0.f;
+		float MinY = 0.f;
+		float MinZ = 0.f;
+		float MaxX = 0.f;
+		float MaxY = 0.f;
+		float MaxZ = 0.f;
+
+		bool Overlaps(const Aabb& other) const
+		{
+			return MinX < other.MaxX && MaxX > other.MinX && MinY < other.MaxY && MaxY > other.MinY &&
+				MinZ < other.MaxZ && MaxZ > other.MinZ;
+		}
+
+		void Offset(float dx, float dy, float dz)
+		{
+			MinX += dx;
+			MaxX += dx;
+			MinY += dy;
+			MaxY += dy;
+			MinZ += dz;
+			MaxZ += dz;
+		}
+
+		/// @brief Also covers the box moved by the motion.
+		Aabb Expand(float dx, float dy, float dz) const
+		{
+			Aabb box = *this;
+			(dx < 0.f ? box.MinX : box.MaxX) += dx;
+			(dy < 0.f ? box.MinY : box.MaxY) += dy;
+			(dz < 0.f ? box.MinZ : box.MaxZ) += dz;
+			return box;
+		}
+	};
+} // namespace onion::voxel
@@ -0,0 +1,202 @@
+#include "EntityPhysics.hpp"
+
+#include <algorithm>
+#include <latch>
+
+namespace onion::voxel
+{
+	namespace
+	{
+		constexpr size_t BodiesPerJob = 1024;
+	} // namespace
+
+	// -------- Bodies --------
+
+	size_t PhysicsBodies::Add(float x, float y, float z, float halfWidth, float height)
+	{
+		PositionX.push_back(x);
+		PositionY.push_back(y);
+		PositionZ.push_back(z);
+		VelocityX.push_back(0.f);
+		VelocityY.push_back(0.f);
+		VelocityZ.push_back(0.f);
+		HalfWidth.push_back(halfWidth);
+		Height.push_back(height);
+		Flags.push_back(0);
+
+		return PositionX.size() - 1;
+	}
+
+	void PhysicsBodies::Remove(size_t index)
+	{
+		auto removeFrom = [index](auto& values)
+		{
+			values[index] = values.back();
+			values.pop_back();
+		};
+
+		removeFrom(PositionX);
+		removeFrom(PositionY);
+		removeFrom(PositionZ);
+		removeFrom(VelocityX);
+		removeFrom(VelocityY);
+		removeFrom(VelocityZ);
+		removeFrom(HalfWidth);
+		removeFrom(Height);
+		removeFrom(Flags);
+	}
+
+	void PhysicsBodies::Reserve(size_t count)
+	{
+		for (std::vector<float>* values :
+			 {&PositionX, &PositionY, &PositionZ, &VelocityX, &VelocityY, &VelocityZ, &HalfWidth, &Height})
+			values->reserve(count);
+		Flags.reserve(count);
+	}
+
+	void PhysicsBodies::Clear()
+	{
+		for (std::vector<float>* values :
+			 {&PositionX, &PositionY, &PositionZ, &VelocityX, &VelocityY, &VelocityZ, &HalfWidth, &Height})
+			values->clear();
+		Flags.clear();
+	}
+
+	// -------- Constructor --------
+
+	EntityPhysics::EntityPhysics(const PhysicsSettings& settings) : m_Settings(settings) {}
+
+	// -------- Public API --------
+
+	int EntityPhysics::Update(const ChunkStore& world, PhysicsBodies& bodies, float deltaSeconds, JobSystem* jobs)
+	{
+		m_Accumulator += deltaSeconds;
+
+		int stepCount = 0;
+		while (m_Accumulator >= m_Settings.FixedStep && stepCount < m_Settings.MaxStepsPerUpdate)
+		{
+			if (jobs)
+				Step(*jobs, world, bodies);
+			else
+				Step(world, bodies);
+
+			m_Accumulator -= m_Settings.FixedStep;
+			stepCount++;
+		}
+
+		// Too far behind : the steps not run are dropped rather than piled on the next update
+		m_Accumulator = std::min(m_Accumulator, m_Settings.FixedStep);
+		return stepCount;
+	}
+
+	void EntityPhysics::Step(const ChunkStore& world, PhysicsBodies& bodies) const
+	{
+		VoxelCollider collider(world);
+		StepRange(collider, bodies, 0, bodies.GetCount());
+	}
+
+	void EntityPhysics::Step(JobSystem& jobs, const ChunkStore& world, PhysicsBodies& bodies) const
+	{
+		const size_t count = bodies.GetCount();
+		const size_t jobCount = (count + BodiesPerJob - 1) / BodiesPerJob;
+		std::latch done(static_cast<std::ptrdiff_t>(jobCount));
+
+		for (size_t job = 0; job < jobCount; job++)
+		{
+			jobs.Submit(
+				[this, &world, &bodies, &done, count, job]()
+				{
+					VoxelCollider collider(world);
+					StepRange(collider, bodies, job * BodiesPerJob, std::min(count, (job + 1) * BodiesPerJob));
+					done.count_down();
+				});
+		}
+
+		done.wait();
+	}
+
+	// -------- Private --------
+
+	void EntityPhysics::StepRange(VoxelCollider& collider, PhysicsBodies& bodies, size_t first, size_t last) const
+	{
+		const float dt = m_Settings.FixedStep;
+
+		for (size_t i = first; i < last; i++)
+		{
+			float velocityX = bodies.VelocityX[i];
+			float velocityY = std::max(bodies.VelocityY[i] - m_Settings.Gravity * dt, -m_Settings.MaxFallSpeed);
+			float velocityZ = bodies.VelocityZ[i];
+
+			const float halfWidth = bodies.HalfWidth[i];
+			const Aabb box{bodies.PositionX[i] - halfWidth,
+						   bodies.PositionY[i],
+						   bodies.PositionZ[i] - halfWidth,
+						   bodies.PositionX[i] + halfWidth,
+						   bodies.PositionY[i] + bodies.Height[i],
+						   bodies.PositionZ[i] + halfWidth};
+
+			const float wantedX = velocityX * dt;
+			const float wantedY = velocityY * dt;
+			const float wantedZ = velocityZ * dt;
+
+			Aabb moved = box;
+			float dx = wantedX;
+			float dy = wantedY;
+			float dz = wantedZ;
+			uint8_t clipped = collider.Move(moved, dx, dy, dz);
+			bool onGround = (clipped & VoxelCollider::ClippedY) && wantedY < 0.f;
+
+			// Walking into a wall : up by the step height, across, then back down onto the step. Not while jumping.
+			const bool wasOnGround = bodies.Flags[i] & BodyFlags::OnGround;
+			const uint8_t horizontal = VoxelCollider::ClippedX | VoxelCollider::ClippedZ;
+			if ((clipped & horizontal) && (wasOnGround || onGround) && wantedY <= 0.f && m_Settings.StepHeight > 0.f)
+			{
+				Aabb raised = box;
+				float upX = 0.f;
+				float upY = m_Settings.StepHeight;
+				float upZ = 0.f;
+				collider.Move(raised, upX, upY, upZ);
+
+				float acrossX = wantedX;
+				float acrossY = 0.f;
+				float acrossZ = wantedZ;
+				const uint8_t acrossClipped = collider.Move(raised, acrossX, acrossY, acrossZ);
+
+				float downX = 0.f;
+				float downY = -upY;
+				float downZ = 0.f;
+				const uint8_t downClipped = collider.Move(raised, downX, downY, downZ) & VoxelCollider::ClippedY;
+
+				if (acrossX * acrossX + acrossZ * acrossZ > dx * dx + dz * dz)
+				{
+					moved = raised;
+					clipped = acrossClipped | downClipped;
+					onGround = downClipped != 0;
+				}
+			}
+
+			if (clipped & VoxelCollider::ClippedX)
+				velocityX = 0.f;
+			if (clipped & VoxelCollider::ClippedY)
+				velocityY = 0.f;
+			if (clipped & VoxelCollider::ClippedZ)
+				velocityZ = 0.f;
+
+			const float friction = onGround ? m_Settings.GroundFriction : m_Settings.AirFriction;
+			bodies.VelocityX[i] = velocityX * friction;
+			bodies.VelocityY[i] = velocityY;
+			bodies.VelocityZ[i] = velocityZ * friction;
+
+			bodies.PositionX[i] = moved.MinX + halfWidth;
+			bodies.PositionY[i] = moved.MinY;
+			bodies.PositionZ[i] = moved.MinZ + halfWidth;
+
+			uint8_t flags = onGround ? BodyFlags::OnGround : 0;
+			if (clipped & horizontal)
+				flags |= BodyFlags::HitWall;
+			if ((clipped & VoxelCollider::ClippedY) && wantedY > 0.f)
+				flags |= BodyFlags::HitCeiling;
+			bodies.Flags[i] = flags;
+		}
+	}
+} // namespace onion::voxel
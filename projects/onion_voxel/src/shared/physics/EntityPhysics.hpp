@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <jobs/JobSystem.hpp>
+#include <world/ChunkStore.hpp>
+
+#include "VoxelCollider.hpp"
+
+namespace onion::voxel
+{
+	namespace BodyFlags
+	{
+		constexpr uint8_t OnGround = 1 << 0;
+		constexpr uint8_t HitWall = 1 << 1; // Stopped along X or Z by the last step
+		constexpr uint8_t HitCeiling = 1 << 2;
+	} // namespace BodyFlags
+
+	/// @brief Entities moved by the physics, one array per field : a step streams through each array once and the
+	/// caller (AI, network) only touches the fields it needs. Indices are not stable, Remove() moves the last body.
+	struct PhysicsBodies
+	{
+		std::vector<float> PositionX; // Center of the bottom face, in blocks
+		std::vector<float> PositionY;
+		std::vector<float> PositionZ;
+		std::vector<float> VelocityX; // Blocks per second
+		std::vector<float> VelocityY;
+		std::vector<float> VelocityZ;
+		std::vector<float> HalfWidth;
+		std::vector<float> Height;
+		std::vector<uint8_t> Flags; // BodyFlags
+
+		/// @return The index of the new body, at rest.
+		size_t Add(float x, float y, float z, float halfWidth, float height);
+		/// @brief Moves the last body into index.
+		void Remove(size_t index);
+		void Reserve(size_t count);
+		void Clear();
+
+		size_t GetCount() const { return PositionX.size(); }
+	};
+
+	struct PhysicsSettings
+	{
+		float FixedStep = 1.f / 20.f;  // Seconds, the server tick
+		float Gravity = 32.f;		   // Blocks per second squared
+		float MaxFallSpeed = 78.4f;	   // Blocks per second
+		float GroundFriction = 0.546f; // Horizontal velocity kept per step on the ground
+		float AirFriction = 0.91f;	   // Horizontal velocity kept per step in the air
+		float StepHeight = 1.f;		   // Blocks climbed while walking : mobs follow the terrain without jumping
+		int MaxStepsPerUpdate = 5;	   // Past it the time is dropped, a stall doesn't snowball
+	};
+
+	/// @brief Moves bodies through the world at a fixed rate : gravity, friction, collision with the solid blocks,
+	/// and walking up steps.
+	///
+	/// Each step integrates the velocity, then moves every body with a VoxelCollider. A walking body stopped by a
+	/// wall tries the move again raised by the step height, and keeps it when it goes further. Bodies don't collide
+	/// with each other.
+	///
+	/// Bodies are independent : large sets are split in ranges over the workers, each with its own collider. The
+	/// ChunkStore must not be modified during a step.
+	class EntityPhysics
+	{
+	  public:
+		explicit EntityPhysics(const PhysicsSettings& settings = {});
+
+		/// @brief Runs the fixed steps covered by the time elapsed, the remainder is carried to the next call.
+		/// @param jobs Steps on the workers when not null. Blocks until done, not from inside a job.
+		/// @return The number of steps run.
+		int Update(const ChunkStore& world, PhysicsBodies& bodies, float deltaSeconds, JobSystem* jobs = nullptr);
+
+		/// @brief A single fixed step.
+		void Step(const ChunkStore& world, PhysicsBodies& bodies) const;
+		void Step(JobSystem& jobs, const ChunkStore& world, PhysicsBodies& bodies) const;
+
+		/// @brief Time left in the accumulator, in steps : drawn positions interpolate by it.
+		float GetInterpolation() const { return m_Accumulator / m_Settings.FixedStep; }
+
+		const PhysicsSettings& GetSettings() const { return m_Settings; }
+
+	  private:
+		void StepRange(VoxelCollider& collider, PhysicsBodies& bodies, size_t first, size_t last) const;
+
+	  private:
+		PhysicsSettings m_Settings;
+		float m_Accumulator = 0.f;
+	};
+} // namespace onion::voxel
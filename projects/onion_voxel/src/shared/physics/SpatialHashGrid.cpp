@@ -0,0 +1,199 @@
+#include "SpatialHashGrid.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace onion::voxel
+{
+	// -------- Constructor --------
+
+	SpatialHashGrid::SpatialHashGrid(const Settings& settings)
+		: m_Settings(settings),
+		  m_InverseCellSize(1.f / settings.CellSize),
+		  m_BucketMask(std::bit_ceil(std::max(settings.BucketCount, 1u)) - 1),
+		  m_Buckets(m_BucketMask + 1)
+	{
+	}
+
+	// -------- Public API --------
+
+	void SpatialHashGrid::Insert(uint32_t id, float x, float y, float z)
+	{
+		if (id >= m_Locations.size())
+			m_Locations.resize(static_cast<size_t>(id) + 1);
+
+		const int32_t cellX = GetCell(x);
+		const int32_t cellZ = GetCell(z);
+		const uint32_t bucket = GetBucket(cellX, cellZ);
+
+		std::vector<Point>& points = m_Buckets[bucket];
+		m_Locations[id] = {bucket, static_cast<uint32_t>(points.size())};
+		points.push_back({x, y, z, id, cellX, cellZ});
+		m_Count++;
+	}
+
+	void SpatialHashGrid::Move(uint32_t id, float x, float y, float z)
+	{
+		Location& location = m_Locations[id];
+		Point& point = m_Buckets[location.Bucket][location.Slot];
+
+		const int32_t cellX = GetCell(x);
+		const int32_t cellZ = GetCell(z);
+		if (cellX == point.CellX && cellZ == point.CellZ)
+		{
+			point.X = x;
+			point.Y = y;
+			point.Z = z;
+			return;
+		}
+
+		RemoveFromBucket(location);
+
+		const uint32_t bucket = GetBucket(cellX, cellZ);
+		std::vector<Point>& points = m_Buckets[bucket];
+		location = {bucket, static_cast<uint32_t>(points.size())};
+		points.push_back({x, y, z, id, cellX, cellZ});
+	}
+
+	void SpatialHashGrid::Remove(uint32_t id)
+	{
+		if (!Contains(id))
+			return;
+
+		RemoveFromBucket(m_Locations[id]);
+		m_Locations[id].Bucket = NotInGrid;
+		m_Count--;
+	}
+
+	bool SpatialHashGrid::Contains(uint32_t id) const
+	{
+		return id < m_Locations.size() && m_Locations[id].Bucket != NotInGrid;
+	}
+
+	void SpatialHashGrid::Clear()
+	{
+		// Buckets keep their capacity, filling the grid again doesn't allocate
+		for (std::vector<Point>& points : m_Buckets)
+			points.clear();
+		for (Location& location : m_Locations)
+			location.Bucket = NotInGrid;
+		m_Count = 0;
+	}
+
+	size_t SpatialHashGrid::QueryRadius(float x, float y, float z, float radius, std::span<uint32_t> results) const
+	{
+		const float radiusSquared = radius * radius;
+		return Query(x - radius,
+					 z - radius,
+					 x + radius,
+					 z + radius,
+					 results,
+					 [x, y, z, radiusSquared](const Point& point)
+					 {
+						 const float dx = point.X - x;
+						 const float dy = point.Y - y;
+						 const float dz = point.Z - z;
+						 return dx * dx + dy * dy + dz * dz <= radiusSquared;
+					 });
+	}
+
+	size_t SpatialHashGrid::QueryAabb(const Aabb& box, std::span<uint32_t> results) const
+	{
+		return Query(box.MinX,
+					 box.MinZ,
+					 box.MaxX,
+					 box.MaxZ,
+					 results,
+					 [&box](const Point& point)
+					 {
+						 return point.X >= box.MinX && point.X <= box.MaxX && point.Y >= box.MinY &&
+							 point.Y <= box.MaxY && point.Z >= box.MinZ && point.Z <= box.MaxZ;
+					 });
+	}
+
+	// -------- Private --------
+
+	int32_t SpatialHashGrid::GetCell(float coordinate) const
+	{
+		// Far coordinates share the cells at the edges rather than overflowing the cast. 2147483520 is the largest
+		// float below 2^31
+		const float cell = std::floor(coordinate * m_InverseCellSize);
+		return static_cast<int32_t>(std::clamp(cell, -2147483648.f, 2147483520.f));
+	}
+
+	uint32_t SpatialHashGrid::GetBucket(int32_t cellX, int32_t cellZ) const
+	{
+		const uint32_t hash = static_cast<uint32_t>(cellX) * 73856093u ^ static_cast<uint32_t>(cellZ) * 19349663u;
+		return (hash ^ (hash >> 16)) & m_BucketMask;
+	}
+
+	void SpatialHashGrid::RemoveFromBucket(const Location& location)
+	{
+		std::vector<Point>& points = m_Buckets[location.Bucket];
+		if (location.Slot + 1 != points.size())
+		{
+			points[location.Slot] = points.back();
+			m_Locations[points[location.Slot].Id].Slot = location.Slot;
+		}
+		points.pop_back();
+	}
+
+	template <typename Test>
+	size_t SpatialHashGrid::Query(
+		float minX, float minZ, float maxX, float maxZ, std::span<uint32_t> results, Test&& test) const
+	{
+		const int32_t firstX = GetCell(minX);
+		const int32_t firstZ = GetCell(minZ);
+		const int32_t lastX = GetCell(maxX);
+		const int32_t lastZ = GetCell(maxZ);
+
+		size_t found = 0;
+		auto add = [&](const Point& point)
+		{
+			if (!test(point))
+				return;
+
+			if (found < results.size())
+				results[found] = point.Id;
+			found++;
+		};
+
+		// 64-bit : the range may span every cell
+		const int64_t width = static_cast<int64_t>(lastX) - firstX + 1;
+		const int64_t depth = static_cast<int64_t>(lastZ) - firstZ + 1;
+		if (width <= 0 || depth <= 0)
+			return 0;
+
+		// More cells than buckets (a query over the whole map) : each bucket once, the cell is tested per point
+		if (static_cast<uint64_t>(width) > m_Buckets.size() / static_cast<uint64_t>(depth))
+		{
+			for (const std::vector<Point>& points : m_Buckets)
+			{
+				for (const Point& point : points)
+				{
+					if (point.CellX >= firstX && point.CellX <= lastX && point.CellZ >= firstZ &&
+						point.CellZ <= lastZ)
+						add(point);
+				}
+			}
+
+			return found;
+		}
+
+		for (int64_t cellZ = firstZ; cellZ <= lastZ; cellZ++)
+		{
+			for (int64_t cellX = firstX; cellX <= lastX; cellX++)
+			{
+				const uint32_t bucket = GetBucket(static_cast<int32_t>(cellX), static_cast<int32_t>(cellZ));
+				for (const Point& point : m_Buckets[bucket])
+				{
+					if (point.CellX == cellX && point.CellZ == cellZ)
+						add(point);
+				}
+			}
+		}
+
+		return found;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Aabb.hpp"
+
+namespace onion::voxel
+{
+	struct SpatialHashSettings
+	{
+		float CellSize = 8.f;			// Blocks, along X and Z. About the most common query radius
+		uint32_t BucketCount = 16384;	// Rounded up to a power of two. About the cells of the loaded area
+	};
+
+	/// @brief Points (entity positions) hashed by the column of cells they are in, for "what is near" queries :
+	/// collision between entities, AI perception, network interest.
+	///
+	/// Cells split the world along X and Z only, the world is much wider than high. Each cell hashes to a bucket of a
+	/// fixed table, and a bucket stores the positions of its points next to their ids : a query scans a few short
+	/// arrays and tests each point without looking it up. Cells sharing a bucket are told apart by the cell stored
+	/// with each point.
+	///
+	/// Points are found by an id given by the caller, like the index of an Entity or of a physics body : ids should be
+	/// dense, the grid keeps a record per id up to the largest. Moving a point within its cell only writes its
+	/// position, moving it to another cell swaps it out of its bucket.
+	///
+	/// Queries write into the caller's buffer and never allocate. Not thread safe, queries from several threads are
+	/// fine as long as nothing inserts, moves or removes meanwhile.
+	class SpatialHashGrid
+	{
+	  public:
+		using Settings = SpatialHashSettings;
+
+		explicit SpatialHashGrid(const Settings& settings = {});
+
+		/// @brief The id must not be in the grid.
+		void Insert(uint32_t id, float x, float y, float z);
+		/// @brief The id must be in the grid.
+		void Move(uint32_t id, float x, float y, float z);
+		/// @brief Does nothing when the id is not in the grid.
+		void Remove(uint32_t id);
+		bool Contains(uint32_t id) const;
+		void Clear();
+
+		/// @brief Ids of the points at most radius away from (x, y, z).
+		/// @return The number of points found : only the first results.size() are written, query again with a
+		/// larger buffer when it is exceeded.
+		size_t QueryRadius(float x, float y, float z, float radius, std::span<uint32_t> results) const;
+
+		/// @brief Ids of the points inside the box, bounds included. Expand the box by the largest entity half size to
+		/// find the entities overlapping it rather than their positions.
+		/// @return Like QueryRadius().
+		size_t QueryAabb(const Aabb& box, std::span<uint32_t> results) const;
+
+		size_t GetCount() const { return m_Count; }
+		const Settings& GetSettings() const { return m_Settings; }
+
+	  private:
+		static constexpr uint32_t NotInGrid = UINT32_MAX;
+
+		struct Point
+		{
+			float X, Y, Z;
+			uint32_t Id;
+			int32_t CellX, CellZ;
+		};
+
+		struct Location
+		{
+			uint32_t Bucket = NotInGrid;
+			uint32_t Slot = 0; // In the bucket
+		};
+
+		int32_t GetCell(float coordinate) const;
+		uint32_t GetBucket(int32_t cellX, int32_t cellZ) const;
+		void RemoveFromBucket(const Location& location);
+
+		/// @brief Calls test(point) for each point of the cells covering [minX, maxX] x [minZ, maxZ], and writes the
+		/// ids of those passing. A range of more cells than buckets scans each bucket once instead, a query over the
+		/// whole map costs about one pass over the points.
+		template <typename Test>
+		size_t Query(float minX, float minZ, float maxX, float maxZ, std::span<uint32_t> results, Test&& test) const;
+
+	  private:
+		Settings m_Settings;
+		float m_InverseCellSize;
+		uint32_t m_BucketMask;
+
+		std::vector<std::vector<Point>> m_Buckets;
+		std::vector<Location> m_Locations; // Indexed by id
+		size_t m_Count = 0;
+	};
+} // namespace onion::voxel
@@ -0,0 +1,126 @@
+#include "VoxelCollider.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <world/Blocks.hpp>
+
+namespace onion::voxel
+{
+	namespace
+	{
+		// Boxes within this distance of a block face are on its side : rounding after a clip never lets them in
+		constexpr float Epsilon = 1e-4f;
+
+		/// @brief Clips a motion along one axis (0 : X, 1 : Y, 2 : Z) against the blocks overlapping the box on the
+		/// two other axes. Never reverses the motion : a block the box already overlaps is ignored, it can get out.
+		float Clip(const std::vector<BlockPos>& blocks, const Aabb& box, int axis, float motion)
+		{
+			const float min[3] = {box.MinX, box.MinY, box.MinZ};
+			const float max[3] = {box.MaxX, box.MaxY, box.MaxZ};
+			const int a = (axis + 1) % 3;
+			const int b = (axis + 2) % 3;
+
+			for (const BlockPos& block : blocks)
+			{
+				const float low[3] = {
+					static_cast<float>(block.x), static_cast<float>(block.y), static_cast<float>(block.z)};
+				if (max[a] <= low[a] || min[a] >= low[a] + 1.f || max[b] <= low[b] || min[b] >= low[b] + 1.f)
+					continue;
+
+				if (motion > 0.f && max[axis] <= low[axis] + Epsilon)
+					motion = std::min(motion, std::max(low[axis] - max[axis], 0.f));
+				else if (motion < 0.f && min[axis] >= low[axis] + 1.f - Epsilon)
+					motion = std::max(motion, std::min(low[axis] + 1.f - min[axis], 0.f));
+			}
+
+			return motion;
+		}
+	} // namespace
+
+	// -------- Constructor --------
+
+	VoxelCollider::VoxelCollider(const ChunkStore& world) : m_World(world) {}
+
+	// -------- Public API --------
+
+	uint8_t VoxelCollider::Move(Aabb& box, float& dx, float& dy, float& dz)
+	{
+		GatherBlocks(box.Expand(dx, dy, dz));
+
+		uint8_t clipped = 0;
+		const float wantedX = dx;
+		const float wantedY = dy;
+		const float wantedZ = dz;
+
+		dy = Clip(m_Blocks, box, 1, dy);
+		box.Offset(0.f, dy, 0.f);
+		dx = Clip(m_Blocks, box, 0, dx);
+		box.Offset(dx, 0.f, 0.f);
+		dz = Clip(m_Blocks, box, 2, dz);
+		box.Offset(0.f, 0.f, dz);
+
+		if ((wantedY < 0.f && dy > wantedY) || (wantedY > 0.f && dy < wantedY))
+			clipped |= ClippedY;
+		if ((wantedX < 0.f && dx > wantedX) || (wantedX > 0.f && dx < wantedX))
+			clipped |= ClippedX;
+		if ((wantedZ < 0.f && dz > wantedZ) || (wantedZ > 0.f && dz < wantedZ))
+			clipped |= ClippedZ;
+
+		return clipped;
+	}
+
+	bool VoxelCollider::IsColliding(const Aabb& box)
+	{
+		GatherBlocks(box);
+
+		return std::any_of(m_Blocks.begin(),
+						   m_Blocks.end(),
+						   [&box](const BlockPos& block)
+						   {
+							   const float x = static_cast<float>(block.x);
+							   const float y = static_cast<float>(block.y);
+							   const float z = static_cast<float>(block.z);
+							   return box.Overlaps({x, y, z, x + 1.f, y + 1.f, z + 1.f});
+						   });
+	}
+
+	// -------- Private --------
+
+	void VoxelCollider::GatherBlocks(const Aabb& region)
+	{
+		m_Blocks.clear();
+
+		const int minX = static_cast<int>(std::floor(region.MinX));
+		const int minY = std::max(static_cast<int>(std::floor(region.MinY)), 0);
+		const int minZ = static_cast<int>(std::floor(region.MinZ));
+		const int maxX = static_cast<int>(std::ceil(region.MaxX)) - 1;
+		const int maxY = std::min(static_cast<int>(std::ceil(region.MaxY)) - 1, Chunk::Height - 1);
+		const int maxZ = static_cast<int>(std::ceil(region.MaxZ)) - 1;
+
+		for (int z = minZ; z <= maxZ; z++)
+		{
+			for (int x = minX; x <= maxX; x++)
+			{
+				const Chunk* chunk = GetChunk(ChunkCoord::FromBlock(x, z));
+				for (int y = minY; y <= maxY; y++)
+				{
+					if (!chunk || GetBlockProperties(chunk->GetBlock(ToLocal(x), y, ToLocal(z))).IsSolid)
+						m_Blocks.push_back({x, y, z});
+				}
+			}
+		}
+	}
+
+	const Chunk* VoxelCollider::GetChunk(ChunkCoord coord)
+	{
+		if (!m_HasCachedChunk || coord != m_CachedCoord)
+		{
+			m_CachedChunk = m_World.GetChunk(coord);
+			m_CachedCoord = coord;
+			m_HasCachedChunk = true;
+		}
+
+		return m_CachedChunk;
+	}
+} // namespace onion::voxel
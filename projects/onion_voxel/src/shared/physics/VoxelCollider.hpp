@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <world/ChunkStore.hpp>
+
+#include "Aabb.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Moves boxes through the world without entering solid blocks.
+	///
+	/// A move only looks at the blocks overlapped by the box expanded by the motion, read straight from the chunk
+	/// sections. Its solid blocks are gathered once, then the motion is clipped against them one axis at a time :
+	/// Y first (landing, ceilings), then X, then Z. The box slides along the walls it touches, and a box resting on
+	/// the ground doesn't sink into it through rounding.
+	///
+	/// Unloaded chunks are solid : nothing falls out of the loaded world. Reads the ChunkStore without locking, one
+	/// collider per thread.
+	class VoxelCollider
+	{
+	  public:
+		/// @brief Axes along which a move was clipped.
+		static constexpr uint8_t ClippedX = 1 << 0;
+		static constexpr uint8_t ClippedY = 1 << 1;
+		static constexpr uint8_t ClippedZ = 1 << 2;
+
+		explicit VoxelCollider(const ChunkStore& world);
+
+		/// @brief Moves the box by up to (dx, dy, dz), which become the motion actually applied.
+		/// @return The Clipped* flags of the axes stopped by a block.
+		uint8_t Move(Aabb& box, float& dx, float& dy, float& dz);
+
+		/// @brief Whether the box overlaps a solid block.
+		bool IsColliding(const Aabb& box);
+
+		/// @brief The chunk pointers looked up are kept until this call, after chunks are inserted or removed.
+		void ClearChunkCache() { m_HasCachedChunk = false; }
+
+	  private:
+		/// @brief Solid blocks overlapped by the region into m_Blocks.
+		void GatherBlocks(const Aabb& region);
+		const Chunk* GetChunk(ChunkCoord coord);
+
+	  private:
+		const ChunkStore& m_World;
+		std::vector<BlockPos> m_Blocks; // Scratch, reused by every move
+
+		ChunkCoord m_CachedCoord;
+		const Chunk* m_CachedChunk = nullptr;
+		bool m_HasCachedChunk = false;
+	};
+} // namespace onion::voxel
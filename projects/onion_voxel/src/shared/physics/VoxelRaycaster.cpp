@@ -0,0 +1,235 @@
+#include "VoxelRaycaster.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <latch>
+#include <limits>
+
+#include <world/Blocks.hpp>
+
+namespace onion::voxel
+{
+	namespace
+	{
+		constexpr float Infinity = std::numeric_limits<float>::infinity();
+		constexpr size_t RaysPerJob = 256;
+
+		int FloorToInt(float value)
+		{
+			return static_cast<int>(std::floor(value));
+		}
+
+		/// @brief Face of the block entered by a step along axis.
+		BlockFace GetEnteredFace(int axis, int step)
+		{
+			return static_cast<BlockFace>(axis * 2 + (step > 0 ? 1 : 0));
+		}
+	} // namespace
+
+	// -------- Constructor --------
+
+	VoxelRaycaster::VoxelRaycaster(const ChunkStore& world, RaycastTarget target) : m_World(world), m_Target(target)
+	{
+	}
+
+	// -------- Public API --------
+
+	RayHit VoxelRaycaster::Cast(const Ray& ray)
+	{
+		ClearChunkCache();
+		return CastRay(ray);
+	}
+
+	void VoxelRaycaster::Cast(const std::vector<Ray>& rays, std::vector<RayHit>& hits)
+	{
+		ClearChunkCache();
+
+		hits.resize(rays.size());
+		for (size_t i = 0; i < rays.size(); i++)
+			hits[i] = CastRay(rays[i]);
+	}
+
+	void VoxelRaycaster::Cast(JobSystem& jobs, const std::vector<Ray>& rays, std::vector<RayHit>& hits) const
+	{
+		hits.resize(rays.size());
+
+		const size_t jobCount = (rays.size() + RaysPerJob - 1) / RaysPerJob;
+		std::latch done(static_cast<std::ptrdiff_t>(jobCount));
+
+		for (size_t job = 0; job < jobCount; job++)
+		{
+			jobs.Submit(
+				[this, &rays, &hits, &done, job]()
+				{
+					// Each batch has its own chunk cache
+					VoxelRaycaster raycaster(m_World, m_Target);
+
+					const size_t end = std::min(rays.size(), (job + 1) * RaysPerJob);
+					for (size_t i = job * RaysPerJob; i < end; i++)
+						hits[i] = raycaster.CastRay(rays[i]);
+
+					done.count_down();
+				});
+		}
+
+		done.wait();
+	}
+
+	bool VoxelRaycaster::HasLineOfSight(float fromX, float fromY, float fromZ, float toX, float toY, float toZ)
+	{
+		const float dx = toX - fromX;
+		const float dy = toY - fromY;
+		const float dz = toZ - fromZ;
+
+		return !Cast({fromX, fromY, fromZ, dx, dy, dz, std::sqrt(dx * dx + dy * dy + dz * dz)}).Hit;
+	}
+
+	// -------- Private --------
+
+	RayHit VoxelRaycaster::CastRay(const Ray& ray)
+	{
+		RayHit hit;
+
+		const float length = std::sqrt(ray.DirectionX * ray.DirectionX + ray.DirectionY * ray.DirectionY +
+									   ray.DirectionZ * ray.DirectionZ);
+		if (!(length > 0.f) || !(ray.MaxDistance >= 0.f))
+			return hit;
+
+		const float origin[3] = {ray.OriginX, ray.OriginY, ray.OriginZ};
+		const float direction[3] = {ray.DirectionX / length, ray.DirectionY / length, ray.DirectionZ / length};
+
+		int cell[3];
+		int step[3];
+		float inverse[3];
+		float tDelta[3]; // Distance between two boundaries along each axis
+		float tMax[3];	 // Distance to the next boundary along each axis
+
+		// Computed from the origin every time rather than accumulated, a jump over a section lands exactly
+		auto boundaryDistance = [&](int axis, int cellCoord)
+		{
+			if (step[axis] == 0)
+				return Infinity;
+			return (static_cast<float>(step[axis] > 0 ? cellCoord + 1 : cellCoord) - origin[axis]) * inverse[axis];
+		};
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			cell[axis] = FloorToInt(origin[axis]);
+			step[axis] = direction[axis] > 0.f ? 1 : (direction[axis] < 0.f ? -1 : 0);
+			inverse[axis] = step[axis] != 0 ? 1.f / direction[axis] : 0.f;
+			tDelta[axis] = step[axis] != 0 ? std::abs(inverse[axis]) : Infinity;
+			tMax[axis] = boundaryDistance(axis, cell[axis]);
+		}
+
+		float distance = 0.f;
+		BlockFace face = BlockFace::Count;
+
+		while (true)
+		{
+			// Above or below the world and moving away from it
+			if ((cell[1] < 0 && step[1] <= 0) || (cell[1] >= Chunk::Height && step[1] >= 0))
+				return hit;
+
+			const int sectionMin[3] = {cell[0] & ~ChunkSizeMask, cell[1] & ~ChunkSizeMask, cell[2] & ~ChunkSizeMask};
+			const int sectionY = cell[1] >> ChunkSizeShift;
+			const Chunk* chunk = sectionY >= 0 && sectionY < Chunk::SectionCount
+				? GetChunk(ChunkCoord::FromBlock(cell[0], cell[2]))
+				: nullptr;
+
+			if (!chunk || !MayHit(chunk->GetSection(sectionY)))
+			{
+				// Nothing to hit in the section : straight to the face the ray leaves it through
+				int exitAxis = 0;
+				float exitDistance = Infinity;
+				for (int axis = 0; axis < 3; axis++)
+				{
+					const int lastCell = step[axis] > 0 ? sectionMin[axis] + ChunkSizeMask : sectionMin[axis];
+					const float axisDistance = boundaryDistance(axis, lastCell);
+					if (axisDistance < exitDistance)
+					{
+						exitDistance = axisDistance;
+						exitAxis = axis;
+					}
+				}
+
+				if (exitDistance > ray.MaxDistance)
+					return hit;
+
+				// Rounding may put the exit point past the section on the other axes, it is clamped back inside
+				for (int axis = 0; axis < 3; axis++)
+				{
+					if (axis == exitAxis)
+						cell[axis] = step[axis] > 0 ? sectionMin[axis] + ChunkSize : sectionMin[axis] - 1;
+					else
+						cell[axis] = std::clamp(FloorToInt(origin[axis] + direction[axis] * exitDistance),
+												sectionMin[axis],
+												sectionMin[axis] + ChunkSizeMask);
+					tMax[axis] = boundaryDistance(axis, cell[axis]);
+				}
+
+				distance = exitDistance;
+				face = GetEnteredFace(exitAxis, step[exitAxis]);
+				continue;
+			}
+
+			// Block by block until the ray hits or leaves the section
+			const PalettedContainer& section = chunk->GetSection(sectionY);
+			while (true)
+			{
+				const BlockId block =
+					section.Get(cell[0] & ChunkSizeMask, cell[1] & ChunkSizeMask, cell[2] & ChunkSizeMask);
+				if (IsTarget(block))
+				{
+					hit.Block = {cell[0], cell[1], cell[2]};
+					hit.Id = block;
+					hit.Face = face;
+					hit.Distance = distance;
+					hit.Hit = true;
+					return hit;
+				}
+
+				const int axis = tMax[0] < tMax[1] ? (tMax[0] < tMax[2] ? 0 : 2) : (tMax[1] < tMax[2] ? 1 : 2);
+				distance = tMax[axis];
+				if (distance > ray.MaxDistance)
+					return hit;
+
+				cell[axis] += step[axis];
+				tMax[axis] += tDelta[axis];
+				face = GetEnteredFace(axis, step[axis]);
+
+				if ((cell[axis] & ~ChunkSizeMask) != sectionMin[axis])
+					break;
+			}
+		}
+	}
+
+	bool VoxelRaycaster::MayHit(const PalettedContainer& section) const
+	{
+		const std::vector<BlockId>& palette = section.GetPalette();
+
+		// 16-bit entries are the block ids, no palette to check
+		if (palette.empty())
+			return true;
+
+		return std::any_of(palette.begin(), palette.end(), [this](BlockId block) { return IsTarget(block); });
+	}
+
+	const Chunk* VoxelRaycaster::GetChunk(ChunkCoord coord)
+	{
+		if (!m_HasCachedChunk || coord != m_CachedCoord)
+		{
+			m_CachedChunk = m_World.GetChunk(coord);
+			m_CachedCoord = coord;
+			m_HasCachedChunk = true;
+		}
+
+		return m_CachedChunk;
+	}
+
+	bool VoxelRaycaster::IsTarget(BlockId block) const
+	{
+		const BlockProperties& properties = GetBlockProperties(block);
+		return m_Target == RaycastTarget::Solid ? properties.IsSolid : properties.IsOpaque;
+	}
+} // namespace onion::voxel
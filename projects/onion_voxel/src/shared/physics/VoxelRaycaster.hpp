@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <jobs/JobSystem.hpp>
+#include <world/BlockFace.hpp>
+#include <world/ChunkStore.hpp>
+
+namespace onion::voxel
+{
+	/// @brief Blocks a ray stops at.
+	enum class RaycastTarget : uint8_t
+	{
+		Solid,	// Block picking : leaves stop it, water doesn't
+		Opaque, // Line of sight : sees through leaves and water
+	};
+
+	struct Ray
+	{
+		float OriginX = 0.f;
+		float OriginY = 0.f;
+		float OriginZ = 0.f;
+		float DirectionX = 0.f; // Any length, zero misses
+		float DirectionY = 0.f;
+		float DirectionZ = 0.f;
+		float MaxDistance = 0.f; // In blocks
+	};
+
+	struct RayHit
+	{
+		BlockPos Block;
+		BlockId Id = AirBlock;
+		BlockFace Face = BlockFace::Count; // Entered through, Count when the ray starts inside the block
+		float Distance = 0.f;			   // From the origin to the face
+		bool Hit = false;
+	};
+
+	/// @brief Walks the blocks along rays, one by one in the order the ray crosses them (Amanatides & Woo DDA).
+	///
+	/// The walk reads the sections of the chunks directly : the ChunkStore is only searched when the ray enters
+	/// another chunk, and the rays of a batch share the last chunk found. Sections without any target in their
+	/// palette (air, water, unloaded chunks) are crossed in a single step to the face the ray leaves them through,
+	/// long rays over the terrain only visit the blocks of the sections they could hit.
+	///
+	/// Reads the ChunkStore without locking : from the world thread, or while it isn't modified.
+	class VoxelRaycaster
+	{
+	  public:
+		explicit VoxelRaycaster(const ChunkStore& world, RaycastTarget target = RaycastTarget::Solid);
+
+		/// @brief The first target block within the max distance (finite), the one the origin is in included.
+		RayHit Cast(const Ray& ray);
+
+		/// @brief hits[i] for rays[i].
+		void Cast(const std::vector<Ray>& rays, std::vector<RayHit>& hits);
+
+		/// @brief Same, split in batches over the workers. Blocks until all are done, not from inside a job.
+		void Cast(JobSystem& jobs, const std::vector<Ray>& rays, std::vector<RayHit>& hits) const;
+
+		/// @brief No target block between the two points, the blocks they are in included.
+		bool HasLineOfSight(float fromX, float fromY, float fromZ, float toX, float toY, float toZ);
+
+	  private:
+		RayHit CastRay(const Ray& ray);
+
+		/// @brief Whether the palette of the section has a target block. Palettes only grow between compactions,
+		/// a section may pass without one.
+		bool MayHit(const PalettedContainer& section) const;
+		/// @brief Only valid inside a public call, chunks may be removed in between.
+		const Chunk* GetChunk(ChunkCoord coord);
+		void ClearChunkCache() { m_HasCachedChunk = false; }
+
+		bool IsTarget(BlockId block) const;
+
+	  private:
+		const ChunkStore& m_World;
+		RaycastTarget m_Target;
+
+		ChunkCoord m_CachedCoord;
+		const Chunk* m_CachedChunk = nullptr;
+		bool m_HasCachedChunk = false;
+	};
+} // namespace onion::voxel
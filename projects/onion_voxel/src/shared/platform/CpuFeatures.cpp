@@ -0,0 +1,55 @@
+#include "CpuFeatures.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace onion::voxel
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	namespace
+	{
+		bool OsSavesYmmRegisters()
+		{
+			int info[4];
+			__cpuid(info, 1);
+			const bool osxsave = (info[2] & (1 << 27)) != 0;
+			return osxsave && (_xgetbv(0) & 0x6) == 0x6;
+		}
+	} // namespace
+#endif
+
+	bool CpuSupportsAvx()
+	{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		if (!OsSavesYmmRegisters())
+			return false;
+
+		int info[4];
+		__cpuid(info, 1);
+		return (info[2] & (1 << 28)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+		return __builtin_cpu_supports("avx");
+#else
+		return false;
+#endif
+	}
+
+	bool CpuSupportsAvx2()
+	{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7 || !OsSavesYmmRegisters())
+			return false;
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+		return __builtin_cpu_supports("avx2");
+#else
+		return false;
+#endif
+	}
+} // namespace onion::voxel
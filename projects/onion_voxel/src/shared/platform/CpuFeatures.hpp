@@ -0,0 +1,9 @@
+#pragma once
+
+namespace onion::voxel
+{
+	/// @brief True when the CPU has the instructions and the OS saves the YMM registers. The paths using them are
+	/// built in their own translation units with the instruction set enabled, and only called after this check.
+	bool CpuSupportsAvx();
+	bool CpuSupportsAvx2();
+} // namespace onion::voxel
@@ -0,0 +1,134 @@
+#include "ChunkSerializer.hpp"
+
+#include <bit>
+#include <cstring>
+
+namespace onion::voxel::ChunkSerializer
+{
+	namespace
+	{
+		template <typename T> void WriteValue(std::vector<uint8_t>& out, T value)
+		{
+			for (size_t i = 0; i < sizeof(T); i++)
+				out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+		}
+
+		/// @brief Bounds checked little endian reads, every read fails once one ran past the end.
+		class Reader
+		{
+		  public:
+			Reader(const uint8_t* data, size_t size) : m_Data(data), m_End(data + size) {}
+
+			template <typename T> T Read()
+			{
+				if (!Has(sizeof(T)))
+					return 0;
+
+				T value = 0;
+				for (size_t i = 0; i < sizeof(T); i++)
+					value |= static_cast<T>(static_cast<T>(m_Data[i]) << (i * 8));
+				m_Data += sizeof(T);
+				return value;
+			}
+
+			/// @brief count 64-bit words, straight copies on little endian CPUs.
+			bool ReadWords(std::vector<uint64_t>& words, size_t count)
+			{
+				if (!Has(count * sizeof(uint64_t)))
+					return false;
+				if (count == 0)
+					return true;
+
+				words.resize(count);
+				if constexpr (std::endian::native == std::endian::little)
+				{
+					std::memcpy(words.data(), m_Data, count * sizeof(uint64_t));
+					m_Data += count * sizeof(uint64_t);
+				}
+				else
+				{
+					for (uint64_t& word : words)
+						word = Read<uint64_t>();
+				}
+				return true;
+			}
+
+			bool IsValid() const { return m_IsValid; }
+			bool IsAtEnd() const { return m_Data == m_End; }
+
+		  private:
+			bool Has(size_t size)
+			{
+				m_IsValid = m_IsValid && size <= static_cast<size_t>(m_End - m_Data);
+				return m_IsValid;
+			}
+
+		  private:
+			const uint8_t* m_Data;
+			const uint8_t* m_End;
+			bool m_IsValid = true;
+		};
+	} // namespace
+
+	void Write(const Chunk& chunk, std::vector<uint8_t>& out)
+	{
+		out.push_back(FormatVersion);
+
+		for (int sectionY = 0; sectionY < Chunk::SectionCount; sectionY++)
+		{
+			const PalettedContainer& section = chunk.GetSection(sectionY);
+			const std::vector<BlockId>& palette = section.GetPalette();
+			const std::vector<uint64_t>& data = section.GetData();
+
+			out.push_back(static_cast<uint8_t>(section.GetBitsPerEntry()));
+			WriteValue(out, static_cast<uint16_t>(palette.size()));
+			for (BlockId block : palette)
+				WriteValue(out, block);
+
+			if (data.empty())
+				continue;
+
+			if constexpr (std::endian::native == std::endian::little)
+			{
+				const size_t start = out.size();
+				out.resize(start + data.size() * sizeof(uint64_t));
+				std::memcpy(out.data() + start, data.data(), data.size() * sizeof(uint64_t));
+			}
+			else
+			{
+				for (uint64_t word : data)
+					WriteValue(out, word);
+			}
+		}
+	}
+
+	std::unique_ptr<Chunk> Read(ChunkCoord coord, const uint8_t* data, size_t size)
+	{
+		Reader reader(data, size);
+		if (reader.Read<uint8_t>() != FormatVersion)
+			return nullptr;
+
+		auto chunk = std::make_unique<Chunk>(coord);
+
+		for (int sectionY = 0; sectionY < Chunk::SectionCount; sectionY++)
+		{
+			const int bitsPerEntry = reader.Read<uint8_t>();
+			if (bitsPerEntry > 16)
+				return nullptr;
+
+			std::vector<BlockId> palette(reader.Read<uint16_t>());
+			for (BlockId& block : palette)
+				block = reader.Read<uint16_t>();
+
+			std::vector<uint64_t> words;
+			const size_t wordCount = static_cast<size_t>(PalettedContainer::Volume) * bitsPerEntry / 64;
+			if (!reader.IsValid() || !reader.ReadWords(words, wordCount))
+				return nullptr;
+
+			if (!chunk->GetSection(sectionY).Load(std::move(palette), bitsPerEntry, std::move(words)))
+				return nullptr;
+		}
+
+		return reader.IsAtEnd() ? std::move(chunk) : nullptr;
+	}
+} // namespace onion::voxel::ChunkSerializer
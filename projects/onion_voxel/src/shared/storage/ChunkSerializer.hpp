@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <world/Chunk.hpp>
+
+namespace onion::voxel
+{
+	/// @brief Binary form of the blocks of a chunk, before compression.
+	///
+	/// A version byte, then for each section from the bottom : the bits per entry, the palette size and ids (16 bits
+	/// each), and the packed 64-bit words of PalettedContainer::GetData(). Little endian. Sections are saved as they
+	/// are in memory, so loading is a copy : Compact() the chunk before saving to keep the palettes small.
+	/// Light isn't saved : LightEngine::AddChunk() recomputes it once the chunk is back in the store.
+	namespace ChunkSerializer
+	{
+		constexpr uint8_t FormatVersion = 1;
+
+		/// @brief Upper bound of the size of a chunk : 16-bit entries and a full palette in every section.
+		constexpr size_t MaxSize = 1 + Chunk::SectionCount * (3 + 256 * sizeof(BlockId) +
+																PalettedContainer::Volume * sizeof(BlockId));
+
+		/// @brief Appends the chunk to out.
+		void Write(const Chunk& chunk, std::vector<uint8_t>& out);
+
+		/// @return nullptr when the data is truncated, from another version or describes invalid sections.
+		std::unique_ptr<Chunk> Read(ChunkCoord coord, const uint8_t* data, size_t size);
+	} // namespace ChunkSerializer
+} // namespace onion::voxel
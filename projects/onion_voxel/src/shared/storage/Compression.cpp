@@ -0,0 +1,297 @@
+#include "Compression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined(ONION_VOXEL_HAS_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace onion::voxel
+{
+	namespace
+	{
+		// ----- LZ4 block format -----
+		// A block is a list of sequences : a token (literal count, match length - 4, 4 bits each), more literal count
+		// bytes when it is 15, the literals, a 2-byte match offset back into the output, more match length bytes.
+		// The last sequence is literals only. Any LZ4 decoder reads these blocks (LZ4_decompress_safe()).
+
+		constexpr size_t MinMatch = 4;
+		constexpr size_t LastLiterals = 5;	 // The last 5 bytes are always literals
+		constexpr size_t MatchStartLimit = 12; // The last match starts at least 12 bytes before the end
+		constexpr size_t MaxOffset = 65535;
+		constexpr int HashLog = 12;
+		constexpr size_t WildCopySize = 16;
+
+		uint32_t Read32(const uint8_t* data)
+		{
+			uint32_t value;
+			std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		uint32_t Hash(uint32_t sequence)
+		{
+			return (sequence * 2654435761u) >> (32 - HashLog);
+		}
+
+		/// @brief The 255-bytes continuation of a length that didn't fit its 4 bits.
+		uint8_t* WriteLength(uint8_t* out, size_t length)
+		{
+			for (; length >= 255; length -= 255)
+				*out++ = 255;
+			*out++ = static_cast<uint8_t>(length);
+			return out;
+		}
+
+		uint8_t* WriteSequence(uint8_t* out, const uint8_t* literals, size_t literalCount, size_t offset, size_t match)
+		{
+			const size_t matchCode = match - MinMatch;
+			uint8_t* token = out++;
+			*token = static_cast<uint8_t>((std::min<size_t>(literalCount, 15) << 4) | std::min<size_t>(matchCode, 15));
+
+			if (literalCount >= 15)
+				out = WriteLength(out, literalCount - 15);
+			std::memcpy(out, literals, literalCount);
+			out += literalCount;
+
+			*out++ = static_cast<uint8_t>(offset);
+			*out++ = static_cast<uint8_t>(offset >> 8);
+
+			if (matchCode >= 15)
+				out = WriteLength(out, matchCode - 15);
+			return out;
+		}
+
+		uint8_t* WriteLastLiterals(uint8_t* out, const uint8_t* literals, size_t literalCount)
+		{
+			*out++ = static_cast<uint8_t>(std::min<size_t>(literalCount, 15) << 4);
+			if (literalCount >= 15)
+				out = WriteLength(out, literalCount - 15);
+			std::memcpy(out, literals, literalCount);
+			return out + literalCount;
+		}
+
+		/// @brief Greedy single pass : each position looks up the last one with the same 4 bytes in a hash table.
+		size_t CompressLz4(const uint8_t* source, size_t size, uint8_t* destination)
+		{
+			uint8_t* out = destination;
+			size_t anchor = 0; // Start of the pending literals
+
+			if (size > MatchStartLimit)
+			{
+				std::array<uint32_t, 1 << HashLog> table{};
+				const size_t matchEnd = size - LastLiterals;
+				const size_t matchStartEnd = size - MatchStartLimit;
+
+				size_t pos = 0;
+				while (pos < matchStartEnd)
+				{
+					const uint32_t sequence = Read32(source + pos);
+					const uint32_t hash = Hash(sequence);
+					size_t candidate = table[hash];
+					table[hash] = static_cast<uint32_t>(pos);
+
+					if (candidate >= pos || pos - candidate > MaxOffset || Read32(source + candidate) != sequence)
+					{
+						// Incompressible data skips ahead faster and faster
+						pos += 1 + ((pos - anchor) >> 6);
+						continue;
+					}
+
+					while (pos > anchor && candidate > 0 && source[pos - 1] == source[candidate - 1])
+					{
+						pos--;
+						candidate--;
+					}
+
+					size_t match = MinMatch;
+					while (pos + match < matchEnd && source[pos + match] == source[candidate + match])
+						match++;
+
+					out = WriteSequence(out, source + anchor, pos - anchor, pos - candidate, match);
+					pos += match;
+					anchor = pos;
+
+					if (pos < matchStartEnd)
+						table[Hash(Read32(source + pos - 2))] = static_cast<uint32_t>(pos - 2);
+				}
+			}
+
+			out = WriteLastLiterals(out, source + anchor, size - anchor);
+			return static_cast<size_t>(out - destination);
+		}
+
+		/// @brief Reads the 255-bytes continuation of a length.
+		bool ReadLength(const uint8_t*& in, const uint8_t* end, size_t& length)
+		{
+			uint8_t byte;
+			do
+			{
+				if (in == end)
+					return false;
+				byte = *in++;
+				length += byte;
+			} while (byte == 255);
+			return true;
+		}
+
+		bool DecompressLz4(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationSize)
+		{
+			const uint8_t* in = source;
+			const uint8_t* const inEnd = source + sourceSize;
+			uint8_t* out = destination;
+			uint8_t* const outEnd = destination + destinationSize;
+
+			while (in < inEnd)
+			{
+				const uint8_t token = *in++;
+
+				size_t literalCount = token >> 4;
+				if (literalCount == 15 && !ReadLength(in, inEnd, literalCount))
+					return false;
+
+				const size_t inLeft = static_cast<size_t>(inEnd - in);
+				const size_t outLeft = static_cast<size_t>(outEnd - out);
+				if (literalCount > inLeft || literalCount > outLeft)
+					return false;
+
+				// Away from the ends, short copies are one fixed size copy writing past them : the next copy overwrites
+				// the extra bytes
+				if (literalCount <= WildCopySize && inLeft >= WildCopySize && outLeft >= WildCopySize)
+					std::memcpy(out, in, WildCopySize);
+				else
+					std::memcpy(out, in, literalCount);
+				in += literalCount;
+				out += literalCount;
+
+				if (in == inEnd)
+					return out == outEnd; // The last sequence has no match
+
+				if (inEnd - in < 2)
+					return false;
+				const size_t offset = in[0] | (in[1] << 8);
+				in += 2;
+				if (offset == 0 || offset > static_cast<size_t>(out - destination))
+					return false;
+
+				size_t match = token & 15;
+				if (match == 15 && !ReadLength(in, inEnd, match))
+					return false;
+				match += MinMatch;
+				if (match > static_cast<size_t>(outEnd - out))
+					return false;
+
+				// A match closer than its length repeats its own output (runs of the same bytes) : the output is
+				// periodic from the reference on
+				const uint8_t* const reference = out - offset;
+				if (static_cast<size_t>(outEnd - out) >= match + WildCopySize)
+				{
+					// Closer matches first repeat their pattern over 16 bytes, then copy from a whole number of
+					// periods back, at least 16 bytes
+					size_t distance = offset;
+					size_t i = 0;
+					if (offset < WildCopySize)
+					{
+						for (; i < WildCopySize; i++)
+							out[i] = reference[i];
+						distance = (WildCopySize + offset - 1) / offset * offset;
+					}
+
+					for (; i < match; i += WildCopySize)
+						std::memcpy(out + i, out + i - distance, WildCopySize);
+					out += match;
+					continue;
+				}
+
+				// Near the end, each copy doubles the part of the pattern the next one can take
+				while (match > 0)
+				{
+					const size_t count = std::min<size_t>(out - reference, match);
+					std::memcpy(out, reference, count);
+					out += count;
+					match -= count;
+				}
+			}
+
+			return false;
+		}
+	} // namespace
+
+	bool IsCompressionSupported(CompressionType type)
+	{
+		switch (type)
+		{
+			case CompressionType::None:
+			case CompressionType::Lz4:
+				return true;
+			case CompressionType::Zstd:
+#if defined(ONION_VOXEL_HAS_ZSTD)
+				return true;
+#else
+				return false;
+#endif
+		}
+		return false;
+	}
+
+	size_t GetMaxCompressedSize(CompressionType type, size_t size)
+	{
+		switch (type)
+		{
+			case CompressionType::Lz4:
+				return size + size / 255 + 16;
+#if defined(ONION_VOXEL_HAS_ZSTD)
+			case CompressionType::Zstd:
+				return ZSTD_compressBound(size);
+#endif
+			default:
+				return size;
+		}
+	}
+
+	size_t Compress(CompressionType type, const uint8_t* source, size_t size, uint8_t* destination)
+	{
+		switch (type)
+		{
+			case CompressionType::Lz4:
+				return CompressLz4(source, size, destination);
+#if defined(ONION_VOXEL_HAS_ZSTD)
+			case CompressionType::Zstd:
+				return ZSTD_compress(destination, ZSTD_compressBound(size), source, size, 3);
+#endif
+			default:
+				std::memcpy(destination, source, size);
+				return size;
+		}
+	}
+
+	bool Decompress(CompressionType type,
+					const uint8_t* source,
+					size_t sourceSize,
+					uint8_t* destination,
+					size_t destinationSize)
+	{
+		switch (type)
+		{
+			case CompressionType::None:
+				if (sourceSize != destinationSize)
+					return false;
+				std::memcpy(destination, source, sourceSize);
+				return true;
+			case CompressionType::Lz4:
+				return DecompressLz4(source, sourceSize, destination, destinationSize);
+			case CompressionType::Zstd:
+#if defined(ONION_VOXEL_HAS_ZSTD)
+			{
+				const size_t result = ZSTD_decompress(destination, destinationSize, source, sourceSize);
+				return !ZSTD_isError(result) && result == destinationSize;
+			}
+#else
+				return false;
+#endif
+		}
+		return false;
+	}
+} // namespace onion::voxel
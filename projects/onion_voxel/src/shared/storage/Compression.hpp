@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace onion::voxel
+{
+	/// @brief Compression of the chunks saved to disk. Values are stored in the files, never renumber them.
+	enum class CompressionType : uint8_t
+	{
+		None = 0,
+		Lz4 = 1,  // LZ4 block format : fast enough to load chunks while playing, about 10x smaller
+		Zstd = 2, // Smaller files, slower saves. Only when built with ONION_VOXEL_WITH_ZSTD
+	};
+
+	/// @brief False for Zstd when the library isn't built in : files using it can't be read.
+	bool IsCompressionSupported(CompressionType type);
+
+	/// @brief Size of the buffer Compress() needs for size bytes of input, whatever the input.
+	size_t GetMaxCompressedSize(CompressionType type, size_t size);
+
+	/// @brief Compresses size bytes of source into destination, which holds GetMaxCompressedSize() bytes. The type
+	/// must be supported.
+	/// @return The compressed size.
+	size_t Compress(CompressionType type, const uint8_t* source, size_t size, uint8_t* destination);
+
+	/// @brief Decompresses exactly destinationSize bytes. Never reads or writes out of the buffers, even when the
+	/// data is corrupt.
+	/// @return False when the data is corrupt or doesn't decompress to destinationSize bytes.
+	bool Decompress(CompressionType type,
+					const uint8_t* source,
+					size_t sourceSize,
+					uint8_t* destination,
+					size_t destinationSize);
+} // namespace onion::voxel
@@ -0,0 +1,167 @@
+#include "MappedFile.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace onion::voxel
+{
+	// -------- Constructor --------
+
+	MappedFile::MappedFile(const std::filesystem::path& path) : m_Path(path)
+	{
+#if defined(_WIN32)
+		HANDLE file = CreateFileW(path.c_str(),
+								  GENERIC_READ | GENERIC_WRITE,
+								  FILE_SHARE_READ,
+								  nullptr,
+								  OPEN_ALWAYS,
+								  FILE_ATTRIBUTE_NORMAL,
+								  nullptr);
+		LARGE_INTEGER size{};
+		if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &size))
+		{
+			if (file != INVALID_HANDLE_VALUE)
+				CloseHandle(file);
+			throw std::runtime_error("Failed to open " + path.string());
+		}
+
+		m_File = file;
+		m_Size = static_cast<size_t>(size.QuadPart);
+#else
+		m_File = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+		struct stat status{};
+		if (m_File < 0 || fstat(m_File, &status) != 0)
+		{
+			if (m_File >= 0)
+				close(m_File);
+			throw std::runtime_error("Failed to open " + path.string());
+		}
+
+		m_Size = static_cast<size_t>(status.st_size);
+#endif
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Unmap();
+#if defined(_WIN32)
+		CloseHandle(static_cast<HANDLE>(m_File));
+#else
+		close(m_File);
+#endif
+	}
+
+	// -------- Public API --------
+
+	const uint8_t* MappedFile::GetData()
+	{
+		if (!m_View && m_Size > 0)
+			Map();
+
+		return m_View;
+	}
+
+	void MappedFile::Write(size_t offset, const void* data, size_t size)
+	{
+		// Windows can't grow a mapped file, and a POSIX mapping wouldn't cover the new end anyway
+		if (offset + size > m_Size)
+			Unmap();
+
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		size_t written = 0;
+
+		while (written < size)
+		{
+#if defined(_WIN32)
+			const uint64_t position = offset + written;
+			OVERLAPPED overlapped{};
+			overlapped.Offset = static_cast<DWORD>(position);
+			overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+
+			const DWORD request = static_cast<DWORD>(std::min<size_t>(size - written, 1u << 30));
+			DWORD result = 0;
+			if (!WriteFile(static_cast<HANDLE>(m_File), bytes + written, request, &result, &overlapped))
+				throw std::runtime_error("Failed to write " + m_Path.string());
+#else
+			const off_t position = static_cast<off_t>(offset + written);
+			const ssize_t result = pwrite(m_File, bytes + written, size - written, position);
+			if (result < 0 && errno == EINTR)
+				continue;
+			if (result <= 0)
+				throw std::runtime_error("Failed to write " + m_Path.string());
+#endif
+			written += static_cast<size_t>(result);
+		}
+
+		m_Size = std::max(m_Size, offset + size);
+	}
+
+	void MappedFile::Flush()
+	{
+#if defined(_WIN32)
+		if (!FlushFileBuffers(static_cast<HANDLE>(m_File)))
+			throw std::runtime_error("Failed to flush " + m_Path.string());
+#else
+		int result = fsync(m_File);
+		while (result != 0 && errno == EINTR)
+			result = fsync(m_File);
+		if (result != 0)
+			throw std::runtime_error("Failed to flush " + m_Path.string());
+#endif
+	}
+
+	// -------- Private --------
+
+	void MappedFile::Map()
+	{
+#if defined(_WIN32)
+		HANDLE mapping = CreateFileMappingW(static_cast<HANDLE>(m_File), nullptr, PAGE_READONLY, 0, 0, nullptr);
+		const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		if (!view)
+		{
+			if (mapping)
+				CloseHandle(mapping);
+			throw std::runtime_error("Failed to map " + m_Path.string());
+		}
+
+		m_Mapping = mapping;
+#else
+		void* view = mmap(nullptr, m_Size, PROT_READ, MAP_SHARED, m_File, 0);
+		if (view == MAP_FAILED)
+			throw std::runtime_error("Failed to map " + m_Path.string());
+#endif
+		m_View = static_cast<const uint8_t*>(view);
+	}
+
+	void MappedFile::Unmap()
+	{
+		if (!m_View)
+			return;
+
+#if defined(_WIN32)
+		UnmapViewOfFile(m_View);
+		CloseHandle(static_cast<HANDLE>(m_Mapping));
+		m_Mapping = nullptr;
+#else
+		munmap(const_cast<uint8_t*>(m_View), m_Size);
+#endif
+		m_View = nullptr;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace onion::voxel
+{
+	/// @brief A file open for reading and writing, read through a memory mapping.
+	///
+	/// Reads are plain memory accesses into the OS page cache : no read call, no copy. Writes go through the file
+	/// handle, the mapping sees them. A write growing the file drops the mapping, the next GetData() maps the new
+	/// size. Not thread safe.
+	class MappedFile
+	{
+	  public:
+		/// @brief Opens the file, creating it when missing. Throws std::runtime_error on failure.
+		explicit MappedFile(const std::filesystem::path& path);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		size_t GetSize() const { return m_Size; }
+
+		/// @brief The whole file, nullptr when it is empty. Valid until a Write() grows the file.
+		const uint8_t* GetData();
+
+		/// @brief Writes at the offset, growing the file when writing past its end. Throws std::runtime_error.
+		void Write(size_t offset, const void* data, size_t size);
+		/// @brief Returns once the data written so far is on the disk, rather than in the OS cache only. Throws
+		/// std::runtime_error.
+		void Flush();
+
+	  private:
+		void Map();
+		void Unmap();
+
+	  private:
+		std::filesystem::path m_Path;
+#if defined(_WIN32)
+		void* m_File = nullptr;
+		void* m_Mapping = nullptr;
+#else
+		int m_File = -1;
+#endif
+		const uint8_t* m_View = nullptr;
+		size_t m_Size = 0;
+	};
+} // namespace onion::voxel
@@ -0,0 +1,223 @@
+#include "RegionFile.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "ChunkSerializer.hpp"
+
+namespace onion::voxel
+{
+	namespace
+	{
+		constexpr size_t HeaderSize = 9;
+		constexpr uint32_t MaxSectorCount = 255;
+		constexpr size_t TableSize = RegionFile::ChunkCount * sizeof(uint32_t);
+
+		static_assert(RegionFile::TableSectorCount * RegionFile::SectorSize == TableSize, "Whole table sectors");
+		static_assert(MaxSectorCount * RegionFile::SectorSize >= HeaderSize + ChunkSerializer::MaxSize,
+					  "Any chunk fits in the sector count of a table entry");
+
+		uint32_t ReadUint32(const uint8_t* data)
+		{
+			return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+		}
+
+		void WriteUint32(uint8_t* data, uint32_t value)
+		{
+			for (int i = 0; i < 4; i++)
+				data[i] = static_cast<uint8_t>(value >> (i * 8));
+		}
+
+		uint32_t GetFirstSector(uint32_t entry)
+		{
+			return entry >> 8;
+		}
+
+		uint32_t GetSectorCount(uint32_t entry)
+		{
+			return entry & 0xFF;
+		}
+	} // namespace
+
+	// -------- Constructor --------
+
+	RegionFile::RegionFile(const std::filesystem::path& path) : m_Path(path), m_File(path)
+	{
+		if (m_File.GetSize() < TableSize)
+		{
+			// New file, or one cut before its table was written : no chunk saved
+			const std::vector<uint8_t> table(TableSize, 0);
+			m_File.Write(0, table.data(), table.size());
+		}
+
+		ReadTable();
+	}
+
+	RegionFile::~RegionFile()
+	{
+		try
+		{
+			Flush();
+		}
+		catch (const std::exception&)
+		{
+		}
+	}
+
+	// -------- Public API --------
+
+	std::unique_ptr<Chunk> RegionFile::LoadChunk(ChunkCoord coord)
+	{
+		const uint32_t entry = m_Table[GetIndex(coord)];
+		if (entry == 0)
+			return nullptr;
+
+		// ReadTable() only kept entries inside the file, the last sector may be partial
+		const size_t offset = GetFirstSector(entry) * SectorSize;
+		const size_t available = std::min<size_t>(GetSectorCount(entry) * SectorSize, m_File.GetSize() - offset);
+		const uint8_t* record = m_File.GetData() + offset;
+
+		const std::string error = "Corrupt chunk " + std::to_string(coord.x) + ", " + std::to_string(coord.z) + " in " +
+			m_Path.string();
+
+		if (available < HeaderSize)
+			throw std::runtime_error(error);
+
+		const size_t compressedSize = ReadUint32(record);
+		const auto compression = static_cast<CompressionType>(record[4]);
+		const size_t size = ReadUint32(record + 5);
+
+		if (compressedSize > available - HeaderSize || size > ChunkSerializer::MaxSize ||
+			!IsCompressionSupported(compression))
+			throw std::runtime_error(error);
+
+		m_Serialized.resize(size);
+		if (!Decompress(compression, record + HeaderSize, compressedSize, m_Serialized.data(), size))
+			throw std::runtime_error(error);
+
+		std::unique_ptr<Chunk> chunk = ChunkSerializer::Read(coord, m_Serialized.data(), size);
+		if (!chunk)
+			throw std::runtime_error(error);
+
+		return chunk;
+	}
+
+	void RegionFile::WriteChunk(const Chunk& chunk, CompressionType compression)
+	{
+		m_Serialized.clear();
+		ChunkSerializer::Write(chunk, m_Serialized);
+
+		m_Record.resize(HeaderSize + GetMaxCompressedSize(compression, m_Serialized.size()) + SectorSize);
+		const size_t compressedSize =
+			Compress(compression, m_Serialized.data(), m_Serialized.size(), m_Record.data() + HeaderSize);
+
+		WriteUint32(m_Record.data(), static_cast<uint32_t>(compressedSize));
+		m_Record[4] = static_cast<uint8_t>(compression);
+		WriteUint32(m_Record.data() + 5, static_cast<uint32_t>(m_Serialized.size()));
+
+		const size_t recordSize = HeaderSize + compressedSize;
+		const uint32_t sectorCount = static_cast<uint32_t>((recordSize + SectorSize - 1) / SectorSize);
+		if (sectorCount > MaxSectorCount)
+			throw std::runtime_error("Chunk too large for a region file : " + m_Path.string());
+
+		std::fill(m_Record.begin() + recordSize, m_Record.begin() + sectorCount * SectorSize, 0);
+
+		const uint32_t first = AllocateSectors(sectorCount);
+		m_File.Write(first * SectorSize, m_Record.data(), sectorCount * SectorSize);
+
+		// A copy written since the last flush was never in the file table, its sectors are free at once
+		const int index = GetIndex(chunk.GetCoord());
+		const uint32_t previous = m_Table[index];
+		if (previous != 0 && previous != m_FileTable[index])
+			SetSectorsUsed(GetFirstSector(previous), GetSectorCount(previous), false);
+
+		m_Table[index] = (first << 8) | sectorCount;
+		m_HasWrites = true;
+	}
+
+	void RegionFile::Flush()
+	{
+		if (!m_HasWrites)
+			return;
+
+		// The new copies first, on the disk before the table entries point to them
+		m_File.Flush();
+
+		// The flush also made the table entries of the previous batch durable : the sectors they replaced are free
+		for (uint32_t pending : m_PendingFree)
+			SetSectorsUsed(GetFirstSector(pending), GetSectorCount(pending), false);
+		m_PendingFree.clear();
+
+		// Until the next flush, a crash may leave the table pointing to the replaced copies
+		for (int index = 0; index < ChunkCount; index++)
+		{
+			if (m_Table[index] != m_FileTable[index] && m_FileTable[index] != 0)
+				m_PendingFree.push_back(m_FileTable[index]);
+		}
+
+		uint8_t table[TableSize];
+		for (int index = 0; index < ChunkCount; index++)
+			WriteUint32(table + index * sizeof(uint32_t), m_Table[index]);
+		m_File.Write(0, table, sizeof(table));
+
+		m_FileTable = m_Table;
+		m_HasWrites = false;
+	}
+
+	void RegionFile::SaveChunk(const Chunk& chunk, CompressionType compression)
+	{
+		WriteChunk(chunk, compression);
+		Flush();
+	}
+
+	// -------- Private --------
+
+	void RegionFile::ReadTable()
+	{
+		const size_t fileSectors = (m_File.GetSize() + SectorSize - 1) / SectorSize;
+		m_UsedSectors.assign(fileSectors, false);
+		SetSectorsUsed(0, TableSectorCount, true);
+
+		const uint8_t* table = m_File.GetData();
+		for (int index = 0; index < ChunkCount; index++)
+		{
+			const uint32_t entry = ReadUint32(table + index * sizeof(uint32_t));
+			const uint32_t first = GetFirstSector(entry);
+			const uint32_t count = GetSectorCount(entry);
+
+			if (count == 0 || first < TableSectorCount || first + count > fileSectors)
+				continue;
+
+			auto sectors = m_UsedSectors.begin() + first;
+			if (std::find(sectors, sectors + count, true) != sectors + count)
+				continue; // Overlaps a chunk read before, one of them is wrong
+
+			SetSectorsUsed(first, count, true);
+			m_Table[index] = entry;
+		}
+
+		m_FileTable = m_Table;
+	}
+
+	uint32_t RegionFile::AllocateSectors(uint32_t count)
+	{
+		// First fit : holes left by chunks that grew are filled before the file grows
+		uint32_t run = 0;
+		uint32_t sector = TableSectorCount;
+		for (; sector < m_UsedSectors.size() && run < count; sector++)
+			run = m_UsedSectors[sector] ? 0 : run + 1;
+
+		const uint32_t first = run == count ? sector - count : sector - run;
+		SetSectorsUsed(first, count, true);
+		return first;
+	}
+
+	void RegionFile::SetSectorsUsed(uint32_t first, uint32_t count, bool used)
+	{
+		if (first + count > m_UsedSectors.size())
+			m_UsedSectors.resize(first + count, false);
+
+		std::fill(m_UsedSectors.begin() + first, m_UsedSectors.begin() + first + count, used);
+	}
+} // namespace onion::voxel
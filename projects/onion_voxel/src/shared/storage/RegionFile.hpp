@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include <world/Chunk.hpp>
+
+#include "Compression.hpp"
+#include "MappedFile.hpp"
+
+namespace onion::voxel
+{
+	/// @brief The saved chunks of a 32x32 chunk area, in one file.
+	///
+	/// The file is made of 1 KiB sectors, LZ4 chunks take one or two. The first 4 are the table : for each chunk of the
+	/// region, a 32-bit entry with its first sector (24 bits) and sector count (8 bits), 0 when it isn't saved. A
+	/// chunk is a 9-byte header
+	/// (compressed size, CompressionType, uncompressed size) and its compressed ChunkSerializer data, padded to whole
+	/// sectors. Each chunk is compressed on its own, so loading one is a table lookup and one decompression straight
+	/// from the memory mapped file, whatever the size of the rest.
+	///
+	/// Writes go to free sectors and only update the table in memory. Flush() makes them durable, then writes their
+	/// table entries : a crash in between keeps the previous copies. The sectors of the replaced copies are reused
+	/// once the next Flush() made the new entries durable, so a batch of writes costs one flush. Chunks are given by
+	/// their world coordinates, inside the region. Not thread safe.
+	class RegionFile
+	{
+	  public:
+		static constexpr int Size = 32; // Chunks along X and Z
+		static constexpr int SizeShift = 5;
+		static constexpr int ChunkCount = Size * Size;
+		static constexpr size_t SectorSize = 1024;
+		static constexpr uint32_t TableSectorCount = ChunkCount * sizeof(uint32_t) / SectorSize;
+
+		/// @brief Opens the region file, creating an empty one when missing. Throws std::runtime_error when it can't
+		/// be opened. Table entries pointing out of the file or into another chunk are dropped.
+		explicit RegionFile(const std::filesystem::path& path);
+		/// @brief Flushes the writes still waiting, errors are ignored : they keep the previous copies.
+		~RegionFile();
+
+		RegionFile(const RegionFile&) = delete;
+		RegionFile& operator=(const RegionFile&) = delete;
+
+		/// @brief The region containing the chunk. Arithmetic shift : floor division, also for negative coordinates.
+		static ChunkCoord GetRegionCoord(ChunkCoord chunk) { return {chunk.x >> SizeShift, chunk.z >> SizeShift}; }
+
+		bool HasChunk(ChunkCoord coord) const { return m_Table[GetIndex(coord)] != 0; }
+
+		/// @return nullptr when the chunk was never saved. Throws std::runtime_error when its data is corrupt.
+		std::unique_ptr<Chunk> LoadChunk(ChunkCoord coord);
+
+		/// @brief Writes the chunk, loads see it at once but it replaces the previous copy on the disk only at the
+		/// next Flush(). Throws std::runtime_error when the write fails.
+		void WriteChunk(const Chunk& chunk, CompressionType compression);
+		/// @brief Makes the written chunks durable, then points the table to them. Does nothing without writes since
+		/// the last call. Throws std::runtime_error when the flush fails.
+		void Flush();
+
+		/// @brief WriteChunk() and Flush(), for a single chunk.
+		void SaveChunk(const Chunk& chunk, CompressionType compression);
+
+		size_t GetFileSize() const { return m_File.GetSize(); }
+
+	  private:
+		static int GetIndex(ChunkCoord coord)
+		{
+			return (coord.x & (Size - 1)) | ((coord.z & (Size - 1)) << SizeShift);
+		}
+
+		void ReadTable();
+		/// @brief First sector of count free sectors in a row, past the end of the file when no hole is large enough.
+		uint32_t AllocateSectors(uint32_t count);
+		void SetSectorsUsed(uint32_t first, uint32_t count, bool used);
+
+	  private:
+		std::filesystem::path m_Path;
+		MappedFile m_File;
+
+		std::array<uint32_t, ChunkCount> m_Table{};	   // Including the writes not flushed yet
+		std::array<uint32_t, ChunkCount> m_FileTable{}; // As written in the file
+		bool m_HasWrites = false;						   // Since the last flush
+		std::vector<bool> m_UsedSectors;				   // The table sector and every chunk's sectors
+		std::vector<uint32_t> m_PendingFree; // Entries replaced in the file since the last flush, still in use
+
+		// Reused between calls
+		std::vector<uint8_t> m_Serialized;
+		std::vector<uint8_t> m_Record;
+	};
+} // namespace onion::voxel
@@ -0,0 +1,93 @@
+#include "WorldStorage.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <string>
+
+namespace onion::voxel
+{
+	// -------- Constructor --------
+
+	WorldStorage::WorldStorage(const std::filesystem::path& directory, CompressionType compression)
+		: m_Directory(directory),
+		  m_Compression(IsCompressionSupported(compression) ? compression : CompressionType::Lz4)
+	{
+		std::filesystem::create_directories(m_Directory);
+	}
+
+	// -------- Public API --------
+
+	bool WorldStorage::HasChunk(ChunkCoord coord)
+	{
+		RegionFile* region = GetRegion(coord, false);
+		return region && region->HasChunk(coord);
+	}
+
+	std::unique_ptr<Chunk> WorldStorage::LoadChunk(ChunkCoord coord)
+	{
+		RegionFile* region = GetRegion(coord, false);
+		return region ? region->LoadChunk(coord) : nullptr;
+	}
+
+	void WorldStorage::WriteChunk(const Chunk& chunk)
+	{
+		RegionFile* region = GetRegion(chunk.GetCoord(), true);
+		region->WriteChunk(chunk, m_Compression);
+
+		if (std::find(m_Written.begin(), m_Written.end(), region) == m_Written.end())
+			m_Written.push_back(region);
+	}
+
+	void WorldStorage::Flush()
+	{
+		std::exception_ptr error;
+		for (RegionFile* region : m_Written)
+		{
+			try
+			{
+				region->Flush();
+			}
+			catch (const std::exception&)
+			{
+				error = std::current_exception();
+			}
+		}
+
+		m_Written.clear();
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	void WorldStorage::SaveChunk(const Chunk& chunk)
+	{
+		GetRegion(chunk.GetCoord(), true)->SaveChunk(chunk, m_Compression);
+	}
+
+	size_t WorldStorage::GetFileSize() const
+	{
+		size_t size = 0;
+		for (const auto& [coord, region] : m_Regions)
+			size += region->GetFileSize();
+
+		return size;
+	}
+
+	// -------- Private --------
+
+	RegionFile* WorldStorage::GetRegion(ChunkCoord chunk, bool create)
+	{
+		const ChunkCoord coord = RegionFile::GetRegionCoord(chunk);
+
+		auto it = m_Regions.find(coord);
+		if (it != m_Regions.end())
+			return it->second.get();
+
+		const std::filesystem::path path =
+			m_Directory / ("r." + std::to_string(coord.x) + "." + std::to_string(coord.z) + ".region");
+		if (!create && !std::filesystem::exists(path))
+			return nullptr;
+
+		auto region = std::make_unique<RegionFile>(path);
+		return m_Regions.emplace(coord, std::move(region)).first->second.get();
+	}
+} // namespace onion::voxel
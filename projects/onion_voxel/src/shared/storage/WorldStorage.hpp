@@ -0,0 +1,52 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "RegionFile.hpp"
+
+namespace onion::voxel
+{
+	/// @brief The saved chunks of a world : a directory of region files named r.<x>.<z>.region, opened on first use
+	/// and kept open. Not thread safe.
+	class WorldStorage
+	{
+	  public:
+		/// @brief Creates the directory when missing. Zstd falls back to LZ4 when it isn't built in, chunks saved with
+		/// any supported compression load whatever the current one.
+		explicit WorldStorage(const std::filesystem::path& directory,
+							  CompressionType compression = CompressionType::Lz4);
+
+		/// @brief Doesn't create the region file when it is missing.
+		bool HasChunk(ChunkCoord coord);
+
+		/// @return nullptr when the chunk was never saved. Throws std::runtime_error when its data is corrupt.
+		std::unique_ptr<Chunk> LoadChunk(ChunkCoord coord);
+
+		/// @brief Writes the chunk, durable at the next Flush(), see RegionFile. Throws std::runtime_error when the
+		/// write fails.
+		void WriteChunk(const Chunk& chunk);
+		/// @brief Flushes every region written since the last call, once each. Throws std::runtime_error when a
+		/// flush fails, the other regions are still flushed.
+		void Flush();
+
+		/// @brief WriteChunk() and the flush of its region. Throws std::runtime_error when the write fails.
+		void SaveChunk(const Chunk& chunk);
+
+		CompressionType GetCompression() const { return m_Compression; }
+		/// @brief Total size of the region files opened so far.
+		size_t GetFileSize() const;
+
+	  private:
+		/// @brief nullptr when the file is missing and create is false.
+		RegionFile* GetRegion(ChunkCoord chunk, bool create);
+
+	  private:
+		std::filesystem::path m_Directory;
+		CompressionType m_Compression;
+		std::unordered_map<ChunkCoord, std::unique_ptr<RegionFile>, ChunkCoordHash> m_Regions;
+		std::vector<RegionFile*> m_Written; // Since the last Flush()
+	};
+} // namespace onion::voxel
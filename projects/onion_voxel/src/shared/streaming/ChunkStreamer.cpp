@@ -0,0 +1,410 @@
+#include "ChunkStreamer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <utility>
+
+namespace onion::voxel
+{
+	// -------- Constructor / Destructor --------
+
+	ChunkStreamer::ChunkStreamer(JobSystem& jobs,
+								 ChunkStore& world,
+								 LightEngine& lighting,
+								 WorldStorage& storage,
+								 const WorldGenerator& generator,
+								 const Settings& settings)
+		: m_Jobs(jobs), m_World(world), m_Lighting(lighting), m_Storage(storage), m_Generator(generator),
+		  m_Settings(settings),
+		  m_MaxInFlight(settings.MaxInFlight != 0 ? settings.MaxInFlight
+												  : std::max<size_t>(jobs.GetWorkerCount(), 1) * 2)
+	{
+	}
+
+	ChunkStreamer::~ChunkStreamer()
+	{
+		m_Jobs.WaitIdle();
+	}
+
+	// -------- World thread --------
+
+	void ChunkStreamer::Update(float x, float z, float viewX, float viewZ)
+	{
+		if (InsertCompleted(m_Settings.MaxInsertsPerUpdate) > 0)
+			m_Lighting.Propagate();
+
+		const ChunkCoord center = ChunkCoord::FromBlock(static_cast<int32_t>(std::floor(x)),
+														static_cast<int32_t>(std::floor(z)));
+		if (!m_HasCenter || center != m_Center)
+			UpdateRanges(center);
+
+		Evict();
+		Dispatch(x, z, viewX, viewZ);
+	}
+
+	void ChunkStreamer::MarkDirty(ChunkCoord coord)
+	{
+		auto it = m_Resident.find(coord);
+		const Chunk* chunk = m_World.GetChunk(coord);
+		if (it == m_Resident.end() || !chunk)
+			return;
+
+		Resident& resident = it->second;
+		if (!resident.Dirty)
+		{
+			resident.Dirty = true;
+			m_DirtyCount++;
+		}
+
+		// Edits may grow the palettes
+		m_ResidentBytes -= resident.Bytes;
+		resident.Bytes = chunk->GetMemoryUsage();
+		m_ResidentBytes += resident.Bytes;
+	}
+
+	size_t ChunkStreamer::SaveAll()
+	{
+		m_Jobs.WaitIdle();
+		if (InsertCompleted(m_InFlightCount) > 0)
+			m_Lighting.Propagate();
+
+		size_t savedCount = 0;
+		std::lock_guard<std::mutex> lock(m_StorageMutex);
+		for (auto& [coord, resident] : m_Resident)
+		{
+			const Chunk* chunk = m_World.GetChunk(coord);
+			if (!resident.Dirty || !chunk)
+				continue;
+
+			try
+			{
+				m_Storage.WriteChunk(*chunk);
+				savedCount++;
+			}
+			catch (const std::exception&)
+			{
+				m_SaveFailedCount.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			resident.Dirty = false;
+		}
+
+		// Once per region for the whole batch
+		try
+		{
+			m_Storage.Flush();
+		}
+		catch (const std::exception&)
+		{
+			m_SaveFailedCount.fetch_add(savedCount, std::memory_order_relaxed);
+			savedCount = 0;
+		}
+
+		m_DirtyCount = 0;
+		m_Totals.SavedCount += savedCount;
+		return savedCount;
+	}
+
+	std::vector<ChunkCoord> ChunkStreamer::TakeLoadedChunks()
+	{
+		return std::exchange(m_Loaded, {});
+	}
+
+	std::vector<ChunkCoord> ChunkStreamer::TakeUnloadedChunks()
+	{
+		return std::exchange(m_Unloaded, {});
+	}
+
+	ChunkStreamer::Stats ChunkStreamer::GetStats() const
+	{
+		Stats stats = m_Totals;
+		stats.ResidentCount = m_Resident.size();
+		stats.CachedCount = m_Lru.size();
+		stats.DirtyCount = m_DirtyCount;
+		stats.PendingCount = m_Pending.size();
+		stats.InFlightCount = m_InFlightCount;
+		stats.ResidentBytes = m_ResidentBytes;
+		stats.CorruptCount = m_CorruptCount.load(std::memory_order_relaxed);
+		stats.SaveFailedCount = m_SaveFailedCount.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	// -------- Private --------
+
+	bool ChunkStreamer::IsInRadius(ChunkCoord coord, int radius) const
+	{
+		const int64_t dx = coord.x - m_Center.x;
+		const int64_t dz = coord.z - m_Center.z;
+		return dx * dx + dz * dz <= static_cast<int64_t>(radius) * radius;
+	}
+
+	void ChunkStreamer::UpdateRanges(ChunkCoord center)
+	{
+		m_Center = center;
+		m_HasCenter = true;
+
+		const int keepRadius = m_Settings.LoadRadius + m_Settings.KeepMargin;
+
+		for (auto& [coord, resident] : m_Resident)
+		{
+			const bool keep = IsInRadius(coord, keepRadius);
+			if (!keep && !resident.Cached)
+			{
+				m_Lru.push_front(coord);
+				resident.LruPosition = m_Lru.begin();
+				resident.Cached = true;
+			}
+			else if (keep && resident.Cached)
+			{
+				m_Lru.erase(resident.LruPosition);
+				resident.Cached = false;
+			}
+		}
+
+		// The jobs check the flag before loading, results already queued are dropped when taken
+		for (auto it = m_Requested.begin(); it != m_Requested.end();)
+		{
+			if (IsInRadius(it->first, keepRadius))
+			{
+				++it;
+				continue;
+			}
+
+			it->second->Cancelled.store(true, std::memory_order_relaxed);
+			it = m_Requested.erase(it);
+		}
+
+		m_Pending.clear();
+		const int radius = m_Settings.LoadRadius;
+		for (int dz = -radius; dz <= radius; dz++)
+		{
+			for (int dx = -radius; dx <= radius; dx++)
+			{
+				const ChunkCoord coord{center.x + dx, center.z + dz};
+				if (IsInRadius(coord, radius) && !m_Resident.contains(coord) && !m_Requested.contains(coord))
+					m_Pending.push_back(coord);
+			}
+		}
+	}
+
+	size_t ChunkStreamer::InsertCompleted(size_t maxInserts)
+	{
+		size_t insertedCount = 0;
+
+		std::unique_ptr<Result> result;
+		while (insertedCount < maxInserts && m_Completed.TryPop(result))
+		{
+			m_InFlightCount--;
+
+			if (!result->Load)
+			{
+				m_Saving.erase(result->Coord);
+				m_Totals.SavedCount += result->Saved ? 1 : 0;
+				continue;
+			}
+
+			// A cancelled request is already out of the map, a newer request for the same chunk may be in it
+			auto request = m_Requested.find(result->Coord);
+			if (request != m_Requested.end() && request->second == result->Load)
+				m_Requested.erase(request);
+
+			if (result->Load->Cancelled.load(std::memory_order_relaxed) || !result->Loaded ||
+				m_World.HasChunk(result->Coord))
+				continue;
+
+			const Chunk& chunk = m_World.InsertChunk(std::move(result->Loaded));
+			m_Lighting.AddChunk(result->Coord);
+
+			// Not cancelled : within the keep radius
+			Resident& resident = m_Resident[result->Coord];
+			resident.Bytes = chunk.GetMemoryUsage();
+			resident.Dirty = result->Generated;
+			m_ResidentBytes += resident.Bytes;
+			m_DirtyCount += resident.Dirty ? 1 : 0;
+
+			(result->Generated ? m_Totals.GeneratedCount : m_Totals.LoadedCount)++;
+			m_Loaded.push_back(result->Coord);
+			insertedCount++;
+		}
+
+		return insertedCount;
+	}
+
+	void ChunkStreamer::Evict()
+	{
+		for (size_t i = 0; i < m_Settings.MaxEvictionsPerUpdate && !m_Lru.empty(); i++)
+		{
+			if (m_Lru.size() <= m_Settings.MaxCachedChunks && m_ResidentBytes <= m_Settings.MaxResidentBytes)
+				break;
+
+			Unload(m_Lru.back());
+		}
+
+		SubmitSaves();
+	}
+
+	void ChunkStreamer::Unload(ChunkCoord coord)
+	{
+		auto it = m_Resident.find(coord);
+		if (it == m_Resident.end())
+			return;
+
+		const Resident resident = it->second;
+		if (resident.Cached)
+			m_Lru.erase(resident.LruPosition);
+		m_Resident.erase(it);
+		m_ResidentBytes -= resident.Bytes;
+
+		std::unique_ptr<Chunk> chunk = m_World.ExtractChunk(coord);
+		if (resident.Dirty)
+		{
+			m_DirtyCount--;
+
+			// Saves bypass the in flight limit, they are counted so loads make room for them
+			if (chunk)
+			{
+				m_Saving.insert(coord);
+				m_InFlightCount++;
+				m_Unsaved.push_back(std::move(chunk));
+			}
+		}
+
+		m_Unloaded.push_back(coord);
+		m_Totals.EvictedCount++;
+	}
+
+	void ChunkStreamer::SubmitSaves()
+	{
+		if (m_Unsaved.empty())
+			return;
+
+		m_Jobs.Submit([this, chunks = std::exchange(m_Unsaved, {})]() { RunSaves(chunks); });
+	}
+
+	void ChunkStreamer::Dispatch(float x, float z, float viewX, float viewZ)
+	{
+		if (m_Pending.empty() || m_InFlightCount >= m_MaxInFlight || m_ResidentBytes >= m_Settings.MaxResidentBytes)
+			return;
+
+		const size_t capacity = m_MaxInFlight - m_InFlightCount;
+
+		const float viewLength = std::sqrt(viewX * viewX + viewZ * viewZ);
+		const float forwardX = viewLength > 0.f ? viewX / viewLength : 0.f;
+		const float forwardZ = viewLength > 0.f ? viewZ / viewLength : 0.f;
+		const float playerX = x / ChunkSize;
+		const float playerZ = z / ChunkSize;
+
+		// Distance squared, weighted from 1 straight ahead to 3 straight behind
+		auto priority = [&](const ChunkCoord& coord)
+		{
+			const float dx = static_cast<float>(coord.x) + 0.5f - playerX;
+			const float dz = static_cast<float>(coord.z) + 0.5f - playerZ;
+			const float distanceSquared = dx * dx + dz * dz;
+			const float facing = (dx * forwardX + dz * forwardZ) / std::sqrt(distanceSquared + 1e-6f);
+			return distanceSquared * (2.f - facing);
+		};
+
+		const size_t count = std::min(capacity, m_Pending.size());
+		std::partial_sort(m_Pending.begin(),
+						  m_Pending.begin() + count,
+						  m_Pending.end(),
+						  [&](const ChunkCoord& a, const ChunkCoord& b) { return priority(a) < priority(b); });
+
+		// Submitted requests leave the list, the ones still being saved stay for a later call
+		size_t kept = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			const ChunkCoord coord = m_Pending[i];
+			if (m_Saving.contains(coord))
+			{
+				m_Pending[kept++] = coord;
+				continue;
+			}
+
+			auto request = std::make_shared<Request>();
+			request->Coord = coord;
+			m_Requested.emplace(coord, request);
+
+			m_InFlightCount++;
+			m_Jobs.Submit([this, request]() { RunLoad(request); });
+		}
+
+		m_Pending.erase(m_Pending.begin() + kept, m_Pending.begin() + count);
+	}
+
+	// -------- Workers --------
+
+	void ChunkStreamer::RunLoad(const std::shared_ptr<Request>& request)
+	{
+		// The world thread finds the request back through it, cancelled or not
+		auto result = std::make_unique<Result>();
+		result->Coord = request->Coord;
+		result->Load = request;
+
+		if (!request->Cancelled.load(std::memory_order_relaxed))
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_StorageMutex);
+				try
+				{
+					result->Loaded = m_Storage.LoadChunk(request->Coord);
+				}
+				catch (const std::exception&)
+				{
+					// Corrupt : generated again, the next save replaces it
+					m_CorruptCount.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+
+			if (!result->Loaded)
+			{
+				result->Loaded = m_Generator.Generate(request->Coord);
+				result->Generated = true;
+			}
+		}
+
+		m_Completed.Push(std::move(result));
+	}
+
+	void ChunkStreamer::RunSaves(const std::vector<std::shared_ptr<const Chunk>>& chunks)
+	{
+		std::vector<bool> written(chunks.size(), false);
+		bool flushed = false;
+		{
+			std::lock_guard<std::mutex> lock(m_StorageMutex);
+			for (size_t i = 0; i < chunks.size(); i++)
+			{
+				try
+				{
+					m_Storage.WriteChunk(*chunks[i]);
+					written[i] = true;
+				}
+				catch (const std::exception&)
+				{
+				}
+			}
+
+			// Once per region for the whole batch
+			try
+			{
+				m_Storage.Flush();
+				flushed = true;
+			}
+			catch (const std::exception&)
+			{
+			}
+		}
+
+		for (size_t i = 0; i < chunks.size(); i++)
+		{
+			auto result = std::make_unique<Result>();
+			result->Coord = chunks[i]->GetCoord();
+			result->Saved = written[i] && flushed;
+			if (!result->Saved)
+				m_SaveFailedCount.fetch_add(1, std::memory_order_relaxed);
+
+			m_Completed.Push(std::move(result));
+		}
+	}
+} // namespace onion::voxel
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <jobs/JobSystem.hpp>
+#include <jobs/MpscQueue.hpp>
+#include <storage/WorldStorage.hpp>
+#include <world/ChunkStore.hpp>
+#include <world/LightEngine.hpp>
+#include <worldgen/WorldGenerator.hpp>
+
+namespace onion::voxel
+{
+	/// @brief Distances in chunks, memory in bytes.
+	struct ChunkStreamerSettings
+	{
+		int LoadRadius = 32;			 // A circle around the player's chunk
+		int KeepMargin = 2;				 // Past the load radius, never unloaded
+		size_t MaxInFlight = 0;			 // Load and save jobs, 0 : two per worker
+		size_t MaxCachedChunks = 1024;	 // Past the keep radius, waiting in the LRU list
+		size_t MaxResidentBytes = size_t(1) << 30;
+		size_t MaxInsertsPerUpdate = 16; // Completed chunks inserted and lit per Update()
+		size_t MaxEvictionsPerUpdate = 64;
+	};
+
+	/// @brief Loads the chunks around the player as they come in range and unloads the far ones, without ever
+	/// waiting on the disk or the generator.
+	///
+	///	World thread : Update() follows the player. The missing chunks within the load radius wait in a pending list,
+	///	the best ones (nearest, in the view direction first) are submitted as jobs, up to the in flight limit so a
+	///	turn of the player is served at once. Completed chunks are inserted and lit a few per call.
+	///	Workers : read the chunk from the WorldStorage, or generate it when it was never saved, and push it to a
+	///	lock-free completion queue. The storage is behind a mutex, generation runs outside of it.
+	///
+	/// Chunks leaving the keep radius go to an LRU list instead of unloading right away, walking back and forth over
+	/// a border doesn't reload them. Past the cached chunk or resident memory caps, the least recently left ones are
+	/// unloaded, dirty ones (edited, or generated and never saved) handed to a save job, one per Update() so each
+	/// region is flushed once for the batch. A chunk being saved isn't loaded again until its save is done : the load
+	/// would read the previous copy.
+	class ChunkStreamer
+	{
+	  public:
+		using Settings = ChunkStreamerSettings;
+
+		struct Stats
+		{
+			size_t ResidentCount = 0;
+			size_t CachedCount = 0; // Resident past the keep radius
+			size_t DirtyCount = 0;
+			size_t PendingCount = 0;
+			size_t InFlightCount = 0;
+			size_t ResidentBytes = 0;
+			uint64_t LoadedCount = 0; // From the storage, since the start
+			uint64_t GeneratedCount = 0;
+			uint64_t SavedCount = 0;
+			uint64_t EvictedCount = 0;
+			uint64_t CorruptCount = 0;	  // Failed to load, generated again
+			uint64_t SaveFailedCount = 0; // Lost edits, the write threw
+		};
+
+		ChunkStreamer(JobSystem& jobs,
+					  ChunkStore& world,
+					  LightEngine& lighting,
+					  WorldStorage& storage,
+					  const WorldGenerator& generator,
+					  const Settings& settings = {});
+		/// @brief Waits for the jobs in flight, they reference the streamer. Doesn't save, see SaveAll().
+		~ChunkStreamer();
+
+		ChunkStreamer(const ChunkStreamer&) = delete;
+		ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+		// ----- World thread : the one that modifies the ChunkStore -----
+
+		/// @brief Inserts completed chunks, unloads past the caps and submits the next loads. Never blocks.
+		/// @param x, z Player position, in blocks.
+		/// @param viewX, viewZ Horizontal view direction, any length, zero when unknown.
+		void Update(float x, float z, float viewX, float viewZ);
+
+		/// @brief A block of the chunk changed, it is saved before unloading.
+		void MarkDirty(ChunkCoord coord);
+
+		/// @brief Waits for the jobs in flight, then saves every dirty chunk. Blocks, for shutting down.
+		/// @return The number of chunks saved.
+		size_t SaveAll();
+
+		/// @brief Chunks inserted into the store since the last call, their meshes are missing.
+		std::vector<ChunkCoord> TakeLoadedChunks();
+		/// @brief Chunks removed from the store since the last call, their meshes are out of date.
+		std::vector<ChunkCoord> TakeUnloadedChunks();
+
+		Stats GetStats() const;
+
+	  private:
+		struct Request
+		{
+			ChunkCoord Coord;
+			std::atomic<bool> Cancelled{false}; // Out of range before the job ran
+		};
+
+		struct Result
+		{
+			ChunkCoord Coord;
+			std::shared_ptr<Request> Load; // nullptr for a save
+			std::unique_ptr<Chunk> Loaded;
+			bool Generated = false;
+			bool Saved = false; // Of a save, the write succeeded
+		};
+
+		struct Resident
+		{
+			size_t Bytes = 0; // As of the load or the last edit
+			bool Dirty = false;
+			bool Cached = false; // Past the keep radius, in m_Lru
+			std::list<ChunkCoord>::iterator LruPosition;
+		};
+
+		bool IsInRadius(ChunkCoord coord, int radius) const;
+		/// @brief Moves the resident chunks in and out of the LRU list and rebuilds the pending list, when the
+		/// player's chunk changed.
+		void UpdateRanges(ChunkCoord center);
+		/// @return The number of chunks inserted.
+		size_t InsertCompleted(size_t maxInserts);
+		void Evict();
+		/// @brief Dirty chunks go to m_Unsaved, see SubmitSaves().
+		void Unload(ChunkCoord coord);
+		void SubmitSaves();
+		void Dispatch(float x, float z, float viewX, float viewZ);
+
+		void RunLoad(const std::shared_ptr<Request>& request);
+		void RunSaves(const std::vector<std::shared_ptr<const Chunk>>& chunks);
+
+	  private:
+		JobSystem& m_Jobs;
+		ChunkStore& m_World;
+		LightEngine& m_Lighting;
+		WorldStorage& m_Storage;
+		const WorldGenerator& m_Generator;
+		const Settings m_Settings;
+		const size_t m_MaxInFlight;
+
+		// ----- World thread -----
+		bool m_HasCenter = false;
+		ChunkCoord m_Center;
+		std::unordered_map<ChunkCoord, Resident, ChunkCoordHash> m_Resident;
+		std::list<ChunkCoord> m_Lru; // Most recently left the keep radius first
+		std::vector<ChunkCoord> m_Pending;
+		std::unordered_map<ChunkCoord, std::shared_ptr<Request>, ChunkCoordHash> m_Requested;
+		std::unordered_set<ChunkCoord, ChunkCoordHash> m_Saving;
+		std::vector<std::shared_ptr<const Chunk>> m_Unsaved; // Unloaded, not submitted yet
+		size_t m_InFlightCount = 0; // Submitted, result not taken yet
+		size_t m_ResidentBytes = 0;
+		size_t m_DirtyCount = 0;
+		std::vector<ChunkCoord> m_Loaded;
+		std::vector<ChunkCoord> m_Unloaded;
+		Stats m_Totals;
+
+		// ----- Workers -----
+		std::mutex m_StorageMutex;
+		std::atomic<uint64_t> m_CorruptCount{0};
+		std::atomic<uint64_t> m_SaveFailedCount{0};
+		MpscQueue<std::unique_ptr<Result>> m_Completed;
+	};
+} // namespace onion::voxel
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+namespace onion::voxel
+{
+	/// @brief Face directions, in the order of the normal index of VoxelVertex and of voxel.vert.
+	enum class BlockFace : uint8_t
+	{
+		PosX = 0,
+		NegX,
+		PosY,
+		NegY,
+		PosZ,
+		NegZ,
+
+		Count
+	};
+} // namespace onion::voxel
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+
+namespace onion::voxel
+{
+	/// @brief Global id of a block type, 0 is air.
+	using BlockId = uint16_t;
+
+	constexpr BlockId AirBlock = 0;
+} // namespace onion::voxel
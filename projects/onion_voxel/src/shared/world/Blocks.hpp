@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "BlockId.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Block types known by the game.
+	namespace Blocks
+	{
+		constexpr BlockId Air = AirBlock;
+		constexpr BlockId Stone = 1;
+		constexpr BlockId Dirt = 2;
+		constexpr BlockId Grass = 3;
+		constexpr BlockId Water = 4;
+		constexpr BlockId Bedrock = 5;
+		constexpr BlockId Sand = 6;
+		constexpr BlockId Gravel = 7;
+		constexpr BlockId OakLog = 8;
+		constexpr BlockId OakLeaves = 9;
+		constexpr BlockId CoalOre = 10;
+		constexpr BlockId IronOre = 11;
+		constexpr BlockId Glowstone = 12;
+
+		constexpr BlockId Count = 13;
+	} // namespace Blocks
+
+	struct BlockProperties
+	{
+		std::string_view Name;
+		bool IsOpaque; // Hides the faces behind it and blocks light
+		bool IsSolid;  // Collides with entities
+		uint8_t LightEmission = 0; // Block light level in [0, 15]
+	};
+
+	namespace detail
+	{
+		constexpr std::array<BlockProperties, Blocks::Count> BlockPropertiesTable{{
+			{"air", false, false},
+			{"stone", true, true},
+			{"dirt", true, true},
+			{"grass_block", true, true},
+			{"water", false, false},
+			{"bedrock", true, true},
+			{"sand", true, true},
+			{"gravel", true, true},
+			{"oak_log", true, true},
+			{"oak_leaves", false, true},
+			{"coal_ore", true, true},
+			{"iron_ore", true, true},
+			{"glowstone", true, true, 15},
+		}};
+
+		constexpr BlockProperties UnknownBlockProperties{"unknown", true, true};
+	} // namespace detail
+
+	/// @brief Unknown ids behave as opaque solid blocks.
+	constexpr const BlockProperties& GetBlockProperties(BlockId block)
+	{
+		return block < Blocks::Count ? detail::BlockPropertiesTable[block] : detail::UnknownBlockProperties;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,23 @@
+#include "Chunk.hpp"
+
+namespace onion::voxel
+{
+	Chunk::Chunk(ChunkCoord coord) : m_Coord(coord) {}
+
+	void Chunk::Compact()
+	{
+		for (PalettedContainer& section : m_Sections)
+			section.Compact();
+	}
+
+	size_t Chunk::GetMemoryUsage() const
+	{
+		size_t memory = sizeof(*this) - sizeof(m_Sections) - sizeof(m_BlockLight) - sizeof(m_SkyLight);
+		for (const PalettedContainer& section : m_Sections)
+			memory += section.GetMemoryUsage();
+		for (int sectionY = 0; sectionY < SectionCount; sectionY++)
+			memory += m_BlockLight[sectionY].GetMemoryUsage() + m_SkyLight[sectionY].GetMemoryUsage();
+
+		return memory;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "LightNibbleArray.hpp"
+#include "PalettedContainer.hpp"
+
+namespace onion::voxel
+{
+	/// @brief A 16 x Height x 16 column of blocks, made of 16-block high sections.
+	class Chunk
+	{
+	  public:
+		static constexpr int SectionCount = 16;
+		static constexpr int Height = SectionCount * ChunkSize;
+
+		explicit Chunk(ChunkCoord coord);
+
+		ChunkCoord GetCoord() const { return m_Coord; }
+
+		/// @brief Local X and Z in [0, 16). Y outside of [0, Height) reads as air.
+		BlockId GetBlock(int x, int y, int z) const
+		{
+			if (static_cast<unsigned>(y) >= static_cast<unsigned>(Height))
+				return AirBlock;
+
+			return m_Sections[y >> ChunkSizeShift].Get(x, y & ChunkSizeMask, z);
+		}
+
+		/// @return False when Y is outside of [0, Height), nothing is written.
+		bool SetBlock(int x, int y, int z, BlockId block)
+		{
+			if (static_cast<unsigned>(y) >= static_cast<unsigned>(Height))
+				return false;
+
+			m_Sections[y >> ChunkSizeShift].Set(x, y & ChunkSizeMask, z, block);
+			return true;
+		}
+
+		PalettedContainer& GetSection(int sectionY) { return m_Sections[sectionY]; }
+		const PalettedContainer& GetSection(int sectionY) const { return m_Sections[sectionY]; }
+
+		/// @brief Local X and Z in [0, 16). Above the world is full sky light, below it is dark.
+		uint8_t GetLight(LightType type, int x, int y, int z) const
+		{
+			if (static_cast<unsigned>(y) >= static_cast<unsigned>(Height))
+				return type == LightType::Sky && y >= Height ? MaxLightLevel : 0;
+
+			return GetLightSection(type, y >> ChunkSizeShift).Get(PalettedContainer::Index(x, y & ChunkSizeMask, z));
+		}
+
+		/// @brief Y in [0, Height). Only the LightEngine writes light, after the blocks it depends on.
+		void SetLight(LightType type, int x, int y, int z, uint8_t level)
+		{
+			GetLightSection(type, y >> ChunkSizeShift).Set(PalettedContainer::Index(x, y & ChunkSizeMask, z), level);
+		}
+
+		LightNibbleArray& GetLightSection(LightType type, int sectionY)
+		{
+			return type == LightType::Sky ? m_SkyLight[sectionY] : m_BlockLight[sectionY];
+		}
+		const LightNibbleArray& GetLightSection(LightType type, int sectionY) const
+		{
+			return type == LightType::Sky ? m_SkyLight[sectionY] : m_BlockLight[sectionY];
+		}
+
+		/// @brief Compacts the palette of every section.
+		void Compact();
+
+		size_t GetMemoryUsage() const;
+
+	  private:
+		ChunkCoord m_Coord;
+		std::array<PalettedContainer, SectionCount> m_Sections;
+		std::array<LightNibbleArray, SectionCount> m_BlockLight;
+		std::array<LightNibbleArray, SectionCount> m_SkyLight; // Dark until the LightEngine lights the chunk
+	};
+} // namespace onion::voxel
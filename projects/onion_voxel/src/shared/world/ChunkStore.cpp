@@ -0,0 +1,96 @@
+#include "ChunkStore.hpp"
+
+namespace onion::voxel
+{
+	// -------- Chunks --------
+
+	Chunk* ChunkStore::GetChunk(const ChunkCoord& coord)
+	{
+		auto it = m_Chunks.find(coord);
+		return it != m_Chunks.end() ? it->second.get() : nullptr;
+	}
+
+	const Chunk* ChunkStore::GetChunk(const ChunkCoord& coord) const
+	{
+		auto it = m_Chunks.find(coord);
+		return it != m_Chunks.end() ? it->second.get() : nullptr;
+	}
+
+	bool ChunkStore::HasChunk(const ChunkCoord& coord) const
+	{
+		return m_Chunks.contains(coord);
+	}
+
+	Chunk& ChunkStore::GetOrCreateChunk(const ChunkCoord& coord)
+	{
+		std::unique_ptr<Chunk>& chunk = m_Chunks[coord];
+		if (!chunk)
+			chunk = std::make_unique<Chunk>(coord);
+
+		return *chunk;
+	}
+
+	Chunk& ChunkStore::InsertChunk(std::unique_ptr<Chunk> chunk)
+	{
+		std::unique_ptr<Chunk>& slot = m_Chunks[chunk->GetCoord()];
+		slot = std::move(chunk);
+		return *slot;
+	}
+
+	bool ChunkStore::RemoveChunk(const ChunkCoord& coord)
+	{
+		return m_Chunks.erase(coord) > 0;
+	}
+
+	std::unique_ptr<Chunk> ChunkStore::ExtractChunk(const ChunkCoord& coord)
+	{
+		auto it = m_Chunks.find(coord);
+		if (it == m_Chunks.end())
+			return nullptr;
+
+		std::unique_ptr<Chunk> chunk = std::move(it->second);
+		m_Chunks.erase(it);
+		return chunk;
+	}
+
+	// -------- Blocks --------
+
+	BlockId ChunkStore::GetBlock(const BlockPos& pos) const
+	{
+		const Chunk* chunk = GetChunk(ChunkCoord::FromBlock(pos));
+		if (!chunk)
+			return AirBlock;
+
+		return chunk->GetBlock(ToLocal(pos.x), pos.y, ToLocal(pos.z));
+	}
+
+	bool ChunkStore::SetBlock(const BlockPos& pos, BlockId block)
+	{
+		Chunk* chunk = GetChunk(ChunkCoord::FromBlock(pos));
+		if (!chunk)
+			return false;
+
+		return chunk->SetBlock(ToLocal(pos.x), pos.y, ToLocal(pos.z), block);
+	}
+
+	// -------- Stats --------
+
+	size_t ChunkStore::GetChunkCount() const
+	{
+		return m_Chunks.size();
+	}
+
+	const ChunkStore::ChunkMap& ChunkStore::GetChunks() const
+	{
+		return m_Chunks;
+	}
+
+	size_t ChunkStore::GetMemoryUsage() const
+	{
+		size_t memory = sizeof(*this) + m_Chunks.bucket_count() * sizeof(void*);
+		for (const auto& [coord, chunk] : m_Chunks)
+			memory += sizeof(ChunkMap::value_type) + chunk->GetMemoryUsage();
+
+		return memory;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+
+#include "Chunk.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Loaded chunks of a world, by chunk coordinate.
+	/// Block access is a hash lookup plus a section read, both O(1). Hot loops over one chunk should resolve it once
+	/// with GetChunk() and use local coordinates. Not thread safe, readers and writers are synchronized by the owner.
+	class ChunkStore
+	{
+	  public:
+		using ChunkMap = std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>, ChunkCoordHash>;
+
+		Chunk* GetChunk(const ChunkCoord& coord);
+		const Chunk* GetChunk(const ChunkCoord& coord) const;
+		bool HasChunk(const ChunkCoord& coord) const;
+
+		/// @brief Returns the chunk, creating an empty (all air) one if it isn't loaded.
+		Chunk& GetOrCreateChunk(const ChunkCoord& coord);
+		/// @brief Adds a generated or loaded chunk, replacing any chunk at the same coordinate.
+		Chunk& InsertChunk(std::unique_ptr<Chunk> chunk);
+		bool RemoveChunk(const ChunkCoord& coord);
+		/// @brief Removes the chunk and hands it over (to save it after unloading), nullptr if it isn't loaded.
+		std::unique_ptr<Chunk> ExtractChunk(const ChunkCoord& coord);
+
+		/// @brief Air when the chunk isn't loaded.
+		BlockId GetBlock(const BlockPos& pos) const;
+		/// @return False when the chunk isn't loaded or Y is out of the world, nothing is written.
+		bool SetBlock(const BlockPos& pos, BlockId block);
+
+		size_t GetChunkCount() const;
+		const ChunkMap& GetChunks() const;
+
+		size_t GetMemoryUsage() const;
+
+	  private:
+		ChunkMap m_Chunks;
+	};
+} // namespace onion::voxel
@@ -0,0 +1,431 @@
+#include "LightEngine.hpp"
+
+#include <algorithm>
+
+#include "Blocks.hpp"
+
+namespace onion::voxel
+{
+	namespace
+	{
+		constexpr std::array<BlockPos, 6> Directions{{
+			{1, 0, 0},
+			{-1, 0, 0},
+			{0, 1, 0},
+			{0, -1, 0},
+			{0, 0, 1},
+			{0, 0, -1},
+		}};
+		constexpr int Down = 3;
+
+		constexpr std::array<LightType, 2> LightTypes{LightType::Block, LightType::Sky};
+
+		BlockPos Offset(const BlockPos& pos, const BlockPos& direction)
+		{
+			return {pos.x + direction.x, pos.y + direction.y, pos.z + direction.z};
+		}
+
+		bool IsOpaque(BlockId block)
+		{
+			return GetBlockProperties(block).IsOpaque;
+		}
+
+		bool IsInWorld(const BlockPos& pos)
+		{
+			return pos.y >= 0 && pos.y < Chunk::Height;
+		}
+	} // namespace
+
+	// -------- Constructor --------
+
+	LightEngine::LightEngine(ChunkStore& world) : m_World(world)
+	{
+		m_LastChanged.fill({0, -1, 0});
+	}
+
+	// -------- Public API --------
+
+	void LightEngine::AddChunk(ChunkCoord coord)
+	{
+		ClearChunkCache();
+
+		Chunk* chunk = m_World.GetChunk(coord);
+		if (!chunk)
+			return;
+
+		for (int sectionY = 0; sectionY < Chunk::SectionCount; sectionY++)
+		{
+			chunk->GetLightSection(LightType::Block, sectionY).Fill(0);
+			chunk->GetLightSection(LightType::Sky, sectionY).Fill(0);
+		}
+
+		LightSky(*chunk);
+		LightEmitters(*chunk);
+		QueueNeighbourBorders(coord);
+	}
+
+	void LightEngine::OnBlockChanged(const BlockPos& pos, BlockId previous)
+	{
+		ClearChunkCache();
+
+		Chunk* chunk = GetChunk(pos);
+		if (!chunk || !IsInWorld(pos))
+			return;
+
+		const BlockProperties& before = GetBlockProperties(previous);
+		const BlockProperties& after = GetBlockProperties(chunk->GetBlock(ToLocal(pos.x), pos.y, ToLocal(pos.z)));
+		if (before.IsOpaque == after.IsOpaque && before.LightEmission == after.LightEmission)
+			return;
+
+		for (LightType type : LightTypes)
+		{
+			const uint8_t oldLevel = GetLight(type, *chunk, pos);
+			if (oldLevel > 0)
+			{
+				SetLight(type, *chunk, pos, 0);
+				GetRemoveQueue(type).Push(pos, oldLevel);
+			}
+
+			const uint8_t emission = type == LightType::Block ? after.LightEmission : 0;
+			if (emission > 0)
+			{
+				SetLight(type, *chunk, pos, emission);
+				GetAddQueue(type).Push(pos, emission);
+			}
+
+			if (after.IsOpaque)
+				continue;
+
+			// The light around flows back into the block, stale entries are skipped once the removals ran
+			if (type == LightType::Sky && pos.y == Chunk::Height - 1)
+			{
+				SetLight(type, *chunk, pos, MaxLightLevel);
+				GetAddQueue(type).Push(pos, MaxLightLevel);
+			}
+
+			for (const BlockPos& direction : Directions)
+			{
+				const BlockPos neighbour = Offset(pos, direction);
+				if (!IsInWorld(neighbour))
+					continue;
+
+				const Chunk* neighbourChunk = GetChunk(neighbour);
+				if (!neighbourChunk)
+					continue;
+
+				const uint8_t level = GetLight(type, *neighbourChunk, neighbour);
+				if (level > 0)
+					GetAddQueue(type).Push(neighbour, level);
+			}
+		}
+	}
+
+	void LightEngine::Propagate()
+	{
+		ClearChunkCache();
+
+		for (LightType type : LightTypes)
+		{
+			PropagateRemovals(type);
+			PropagateAdditions(type);
+		}
+
+		ClearChunkCache();
+	}
+
+	std::vector<SectionCoord> LightEngine::TakeChangedSections()
+	{
+		std::vector<SectionCoord> sections(m_ChangedSections.begin(), m_ChangedSections.end());
+		m_ChangedSections.clear();
+		m_LastChanged.fill({0, -1, 0});
+		return sections;
+	}
+
+	// -------- Private --------
+
+	Chunk* LightEngine::GetChunk(const BlockPos& pos)
+	{
+		const ChunkCoord coord = ChunkCoord::FromBlock(pos);
+		CachedChunk& cached = m_ChunkCache[(coord.x & 1) | ((coord.z & 1) << 1)];
+		if (cached.Pointer && coord == cached.Coord)
+			return cached.Pointer;
+
+		cached.Pointer = m_World.GetChunk(coord);
+		cached.Coord = coord;
+		return cached.Pointer;
+	}
+
+	void LightEngine::ClearChunkCache()
+	{
+		m_ChunkCache.fill({});
+	}
+
+	void LightEngine::SetLight(LightType type, Chunk& chunk, const BlockPos& pos, uint8_t level)
+	{
+		const int x = ToLocal(pos.x);
+		const int y = ToLocal(pos.y);
+		const int z = ToLocal(pos.z);
+		chunk.SetLight(type, x, pos.y, z, level);
+		m_Stats.ChangedCount++;
+
+		const SectionCoord section = SectionCoord::FromBlock(pos);
+		MarkChanged(section, 0);
+
+		// Faces of the neighbour sections read the light of the blocks along their border
+		if (x == 0 || x == ChunkSizeMask)
+			MarkChanged({section.x + (x == 0 ? -1 : 1), section.y, section.z}, 1);
+		if ((y == 0 && section.y > 0) || (y == ChunkSizeMask && section.y < Chunk::SectionCount - 1))
+			MarkChanged({section.x, section.y + (y == 0 ? -1 : 1), section.z}, 2);
+		if (z == 0 || z == ChunkSizeMask)
+			MarkChanged({section.x, section.y, section.z + (z == 0 ? -1 : 1)}, 3);
+	}
+
+	void LightEngine::MarkChanged(const SectionCoord& section, int axis)
+	{
+		if (section == m_LastChanged[axis])
+			return;
+
+		m_ChangedSections.insert(section);
+		m_LastChanged[axis] = section;
+	}
+
+	void LightEngine::PropagateRemovals(LightType type)
+	{
+		LightQueue& queue = GetRemoveQueue(type);
+		LightQueue& additions = GetAddQueue(type);
+
+		while (!queue.IsEmpty())
+		{
+			const LightNode node = queue.Pop();
+			m_Stats.VisitedCount++;
+
+			for (int direction = 0; direction < static_cast<int>(Directions.size()); direction++)
+			{
+				const BlockPos neighbour = Offset(node.Pos, Directions[direction]);
+				if (!IsInWorld(neighbour))
+					continue;
+
+				Chunk* neighbourChunk = GetChunk(neighbour);
+				if (!neighbourChunk)
+					continue;
+
+				const uint8_t level = GetLight(type, *neighbourChunk, neighbour);
+				if (level == 0)
+					continue;
+
+				// Darker neighbours were lit by this block, so was the full sky light column below it
+				const bool skyColumn = type == LightType::Sky && direction == Down && node.Level == MaxLightLevel;
+				if (level >= node.Level && !(skyColumn && level == MaxLightLevel))
+				{
+					additions.Push(neighbour, level);
+					continue;
+				}
+
+				SetLight(type, *neighbourChunk, neighbour, 0);
+				queue.Push(neighbour, level);
+
+				// A light emitting block dimmed by the wave shines again
+				if (type == LightType::Block)
+				{
+					const BlockId block =
+						neighbourChunk->GetBlock(ToLocal(neighbour.x), neighbour.y, ToLocal(neighbour.z));
+					const uint8_t emission = GetBlockProperties(block).LightEmission;
+					if (emission > 0)
+					{
+						SetLight(type, *neighbourChunk, neighbour, emission);
+						additions.Push(neighbour, emission);
+					}
+				}
+			}
+		}
+
+		queue.Clear();
+	}
+
+	void LightEngine::PropagateAdditions(LightType type)
+	{
+		LightQueue& queue = GetAddQueue(type);
+
+		while (!queue.IsEmpty())
+		{
+			const LightNode node = queue.Pop();
+			m_Stats.VisitedCount++;
+
+			if (node.Level <= 1)
+				continue;
+
+			// Went dark since it was queued, or was lit brighter by an entry that spreads further
+			const Chunk* chunk = GetChunk(node.Pos);
+			if (!chunk || GetLight(type, *chunk, node.Pos) != node.Level)
+				continue;
+
+			for (int direction = 0; direction < static_cast<int>(Directions.size()); direction++)
+			{
+				const BlockPos neighbour = Offset(node.Pos, Directions[direction]);
+				if (!IsInWorld(neighbour))
+					continue;
+
+				Chunk* neighbourChunk = GetChunk(neighbour);
+				if (!neighbourChunk)
+					continue;
+
+				const bool skyColumn = type == LightType::Sky && direction == Down && node.Level == MaxLightLevel;
+				const uint8_t level = skyColumn ? MaxLightLevel : static_cast<uint8_t>(node.Level - 1);
+
+				const int x = ToLocal(neighbour.x);
+				const int z = ToLocal(neighbour.z);
+				if (neighbourChunk->GetLight(type, x, neighbour.y, z) >= level ||
+					IsOpaque(neighbourChunk->GetBlock(x, neighbour.y, z)))
+					continue;
+
+				SetLight(type, *neighbourChunk, neighbour, level);
+				queue.Push(neighbour, level);
+			}
+		}
+
+		queue.Clear();
+	}
+
+	void LightEngine::LightSky(Chunk& chunk)
+	{
+		constexpr int ColumnCount = ChunkSize * ChunkSize;
+
+		// Sections above the highest block are open sky, without data
+		int topSection = Chunk::SectionCount - 1;
+		while (topSection >= 0)
+		{
+			const PalettedContainer& section = chunk.GetSection(topSection);
+			if (!section.IsUniform() || section.GetPalette()[0] != AirBlock)
+				break;
+
+			chunk.GetLightSection(LightType::Sky, topSection).Fill(MaxLightLevel);
+			topSection--;
+		}
+
+		// Full light straight down each column, until the first opaque block
+		const int top = (topSection + 1) * ChunkSize;
+		std::array<int, ColumnCount> floors; // Lowest block of each column in full sky light
+
+		for (int z = 0; z < ChunkSize; z++)
+		{
+			for (int x = 0; x < ChunkSize; x++)
+			{
+				int y = top - 1;
+				for (; y >= 0 && !IsOpaque(chunk.GetBlock(x, y, z)); y--)
+					chunk.SetLight(LightType::Sky, x, y, z, MaxLightLevel);
+
+				floors[z * ChunkSize + x] = y + 1;
+			}
+		}
+
+		// The flood spreads sideways from the blocks next to a darker column of the chunk, QueueNeighbourBorders()
+		// takes care of the columns of the other chunks
+		const ChunkCoord coord = chunk.GetCoord();
+		LightQueue& queue = GetAddQueue(LightType::Sky);
+
+		for (int z = 0; z < ChunkSize; z++)
+		{
+			for (int x = 0; x < ChunkSize; x++)
+			{
+				int neighbourFloor = 0;
+				for (const BlockPos& direction : Directions)
+				{
+					const int neighbourX = x + direction.x;
+					const int neighbourZ = z + direction.z;
+					if (direction.y == 0 && neighbourX >= 0 && neighbourX < ChunkSize && neighbourZ >= 0 &&
+						neighbourZ < ChunkSize)
+						neighbourFloor = std::max(neighbourFloor, floors[neighbourZ * ChunkSize + neighbourX]);
+				}
+
+				for (int y = floors[z * ChunkSize + x]; y < neighbourFloor; y++)
+					queue.Push({coord.x * ChunkSize + x, y, coord.z * ChunkSize + z}, MaxLightLevel);
+			}
+		}
+	}
+
+	void LightEngine::LightEmitters(Chunk& chunk)
+	{
+		const ChunkCoord coord = chunk.GetCoord();
+		LightQueue& queue = GetAddQueue(LightType::Block);
+
+		for (int sectionY = 0; sectionY < Chunk::SectionCount; sectionY++)
+		{
+			// The palette tells which sections may hold a light, direct sections have none
+			const PalettedContainer& section = chunk.GetSection(sectionY);
+			bool hasEmitter = section.GetPalette().empty();
+			for (BlockId block : section.GetPalette())
+				hasEmitter |= GetBlockProperties(block).LightEmission > 0;
+
+			if (!hasEmitter)
+				continue;
+
+			for (int index = 0; index < PalettedContainer::Volume; index++)
+			{
+				const uint8_t emission = GetBlockProperties(section.Get(index)).LightEmission;
+				if (emission == 0)
+					continue;
+
+				const int x = index & ChunkSizeMask;
+				const int z = (index >> ChunkSizeShift) & ChunkSizeMask;
+				const int y = sectionY * ChunkSize + (index >> (2 * ChunkSizeShift));
+				chunk.SetLight(LightType::Block, x, y, z, emission);
+				queue.Push({coord.x * ChunkSize + x, y, coord.z * ChunkSize + z}, emission);
+			}
+		}
+	}
+
+	void LightEngine::QueueNeighbourBorders(ChunkCoord coord)
+	{
+		const Chunk* chunk = m_World.GetChunk(coord);
+
+		for (const BlockPos& direction : Directions)
+		{
+			if (direction.y != 0)
+				continue;
+
+			const Chunk* neighbour = m_World.GetChunk({coord.x + direction.x, coord.z + direction.z});
+			if (!neighbour)
+				continue;
+
+			// Both ways : the light of the neighbour flows in, and the sky light of this chunk flows out
+			QueueBorder(*neighbour, *chunk, {-direction.x, 0, -direction.z});
+			QueueBorder(*chunk, *neighbour, direction);
+		}
+	}
+
+	void LightEngine::QueueBorder(const Chunk& from, const Chunk& to, const BlockPos& direction)
+	{
+		// The layer of blocks of from touching to
+		const int borderX = direction.x == 0 ? -1 : (direction.x > 0 ? ChunkSizeMask : 0);
+		const int borderZ = direction.z == 0 ? -1 : (direction.z > 0 ? ChunkSizeMask : 0);
+		const ChunkCoord coord = from.GetCoord();
+
+		for (LightType type : LightTypes)
+		{
+			LightQueue& queue = GetAddQueue(type);
+
+			for (int sectionY = 0; sectionY < Chunk::SectionCount; sectionY++)
+			{
+				// Nothing to spread when both sides are already at the same uniform level
+				const LightNibbleArray& fromLight = from.GetLightSection(type, sectionY);
+				const LightNibbleArray& toLight = to.GetLightSection(type, sectionY);
+				if (fromLight.IsUniform() &&
+					(fromLight.GetUniformLevel() <= 1 ||
+					 (toLight.IsUniform() && toLight.GetUniformLevel() >= fromLight.GetUniformLevel() - 1)))
+					continue;
+
+				for (int y = sectionY * ChunkSize; y < (sectionY + 1) * ChunkSize; y++)
+				{
+					for (int i = 0; i < ChunkSize; i++)
+					{
+						const int x = borderX < 0 ? i : borderX;
+						const int z = borderZ < 0 ? i : borderZ;
+						const uint8_t level = from.GetLight(type, x, y, z);
+						if (level > 1)
+							queue.Push({coord.x * ChunkSize + x, y, coord.z * ChunkSize + z}, level);
+					}
+				}
+			}
+		}
+	}
+} // namespace onion::voxel
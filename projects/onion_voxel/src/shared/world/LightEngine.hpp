@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "ChunkStore.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Keeps the block and sky light of a ChunkStore up to date, with flood fills that only visit the blocks
+	/// whose light changes.
+	///
+	/// Light spreads from each block to its 6 neighbours, one level darker per step, and stops at opaque blocks. Sky
+	/// light also goes straight down at full level. Each channel has two queues :
+	/// - the add queue holds lit blocks to spread from, each neighbour brighter than it was is lit and queued.
+	/// - the remove queue holds blocks that went dark, with their old level. Neighbours darker than it were lit by
+	///   it : they go dark too and are queued. Brighter neighbours have another source, they go back to the add
+	///   queue to fill the hole.
+	/// Removals run first, then additions, so breaking or placing a light only touches the blocks it lit.
+	///
+	/// Floods cross chunk borders and stop at unloaded chunks, AddChunk() lets the light in once they load.
+	/// World thread only, like the ChunkStore.
+	class LightEngine
+	{
+	  public:
+		struct Stats
+		{
+			uint64_t VisitedCount = 0; // Queue entries processed
+			uint64_t ChangedCount = 0; // Light levels written
+		};
+
+		explicit LightEngine(ChunkStore& world);
+
+		/// @brief Lights a chunk just added to the store (generated or loaded) : sky light down its columns, its light
+		/// emitting blocks, and the light of the loaded neighbours flowing in. Resets any light it had.
+		void AddChunk(ChunkCoord coord);
+
+		/// @brief Queues the relighting around a block changed in the store, call it after ChunkStore::SetBlock().
+		void OnBlockChanged(const BlockPos& pos, BlockId previous);
+
+		/// @brief Runs the queued floods. Call once after a batch of AddChunk() and OnBlockChanged().
+		void Propagate();
+
+		/// @brief Sections whose light changed since the last call, their meshes are out of date.
+		std::vector<SectionCoord> TakeChangedSections();
+
+		Stats GetStats() const { return m_Stats; }
+
+	  private:
+		struct LightNode
+		{
+			BlockPos Pos;
+			uint8_t Level;
+		};
+
+		/// @brief FIFO reusing its storage : entries are only dropped when the queue is empty.
+		class LightQueue
+		{
+		  public:
+			void Push(const BlockPos& pos, uint8_t level) { m_Nodes.push_back({pos, level}); }
+			LightNode Pop() { return m_Nodes[m_Head++]; }
+			bool IsEmpty() const { return m_Head == m_Nodes.size(); }
+
+			void Clear()
+			{
+				m_Nodes.clear();
+				m_Head = 0;
+			}
+
+		  private:
+			std::vector<LightNode> m_Nodes;
+			size_t m_Head = 0;
+		};
+
+		static constexpr size_t ChannelCount = 2;
+
+		/// @brief The chunk holding the block, nullptr when unloaded. Floods stay in a few chunks, the last ones are
+		/// cached by the parity of their coordinates : the 4 chunks around a corner never evict each other.
+		Chunk* GetChunk(const BlockPos& pos);
+		void ClearChunkCache();
+		/// @brief Remembers that the meshes of the section need the new light.
+		void MarkChanged(const SectionCoord& section, int axis);
+
+		uint8_t GetLight(LightType type, const Chunk& chunk, const BlockPos& pos) const
+		{
+			return chunk.GetLight(type, ToLocal(pos.x), pos.y, ToLocal(pos.z));
+		}
+		void SetLight(LightType type, Chunk& chunk, const BlockPos& pos, uint8_t level);
+
+		void PropagateRemovals(LightType type);
+		void PropagateAdditions(LightType type);
+
+		void LightSky(Chunk& chunk);
+		void LightEmitters(Chunk& chunk);
+		/// @brief Queues the lit blocks on both sides of the borders between the chunk and its loaded neighbours.
+		void QueueNeighbourBorders(ChunkCoord coord);
+		/// @brief Queues the lit blocks of from along its side towards to.
+		void QueueBorder(const Chunk& from, const Chunk& to, const BlockPos& direction);
+
+		LightQueue& GetAddQueue(LightType type) { return m_AddQueues[static_cast<size_t>(type)]; }
+		LightQueue& GetRemoveQueue(LightType type) { return m_RemoveQueues[static_cast<size_t>(type)]; }
+
+	  private:
+		ChunkStore& m_World;
+
+		std::array<LightQueue, ChannelCount> m_AddQueues;
+		std::array<LightQueue, ChannelCount> m_RemoveQueues;
+
+		struct CachedChunk
+		{
+			Chunk* Pointer = nullptr; // Only valid inside a public call, chunks may be removed in between
+			ChunkCoord Coord;
+		};
+		std::array<CachedChunk, 4> m_ChunkCache;
+
+		std::unordered_set<SectionCoord, SectionCoordHash> m_ChangedSections;
+		// Last section marked for the block itself then along X, Y and Z : skips the hash set while a flood stays in
+		// the same sections
+		std::array<SectionCoord, 4> m_LastChanged;
+
+		Stats m_Stats;
+	};
+} // namespace onion::voxel
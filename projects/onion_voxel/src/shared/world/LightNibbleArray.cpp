@@ -0,0 +1,16 @@
+#include "LightNibbleArray.hpp"
+
+namespace onion::voxel
+{
+	void LightNibbleArray::Fill(uint8_t level)
+	{
+		m_Fill = level;
+		m_Data.clear();
+		m_Data.shrink_to_fit();
+	}
+
+	void LightNibbleArray::Expand()
+	{
+		m_Data.assign(Volume / 2, static_cast<uint8_t>(m_Fill * 0x11));
+	}
+} // namespace onion::voxel
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "WorldCoordinates.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Light of the blocks of a world, two independent channels with levels in [0, 15].
+	enum class LightType : uint8_t
+	{
+		Block, // From light emitting blocks
+		Sky,   // From above the world, 15 straight down through transparent blocks
+	};
+
+	constexpr uint8_t MaxLightLevel = 15;
+
+	/// @brief Light levels of the 16x16x16 blocks of a section, 4 bits each : 2 KiB.
+	///
+	/// Like a single block PalettedContainer, a section at one level everywhere (sky above the terrain, dark rock
+	/// below it) has no data at all. Entries use PalettedContainer::Index() order. Not thread safe.
+	class LightNibbleArray
+	{
+	  public:
+		static constexpr int Volume = ChunkSize * ChunkSize * ChunkSize;
+
+		explicit LightNibbleArray(uint8_t fill = 0) : m_Fill(fill) {}
+
+		uint8_t Get(int index) const
+		{
+			if (m_Data.empty())
+				return m_Fill;
+
+			return (m_Data[index >> 1] >> ((index & 1) << 2)) & 0xF;
+		}
+
+		void Set(int index, uint8_t level)
+		{
+			if (m_Data.empty())
+			{
+				if (level == m_Fill)
+					return;
+				Expand();
+			}
+
+			uint8_t& byte = m_Data[index >> 1];
+			const int shift = (index & 1) << 2;
+			byte = static_cast<uint8_t>((byte & ~(0xF << shift)) | (level << shift));
+		}
+
+		/// @brief Sets every entry to the level, releasing the data.
+		void Fill(uint8_t level);
+
+		bool IsUniform() const { return m_Data.empty(); }
+		/// @brief The level of every entry, when IsUniform().
+		uint8_t GetUniformLevel() const { return m_Fill; }
+
+		size_t GetMemoryUsage() const { return sizeof(*this) + m_Data.capacity(); }
+
+	  private:
+		void Expand();
+
+	  private:
+		std::vector<uint8_t> m_Data; // Empty : every entry is m_Fill
+		uint8_t m_Fill;
+	};
+} // namespace onion::voxel
@@ -0,0 +1,265 @@
+#include "PalettedContainer.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace onion::voxel
+{
+	namespace
+	{
+		/// @brief Smallest power of two width (in log2) able to index paletteSize entries, -1 for a single entry.
+		int BitsLog2ForPaletteSize(size_t paletteSize)
+		{
+			if (paletteSize <= 1)
+				return -1;
+
+			int bitsLog2 = 0;
+			while ((size_t(1) << (1 << bitsLog2)) < paletteSize)
+				bitsLog2++;
+
+			return bitsLog2;
+		}
+	} // namespace
+
+	// -------- Constructor --------
+
+	PalettedContainer::PalettedContainer(BlockId fill) : m_Palette{fill} {}
+
+	// -------- Public API --------
+
+	void PalettedContainer::Set(int index, BlockId block)
+	{
+		if (m_BitsLog2 < 0 && m_Palette[0] == block)
+			return;
+
+		uint32_t entry = GetOrAddEntry(block);
+		WriteEntry(index, entry);
+	}
+
+	void PalettedContainer::Fill(BlockId block)
+	{
+		m_Palette.assign(1, block);
+		m_Data.clear();
+		m_Data.shrink_to_fit();
+		m_BitsLog2 = -1;
+	}
+
+	void PalettedContainer::Assign(const BlockId* blocks)
+	{
+		// Palette in order of first appearance, runs of the same block skip the search
+		std::array<uint16_t, Volume> entries;
+		std::vector<BlockId> palette{blocks[0]};
+		BlockId last = blocks[0];
+		uint16_t lastEntry = 0;
+		bool direct = false;
+
+		for (int i = 0; i < Volume && !direct; i++)
+		{
+			if (blocks[i] != last)
+			{
+				last = blocks[i];
+				auto it = std::find(palette.begin(), palette.end(), last);
+				if (it == palette.end())
+				{
+					direct = palette.size() == 256;
+					palette.push_back(last);
+					it = palette.end() - 1;
+				}
+				lastEntry = static_cast<uint16_t>(it - palette.begin());
+			}
+			entries[i] = lastEntry;
+		}
+
+		if (palette.size() == 1)
+		{
+			Fill(palette[0]);
+			return;
+		}
+
+		if (direct)
+		{
+			m_Palette.clear();
+			m_BitsLog2 = DirectBitsLog2;
+		}
+		else
+		{
+			m_Palette = std::move(palette);
+			m_BitsLog2 = static_cast<int8_t>(BitsLog2ForPaletteSize(m_Palette.size()));
+		}
+
+		const int bits = 1 << m_BitsLog2;
+		const int entriesPerWord = 64 / bits;
+		m_Data.assign(Volume / entriesPerWord, 0);
+
+		for (size_t word = 0; word < m_Data.size(); word++)
+		{
+			uint64_t packed = 0;
+			for (int i = 0; i < entriesPerWord; i++)
+			{
+				const size_t index = word * entriesPerWord + i;
+				const uint64_t entry = direct ? blocks[index] : entries[index];
+				packed |= entry << (i * bits);
+			}
+			m_Data[word] = packed;
+		}
+	}
+
+	bool PalettedContainer::Load(std::vector<BlockId> palette, int bitsPerEntry, std::vector<uint64_t> data)
+	{
+		if (bitsPerEntry == 0)
+		{
+			if (palette.size() != 1 || !data.empty())
+				return false;
+
+			Fill(palette[0]);
+			return true;
+		}
+
+		int bitsLog2 = 0;
+		while (bitsLog2 < DirectBitsLog2 && (1 << bitsLog2) != bitsPerEntry)
+			bitsLog2++;
+		if ((1 << bitsLog2) != bitsPerEntry || data.size() != static_cast<size_t>(Volume >> (6 - bitsLog2)))
+			return false;
+
+		if (bitsLog2 == DirectBitsLog2)
+		{
+			if (!palette.empty())
+				return false;
+		}
+		else
+		{
+			const size_t capacity = size_t(1) << bitsPerEntry;
+			if (palette.empty() || palette.size() > capacity)
+				return false;
+
+			// Entries past the end of a partly filled palette would read out of it. Every other entry at once : with
+			// the free bits above them, adding capacity - size carries out of the entries past the palette.
+			if (palette.size() < capacity)
+			{
+				uint64_t lanes = 0;
+				for (int shift = 0; shift < 64; shift += 2 * bitsPerEntry)
+					lanes |= uint64_t(1) << shift;
+
+				const uint64_t entries = lanes * (capacity - 1);
+				const uint64_t carries = lanes << bitsPerEntry;
+				const uint64_t offset = lanes * (capacity - palette.size());
+
+				uint64_t overflow = 0;
+				for (uint64_t word : data)
+					overflow |= ((word & entries) + offset) | (((word >> bitsPerEntry) & entries) + offset);
+
+				if (overflow & carries)
+					return false;
+			}
+		}
+
+		m_Palette = std::move(palette);
+		m_Data = std::move(data);
+		m_BitsLog2 = static_cast<int8_t>(bitsLog2);
+		return true;
+	}
+
+	void PalettedContainer::Compact()
+	{
+		if (m_BitsLog2 < 0)
+			return;
+
+		// Blocks in use, in order of first appearance
+		std::vector<BlockId> blocks(Volume);
+		std::vector<BlockId> palette;
+
+		for (int i = 0; i < Volume; i++)
+		{
+			blocks[i] = Get(i);
+			if (std::find(palette.begin(), palette.end(), blocks[i]) == palette.end())
+			{
+				palette.push_back(blocks[i]);
+				if (palette.size() > 256)
+					return; // Stays in direct mode
+			}
+		}
+
+		if (palette.size() == 1)
+		{
+			Fill(palette[0]);
+			return;
+		}
+
+		m_Palette = std::move(palette);
+		m_BitsLog2 = static_cast<int8_t>(BitsLog2ForPaletteSize(m_Palette.size()));
+		m_Data.assign(Volume >> (6 - m_BitsLog2), 0);
+		m_Data.shrink_to_fit();
+
+		for (int i = 0; i < Volume; i++)
+		{
+			auto it = std::find(m_Palette.begin(), m_Palette.end(), blocks[i]);
+			WriteEntry(i, static_cast<uint32_t>(it - m_Palette.begin()));
+		}
+	}
+
+	size_t PalettedContainer::GetMemoryUsage() const
+	{
+		return sizeof(*this) + m_Palette.capacity() * sizeof(BlockId) + m_Data.capacity() * sizeof(uint64_t);
+	}
+
+	// -------- Private --------
+
+	void PalettedContainer::WriteEntry(int index, uint32_t entry)
+	{
+		const int entriesPerWordLog2 = 6 - m_BitsLog2;
+		const int bits = 1 << m_BitsLog2;
+		const uint64_t mask = (uint64_t(1) << bits) - 1;
+
+		uint64_t& word = m_Data[index >> entriesPerWordLog2];
+		int shift = (index & ((1 << entriesPerWordLog2) - 1)) << m_BitsLog2;
+		word = (word & ~(mask << shift)) | (static_cast<uint64_t>(entry) << shift);
+	}
+
+	uint32_t PalettedContainer::GetOrAddEntry(BlockId block)
+	{
+		if (m_BitsLog2 == DirectBitsLog2)
+			return block;
+
+		// At most 256 entries, a linear scan of contiguous 16-bit ids beats a hash map at this size
+		auto it = std::find(m_Palette.begin(), m_Palette.end(), block);
+		if (it != m_Palette.end())
+			return static_cast<uint32_t>(it - m_Palette.begin());
+
+		size_t capacity = m_BitsLog2 < 0 ? 1 : size_t(1) << (1 << m_BitsLog2);
+		if (m_Palette.size() == capacity)
+		{
+			int newBitsLog2 = m_BitsLog2 + 1;
+			Repack(newBitsLog2);
+
+			if (newBitsLog2 == DirectBitsLog2)
+				return block;
+		}
+
+		m_Palette.push_back(block);
+		return static_cast<uint32_t>(m_Palette.size() - 1);
+	}
+
+	void PalettedContainer::Repack(int newBitsLog2)
+	{
+		// The palette is unchanged, only the width of the indices grows
+		std::array<uint32_t, Volume> entries;
+		for (int i = 0; i < Volume; i++)
+			entries[i] = m_BitsLog2 < 0 ? 0 : ReadEntry(i);
+
+		m_BitsLog2 = static_cast<int8_t>(newBitsLog2);
+		m_Data.assign(Volume >> (6 - newBitsLog2), 0);
+
+		if (newBitsLog2 == DirectBitsLog2)
+		{
+			for (int i = 0; i < Volume; i++)
+				WriteEntry(i, m_Palette[entries[i]]);
+
+			m_Palette.clear();
+			m_Palette.shrink_to_fit();
+			return;
+		}
+
+		for (int i = 0; i < Volume; i++)
+			WriteEntry(i, entries[i]);
+	}
+} // namespace onion::voxel
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BlockId.hpp"
+#include "WorldCoordinates.hpp"
+
+namespace onion::voxel
+{
+	/// @brief The 16x16x16 blocks of a section, stored as indices into a local palette of block ids.
+	///
+	/// Indices use 0, 1, 2, 4, 8 or 16 bits, packed in 64-bit words without crossing a word boundary. Power of two
+	/// widths keep Get() to a shift and a mask. A section made of a single block (air, stone...) has 0 bits and no
+	/// data at all. Past 256 distinct blocks the palette is dropped and the 16-bit entries are the block ids.
+	/// Typical terrain sections have 2 to 16 blocks : 1 to 4 bits, 0.125 to 0.5 byte per block.
+	///
+	/// Not thread safe, readers and writers are synchronized by the owner.
+	class PalettedContainer
+	{
+	  public:
+		static constexpr int Size = ChunkSize;
+		static constexpr int Volume = Size * Size * Size;
+
+		explicit PalettedContainer(BlockId fill = AirBlock);
+
+		/// @brief Local coordinates in [0, 16), Y major so a horizontal layer is contiguous.
+		static int Index(int x, int y, int z) { return (y << 8) | (z << 4) | x; }
+
+		BlockId Get(int x, int y, int z) const { return Get(Index(x, y, z)); }
+		void Set(int x, int y, int z, BlockId block) { Set(Index(x, y, z), block); }
+
+		BlockId Get(int index) const
+		{
+			if (m_BitsLog2 < 0)
+				return m_Palette[0];
+
+			uint32_t entry = ReadEntry(index);
+			return m_BitsLog2 == DirectBitsLog2 ? static_cast<BlockId>(entry) : m_Palette[entry];
+		}
+
+		void Set(int index, BlockId block);
+
+		/// @brief Makes the whole section a single block, releasing the packed data.
+		void Fill(BlockId block);
+		/// @brief Replaces every block at once, in Index() order, packed at the narrowest width. Much faster than a
+		/// Set() per block to build a new section (generation, loading).
+		void Assign(const BlockId* blocks);
+
+		/// @brief Replaces the section with saved data : a palette (empty for 16-bit block ids) and entries packed
+		/// like GetData(), at bitsPerEntry (0 for a single block). No repacking, loading is a copy and a check.
+		/// @return False, leaving the section unchanged, when the data doesn't describe a valid section.
+		bool Load(std::vector<BlockId> palette, int bitsPerEntry, std::vector<uint64_t> data);
+
+		/// @brief Rebuilds the palette with the blocks still in use, narrowing the indices when possible.
+		/// The palette only grows on Set(), call this after many edits or before serializing.
+		void Compact();
+
+		bool IsUniform() const { return m_BitsLog2 < 0; }
+		int GetBitsPerEntry() const { return m_BitsLog2 < 0 ? 0 : 1 << m_BitsLog2; }
+
+		/// @brief Empty when the entries are block ids (16 bits).
+		const std::vector<BlockId>& GetPalette() const { return m_Palette; }
+		const std::vector<uint64_t>& GetData() const { return m_Data; }
+
+		size_t GetMemoryUsage() const;
+
+	  private:
+		static constexpr int DirectBitsLog2 = 4; // 16 bits, entries are block ids
+
+		uint32_t ReadEntry(int index) const
+		{
+			const int entriesPerWordLog2 = 6 - m_BitsLog2;
+			const int bits = 1 << m_BitsLog2;
+
+			uint64_t word = m_Data[index >> entriesPerWordLog2];
+			int shift = (index & ((1 << entriesPerWordLog2) - 1)) << m_BitsLog2;
+			return static_cast<uint32_t>((word >> shift) & ((uint64_t(1) << bits) - 1));
+		}
+
+		void WriteEntry(int index, uint32_t entry);
+
+		/// @brief Palette index of the block (or the block itself in direct mode), widening the entries if needed.
+		uint32_t GetOrAddEntry(BlockId block);
+		void Repack(int newBitsLog2);
+
+	  private:
+		std::vector<BlockId> m_Palette;
+		std::vector<uint64_t> m_Data;
+		int8_t m_BitsLog2 = -1; // -1 : uniform, no data
+	};
+} // namespace onion::voxel
@@ -0,0 +1,53 @@
+#include "SectionRegion.hpp"
+
+#include "SectionSnapshot.hpp"
+
+namespace onion::voxel
+{
+	bool SectionRegion::Capture(const ChunkStore& store, const SectionCoord& coord, int level)
+	{
+		m_Coord = coord;
+		m_Level = level;
+
+		const int size = GetSectionsPerAxis();
+		const SectionCoord first{coord.x << level, coord.y << level, coord.z << level};
+
+		// The columns of the region, resolved once
+		std::vector<const Chunk*> columns(static_cast<size_t>(size) * size);
+		bool anyBlock = false;
+
+		for (int z = 0; z < size; z++)
+		{
+			for (int x = 0; x < size; x++)
+			{
+				const Chunk* chunk = store.GetChunk({first.x + x, first.z + z});
+				columns[z * size + x] = chunk;
+
+				for (int y = 0; y < size && chunk && !anyBlock; y++)
+				{
+					const int sectionY = first.y + y;
+					anyBlock = sectionY < Chunk::SectionCount && !SectionSnapshot::IsSectionEmpty(*chunk, sectionY);
+				}
+			}
+		}
+
+		if (!anyBlock)
+			return false;
+
+		m_Sections.assign(static_cast<size_t>(size) * size * size, PalettedContainer(AirBlock));
+
+		for (int y = 0; y < size; y++)
+		{
+			const int sectionY = first.y + y;
+			if (sectionY >= Chunk::SectionCount)
+				break;
+
+			for (int z = 0; z < size; z++)
+				for (int x = 0; x < size; x++)
+					if (const Chunk* chunk = columns[z * size + x])
+						m_Sections[(y * size + z) * size + x] = chunk->GetSection(sectionY);
+		}
+
+		return true;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+
+#include "ChunkStore.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Copy of the sections of a cube of 2^level sections per axis, taken on the world thread so a coarse
+	/// level of detail can be downsampled from it on a worker, see SectionSnapshot::Downsample().
+	///
+	/// The copies keep the paletted storage : a region of 8x8x8 sections of typical terrain is a few hundred KiB.
+	class SectionRegion
+	{
+	  public:
+		static constexpr int MaxLevel = 3; // 8x8x8 sections, 128 blocks per axis
+
+		/// @param coord Region coordinate : the coordinate of its first section shifted right by level.
+		/// @return False when the region only holds air, or unloaded chunks. Nothing is copied then.
+		bool Capture(const ChunkStore& store, const SectionCoord& coord, int level);
+
+		SectionCoord GetCoord() const { return m_Coord; }
+		int GetLevel() const { return m_Level; }
+		int GetSectionsPerAxis() const { return 1 << m_Level; }
+
+		/// @brief Coordinates relative to the region, in [0, 2^level). Air above the world and in unloaded chunks.
+		const PalettedContainer& GetSection(int x, int y, int z) const
+		{
+			const int size = GetSectionsPerAxis();
+			return m_Sections[(y * size + z) * size + x];
+		}
+
+	  private:
+		std::vector<PalettedContainer> m_Sections; // X major, then Z, then Y
+		SectionCoord m_Coord;
+		int m_Level = 0;
+	};
+} // namespace onion::voxel
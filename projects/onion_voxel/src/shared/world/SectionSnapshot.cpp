@@ -0,0 +1,192 @@
+#include "SectionSnapshot.hpp"
+
+#include <algorithm>
+
+namespace onion::voxel
+{
+	namespace
+	{
+		uint8_t GetPackedLight(const Chunk* chunk, int x, int y, int z)
+		{
+			if (!chunk)
+				return SectionSnapshot::OpenSkyLight;
+
+			return static_cast<uint8_t>(chunk->GetLight(LightType::Block, x, y, z) |
+										(chunk->GetLight(LightType::Sky, x, y, z) << 4));
+		}
+
+		/// @brief The packed light of the 16 blocks of a row along X, without a lookup per block when the sections
+		/// are at one level (most of them, sky above the terrain and dark rock below it).
+		void CaptureLightRow(const Chunk& chunk, int y, int z, uint8_t* row)
+		{
+			if (y < 0 || y >= Chunk::Height)
+			{
+				for (int x = 0; x < ChunkSize; x++)
+					row[x] = GetPackedLight(&chunk, x, y, z);
+				return;
+			}
+
+			const LightNibbleArray& block = chunk.GetLightSection(LightType::Block, y >> ChunkSizeShift);
+			const LightNibbleArray& sky = chunk.GetLightSection(LightType::Sky, y >> ChunkSizeShift);
+
+			if (block.IsUniform() && sky.IsUniform())
+			{
+				const uint8_t light = static_cast<uint8_t>(block.GetUniformLevel() | (sky.GetUniformLevel() << 4));
+				std::fill(row, row + ChunkSize, light);
+				return;
+			}
+
+			const int first = PalettedContainer::Index(0, y & ChunkSizeMask, z);
+			for (int x = 0; x < ChunkSize; x++)
+				row[x] = static_cast<uint8_t>(block.Get(first + x) | (sky.Get(first + x) << 4));
+		}
+	} // namespace
+
+	void SectionSnapshot::Capture(const ChunkStore& store, ChunkCoord coord, int sectionY)
+	{
+		m_Coord = coord;
+		m_SectionY = sectionY;
+
+		// The 3x3 columns around the section, resolved once
+		const Chunk* columns[3][3];
+		for (int dz = -1; dz <= 1; dz++)
+			for (int dx = -1; dx <= 1; dx++)
+				columns[dz + 1][dx + 1] = store.GetChunk({coord.x + dx, coord.z + dz});
+
+		const Chunk* center = columns[1][1];
+		m_IsEmpty = !center || IsSectionEmpty(*center, sectionY);
+
+		const int baseY = sectionY * ChunkSize;
+
+		for (int y = -1; y <= ChunkSize; y++)
+		{
+			for (int z = -1; z <= ChunkSize; z++)
+			{
+				const int columnZ = z < 0 ? 0 : (z >= ChunkSize ? 2 : 1);
+				const int localZ = z & ChunkSizeMask;
+
+				const Chunk* const* rowColumns = columns[columnZ];
+				BlockId* row = &m_Blocks[Index(-1, y, z)];
+				uint8_t* lightRow = &m_Light[Index(-1, y, z)];
+
+				// Neighbour columns give the first and last block of the row, the middle one the 16 others
+				row[0] = rowColumns[0] ? rowColumns[0]->GetBlock(ChunkSize - 1, baseY + y, localZ) : AirBlock;
+				row[ChunkSize + 1] = rowColumns[2] ? rowColumns[2]->GetBlock(0, baseY + y, localZ) : AirBlock;
+				lightRow[0] = GetPackedLight(rowColumns[0], ChunkSize - 1, baseY + y, localZ);
+				lightRow[ChunkSize + 1] = GetPackedLight(rowColumns[2], 0, baseY + y, localZ);
+
+				if (rowColumns[1])
+				{
+					for (int x = 0; x < ChunkSize; x++)
+						row[x + 1] = rowColumns[1]->GetBlock(x, baseY + y, localZ);
+					CaptureLightRow(*rowColumns[1], baseY + y, localZ, lightRow + 1);
+				}
+				else
+				{
+					std::fill(row + 1, row + 1 + ChunkSize, AirBlock);
+					std::fill(lightRow + 1, lightRow + 1 + ChunkSize, OpenSkyLight);
+				}
+			}
+		}
+	}
+
+	void SectionSnapshot::Downsample(const SectionRegion& region)
+	{
+		const int level = region.GetLevel();
+		const SectionCoord coord = region.GetCoord();
+		m_Coord = {coord.x << level, coord.z << level};
+		m_SectionY = coord.y << level;
+		m_IsEmpty = true;
+		m_Blocks.fill(AirBlock);
+		m_Light.fill(OpenSkyLight);
+
+		const int sections = region.GetSectionsPerAxis();
+		const int scale = 1 << level;
+		const int cells = ChunkSize >> level; // Per axis, inside each section
+
+		for (int sectionY = 0; sectionY < sections; sectionY++)
+		{
+			for (int sectionZ = 0; sectionZ < sections; sectionZ++)
+			{
+				for (int sectionX = 0; sectionX < sections; sectionX++)
+				{
+					const PalettedContainer& section = region.GetSection(sectionX, sectionY, sectionZ);
+
+					// Stone under the surface and the sky above it, no need to look at the blocks
+					const bool uniform = section.IsUniform();
+					if (uniform && section.GetPalette()[0] == AirBlock)
+						continue;
+
+					const int firstX = sectionX * cells;
+					const int firstY = sectionY * cells;
+					const int firstZ = sectionZ * cells;
+
+					for (int y = 0; y < cells; y++)
+					{
+						for (int z = 0; z < cells; z++)
+						{
+							BlockId* row = &m_Blocks[Index(firstX, firstY + y, firstZ + z)];
+							for (int x = 0; x < cells; x++)
+							{
+								row[x] = uniform ? section.GetPalette()[0]
+												 : DownsampleCell(section, x * scale, y * scale, z * scale, scale);
+								m_IsEmpty &= row[x] == AirBlock;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	BlockId SectionSnapshot::DownsampleCell(const PalettedContainer& section, int x, int y, int z, int scale)
+	{
+		constexpr int MaxLayerBlocks = ChunkSize * ChunkSize / 4; // Scale up to 8
+
+		std::array<BlockId, MaxLayerBlocks> blocks;
+		std::array<int, MaxLayerBlocks> counts;
+		int distinctCount = 0;
+		int filledCount = 0;
+		BlockId top = AirBlock;
+
+		for (int layer = y + scale - 1; layer >= y; layer--)
+		{
+			for (int cellZ = z; cellZ < z + scale; cellZ++)
+			{
+				for (int cellX = x; cellX < x + scale; cellX++)
+				{
+					const BlockId block = section.Get(cellX, layer, cellZ);
+					if (block == AirBlock)
+						continue;
+
+					filledCount++;
+
+					// Only the highest filled layer votes
+					if (top != AirBlock)
+						continue;
+
+					int i = 0;
+					while (i < distinctCount && blocks[i] != block)
+						i++;
+					if (i == distinctCount)
+					{
+						blocks[distinctCount] = block;
+						counts[distinctCount++] = 0;
+					}
+					counts[i]++;
+				}
+			}
+
+			if (top == AirBlock && distinctCount > 0)
+			{
+				int best = 0;
+				for (int i = 1; i < distinctCount; i++)
+					if (counts[i] > counts[best])
+						best = i;
+				top = blocks[best];
+			}
+		}
+
+		return filledCount * 2 >= scale * scale * scale ? top : AirBlock;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "ChunkStore.hpp"
+#include "SectionRegion.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Copy of a section and the ring of blocks around it, 18x18x18, with their light, taken at one point in
+	/// time. Meshing and lighting jobs read it on worker threads while the world keeps changing.
+	class SectionSnapshot
+	{
+	  public:
+		static constexpr int Size = ChunkSize + 2;
+		static constexpr int Volume = Size * Size * Size;
+
+		/// @brief Full sky light and no block light, for blocks without light data.
+		static constexpr uint8_t OpenSkyLight = MaxLightLevel << 4;
+
+		/// @brief Copies the section and its neighbours. Blocks of unloaded chunks, above or below the world are air.
+		/// Unloaded chunks and above the world are in OpenSkyLight, below the world is dark.
+		void Capture(const ChunkStore& store, ChunkCoord coord, int sectionY);
+
+		/// @brief Fills the section with a region downsampled to 16x16x16, each block standing for 2^level blocks per
+		/// axis. The border is air : coarse meshes are closed on every side, their walls cover the cracks between
+		/// levels of detail. Far terrain has no light data, it is all in OpenSkyLight.
+		void Downsample(const SectionRegion& region);
+
+		/// @brief True when the section of the chunk is only air, without copying anything.
+		static bool IsSectionEmpty(const Chunk& chunk, int sectionY)
+		{
+			const PalettedContainer& section = chunk.GetSection(sectionY);
+			return section.IsUniform() && section.GetPalette()[0] == AirBlock;
+		}
+
+		/// @brief Coordinates relative to the section, in [-1, 16].
+		static int Index(int x, int y, int z) { return ((y + 1) * Size + (z + 1)) * Size + (x + 1); }
+
+		BlockId Get(int x, int y, int z) const { return m_Blocks[Index(x, y, z)]; }
+		BlockId Get(int index) const { return m_Blocks[index]; }
+
+		/// @brief Block light in the low nibble, sky light in the high nibble.
+		uint8_t GetLight(int index) const { return m_Light[index]; }
+
+		ChunkCoord GetCoord() const { return m_Coord; }
+		int GetSectionY() const { return m_SectionY; }
+
+		/// @brief True when the section itself (not its border) is only air : nothing to mesh.
+		bool IsEmpty() const { return m_IsEmpty; }
+
+	  private:
+		/// @brief Air when less than half of the cell is filled. Otherwise the most common block of its highest
+		/// filled layer, so hills keep their grass.
+		static BlockId DownsampleCell(const PalettedContainer& section, int x, int y, int z, int scale);
+
+	  private:
+		std::array<BlockId, Volume> m_Blocks{};
+		std::array<uint8_t, Volume> m_Light{};
+		ChunkCoord m_Coord;
+		int m_SectionY = 0;
+		bool m_IsEmpty = true;
+	};
+} // namespace onion::voxel
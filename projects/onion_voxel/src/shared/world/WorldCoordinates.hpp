@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace onion::voxel
+{
+	constexpr int ChunkSize = 16;	  // Blocks along X and Z of a chunk, and along each axis of a section
+	constexpr int ChunkSizeShift = 4; // log2(ChunkSize)
+	constexpr int ChunkSizeMask = ChunkSize - 1;
+
+	/// @brief Absolute position of a block in the world.
+	struct BlockPos
+	{
+		int32_t x = 0;
+		int32_t y = 0;
+		int32_t z = 0;
+
+		bool operator==(const BlockPos&) const = default;
+	};
+
+	/// @brief Position of a chunk column, in chunks.
+	struct ChunkCoord
+	{
+		int32_t x = 0;
+		int32_t z = 0;
+
+		bool operator==(const ChunkCoord&) const = default;
+
+		/// @brief Chunk containing the block. Arithmetic shift : floor division, also for negative coordinates.
+		static ChunkCoord FromBlock(int32_t blockX, int32_t blockZ)
+		{
+			return {blockX >> ChunkSizeShift, blockZ >> ChunkSizeShift};
+		}
+
+		static ChunkCoord FromBlock(const BlockPos& pos) { return FromBlock(pos.x, pos.z); }
+	};
+
+	struct ChunkCoordHash
+	{
+		size_t operator()(const ChunkCoord& coord) const noexcept
+		{
+			// Both halves through a 64-bit finalizer, neighbour chunks land in unrelated buckets
+			uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(coord.x)) << 32) |
+				static_cast<uint32_t>(coord.z);
+			key ^= key >> 33;
+			key *= 0xff51afd7ed558ccdULL;
+			key ^= key >> 33;
+			key *= 0xc4ceb9fe1a85ec53ULL;
+			key ^= key >> 33;
+			return static_cast<size_t>(key);
+		}
+	};
+
+	/// @brief Position of a 16x16x16 section, in sections. Y is the section index inside its chunk column.
+	struct SectionCoord
+	{
+		int32_t x = 0;
+		int32_t y = 0;
+		int32_t z = 0;
+
+		bool operator==(const SectionCoord&) const = default;
+
+		ChunkCoord GetChunk() const { return {x, z}; }
+
+		static SectionCoord FromBlock(const BlockPos& pos)
+		{
+			return {pos.x >> ChunkSizeShift, pos.y >> ChunkSizeShift, pos.z >> ChunkSizeShift};
+		}
+	};
+
+	struct SectionCoordHash
+	{
+		size_t operator()(const SectionCoord& coord) const noexcept
+		{
+			// Y only spans a few sections, folded into the high bits of X before the chunk hash
+			return ChunkCoordHash{}({coord.x ^ (coord.y << 24), coord.z});
+		}
+	};
+
+	/// @brief Coordinate of a block inside its chunk, in [0, ChunkSize).
+	inline int ToLocal(int32_t blockCoord)
+	{
+		return blockCoord & ChunkSizeMask;
+	}
+} // namespace onion::voxel
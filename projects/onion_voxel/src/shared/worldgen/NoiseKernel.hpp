@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+
+#include "TerrainNoise.hpp"
+
+namespace onion::voxel::detail
+{
+	// Terrain noise written once for any lane type, instantiated by TerrainNoise.cpp with one float per lane and by
+	// TerrainNoiseAvx2.cpp with 8. Both run the same IEEE operations in the same order (no fused multiply-add, no
+	// approximations) so the SIMD and scalar heights are bit-identical.
+	//
+	// A lane type L provides : Float, Int (32-bit, wrapping), Mask, Width, and the static operations used below.
+	// Everything here is a template of L, and the lane types live in anonymous namespaces : the AVX2 translation
+	// unit, built with AVX2 enabled, never emits a function that the scalar path could end up linking to.
+
+	template <typename L> typename L::Int HashCorner(typename L::Int x, typename L::Int y, uint32_t seed)
+	{
+		typename L::Int hash = L::Xor(L::Xor(L::Mul(x, L::SetInt(0x27d4eb2du)), L::Mul(y, L::SetInt(0x165667b1u))),
+									  L::SetInt(seed));
+		hash = L::Xor(hash, L::ShiftRight(hash, 15));
+		hash = L::Mul(hash, L::SetInt(0x85ebca6bu));
+		hash = L::Xor(hash, L::ShiftRight(hash, 13));
+		return hash;
+	}
+
+	/// @brief Dot product of the offset with one of 8 gradients, (+-1, +-2) and (+-2, +-1), picked by the hash.
+	template <typename L>
+	typename L::Float Gradient(typename L::Int hash, typename L::Float x, typename L::Float y)
+	{
+		const typename L::Mask swap = L::HasBit(hash, 4u);
+		const typename L::Float u = L::Select(swap, y, x);
+		const typename L::Float v = L::Select(swap, x, y);
+		const typename L::Float twiceV = L::Add(v, v);
+
+		const typename L::Float zero = L::Set(0.f);
+		return L::Add(L::Select(L::HasBit(hash, 1u), L::Sub(zero, u), u),
+					  L::Select(L::HasBit(hash, 2u), L::Sub(zero, twiceV), twiceV));
+	}
+
+	/// @brief 6t^5 - 15t^4 + 10t^3
+	template <typename L> typename L::Float Fade(typename L::Float t)
+	{
+		const typename L::Float inner = L::Add(L::Mul(t, L::Sub(L::Mul(t, L::Set(6.f)), L::Set(15.f))), L::Set(10.f));
+		return L::Mul(L::Mul(L::Mul(t, t), t), inner);
+	}
+
+	template <typename L> typename L::Float Lerp(typename L::Float a, typename L::Float b, typename L::Float t)
+	{
+		return L::Add(a, L::Mul(t, L::Sub(b, a)));
+	}
+
+	/// @brief 2D gradient noise, about [-1, 1].
+	template <typename L> typename L::Float Perlin(typename L::Float x, typename L::Float y, uint32_t seed)
+	{
+		const typename L::Float floorX = L::Floor(x);
+		const typename L::Float floorY = L::Floor(y);
+		const typename L::Int x0 = L::ToInt(floorX);
+		const typename L::Int y0 = L::ToInt(floorY);
+		const typename L::Int x1 = L::AddInt(x0, L::SetInt(1u));
+		const typename L::Int y1 = L::AddInt(y0, L::SetInt(1u));
+
+		const typename L::Float dx0 = L::Sub(x, floorX);
+		const typename L::Float dy0 = L::Sub(y, floorY);
+		const typename L::Float dx1 = L::Sub(dx0, L::Set(1.f));
+		const typename L::Float dy1 = L::Sub(dy0, L::Set(1.f));
+
+		const typename L::Float g00 = Gradient<L>(HashCorner<L>(x0, y0, seed), dx0, dy0);
+		const typename L::Float g10 = Gradient<L>(HashCorner<L>(x1, y0, seed), dx1, dy0);
+		const typename L::Float g01 = Gradient<L>(HashCorner<L>(x0, y1, seed), dx0, dy1);
+		const typename L::Float g11 = Gradient<L>(HashCorner<L>(x1, y1, seed), dx1, dy1);
+
+		const typename L::Float u = Fade<L>(dx0);
+		const typename L::Float v = Fade<L>(dy0);
+		return L::Mul(Lerp<L>(Lerp<L>(g00, g10, u), Lerp<L>(g01, g11, u), v), L::Set(0.5f));
+	}
+
+	/// @brief Octaves of Perlin noise, each at twice the frequency and a fraction of the amplitude of the previous.
+	template <typename L>
+	typename L::Float Fractal(const NoiseLayer& layer, typename L::Float x, typename L::Float z, uint32_t seed)
+	{
+		typename L::Float sum = L::Set(0.f);
+		float frequency = layer.Frequency;
+		float amplitude = 1.f;
+
+		for (int octave = 0; octave < layer.Octaves; octave++)
+		{
+			const typename L::Float noise =
+				Perlin<L>(L::Mul(x, L::Set(frequency)), L::Mul(z, L::Set(frequency)), seed + layer.Seed + octave);
+			sum = L::Add(sum, L::Mul(noise, L::Set(amplitude)));
+			frequency *= 2.f;
+			amplitude *= layer.Gain;
+		}
+
+		return sum;
+	}
+
+	/// @brief 0 below edge0, 1 above edge1, smooth in between.
+	template <typename L> typename L::Float SmoothStep(typename L::Float value, float edge0, float edge1)
+	{
+		typename L::Float t = L::Mul(L::Sub(value, L::Set(edge0)), L::Set(1.f / (edge1 - edge0)));
+		t = L::Min(L::Max(t, L::Set(0.f)), L::Set(1.f));
+		return L::Mul(L::Mul(t, t), L::Sub(L::Set(3.f), L::Add(t, t)));
+	}
+
+	/// @brief Height and biome of the 16x16 columns of a chunk, L::Width columns at a time along X.
+	/// Takes the settings rather than the TerrainNoise : no inline function of another header gets compiled here.
+	template <typename L>
+	void SampleChunkColumns(const TerrainNoiseSettings& settings,
+							uint32_t seed,
+							ChunkCoord coord,
+							ColumnSamples& samples)
+	{
+		for (int z = 0; z < ChunkSize; z++)
+		{
+			for (int x = 0; x < ChunkSize; x += L::Width)
+			{
+				const typename L::Float worldX =
+					L::ToFloat(L::AddInt(L::SetInt(static_cast<uint32_t>(coord.x * ChunkSize + x)), L::LaneIndex()));
+				const typename L::Float worldZ = L::Set(static_cast<float>(coord.z * ChunkSize + z));
+
+				const typename L::Float continent = Fractal<L>(settings.Continent, worldX, worldZ, seed);
+				const typename L::Float detail = Fractal<L>(settings.Detail, worldX, worldZ, seed);
+				const typename L::Float temperature = Fractal<L>(settings.Temperature, worldX, worldZ, seed);
+
+				// Each biome shapes its own height, blended by smooth weights so borders have no cliffs
+				const typename L::Float plains =
+					L::Add(L::Set(settings.PlainsHeight), L::Mul(detail, L::Set(settings.PlainsVariation)));
+				const typename L::Float hills =
+					L::Add(L::Add(L::Set(settings.HillsHeight), L::Mul(continent, L::Set(settings.HillsVariation))),
+						   L::Mul(detail, L::Set(settings.PlainsVariation)));
+				const typename L::Float desert =
+					L::Add(L::Set(settings.DesertHeight), L::Mul(detail, L::Set(settings.DesertVariation)));
+
+				const typename L::Float hillsWeight = SmoothStep<L>(continent, settings.HillsStart, settings.HillsEnd);
+				const typename L::Float desertWeight =
+					SmoothStep<L>(temperature, settings.DesertStart, settings.DesertEnd);
+
+				const int index = z * ChunkSize + x;
+				L::Store(&samples.Height[index], Lerp<L>(Lerp<L>(plains, hills, hillsWeight), desert, desertWeight));
+				L::Store(&samples.Desert[index], desertWeight);
+			}
+		}
+	}
+} // namespace onion::voxel::detail
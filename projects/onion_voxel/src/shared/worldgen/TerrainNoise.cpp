@@ -0,0 +1,89 @@
+#include "TerrainNoise.hpp"
+
+#include <cmath>
+
+#include <platform/CpuFeatures.hpp>
+
+#include "NoiseKernel.hpp"
+
+namespace onion::voxel
+{
+	namespace
+	{
+		/// @brief One column at a time, the reference the SIMD paths must match bit for bit.
+		struct ScalarLanes
+		{
+			using Float = float;
+			using Int = uint32_t; // Wraps on overflow, like the SIMD lanes
+			using Mask = bool;
+			static constexpr int Width = 1;
+
+			static Float Set(float value) { return value; }
+			static Int SetInt(uint32_t value) { return value; }
+			static Int LaneIndex() { return 0; }
+
+			static Float Add(Float a, Float b) { return a + b; }
+			static Float Sub(Float a, Float b) { return a - b; }
+			static Float Mul(Float a, Float b) { return a * b; }
+			// Same operand order as minps / maxps
+			static Float Min(Float a, Float b) { return a < b ? a : b; }
+			static Float Max(Float a, Float b) { return a > b ? a : b; }
+			static Float Floor(Float a) { return std::floor(a); }
+
+			static Int ToInt(Float a) { return static_cast<uint32_t>(static_cast<int32_t>(a)); }
+			static Float ToFloat(Int a) { return static_cast<float>(static_cast<int32_t>(a)); }
+			static Int AddInt(Int a, Int b) { return a + b; }
+			static Int Mul(Int a, Int b) { return a * b; }
+			static Int Xor(Int a, Int b) { return a ^ b; }
+			static Int ShiftRight(Int a, int count) { return a >> count; }
+
+			static Mask HasBit(Int a, uint32_t bit) { return (a & bit) != 0; }
+			static Float Select(Mask mask, Float ifSet, Float otherwise) { return mask ? ifSet : otherwise; }
+			static void Store(float* destination, Float value) { *destination = value; }
+		};
+	} // namespace
+
+	// -------- Constructor --------
+
+	TerrainNoise::TerrainNoise(uint32_t seed, const TerrainNoiseSettings& settings) : m_Seed(seed), m_Settings(settings)
+	{
+		if (IsSupported(NoiseInstructionSet::Avx2))
+			m_InstructionSet = NoiseInstructionSet::Avx2;
+	}
+
+	// -------- Public API --------
+
+	void TerrainNoise::SampleChunk(ChunkCoord coord, ColumnSamples& samples) const
+	{
+		if (m_InstructionSet == NoiseInstructionSet::Avx2 &&
+			detail::SampleChunkColumnsAvx2(m_Settings, m_Seed, coord, samples))
+			return;
+
+		detail::SampleChunkColumns<ScalarLanes>(m_Settings, m_Seed, coord, samples);
+	}
+
+	bool TerrainNoise::SetInstructionSet(NoiseInstructionSet instructionSet)
+	{
+		if (!IsSupported(instructionSet))
+			return false;
+
+		m_InstructionSet = instructionSet;
+		return true;
+	}
+
+	bool TerrainNoise::IsSupported(NoiseInstructionSet instructionSet)
+	{
+		switch (instructionSet)
+		{
+			case NoiseInstructionSet::Scalar:
+				return true;
+			case NoiseInstructionSet::Avx2:
+			{
+				static const bool supported = detail::HasAvx2Path() && CpuSupportsAvx2();
+				return supported;
+			}
+		}
+
+		return false;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+
+#include <world/WorldCoordinates.hpp>
+
+namespace onion::voxel
+{
+	/// @brief Fractal Perlin noise : Octaves layers, each at twice the frequency and Gain times the amplitude.
+	struct NoiseLayer
+	{
+		float Frequency = 0.01f; // Cycles per block of the first octave
+		int Octaves = 4;
+		float Gain = 0.5f;
+		uint32_t Seed = 0; // Added to the world seed, layers with different seeds are unrelated
+	};
+
+	/// @brief Shape of the terrain. Heights in blocks, the start and end of the biomes in noise values (about [-1, 1]).
+	struct TerrainNoiseSettings
+	{
+		NoiseLayer Continent{0.0015f, 4, 0.5f, 0x9e3779b9u}; // Large scale shape : plains or hills
+		NoiseLayer Detail{0.02f, 4, 0.5f, 0x7f4a7c15u};		 // Small bumps everywhere
+		NoiseLayer Temperature{0.001f, 3, 0.5f, 0x2545f491u}; // Deserts where hot
+
+		float PlainsHeight = 66.f;
+		float PlainsVariation = 6.f;
+		float HillsHeight = 84.f;
+		float HillsVariation = 40.f;
+		float DesertHeight = 68.f;
+		float DesertVariation = 3.f;
+
+		float HillsStart = 0.05f;
+		float HillsEnd = 0.35f;
+		float DesertStart = 0.1f;
+		float DesertEnd = 0.3f;
+	};
+
+	/// @brief Noise of the 16x16 columns of a chunk, indexed z * 16 + x.
+	struct ColumnSamples
+	{
+		alignas(32) float Height[ChunkSize * ChunkSize]; // Surface height in blocks, before rounding
+		alignas(32) float Desert[ChunkSize * ChunkSize]; // Desert weight in [0, 1]
+	};
+
+	enum class NoiseInstructionSet
+	{
+		Scalar,
+		Avx2, // 8 columns at a time
+	};
+
+	/// @brief Samples the terrain noise of whole chunks. The AVX2 path is picked at runtime when the CPU supports it
+	/// and gives bit-identical results to the scalar one, a seed makes the same world on every machine.
+	/// Immutable after construction apart from SetInstructionSet(), safe to share between worker threads.
+	class TerrainNoise
+	{
+	  public:
+		explicit TerrainNoise(uint32_t seed, const TerrainNoiseSettings& settings = {});
+
+		void SampleChunk(ChunkCoord coord, ColumnSamples& samples) const;
+
+		uint32_t GetSeed() const { return m_Seed; }
+		const TerrainNoiseSettings& GetSettings() const { return m_Settings; }
+
+		NoiseInstructionSet GetInstructionSet() const { return m_InstructionSet; }
+		/// @brief Forces a path, for benchmarks and tests. Not while chunks are being sampled.
+		/// @return False when the CPU (or the build) doesn't support it, nothing changes.
+		bool SetInstructionSet(NoiseInstructionSet instructionSet);
+
+		static bool IsSupported(NoiseInstructionSet instructionSet);
+
+	  private:
+		uint32_t m_Seed;
+		TerrainNoiseSettings m_Settings;
+		NoiseInstructionSet m_InstructionSet = NoiseInstructionSet::Scalar;
+	};
+
+	namespace detail
+	{
+		/// @brief False when the compiler or the target can't build the AVX2 path.
+		bool HasAvx2Path();
+		/// @brief AVX2 path, in its own translation unit built with AVX2 enabled.
+		/// @return False when the build has no AVX2 path, nothing is written.
+		bool SampleChunkColumnsAvx2(const TerrainNoiseSettings& settings,
+									uint32_t seed,
+									ChunkCoord coord,
+									ColumnSamples& samples);
+	} // namespace detail
+} // namespace onion::voxel
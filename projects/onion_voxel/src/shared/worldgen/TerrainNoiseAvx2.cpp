@@ -0,0 +1,86 @@
+// Built with AVX2 enabled (see CMakeLists.txt), only called after a runtime check of the CPU.
+// No standard library here : an inline function instantiated in this file could be picked by the linker for the
+// whole program, and crash on CPUs without AVX2.
+
+#include "TerrainNoise.hpp"
+
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+#include "NoiseKernel.hpp"
+
+namespace onion::voxel
+{
+	namespace
+	{
+		/// @brief 8 columns at a time.
+		struct Avx2Lanes
+		{
+			using Float = __m256;
+			using Int = __m256i;
+			using Mask = __m256;
+			static constexpr int Width = 8;
+
+			static Float Set(float value) { return _mm256_set1_ps(value); }
+			static Int SetInt(uint32_t value) { return _mm256_set1_epi32(static_cast<int>(value)); }
+			static Int LaneIndex() { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+
+			static Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+			static Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+			static Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+			static Float Min(Float a, Float b) { return _mm256_min_ps(a, b); }
+			static Float Max(Float a, Float b) { return _mm256_max_ps(a, b); }
+			static Float Floor(Float a) { return _mm256_floor_ps(a); }
+
+			static Int ToInt(Float a) { return _mm256_cvttps_epi32(a); }
+			static Float ToFloat(Int a) { return _mm256_cvtepi32_ps(a); }
+			static Int AddInt(Int a, Int b) { return _mm256_add_epi32(a, b); }
+			static Int Mul(Int a, Int b) { return _mm256_mullo_epi32(a, b); }
+			static Int Xor(Int a, Int b) { return _mm256_xor_si256(a, b); }
+			static Int ShiftRight(Int a, int count) { return _mm256_srl_epi32(a, _mm_cvtsi32_si128(count)); }
+
+			static Mask HasBit(Int a, uint32_t bit)
+			{
+				const Int bitMask = SetInt(bit);
+				return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(a, bitMask), bitMask));
+			}
+			static Float Select(Mask mask, Float ifSet, Float otherwise)
+			{
+				return _mm256_blendv_ps(otherwise, ifSet, mask);
+			}
+			static void Store(float* destination, Float value) { _mm256_storeu_ps(destination, value); }
+		};
+	} // namespace
+
+	bool detail::HasAvx2Path()
+	{
+		return true;
+	}
+
+	bool detail::SampleChunkColumnsAvx2(const TerrainNoiseSettings& settings,
+										uint32_t seed,
+										ChunkCoord coord,
+										ColumnSamples& samples)
+	{
+		detail::SampleChunkColumns<Avx2Lanes>(settings, seed, coord, samples);
+		return true;
+	}
+} // namespace onion::voxel
+
+#else
+
+namespace onion::voxel
+{
+	bool detail::HasAvx2Path()
+	{
+		return false;
+	}
+
+	bool detail::SampleChunkColumnsAvx2(const TerrainNoiseSettings&, uint32_t, ChunkCoord, ColumnSamples&)
+	{
+		return false;
+	}
+} // namespace onion::voxel
+
+#endif
@@ -0,0 +1,139 @@
+#include "WorldGenerator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <latch>
+
+#include <world/Blocks.hpp>
+
+namespace onion::voxel
+{
+	namespace
+	{
+		constexpr int DirtDepth = 3; // Blocks of dirt (or sand) between the surface and the stone
+		constexpr int BeachDepth = 3; // Blocks under the sea level where the shore is sand
+
+		/// @brief Uniform 32 bits for a block, the same on every machine.
+		uint32_t HashBlock(int x, int y, int z, uint32_t seed)
+		{
+			uint32_t hash = static_cast<uint32_t>(x) * 0x27d4eb2du ^ static_cast<uint32_t>(y) * 0x165667b1u ^
+				static_cast<uint32_t>(z) * 0x9e3779b1u ^ seed;
+			hash ^= hash >> 15;
+			hash *= 0x85ebca6bu;
+			hash ^= hash >> 13;
+			hash *= 0xc2b2ae35u;
+			hash ^= hash >> 16;
+			return hash;
+		}
+	} // namespace
+
+	// -------- Constructor --------
+
+	WorldGenerator::WorldGenerator(uint32_t seed, const TerrainNoiseSettings& settings) : m_Noise(seed, settings) {}
+
+	// -------- Public API --------
+
+	std::unique_ptr<Chunk> WorldGenerator::Generate(ChunkCoord coord) const
+	{
+		constexpr int ColumnCount = ChunkSize * ChunkSize;
+
+		ColumnSamples samples;
+		m_Noise.SampleChunk(coord, samples);
+
+		std::array<int, ColumnCount> heights;
+		std::array<bool, ColumnCount> deserts;
+		int maxHeight = SeaLevel;
+
+		for (int column = 0; column < ColumnCount; column++)
+		{
+			heights[column] = std::clamp(static_cast<int>(std::floor(samples.Height[column])), 1, Chunk::Height - 1);
+			deserts[column] = samples.Desert[column] > 0.5f;
+			maxHeight = std::max(maxHeight, heights[column]);
+		}
+
+		auto chunk = std::make_unique<Chunk>(coord);
+		const int firstX = coord.x * ChunkSize;
+		const int firstZ = coord.z * ChunkSize;
+
+		// Each section is built in a flat buffer and packed once, the sections above the terrain stay air
+		std::array<BlockId, PalettedContainer::Volume> blocks;
+		for (int sectionY = 0; sectionY * ChunkSize <= maxHeight; sectionY++)
+		{
+			for (int localY = 0; localY < ChunkSize; localY++)
+			{
+				const int y = sectionY * ChunkSize + localY;
+
+				for (int z = 0; z < ChunkSize; z++)
+				{
+					for (int x = 0; x < ChunkSize; x++)
+					{
+						const int column = z * ChunkSize + x;
+
+						BlockId block = Blocks::Air;
+						if (y == 0)
+							block = Blocks::Bedrock;
+						else if (y <= heights[column])
+							block = GetColumnBlock(firstX + x, y, firstZ + z, heights[column], deserts[column]);
+						else if (y <= SeaLevel)
+							block = Blocks::Water;
+
+						blocks[PalettedContainer::Index(x, localY, z)] = block;
+					}
+				}
+			}
+
+			chunk->GetSection(sectionY).Assign(blocks.data());
+		}
+
+		return chunk;
+	}
+
+	std::vector<std::unique_ptr<Chunk>> WorldGenerator::GenerateChunks(JobSystem& jobs,
+																	   const std::vector<ChunkCoord>& coords) const
+	{
+		std::vector<std::unique_ptr<Chunk>> chunks(coords.size());
+		std::latch done(static_cast<std::ptrdiff_t>(coords.size()));
+
+		for (size_t i = 0; i < coords.size(); i++)
+		{
+			jobs.Submit(
+				[this, &coords, &chunks, &done, i]()
+				{
+					chunks[i] = Generate(coords[i]);
+					done.count_down();
+				});
+		}
+
+		done.wait();
+		return chunks;
+	}
+
+	// -------- Private --------
+
+	BlockId WorldGenerator::GetColumnBlock(int worldX, int y, int worldZ, int height, bool desert) const
+	{
+		const int depth = height - y;
+		const bool underwater = height < SeaLevel;
+		const bool beach = underwater && height >= SeaLevel - BeachDepth;
+
+		if (depth == 0)
+		{
+			if (desert || beach)
+				return Blocks::Sand;
+			return underwater ? Blocks::Gravel : Blocks::Grass;
+		}
+
+		if (depth <= DirtDepth)
+			return desert || beach ? Blocks::Sand : Blocks::Dirt;
+
+		// Ores : coal in the upper half of the stone, iron deeper
+		const uint32_t roll = HashBlock(worldX, y, worldZ, m_Noise.GetSeed()) % 1000;
+		if (roll < 8 && y < 128)
+			return Blocks::CoalOre;
+		if (roll >= 8 && roll < 12 && y < 64)
+			return Blocks::IronOre;
+
+		return Blocks::Stone;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <jobs/JobSystem.hpp>
+#include <world/Chunk.hpp>
+
+#include "TerrainNoise.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Makes the chunks of a world from its seed : plains, hills and deserts, with water up to the sea level
+	/// and ores in the stone. The same seed and coordinate always give the same chunk, on any machine.
+	///
+	/// Immutable, Generate() can run on any number of threads at once.
+	class WorldGenerator
+	{
+	  public:
+		static constexpr int SeaLevel = 62; // Highest water block
+
+		explicit WorldGenerator(uint32_t seed, const TerrainNoiseSettings& settings = {});
+
+		std::unique_ptr<Chunk> Generate(ChunkCoord coord) const;
+
+		/// @brief Generates the chunks in parallel on the workers, in the order of coords.
+		/// Blocks until all are done, not from inside a job.
+		std::vector<std::unique_ptr<Chunk>> GenerateChunks(JobSystem& jobs,
+														   const std::vector<ChunkCoord>& coords) const;
+
+		uint32_t GetSeed() const { return m_Noise.GetSeed(); }
+
+		/// @brief Lets benchmarks force the scalar or the SIMD noise.
+		TerrainNoise& GetNoise() { return m_Noise; }
+		const TerrainNoise& GetNoise() const { return m_Noise; }
+
+	  private:
+		/// @brief The block at Y of a column whose surface is at height, for Y in [1, height].
+		BlockId GetColumnBlock(int worldX, int y, int worldZ, int height, bool desert) const;
+
+	  private:
+		TerrainNoise m_Noise;
+	};
+} // namespace onion::voxel